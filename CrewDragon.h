@@ -18,13 +18,14 @@ class TestCrewDragon;
 // Components
 class CrewDragonCenter : public Satellite {
 public:
+    virtual Kind getKind() const override { return CREW_DRAGON_CENTER; }
     CrewDragonCenter(const Satellite& parent) : Satellite(0, 6.0, 0.0) {
         pos = parent.getPosition();
         velocity = Velocity();
-        timeDilation = 48.0;
     }
 
     void destroy(std::list<Satellite*>& satellites) override {
+        TRACE_SCOPE("CrewDragonCenter::destroy");
         if (!isInvisible() && !isDead()) {
             for (int i = 0; i < 4; i++) {
                 Angle angle;
@@ -39,20 +40,18 @@ public:
         if (!isInvisible() && !isDead())
             gout.drawCrewDragonCenter(pos, angle.getRadians());
     }
-
-private:
-    double timeDilation;
 };
 
 class CrewDragonLeft : public Satellite {
 public:
+    virtual Kind getKind() const override { return CREW_DRAGON_LEFT; }
     CrewDragonLeft(const Satellite& parent) : Satellite(0, 6.0, 0.0) {
         pos = parent.getPosition();
         velocity = Velocity();
-        timeDilation = 48.0;
     }
 
     void destroy(std::list<Satellite*>& satellites) override {
+        TRACE_SCOPE("CrewDragonLeft::destroy");
         if (!isInvisible() && !isDead()) {
             for (int i = 0; i < 2; i++) {
                 Angle angle;
@@ -67,20 +66,18 @@ public:
         if (!isInvisible() && !isDead())
             gout.drawCrewDragonLeft(pos, angle.getRadians());
     }
-
-private:
-    double timeDilation;
 };
 
 class CrewDragonRight : public Satellite {
 public:
+    virtual Kind getKind() const override { return CREW_DRAGON_RIGHT; }
     CrewDragonRight(const Satellite& parent) : Satellite(0, 6.0, 0.0) {
         pos = parent.getPosition();
         velocity = Velocity();
-        timeDilation = 48.0;
     }
 
     void destroy(std::list<Satellite*>& satellites) override {
+        TRACE_SCOPE("CrewDragonRight::destroy");
         if (!isInvisible() && !isDead()) {
             for (int i = 0; i < 2; i++) {
                 Angle angle;
@@ -95,9 +92,6 @@ public:
         if (!isInvisible() && !isDead())
             gout.drawCrewDragonRight(pos, angle.getRadians());
     }
-
-private:
-    double timeDilation;
 };
 
 
@@ -110,6 +104,7 @@ class CrewDragon : public Satellite
 {
 public:
     friend TestCrewDragon;
+    virtual Kind getKind() const override { return CREW_DRAGON; }
     CrewDragon() : Satellite(0, 7.0, 0.0)  // age=0, radius=8.0 (larger than other satellites), no rotation
     {
         // Initial position at ISS-like orbit (~400km altitude)
@@ -120,19 +115,16 @@ public:
         velocity.setDX(-7900.0);  // m/s - slightly faster than Starlink due to lower orbit
         velocity.setDY(0.0);      // m/s
 
-        timeDilation = 48.0; // Same time dilation as other satellites
     }
 
     virtual void move(double time) override
     {
-        // Scale time by dilation factor for orbital motion
-        Satellite::move(time * timeDilation);
-
-        // Reset angle change to remove time dilation effect on rotation
-        angle.add(-angularVelocity * (timeDilation - 1.0));
+        // Every tick covers the same simulated time, whatever the object
+        Satellite::move(time * getTimeWarp());
     }
 
     void destroy(std::list<Satellite*>& satellites) override {
+        TRACE_SCOPE("CrewDragon::destroy");
         if (!isInvisible() && !isDead()) {
             satellites.push_back(new CrewDragonCenter(*this));
             satellites.push_back(new CrewDragonLeft(*this));
@@ -154,8 +146,5 @@ public:
         if (!isInvisible() && !isDead())
             gout.drawCrewDragon(pos, angle.getRadians());
     }
-
-private:
-    double timeDilation;  // Time scaling factor for this satellite
 };
 
@@ -0,0 +1,39 @@
+/***********************************************************************
+ * Header File:
+ *    DEBRIS
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Debris class
+ ************************************************************************/
+
+#pragma once
+#include "Satellite.h"
+#include "integrator.h"
+#include "uiDraw.h"
+
+/*********************************************
+ * DEBRIS
+ * A bare piece of something that broke up, placed by a scenario. Like a
+ * fragment it has no radius, so it never hits anything, but it goes
+ * with the time warp like everything else in orbit
+ *********************************************/
+class Debris : public Satellite
+{
+public:
+    virtual Kind getKind() const override { return DEBRIS; }
+    Debris(const Integrator::State& state) : Satellite(10, 0.0, 0.01)
+    {
+        setState(state);
+    }
+
+    virtual void move(double time) override
+    {
+        Satellite::move(time * getTimeWarp());
+    }
+
+    virtual void draw(ogstream& gout) override
+    {
+        gout.drawFragment(pos, angle.getRadians());
+    }
+};
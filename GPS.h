@@ -24,18 +24,17 @@ class TestGPS;
 class GPSCenter : public Satellite
 {
 public:
+    virtual Kind getKind() const override { return GPS_CENTER; }
     GPSCenter(const Satellite& parent) :
         Satellite(0, 7.0, 0.001)
     {
         this->pos = parent.getPosition();
         this->velocity = Velocity();
-        this->timeDilation = 48.0;
     }
 
     virtual void move(double time) override
     {
-        Satellite::move(time * timeDilation);
-        angle.add(-angularVelocity * (timeDilation - 1.0));
+        Satellite::move(time * getTimeWarp());
     }
 
     virtual void draw(ogstream& gout) override
@@ -46,6 +45,7 @@ public:
 
     virtual void destroy(std::list<Satellite*>& satellites) override
     {
+        TRACE_SCOPE("GPSCenter::destroy");
         if (!isInvisible() && !isDead())
         {
             createFragments(satellites, 3);
@@ -63,9 +63,6 @@ protected:
             satellites.push_back(new Satellite(*this, fragmentAngle));
         }
     }
-
-private:
-    double timeDilation;
 };
 
 /*********************************************
@@ -75,18 +72,17 @@ private:
 class GPSLeftArray : public Satellite
 {
 public:
+    virtual Kind getKind() const override { return GPS_LEFT_ARRAY; }
     GPSLeftArray(const Satellite& parent) :
         Satellite(0, 8.0, 0.001)
     {
         this->pos = parent.getPosition();
         this->velocity = Velocity();
-        this->timeDilation = 48.0;
     }
 
     virtual void move(double time) override
     {
-        Satellite::move(time * timeDilation);
-        angle.add(-angularVelocity * (timeDilation - 1.0));
+        Satellite::move(time * getTimeWarp());
     }
 
     virtual void draw(ogstream& gout) override
@@ -102,6 +98,7 @@ public:
 
     virtual void destroy(std::list<Satellite*>& satellites) override
     {
+        TRACE_SCOPE("GPSLeftArray::destroy");
         if (!isInvisible() && !isDead())
         {
             createFragments(satellites, 3);
@@ -119,9 +116,6 @@ protected:
             satellites.push_back(new Satellite(*this, fragmentAngle));
         }
     }
-
-private:
-    double timeDilation;
 };
 
 /*********************************************
@@ -131,18 +125,17 @@ private:
 class GPSRightArray : public Satellite
 {
 public:
+    virtual Kind getKind() const override { return GPS_RIGHT_ARRAY; }
     GPSRightArray(const Satellite& parent) :
         Satellite(0, 8.0, 0.001)
     {
         this->pos = parent.getPosition();
         this->velocity = Velocity();
-        this->timeDilation = 48.0;
     }
 
     virtual void move(double time) override
     {
-        Satellite::move(time * timeDilation);
-        angle.add(-angularVelocity * (timeDilation - 1.0));
+        Satellite::move(time * getTimeWarp());
     }
 
     virtual void draw(ogstream& gout) override
@@ -158,6 +151,7 @@ public:
 
     virtual void destroy(std::list<Satellite*>& satellites) override
     {
+        TRACE_SCOPE("GPSRightArray::destroy");
         if (!isInvisible() && !isDead())
         {
             createFragments(satellites, 3);
@@ -175,9 +169,6 @@ protected:
             satellites.push_back(new Satellite(*this, fragmentAngle));
         }
     }
-
-private:
-    double timeDilation;
 };
 
 /*********************************************
@@ -188,34 +179,54 @@ class GPS : public Satellite
 {
 public:
     friend TestGPS;
+    virtual Kind getKind() const override { return GPS_SATELLITE; }
+
+    // Where one of the constellation starts, in meters and m/s
+    struct InitialState
+    {
+        double x;
+        double y;
+        double dx;
+        double dy;
+    };
+
+    // The six of them, evenly spaced around the same orbit. Built in at
+    // compile time, so starting up costs nothing
+    static constexpr InitialState INITIAL_STATES[] =
+    {
+        {0.0, 26560000.0, -3880.0, 0.0},
+        {23001634.72, 13280000.0, -1940.00, 3360.18},
+        {23001634.72, -13280000.0, 1940.00, 3360.18},
+        {0.0, -26560000.0, 3880.0, 0.0},
+        {-23001634.72, -13280000.0, 1940.00, -3360.18},
+        {-23001634.72, 13280000.0, -1940.00, -3360.18}
+    };
 
     GPS(const Position& pos, const Velocity& vel) :
         Satellite(0, 12.0, 0.001)
     {
        this->pos = pos;
        this->velocity = vel;
-       timeDilation = 48.0;
     }
 
-    GPS() : GPS(
-        Position(0.0, 26560000.0),
-        Velocity(-3880.0, 0.0)
+    GPS(const InitialState& state) : GPS(
+        Position(state.x, state.y),
+        Velocity(state.dx, state.dy)
     ) {}
 
+    GPS() : GPS(INITIAL_STATES[0]) {}
+
     static std::vector<std::pair<Position, Velocity>> getInitialPositions()
     {
-        return {
-            {Position(0.0, 26560000.0), Velocity(-3880.0, 0.0)},
-            {Position(23001634.72, 13280000.0), Velocity(-1940.00, 3360.18)},
-            {Position(23001634.72, -13280000.0), Velocity(1940.00, 3360.18)},
-            {Position(0.0, -26560000.0), Velocity(3880.0, 0.0)},
-            {Position(-23001634.72, -13280000.0), Velocity(1940.00, -3360.18)},
-            {Position(-23001634.72, 13280000.0), Velocity(-1940.00, -3360.18)}
-        };
+        std::vector<std::pair<Position, Velocity>> positions;
+        for (const InitialState& state : INITIAL_STATES)
+            positions.push_back({Position(state.x, state.y), Velocity(state.dx, state.dy)});
+        return positions;
     }
 
     virtual void destroy(std::list<Satellite*>& satellites) override
     {
+        TRACE_SCOPE("GPS::destroy");
         if (!isInvisible() && !isDead())
         {
             satellites.push_back(new GPSCenter(*this));
@@ -228,8 +239,7 @@ public:
 
     virtual void move(double time) override
     {
-        Satellite::move(time * timeDilation);
-        angle.add(-angularVelocity * (timeDilation - 1.0));
+        Satellite::move(time * getTimeWarp());
     }
 
     virtual void draw(ogstream& gout) override
@@ -250,7 +260,4 @@ protected:
             satellites.push_back(new Satellite(*this, fragmentAngle));
         }
     }
-
-private:
-    double timeDilation;
 };
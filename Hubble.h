@@ -24,10 +24,10 @@ public:
     {
         pos = parent.getPosition();
         velocity = Velocity();
-        timeDilation = 48.0;
     }
 
     virtual void destroy(std::list<Satellite*>& satellites) override {
+        TRACE_SCOPE("HubbleComponent::destroy");
         if (!isInvisible() && !isDead()) {
             for (int i = 0; i < numFragments; i++) {
                 Angle angle;
@@ -39,17 +39,16 @@ public:
     }
 
     virtual void move(double time) override {
-        Satellite::move(time * timeDilation);
-        angle.add(-angularVelocity * (timeDilation - 1.0));
+        Satellite::move(time * getTimeWarp());
     }
 
 protected:
     int numFragments;
-    double timeDilation;
 };
 
 class HubbleTelescope : public HubbleComponent {
 public:
+    virtual Kind getKind() const override { return HUBBLE_TELESCOPE; }
     HubbleTelescope(const Satellite& parent) : HubbleComponent(parent, 10.0, 3) {}
     virtual void draw(ogstream& gout) override {
         if (!isInvisible() && !isDead())
@@ -59,6 +58,7 @@ public:
 
 class HubbleComputer : public HubbleComponent {
 public:
+    virtual Kind getKind() const override { return HUBBLE_COMPUTER; }
     HubbleComputer(const Satellite& parent) : HubbleComponent(parent, 7.0, 2) {}
     virtual void draw(ogstream& gout) override {
         if (!isInvisible() && !isDead())
@@ -68,6 +68,7 @@ public:
 
 class HubbleLeftArray : public HubbleComponent {
 public:
+    virtual Kind getKind() const override { return HUBBLE_LEFT_ARRAY; }
     HubbleLeftArray(const Satellite& parent) : HubbleComponent(parent, 8.0, 2) {}
     virtual void draw(ogstream& gout) override {
         if (!isInvisible() && !isDead())
@@ -77,6 +78,7 @@ public:
 
 class HubbleRightArray : public HubbleComponent {
 public:
+    virtual Kind getKind() const override { return HUBBLE_RIGHT_ARRAY; }
     HubbleRightArray(const Satellite& parent) : HubbleComponent(parent, 8.0, 2) {}
     virtual void draw(ogstream& gout) override {
         if (!isInvisible() && !isDead())
@@ -87,16 +89,17 @@ public:
 class Hubble : public Satellite {
 public:
     friend TestHubble;
+    virtual Kind getKind() const override { return HUBBLE; }
 
     Hubble() : Satellite(0, 10.0, 0.0) {
         pos.setMetersX(0.0);
         pos.setMetersY(-42164000.0);
         velocity.setDX(3100.0);
         velocity.setDY(0.0);
-        timeDilation = 48.0;
     }
 
     virtual void destroy(std::list<Satellite*>& satellites) override {
+        TRACE_SCOPE("Hubble::destroy");
         if (!isInvisible() && !isDead()) {
             satellites.push_back(new HubbleTelescope(*this));
             satellites.push_back(new HubbleComputer(*this));
@@ -107,15 +110,11 @@ public:
     }
 
     virtual void move(double time) override {
-        Satellite::move(time * timeDilation);
-        angle.add(-angularVelocity * (timeDilation - 1.0));
+        Satellite::move(time * getTimeWarp());
     }
 
     virtual void draw(ogstream& gout) override {
         if (!isInvisible() && !isDead())
             gout.drawHubble(pos, angle.getRadians());
     }
-
-private:
-    double timeDilation;
 };
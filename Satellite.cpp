@@ -9,13 +9,52 @@
 
 #include "Satellite.h"
 #include "acceleration.h"
+#include <cmath>    // for ceil()
 
  // Constants
 const double EARTH_RADIUS = 6378000.0;    // meters
 const double G = 9.80665;                 // m/s^2
-const double TIME_DILATION = 1440.0;      // 24 hours * 60 minutes
-const double FRAME_RATE = 30.0;           // frames per second
-const double TIME_PER_FRAME = TIME_DILATION / FRAME_RATE;
+
+std::atomic<double> Satellite::timeWarp(Satellite::DEFAULT_WARP);
+std::atomic<Integrator::Method> Satellite::integrator(Integrator::SYMPLECTIC_EULER);
+
+/*********************************************
+ * SATELLITE : SET TIME WARP
+ * Speed up or slow down everything at once. Anything but a positive
+ * number of seconds is ignored
+ *********************************************/
+void Satellite::setTimeWarp(double warp)
+{
+    if (warp > 0.0)
+        timeWarp.store(warp, std::memory_order_relaxed);
+}
+
+/*********************************************
+ * SATELLITE : SET INTEGRATOR
+ * Change how everything steps through gravity. Anything that is not an
+ * integrator is ignored
+ *********************************************/
+void Satellite::setIntegrator(Integrator::Method method)
+{
+    if (method >= 0 && method < Integrator::NUM_METHODS)
+        integrator.store(method, std::memory_order_relaxed);
+}
+
+/*********************************************
+ * SATELLITE : GET STATE and SET STATE
+ *********************************************/
+Integrator::State Satellite::getState() const
+{
+    return { pos.getMetersX(), pos.getMetersY(), velocity.getDX(), velocity.getDY() };
+}
+
+void Satellite::setState(const Integrator::State& state)
+{
+    pos.setMetersX(state.x);
+    pos.setMetersY(state.y);
+    velocity.setDX(state.dx);
+    velocity.setDY(state.dy);
+}
 
  /*********************************************
   * SATELLITE : GET GRAVITY
@@ -107,20 +146,23 @@ Satellite::Satellite(const Satellite& parent, const Position& offset, const Velo
 
 /*********************************************
  * SATELLITE : MOVE
- * Inertia and gravity using proper time dilation
+ * Inertia and gravity using proper time dilation. Gravity changes along
+ * the way, so a long time is split into equal steps of at most MAX_STEP
+ * with gravity worked out again for each. Spin and age go by the call,
+ * not by the simulated time. How each step goes is up to the integrator
+ *    INPUT  time  Simulated seconds to move forward
  *********************************************/
 void Satellite::move(double time)
 {
-    // Get gravity acceleration at current position
-    Acceleration aGravity = getGravity(pos);
-
-    // Update velocity first with gravity
-    velocity.addDX(aGravity.getDDX() * time);  // v = v0 + at
-    velocity.addDY(aGravity.getDDY() * time);
-
-    // Update position with current velocity
-    pos.addMetersX(velocity.getDX() * time);   // x = x0 + vt
-    pos.addMetersY(velocity.getDY() * time);
+    TRACE_SCOPE("Satellite::move");
+
+    int steps = time > MAX_STEP ? (int)ceil(time / MAX_STEP) : 1;
+    double dt = time / steps;
+    Integrator::Method method = getIntegrator();
+    Integrator::State state = getState();
+    for (int step = 0; step < steps; step++)
+        Integrator::step(method, state, dt);
+    setState(state);
 
     // Update rotation
     angle.add(angularVelocity);
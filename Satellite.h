@@ -14,12 +14,17 @@
 #include "velocity.h"
 #include "angle.h"
 #include "uiDraw.h"
+#include "trace.h"
+#include "integrator.h"
 #include <list>
+#include <atomic>   // the warp can be changed from any thread
 
 class TestSatellite;
 class Interface;
 class TestSatellite;
 class TestShip;
+class TestIntegrator;
+class Checkpoint;
 
 
 /*********************************************
@@ -31,7 +36,22 @@ class Satellite
 public:
     friend TestSatellite;
     friend TestShip;
+    friend TestIntegrator;
+    friend Checkpoint;
 
+    // What it is, so a checkpoint can make another one just like it.
+    // New kinds go on the end: the numbers are written to disk
+    enum Kind
+    {
+        SATELLITE, SPUTNIK,
+        HUBBLE, HUBBLE_TELESCOPE, HUBBLE_COMPUTER, HUBBLE_LEFT_ARRAY, HUBBLE_RIGHT_ARRAY,
+        STARLINK, STARLINK_BODY, STARLINK_ARRAY,
+        CREW_DRAGON, CREW_DRAGON_CENTER, CREW_DRAGON_LEFT, CREW_DRAGON_RIGHT,
+        GPS_SATELLITE, GPS_CENTER, GPS_LEFT_ARRAY, GPS_RIGHT_ARRAY,
+        SHIP, DEBRIS,
+        NUM_KINDS
+    };
+    virtual Kind getKind() const { return SATELLITE; }
 
     // constructors
     Satellite(int age = 0, double radius = 0.0, double angularVelocity = 0.0)
@@ -48,15 +68,34 @@ public:
     // Used to create projectiles. They have specific speeds
     Satellite(const Satellite& parent, const Position& offset, const Velocity& kick);
 
+    // Everything is deleted through a Satellite pointer
+    virtual ~Satellite() {}
+
     // Getters
     double getRadius() const { return radius; }
     bool isDead() const { return dead; }
     bool isInvisible() const { return age < 10; }
     const Angle& getAngle() const { return angle; }
     const Position& getPosition() const { return pos; }
+    const Velocity& getVelocity() const { return velocity; }
+
+    // Where it is and how fast it is going, all at once
+    Integrator::State getState() const;
+    void setState(const Integrator::State& state);
 
 
     virtual int getAge() const { return age; }
+
+    // How many simulated seconds one tick covers, for everything in orbit.
+    // However large, move() takes steps no longer than MAX_STEP seconds
+    static double getTimeWarp() { return timeWarp.load(std::memory_order_relaxed); }
+    static void setTimeWarp(double warp);
+    static constexpr double DEFAULT_WARP = 48.0;   // a day a minute at 30 ticks a second
+    static constexpr double MAX_STEP = 48.0;       // longest step that still stays in orbit
+
+    // How move() steps through gravity, for everything in orbit
+    static Integrator::Method getIntegrator() { return integrator.load(std::memory_order_relaxed); }
+    static void setIntegrator(Integrator::Method method);
     //virtual double getRadius() const { return radius; }
     // virtual const Position& getPosition() const { return pos; }
     // virtual const Angle& getAngle() const { return angle; }
@@ -82,6 +121,8 @@ protected:
     double radius;          // radius in meters
     int age;               // how long have we been alive?
     Acceleration getGravity(const Position& pos) const;
+    static std::atomic<double> timeWarp;   // simulated seconds per tick
+    static std::atomic<Integrator::Method> integrator;   // how move() steps
 #ifdef NDEBUG
     bool useRandom;
 #endif // DEBUG
@@ -9,3 +9,47 @@
 
 
 #include "Ship.h"
+#include <cmath>    // for ceil()
+
+/*********************************************
+ * SHIP : MOVE
+ * Coasting is no different from any other satellite. Under power, the
+ * engine and gravity go in together with velocity Verlet: position
+ * takes half of the acceleration at the start of a step, and velocity
+ * takes the average of gravity at both ends plus the thrust. Constant
+ * thrust is integrated exactly this way, so a burn comes out the same
+ * however the time is split up
+ *    INPUT  time  Ticks to move forward
+ *********************************************/
+void Ship::move(double time)
+{
+   time *= getTimeWarp();
+   if (!isThrusting())
+   {
+      Satellite::move(time);
+      return;
+   }
+
+   TRACE_SCOPE("Ship::move");
+   int steps = time > MAX_STEP ? (int)ceil(time / MAX_STEP) : 1;
+   double dt = time / steps;
+   Acceleration aGravity = getGravity(pos);
+   for (int step = 0; step < steps; step++)
+   {
+      // x = x0 + vt + 1/2 at^2
+      pos.addMetersX((velocity.getDX() + 0.5 * (aGravity.getDDX() + thrust.getDDX()) * dt) * dt);
+      pos.addMetersY((velocity.getDY() + 0.5 * (aGravity.getDDY() + thrust.getDDY()) * dt) * dt);
+
+      // v = v0 + at, with gravity averaged over the step
+      Acceleration aGravityEnd = getGravity(pos);
+      velocity.addDX((0.5 * (aGravity.getDDX() + aGravityEnd.getDDX()) + thrust.getDDX()) * dt);
+      velocity.addDY((0.5 * (aGravity.getDDY() + aGravityEnd.getDDY()) + thrust.getDDY()) * dt);
+      aGravity = aGravityEnd;
+   }
+
+   // Update rotation
+   angle.add(angularVelocity);
+
+   // Update age
+   age++;
+}
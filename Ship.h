@@ -15,11 +15,14 @@
 #include "uiDraw.h"
 
 class TestShip;
+class Checkpoint;
 
 class Ship : public Satellite
 {
 public:
    friend TestShip;
+   friend Checkpoint;
+   virtual Kind getKind() const override { return SHIP; }
    
    // constructor
    Ship() : Satellite(0, 10.0, 0.0)
@@ -34,7 +37,7 @@ public:
   void draw(ogstream &gout) override
    {
        if (!isInvisible() && !isDead())
-           gout.drawShip(pos, angle.getRadians(), false);
+           gout.drawShip(pos, angle.getRadians(), isThrusting());
    }
    
    void input(const Interface& ui) override
@@ -44,56 +47,39 @@ public:
        if (ui.isLeft())
            this->angle.add(-0.1);
        
-       if (ui.isDown())
-       {
-          // Calculate thrust effect based on the direction the ship is pointing
-          Acceleration thrust;
-          for (int i = 0; i < 48; i++)
-          {
-             thrust.setDDX(2.0 * sin(angle.getRadians()));
-             thrust.setDDY(2.0 * cos(angle.getRadians()));
-             
-             // udpate velocity
-             // velocity.add(thrust, 1.0);
-             velocity.addDX(thrust.getDDX() * 1.0);  // v = v0 + at
-             velocity.addDY(thrust.getDDY() * 1.0);
-             
-             // Update the position using the current velocity
-             // pos.add(thrust, velocity, 48.0);
-             pos.addMetersX(velocity.getDX() * 1.0);   // x = x0 + vt
-             pos.addMetersY(velocity.getDY() * 1.0);
-          }
-       }
+       setThrust(ui.isDown() != 0);
    }
-   
-   void move(double time) override
+
+   // Fire the engine the way the ship is pointing, or shut it off.
+   // It stays that way until told otherwise
+   void setThrust(bool isOn)
    {
-      Satellite::move(48.0);
-      
-      // Reset angle change to remove time dilation effect on rotation
-      angle.add(-angularVelocity * (48.0 - 1.0));
+      if (isOn)
+         thrust.set(angle, THRUST);
+      else
+         thrust = Acceleration();
    }
+   bool isThrusting() const { return thrust.getDDX() != 0.0 || thrust.getDDY() != 0.0; }
+   
+   void move(double time) override;
    
    void destroy(std::list<Satellite*>& satellites) override
    {
+      TRACE_SCOPE("Ship::destroy");
       // lab 12
    }
    
    bool getDefunct() override { return dead; }
+
+private:
+   Acceleration thrust;   // from the engine, on top of gravity
+
+   static constexpr double THRUST = 2.0;   // m/s^2 with the engine on
 };
 
-class FakeShip : public Satellite
+class FakeShip : public Ship
 {
 public:
-   FakeShip() : Satellite(0, 10.0, 0.0)
-   {
-      pos.setPixelsX(-450.0);
-      pos.setPixelsY(450.0);
-      velocity.setDX(0.0);
-      velocity.setDY(-2000.0);
-      angle.setDown();
-   }
-   
    void input(bool isRight, bool isLeft, bool isDown, bool isSpace)
    {
       if (isRight)
@@ -101,25 +87,6 @@ public:
       if (isLeft)
           this->angle.add(-0.1);
       
-      if (isDown)
-      {
-          // Calculate thrust effect based on the direction the ship is pointing
-         Acceleration thrust;
-         for (int i = 0; i < 48; i++)
-         {
-            thrust.setDDX(2.0 * sin(angle.getRadians()));
-            thrust.setDDY(2.0 * cos(angle.getRadians()));
-            
-            // udpate velocity
-            // velocity.add(thrust, 1.0);
-            velocity.addDX(thrust.getDDX() * 1.0);  // v = v0 + at
-            velocity.addDY(thrust.getDDY() * 1.0);
-            
-            // Update the position using the current velocity
-            // pos.add(thrust, velocity, 48.0);
-            pos.addMetersX(velocity.getDX() * 1.0);   // x = x0 + vt
-            pos.addMetersY(velocity.getDY() * 1.0);
-         }
-      }
+      setThrust(isDown);
    }
 };
@@ -16,6 +16,31 @@
 #include "crewDragon.h"
 #include "GPS.h"
 #include "Ship.h"
+#include "camera.h"
+#include "heatmap.h"
+#include "uiRaster.h"
+#include "uiRecord.h"
+#include "tripleBuffer.h"
+#include "fixedStep.h"
+#include "profiler.h"
+#include "trace.h"
+#include "scenario.h"
+#include "phases.h"
+#include "checkpoint.h"
+#include "trajectory.h"
+#include "conjunction.h"
+#include "receivers.h"
+#include "linkGraph.h"
+#include <list>
+#include <vector>
+#include <thread>    // for the simulation thread
+#include <iomanip>   // for setprecision()
+#include <atomic>
+#include <chrono>    // for steady_clock
+#include <cstring>   // for strcmp()
+#include <cstdlib>   // for atoi() and strtoull()
+#include <cstdio>    // for snprintf()
+#include <cmath>     // for pow()
 using namespace std;
 
 /*********************************************
@@ -25,21 +50,37 @@ using namespace std;
 class Simulator
 {
    public:
-   // Constructor initializes the simulation
-   Simulator(Position ptUpperRight) :
+   // Constructor initializes the simulation, with what we always start
+   // with or with a scenario made up for the occasion
+   Simulator(Position ptUpperRight, const Scenario* pScenario = NULL) :
    ptUpperRight(ptUpperRight),
-   pSputnik(new Sputnik()),
-   pHubble(new Hubble()),
-   pStarlink(new Starlink()),
-   pCrewDragon(new CrewDragon()),
-   pGPS(new GPS()),
-   pGPS2(new GPS(GPS().getInitialPositions()[1].first, GPS().getInitialPositions()[1].second)),
-   pGPS3(new GPS(GPS().getInitialPositions()[2].first, GPS().getInitialPositions()[2].second)),
-   pGPS4(new GPS(GPS().getInitialPositions()[3].first, GPS().getInitialPositions()[3].second)),
-   pGPS5(new GPS(GPS().getInitialPositions()[4].first, GPS().getInitialPositions()[4].second)),
-   pGPS6(new GPS(GPS().getInitialPositions()[5].first, GPS().getInitialPositions()[5].second)),
-   pShip(new Ship())
+   camera(ptUpperRight),
+   heatmap(ptUpperRight),
+   pShip(new Ship()),
+   secondsSimulated(0.0),
+   checkpointFileName(NULL),
+   secondsCheckpoint(0.0),
+   pTrajectory(NULL),
+   pReceivers(NULL),
+   leastFixed(0),
+   secondsLeastFixed(0.0),
+   pLinks(NULL)
    {
+      if (pScenario)
+         for (const Scenario::Object& object : pScenario->getObjects())
+            satellites.push_back(Scenario::create(object));
+      else
+      {
+         satellites.push_back(new Sputnik());
+         satellites.push_back(new Hubble());
+         satellites.push_back(new Starlink());
+         satellites.push_back(new CrewDragon());
+         for (const GPS::InitialState& state : GPS::INITIAL_STATES)
+            satellites.push_back(new GPS(state));
+      }
+
+      satellites.push_back(pShip);
+
       // Initialize the random stars
       for (int i = 0; i < NUM_STARS; i++)
       {
@@ -54,152 +95,863 @@ class Simulator
    // Destructor cleans up any allocated memory
    ~Simulator()
    {
-      delete pSputnik;
-      delete pHubble;
-      delete pStarlink;
-      delete pCrewDragon;
-      delete pGPS;
-      delete pGPS2;
-      delete pGPS3;
-      delete pGPS4;
-      delete pGPS5;
-      delete pGPS6;
-      delete pShip;
+      for (Satellite* pSatellite : satellites)
+         delete pSatellite;
    }
    
    // Move everything forward one time unit
    void update(const Interface & pUI)
    {
-      // Move Sputnik according to physics (includes orbital motion)
-      if (pSputnik && !pSputnik->isDead())
-         pSputnik->move(1.0);
-      
-      // Move Hubble according to physics
-      if (pHubble && !pHubble->isDead())
-         pHubble->move(1.0);
-      
-      // Move Starlink according to physics
-      if (pStarlink && !pStarlink->isDead())
-         pStarlink->move(1.0);
-      
-      // Move CrewDragon according to physics
-      if (pCrewDragon && !pCrewDragon->isDead())
-         pCrewDragon->move(1.0);
-      
-      if (pGPS && !pGPS->isDead())
-         pGPS->move(1.0);
-      
-      if (pGPS2 && !pGPS2->isDead())
-         pGPS2->move(1.0);
-      
-      if (pGPS3 && !pGPS3->isDead())
-         pGPS3->move(1.0);
-      
-      if (pGPS4 && !pGPS4->isDead())
-         pGPS4->move(1.0);
-      
-      if (pGPS5 && !pGPS5->isDead())
-         pGPS5->move(1.0);
-      
-      if (pGPS6 && !pGPS6->isDead())
-         pGPS6->move(1.0);
-      
-      if (pShip && !pShip->isDead())
-      {
-         pShip->input(pUI);
-         pShip->move(1.0);
-      }
+      TRACE_SCOPE("Simulator::update");
+
+      // Speed time up or slow it down, twice as much for each press
+      if (pUI.getWarpSteps())
+         Satellite::setTimeWarp(std::max(WARP_MIN, std::min(WARP_MAX,
+            Satellite::getTimeWarp() * pow(2.0, pUI.getWarpSteps()))));
+
+      // Move everything according to physics (includes orbital motion).
+      // Only the ship pays any attention to the input
+      tickPhases.move(satellites, pUI);
+
+      secondsSimulated += Satellite::getTimeWarp();
+
+      // Look around
+      camera.input(pUI);
       
       // Update star phases for twinkling
       for (int i = 0; i < NUM_STARS; i++)
          phases[i] = (phases[i] + 1) % 256;
    }
+
    
    // Draw everything on the screen
    void draw(ogstream& gout)
    {
-      // Draw the stars first (background)
+      TRACE_SCOPE("Simulator::draw");
+
+      // Draw the stars first (background). They stay put on the screen,
+      // so they are drawn at the home zoom they were made at
+      gout.setView(Position());
       for (int i = 0; i < NUM_STARS; i++)
          gout.drawStar(stars[i], phases[i]);
+
+      // Everything else moves and zooms with the camera
+      double zoom = camera.apply();
+      gout.setView(camera.getCenter());
       
       // Draw stationary Earth
       Position posEarth;
-      gout.drawEarth(posEarth, 0.0);
-      
-      // Draw Sputnik last (foreground)
-      if (pSputnik && !pSputnik->isDead())
-         pSputnik->draw(gout);
-      
-      if (pHubble && !pHubble->isDead())
-         pHubble->draw(gout);
-      
-      if (pStarlink && !pStarlink->isDead())
-         pStarlink->draw(gout);
-      
-      if (pCrewDragon && !pCrewDragon->isDead())
-         pCrewDragon->draw(gout);
-      
-      if (pGPS && !pGPS->isDead())
-         pGPS->draw(gout);
-      
-      if (pGPS2 && !pGPS2->isDead())
-         pGPS2->draw(gout);
-      
-      if (pGPS3 && !pGPS3->isDead())
-         pGPS3->draw(gout);
-      
-      if (pGPS4 && !pGPS4->isDead())
-         pGPS4->draw(gout);
-      
-      if (pGPS5 && !pGPS5->isDead())
-         pGPS5->draw(gout);
+      if (camera.isVisible(posEarth, EARTH_MARGIN))
+         gout.drawEarth(posEarth, 0.0);
       
-      if (pGPS6 && !pGPS6->isDead())
-         pGPS6->draw(gout);
-      
-      if (pShip && !pShip->isDead())
+      // Cull anything that cannot reach the screen before drawing it
+      const std::vector<Satellite*>& visible =
+         tickPhases.cull(satellites, camera, SPRITE_MARGIN, pShip);
+
+      // The farther out and the more crowded, the less detail
+      switch (camera.getDetail(SPRITE_MARGIN, visible.size()))
+      {
+         case Camera::SPRITE:
+            for (Satellite* pSatellite : visible)
+               pSatellite->draw(gout);
+            break;
+         case Camera::POINT:
+            for (Satellite* pSatellite : visible)
+               gout.drawPoint(pSatellite->getPosition());
+            break;
+         case Camera::HEATMAP:
+            points.clear();
+            for (Satellite* pSatellite : visible)
+               points.push_back(pSatellite->getPosition());
+            heatmap.accumulate(points, camera);
+            heatmap.draw(gout, camera);
+            break;
+      }
+
+      // We always want to see the ship, and it goes in the foreground
+      if (!pShip->isDead() && camera.isVisible(pShip->getPosition(), SPRITE_MARGIN))
          pShip->draw(gout);
-      
+
+      // How fast time is going, in the bottom left corner
+      Position ptWarp;
+      ptWarp.setPixelsX(-ptUpperRight.getPixelsX() / 2.0 + 10.0);
+      ptWarp.setPixelsY(-ptUpperRight.getPixelsY() / 2.0 + 10.0);
+      char text[64];
+      snprintf(text, sizeof(text), "Time warp %gx", Satellite::getTimeWarp());
+      gout.setPosition(ptWarp);
+      gout << text;
+      gout.flush();
+
+      // and how the GPS receivers and routes are doing, just above where
+      // fast forward shows how far it has got
+      Position ptStatus;
+      ptStatus.setPixelsX(ptWarp.getPixelsX());
+      ptStatus.setPixelsY(ptWarp.getPixelsY() + 36.0);
+      if (pReceivers)
+      {
+         Receivers::Summary summary = pReceivers->getSummary();
+         snprintf(text, sizeof(text), "GPS fix %zu of %zu, PDOP %.1f",
+                  summary.numFixed, summary.numReceivers, summary.meanPdop);
+         gout.setPosition(ptStatus);
+         gout << text;
+         gout.flush();
+         ptStatus.addPixelsY(18.0);
+      }
+      for (int route = 0; pLinks && route < (int)pLinks->getNumRoutes(); route++)
+      {
+         if (pLinks->getLatency(route) < 0.0)
+            snprintf(text, sizeof(text), "Route %d: no way", route);
+         else
+            snprintf(text, sizeof(text), "Route %d: %.1f ms, %d hops", route,
+                     pLinks->getLatency(route) * 1000.0, pLinks->getNumHops(route));
+         gout.setPosition(ptStatus);
+         gout << text;
+         gout.flush();
+         ptStatus.addPixelsY(18.0);
+      }
+
+      // Leave pixels as they were for the physics
+      Position().setZoom(zoom);
+   }
+
+   // Write everything there is about the simulation to a checkpoint, or
+   // pick it all up again from one. The satellites keep their order, so a
+   // restored run goes on exactly as the saved one would have. False when
+   // the file cannot be written or read, and then nothing changes
+   bool save(const char* fileName) const
+   {
+      TRACE_SCOPE("Simulator::save");
+      Checkpoint checkpoint;
+      for (const Satellite* pSatellite : satellites)
+      {
+         if (pSatellite == pShip)
+            checkpoint.shipIndex = (int32_t)checkpoint.records.size();
+         checkpoint.add(*pSatellite);
+      }
+      for (int i = 0; i < NUM_STARS; i++)
+         checkpoint.stars.push_back({ stars[i].getMetersX(), stars[i].getMetersY(), phases[i], 0 });
+      checkpoint.cameraX = camera.getCenter().getMetersX();
+      checkpoint.cameraY = camera.getCenter().getMetersY();
+      checkpoint.cameraZoom = camera.getZoom();
+      checkpoint.secondsSimulated = secondsSimulated;
+      checkpoint.timeWarp = Satellite::getTimeWarp();
+      checkpoint.integrator = Satellite::getIntegrator();
+      checkpoint.random = getRandomState();
+      return checkpoint.write(fileName);
+   }
+
+   bool restore(const char* fileName)
+   {
+      TRACE_SCOPE("Simulator::restore");
+      Checkpoint checkpoint;
+      if (!checkpoint.read(fileName) ||
+          checkpoint.stars.size() != NUM_STARS ||
+          checkpoint.integrator < 0 || checkpoint.integrator >= Integrator::NUM_METHODS)
+         return false;
+
+      // the random numbers go back last, but make sure they can first
+      std::string randomNow = getRandomState();
+      if (!setRandomState(checkpoint.random))
+         return false;
+      setRandomState(randomNow);
+
+      // make them all before letting go of any we have now
+      std::list<Satellite*> restored;
+      Satellite* pShipRestored;
+      if (!checkpoint.createAll(restored, pShipRestored))
+         return false;
+
+      for (Satellite* pSatellite : satellites)
+         delete pSatellite;
+      satellites.swap(restored);
+      if (pShipRestored)
+         pShip = (Ship*)pShipRestored;
+      else
+      {
+         pShip = new Ship();
+         satellites.push_back(pShip);
+      }
+
+      for (int i = 0; i < NUM_STARS; i++)
+      {
+         stars[i].setMetersX(checkpoint.stars[i].x);
+         stars[i].setMetersY(checkpoint.stars[i].y);
+         phases[i] = (uint8_t)checkpoint.stars[i].phase;
+      }
+      Position center;
+      center.setMetersX(checkpoint.cameraX);
+      center.setMetersY(checkpoint.cameraY);
+      camera.setCenter(center);
+      camera.setZoom(checkpoint.cameraZoom);
+      secondsSimulated = checkpoint.secondsSimulated;
+      Satellite::setTimeWarp(checkpoint.timeWarp);
+      Satellite::setIntegrator((Integrator::Method)checkpoint.integrator);
+
+      // last, so nothing above can draw a number before the run goes on
+      return setRandomState(checkpoint.random);
+   }
+
+   // Save a checkpoint to fileName every so many seconds of wall time,
+   // or never when fileName is NULL
+   void setCheckpoint(const char* fileName, double seconds)
+   {
+      checkpointFileName = fileName;
+      secondsCheckpoint = seconds;
+      timeCheckpoint = chrono::steady_clock::now();
+   }
+
+   // Sample where everything is into a trajectory every so many ticks,
+   // or never when pTrajectory is NULL
+   void setTrajectory(TrajectoryRecorder* pTrajectory) { this->pTrajectory = pTrajectory; }
+
+   // Work out where each receiver is every tick from the GPS satellites
+   // still whole, or never when pReceivers is NULL
+   void setReceivers(Receivers* pReceivers)
+   {
+      this->pReceivers = pReceivers;
+      leastFixed = pReceivers ? pReceivers->size() : 0;
+      secondsLeastFixed = secondsSimulated;
+   }
+
+   // The fewest receivers with a fix after any tick, and when that was
+   size_t getLeastFixed() const { return leastFixed; }
+   double getSecondsLeastFixed() const { return secondsLeastFixed; }
+
+   // Link the Starlink satellites still whole every tick and keep the
+   // routes over them up to date, or never when pLinks is NULL
+   void setLinks(LinkGraph* pLinks) { this->pLinks = pLinks; }
+
+   // Called after each tick. Positions the receivers, links Starlink,
+   // copies out a trajectory sample, and saves a checkpoint when they
+   // are due
+   void endTick()
+   {
+      if (pReceivers)
+         locate();
+      if (pLinks)
+         relay();
+
+      TrajectoryCodec::Sample* pSample = pTrajectory ?
+         pTrajectory->getStageIfDue(secondsSimulated) : NULL;
+      if (pSample)
+      {
+         for (const Satellite* pSatellite : satellites)
+            if (!pSatellite->isDead())
+            {
+               Integrator::State state = pSatellite->getState();
+               pSample->add((uint8_t)pSatellite->getKind(), state.x, state.y, state.dx, state.dy);
+            }
+         pTrajectory->submit();
+      }
+
+      if (!checkpointFileName ||
+          chrono::duration<double>(chrono::steady_clock::now() - timeCheckpoint).count() < secondsCheckpoint)
+         return;
+      if (!save(checkpointFileName))
+         cerr << "Unable to write " << checkpointFileName << endl;
+      timeCheckpoint = chrono::steady_clock::now();
+   }
+   const char* getCheckpoint() const { return checkpointFileName; }
+
+   const Position& getUpperRight() const { return ptUpperRight; }
+   double getSimulatedSeconds() const { return secondsSimulated; }
+
+   // Where everything still in orbit is, in the order it is kept
+   vector<Integrator::State> getStates() const
+   {
+      vector<Integrator::State> states;
+      states.reserve(satellites.size());
+      for (const Satellite* pSatellite : satellites)
+         if (!pSatellite->isDead())
+            states.push_back(pSatellite->getState());
+      return states;
    }
    
    private:
+   // The receivers hear only the GPS satellites that are still whole
+   void locate()
+   {
+      TRACE_SCOPE("Simulator::locate");
+      transmitters.clear();
+      for (const Satellite* pSatellite : satellites)
+         if (!pSatellite->isDead() && pSatellite->getKind() == Satellite::GPS_SATELLITE)
+            transmitters.push_back(pSatellite->getState());
+      pReceivers->solve(secondsSimulated, transmitters);
+      size_t numFixed = pReceivers->getSummary().numFixed;
+      if (numFixed < leastFixed)
+      {
+         leastFixed = numFixed;
+         secondsLeastFixed = secondsSimulated;
+      }
+   }
+
+   // Starlink satellites are linked in the order they are kept
+   void relay()
+   {
+      TRACE_SCOPE("Simulator::relay");
+      relays.clear();
+      for (const Satellite* pSatellite : satellites)
+         if (!pSatellite->isDead() && pSatellite->getKind() == Satellite::STARLINK)
+            relays.push_back(pSatellite->getState());
+      pLinks->update(relays);
+   }
+
    Position ptUpperRight;         // Size of the screen
-   Sputnik* pSputnik;            // The Sputnik satellite
-   Hubble* pHubble;
-   CrewDragon* pCrewDragon;
-   Starlink* pStarlink;
-   GPS* pGPS;
-   GPS* pGPS2;
-   GPS* pGPS3;
-   GPS* pGPS4;
-   GPS* pGPS5;
-   GPS* pGPS6;
-   Ship* pShip;
+   Camera camera;                 // What part of the world we see
+   Heatmap heatmap;               // How crowded the screen is when zoomed out
+   std::list<Satellite*> satellites;  // Everything in orbit, ship included
+   Ship* pShip;                   // The one we fly
+   double secondsSimulated;       // How much time has gone by in orbit
+   Phases tickPhases;                 // Moving and culling, on every core
+   std::vector<Position> points;      // Where what survived culling is, for the heatmap
+   const char* checkpointFileName;    // Where checkpoints go, NULL for none
+   double secondsCheckpoint;          // Wall time between checkpoints
+   chrono::steady_clock::time_point timeCheckpoint;   // When the last one was saved
+   TrajectoryRecorder* pTrajectory;   // Where samples go, NULL for nowhere
+   Receivers* pReceivers;             // Who wants to know where they are, NULL for nobody
+   std::vector<Integrator::State> transmitters;   // The GPS satellites they can hear
+   size_t leastFixed;                 // The fewest of them that knew
+   double secondsLeastFixed;          //    and when
+   LinkGraph* pLinks;                 // Starlink's links and routes, NULL for none
+   std::vector<Integrator::State> relays;   // The Starlink satellites still whole
    static const int NUM_STARS = 100;
+   static constexpr double SPRITE_MARGIN = 32.0;  // pixels a sprite reaches from its center
+   static constexpr double EARTH_MARGIN = 50.0;   // pixels the Earth reaches from its center
+   static constexpr double WARP_MIN = 1.0;        // simulated seconds per tick, slowest
+   static constexpr double WARP_MAX = 100000.0;   //    "                     , fastest
    Position stars[NUM_STARS];     // Array of star positions
    uint8_t phases[NUM_STARS];     // Array of star phases
 };
 
+const double SECONDS_PER_DAY = 86400.0;
+
+/*************************************
+ * REPORT STARTUP
+ * How long it took from main() until we were ready: the first frame
+ * handed to the display, or the first tick when nothing is displayed.
+ * Scripted runs start a lot of simulators, so this adds up
+ *    INPUT  timeReady  When that was
+ **************************************/
+chrono::steady_clock::time_point timeStarted;
+void reportStartup(chrono::steady_clock::time_point timeReady)
+{
+   cout << "Started in " << fixed << setprecision(2)
+        << chrono::duration<double, milli>(timeReady - timeStarted).count()
+        << " ms" << endl;
+}
+
+/*********************************************
+ * SIMULATION THREAD
+ * Run the simulator on a thread of its own at a fixed tick rate, driven
+ * by the wall clock. The newest tick is recorded rather than drawn and
+ * handed over through a triple buffer, so the display never waits on
+ * physics and physics never waits on the display. The display blends
+ * the two newest ticks for smooth motion at whatever rate it runs.
+ * When fast forwarding, the wall clock is ignored: ticks run back to
+ * back until the target time, and a frame goes out each display period
+ * to show how far we have got.
+ *********************************************/
+class SimulationThread
+{
+public:
+   SimulationThread(Simulator& sim, double ticksPerSecond, Profiler* pProfiler = NULL) :
+      sim(sim),
+      step(1.0 / ticksPerSecond),
+      zoom(Position().getZoom()),
+      pProfiler(pProfiler),
+      secondsTarget(-1.0),
+      running(false)
+   {
+   }
+   ~SimulationThread() { stop(); }
+
+   // Start and stop the simulation
+   void start()
+   {
+      if (!running.exchange(true))
+         thread = std::thread(&SimulationThread::loop, this);
+   }
+   void stop()
+   {
+      running = false;
+      if (thread.joinable())
+         thread.join();
+   }
+
+   // Simulate as fast as we can until this much time has gone by in
+   // orbit, then go back to real time. A target already passed stops
+   void fastForward(double secondsTarget) { this->secondsTarget = secondsTarget; }
+   bool isFastForward() const { return secondsTarget >= 0.0; }
+
+   // Draw the latest tick. Called from the display thread
+   void draw(ogstream& gout)
+   {
+      TRACE_SCOPE("SimulationThread::draw");
+
+      // a new tick came in: the one we were showing becomes the previous
+      if (frames.isFresh())
+      {
+         previous.swap(frames.getFront().gout);
+         frames.pickUp();
+      }
+
+      // fast forward frames are too far apart to blend
+      const Frame& latest = frames.getFront();
+      double weight = !latest.isBlended ? 1.0 :
+                      chrono::duration<double>(chrono::steady_clock::now() - latest.time).count()
+                      / step.getSecondsPerTick();
+      latest.gout.replay(gout, previous, std::max(0.0, std::min(1.0, weight)));
+   }
+
+   // Show how long each phase of a frame takes in the top left corner
+   void drawProfile(ogstream& gout)
+   {
+      if (!pProfiler)
+         return;
+      Position topLeft;
+      topLeft.setPixelsX(-sim.getUpperRight().getPixelsX() / 2.0 + 10.0);
+      topLeft.setPixelsY(sim.getUpperRight().getPixelsY() / 2.0 - 20.0);
+      pProfiler->draw(gout, topLeft);
+   }
+
+private:
+   // One tick of the simulation, ready to draw
+   struct Frame
+   {
+      ogstreamRecord gout;
+      chrono::steady_clock::time_point time;
+      bool isBlended = true;   // whether it follows on smoothly from the one before
+   };
+
+   // One tick of physics, with the keys pressed by the time it ends
+   void tick(Interface& ui, chrono::steady_clock::time_point until)
+   {
+      ui.pollEvents(until);
+      {
+         Profiler::Timer timer(pProfiler, Profiler::UPDATE);
+         sim.update(ui);
+         ui.keyEvent();
+      }
+      sim.endTick();
+   }
+
+   // Record where everything is now and hand it to the display
+   void publish(bool isBlended)
+   {
+      Frame& frame = frames.getBack();
+      frame.gout.clear();
+      sim.draw(frame.gout);
+      if (!isBlended)
+         drawProgress(frame.gout);
+      frame.gout.flush();
+      frame.time = chrono::steady_clock::now();
+      frame.isBlended = isBlended;
+      frames.publish();
+
+      // the display has something to show: we are up and running
+      if (!isPublished)
+      {
+         isPublished = true;
+         reportStartup(frame.time);
+      }
+   }
+
+   // How far a fast forward has got, just above the time warp
+   void drawProgress(ogstream& gout)
+   {
+      Position pt;
+      pt.setPixelsX(-sim.getUpperRight().getPixelsX() / 2.0 + 10.0);
+      pt.setPixelsY(-sim.getUpperRight().getPixelsY() / 2.0 + 28.0);
+      char text[64];
+      snprintf(text, sizeof(text), "Fast forward: day %.2f of %.2f",
+               sim.getSimulatedSeconds() / SECONDS_PER_DAY, secondsTarget / SECONDS_PER_DAY);
+      gout.setPosition(pt);
+      gout << text;
+   }
+
+   // Run ticks back to back until the target or the next display
+   // period, whichever is first
+   void loopFast(Interface& ui)
+   {
+      auto until = chrono::steady_clock::now() +
+         chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(SECONDS_FAST_FRAME));
+      do
+         tick(ui, chrono::steady_clock::now());
+      while (sim.getSimulatedSeconds() < secondsTarget && chrono::steady_clock::now() < until);
+      publish(false /*isBlended*/);
+   }
+
+   // Move, record, and hand over ticks as wall time passes
+   void loop()
+   {
+      // every thread has its own zoom, so start with the one we were given
+      Position().setZoom(zoom);
+      TRACE_THREAD("simulation");
+
+      Interface ui;   // all the members are static, so these are the real keys
+      auto last = chrono::steady_clock::now();
+      while (running)
+      {
+         // 'F' goes a day ahead, or stops a fast forward already going
+         if (ui.isFastForwardRequested())
+            fastForward(isFastForward() ? -1.0 : sim.getSimulatedSeconds() + SECONDS_PER_DAY);
+
+         if (isFastForward())
+         {
+            if (sim.getSimulatedSeconds() < secondsTarget)
+            {
+               loopFast(ui);
+               continue;
+            }
+
+            // made it: back to real time without trying to catch up
+            secondsTarget = -1.0;
+            step.reset();
+            last = chrono::steady_clock::now();
+         }
+
+         auto now = chrono::steady_clock::now();
+         int ticks = step.advance(chrono::duration<double>(now - last).count());
+         last = now;
+
+         // each tick ends a tick apart, the last one where the clock is now
+         // less the part of a tick still to come
+         auto secondsPerTick = chrono::duration_cast<chrono::steady_clock::duration>(
+            chrono::duration<double>(step.getSecondsPerTick()));
+         auto end = now - chrono::duration_cast<chrono::steady_clock::duration>(
+            chrono::duration<double>(step.getAlpha() * step.getSecondsPerTick()));
+         for (int tick = 0; tick < ticks; tick++)
+            this->tick(ui, end - (ticks - 1 - tick) * secondsPerTick);
+
+         // only the newest tick is worth drawing
+         if (ticks > 0)
+            publish(true /*isBlended*/);
+
+         std::this_thread::sleep_until(now +
+            chrono::duration_cast<chrono::steady_clock::duration>(
+               chrono::duration<double>(step.getSecondsToNext())));
+      }
+   }
+
+   Simulator& sim;
+   FixedStep step;                    // turns wall time into ticks
+   double zoom;                       // meters per pixel for the simulation
+   Profiler* pProfiler;               // where update times go
+   std::atomic<double> secondsTarget; // where fast forward stops, negative when off
+   TripleBuffer<Frame> frames;        // ticks on their way to the display
+   bool isPublished = false;          // has the display been handed a frame yet
+   ogstreamRecord previous;           // the tick before the latest, for blending
+   std::atomic<bool> running;
+   std::thread thread;
+
+   static constexpr double SECONDS_FAST_FRAME = 1.0 / 60.0;   // how often fast forward shows progress
+};
+
+/*************************************
+ * SAVE TRACE
+ * Write the scopes every thread has recorded lately for
+ * chrome://tracing or ui.perfetto.dev
+ **************************************/
+const char* traceFileName = "trace.json";
+void saveTrace()
+{
+   if (!Trace::isEnabled())
+      cerr << "Tracing is off; build with ORBIT_TRACE defined to turn it on" << endl;
+   else if (!Trace::write(traceFileName))
+      cerr << "Unable to write " << traceFileName << endl;
+   else
+      cout << "Wrote " << traceFileName << endl;
+}
+
 /*************************************
  * CALLBACK
- * Handle all the frames by moving everything and drawing
+ * Handle all the frames by drawing whatever the simulation has
+ * finished. The simulation moves on its own thread
  **************************************/
 void callBack(const Interface* pUI, void* p)
 {
-   // Cast the void pointer to a simulator object
-   Simulator* pSim = (Simulator*)p;
-   
-   // Update the simulation
-   pSim->update(*pUI);
+   // Cast the void pointer to a simulation thread object
+   SimulationThread* pSim = (SimulationThread*)p;
    
    // Draw everything
    Position pos;  // Center of the screen
    ogstream gout(pos);
    pSim->draw(gout);
+
+   // How the frames have been going
+   if (pUI->isProfileShown())
+      pSim->drawProfile(gout);
+
+   // Save what every thread has been up to
+   if (pUI->isTraceRequested())
+      saveTrace();
+}
+
+// The physics assumes 30 ticks a second; the display can go faster
+const double TICKS_PER_SECOND = 30.0;
+const double FRAMES_PER_SECOND = 60.0;
+
+/*************************************
+ * SHUT DOWN
+ * GLUT exits without returning from its loop, so the simulation thread
+ * has to be stopped, and the frame timing and the rest of the trajectory
+ * saved, on the way out
+ **************************************/
+SimulationThread* pSimulationThread = NULL;
+Profiler* pProfiler = NULL;
+TrajectoryRecorder* pTrajectory = NULL;
+Receivers* pReceivers = NULL;
+LinkGraph* pLinks = NULL;
+const char* profileFileName = "profile.csv";
+const char* trajectoryFileName = NULL;
+void shutDown()
+{
+   if (pSimulationThread)
+      pSimulationThread->stop();
+   if (pTrajectory && pTrajectory->isOpen())
+   {
+      if (!pTrajectory->close())
+         cerr << "Unable to write " << trajectoryFileName << endl;
+      else
+         cout << "Recorded " << pTrajectory->getNumStates() << " states in "
+              << pTrajectory->getNumSamples() << " samples, waiting " << fixed << setprecision(1)
+              << pTrajectory->getSecondsWaited() * 1000.0 << " ms on the writer\n";
+   }
+   if (pProfiler && !pProfiler->writeCSV(profileFileName))
+      cerr << "Unable to write " << profileFileName << endl;
+}
+
+/*************************************
+ * START CHECKPOINTS
+ * Pick up where a checkpoint left off, if asked to, and from then on
+ * save one every so often. False when the checkpoint cannot be read
+ **************************************/
+const char* checkpointFileName = NULL;
+double secondsCheckpoint = 300.0;
+const char* restoreFileName = NULL;
+bool startCheckpoints(Simulator& sim)
+{
+   if (restoreFileName)
+   {
+      auto start = chrono::steady_clock::now();
+      if (!sim.restore(restoreFileName))
+      {
+         cerr << "Unable to restore " << restoreFileName << endl;
+         return false;
+      }
+      cout << "Restored " << restoreFileName << " at day " << fixed << setprecision(2)
+           << sim.getSimulatedSeconds() / SECONDS_PER_DAY << " in " << setprecision(1)
+           << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count()
+           << " ms\n";
+   }
+   sim.setCheckpoint(checkpointFileName, secondsCheckpoint);
+   return true;
+}
+
+/*********************************
+ * SCREEN CONJUNCTIONS
+ * Say which pairs will pass close to each other in the hours ahead,
+ * closest first, if asked to
+ *********************************/
+double hoursScreen = 0.0;
+double distanceScreen = 10000.0;
+void screenConjunctions(const Simulator& sim)
+{
+   if (hoursScreen <= 0.0)
+      return;
+   auto start = chrono::steady_clock::now();
+   vector<Integrator::State> states = sim.getStates();
+   ConjunctionScreen screen(distanceScreen);
+   screen.screen(states, hoursScreen * 3600.0);
+   const vector<ConjunctionScreen::Approach>& approaches = screen.getApproaches();
+   cout << "Screened " << states.size() << " objects " << fixed << setprecision(1)
+        << hoursScreen << " hours ahead in "
+        << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count()
+        << " ms: " << screen.getNumInBand() << " of " << screen.getNumPairs()
+        << " pairs in band, " << screen.getNumOnPath() << " on crossing paths, "
+        << screen.getNumAligned() << " lined up, " << approaches.size()
+        << " closer than " << setprecision(0) << distanceScreen << " m\n";
+   for (size_t i = 0; i < approaches.size() && i < 10; i++)
+   {
+      const ConjunctionScreen::Approach& approach = approaches[i];
+      int seconds = (int)approach.seconds;
+      char when[32];
+      snprintf(when, sizeof(when), "%d:%02d:%02d", seconds / 3600, seconds / 60 % 60, seconds % 60);
+      cout << "   " << approach.first << " and " << approach.second << " at " << when << ", "
+           << approach.distance << " m apart at " << approach.speed << " m/s\n";
+   }
+}
+
+const double RECEIVER_ALTITUDE = 550000.0;  // meters, where the orbiting receivers go round
+
+/*********************************
+ * REPORT RECEIVERS
+ * How the GPS receivers did on the last tick, and on the worst one
+ *********************************/
+void reportReceivers(const Simulator& sim)
+{
+   if (!pReceivers)
+      return;
+   Receivers::Summary summary = pReceivers->getSummary();
+   cout << "Receivers: " << summary.numFixed << " of " << summary.numReceivers
+        << " fixed, " << fixed << setprecision(1) << summary.meanVisible
+        << " satellites in sight, PDOP " << summary.meanPdop << ", error "
+        << summary.rmsError << " m RMS and " << summary.maxError << " m at worst. Fewest fixed "
+        << sim.getLeastFixed() << " at day " << setprecision(2)
+        << sim.getSecondsLeastFixed() / SECONDS_PER_DAY << "\n";
+}
+
+/*********************************
+ * REPORT LINKS
+ * How Starlink was linked on the last tick, and how long each route took
+ *********************************/
+void reportLinks()
+{
+   if (!pLinks)
+      return;
+   cout << "Links: " << pLinks->getLinks().size() << " between " << pLinks->size()
+        << " Starlink satellites\n";
+   for (int route = 0; route < (int)pLinks->getNumRoutes(); route++)
+   {
+      cout << "Route " << route << ": ";
+      if (pLinks->getLatency(route) < 0.0)
+         cout << "no way\n";
+      else
+         cout << fixed << setprecision(2) << pLinks->getLatency(route) * 1000.0 << " ms, "
+              << pLinks->getNumHops(route) << " hops\n";
+   }
+}
+
+/*********************************
+ * RUN HEADLESS
+ * Simulate and draw into memory rather than a window. This works on
+ * machines without a display and gives a repeatable draw timing. Each
+ * frame is recorded first and then replayed into the rasterizer, so the
+ * cost of producing a frame and the cost of rendering it are timed apart
+ *    INPUT  ptUpperRight  The size of the frame
+ *           numFrames     How many frames to simulate and draw
+ *           prefix        Where to write PNG frames, or NULL for none
+ *           daysUntil     How far to simulate before drawing anything
+ *           pScenario     What to start with, or NULL for the usual
+ *    OUTPUT               False when a checkpoint could not be restored.
+ *                         A checkpoint is always saved at the end, if
+ *                         there is one to save
+ *********************************/
+bool runHeadless(const Position& ptUpperRight, int numFrames, const char* prefix,
+                 double daysUntil, const Scenario* pScenario)
+{
+   Interface ui;   // never initialized: no window and no keys down
+   Simulator sim(ptUpperRight, pScenario);
+   if (!startCheckpoints(sim))
+      return false;
+   screenConjunctions(sim);
+   sim.setTrajectory(pTrajectory);
+   sim.setReceivers(pReceivers);
+   sim.setLinks(pLinks);
+   Profiler profiler;
+   pProfiler = &profiler;
+   reportStartup(chrono::steady_clock::now());
+
+   // Nobody is watching, so get there without drawing
+   if (daysUntil > 0.0)
+   {
+      auto start = chrono::steady_clock::now();
+      while (sim.getSimulatedSeconds() < daysUntil * SECONDS_PER_DAY)
+      {
+         {
+            Profiler::Timer timer(&profiler, Profiler::UPDATE);
+            sim.update(ui);
+         }
+         sim.endTick();
+      }
+      cout << fixed << setprecision(1) << "Simulated " << sim.getSimulatedSeconds() / SECONDS_PER_DAY << " days in "
+           << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " s\n";
+   }
+
+   ogstreamRecord goutRecord;
+   ogstreamRaster gout((int)ptUpperRight.getPixelsX(), (int)ptUpperRight.getPixelsY());
+
+   double secondsRecord = 0.0;
+   double secondsRender = 0.0;
+   size_t numBytes = 0;
+   for (int frame = 0; frame < numFrames; frame++)
+   {
+      {
+         Profiler::Timer timer(&profiler, Profiler::UPDATE);
+         sim.update(ui);
+      }
+      sim.endTick();
+
+      auto start = chrono::steady_clock::now();
+      goutRecord.clear();
+      sim.draw(goutRecord);
+      goutRecord.flush();
+      auto recorded = chrono::steady_clock::now();
+      gout.clear();
+      goutRecord.replay(gout);
+      gout.render();
+      auto rendered = chrono::steady_clock::now();
+      profiler.add(Profiler::DRAW, chrono::duration<double>(rendered - start).count());
+
+      secondsRecord += chrono::duration<double>(recorded - start).count();
+      secondsRender += chrono::duration<double>(rendered - recorded).count();
+      numBytes += goutRecord.getBuffer().size();
+
+      if (prefix)
+      {
+         char fileName[256];
+         snprintf(fileName, sizeof(fileName), "%s%04d.png", prefix, frame);
+         if (!gout.writePNG(fileName))
+            cerr << "Unable to write " << fileName << endl;
+      }
+   }
+
+   if (numFrames > 0)
+      cout << fixed << setprecision(1) << "Rendered " << numFrames << " frames at "
+           << 1000.0 * (secondsRecord + secondsRender) / numFrames << " ms per frame ("
+           << 1000000.0 * secondsRecord / numFrames << " us recording "
+           << numBytes / numFrames << " bytes, "
+           << 1000.0 * secondsRender / numFrames << " ms rasterizing)\n";
+
+   if (sim.getCheckpoint() && !sim.save(sim.getCheckpoint()))
+      cerr << "Unable to write " << sim.getCheckpoint() << endl;
+   reportReceivers(sim);
+   reportLinks();
+
+   shutDown();
+   pProfiler = NULL;
+   if (Trace::isEnabled())
+      saveTrace();
+   return true;
 }
 
 /*********************************
  * Main handles command line parameters and creates the game
+ *    --headless <frames>   draw into memory instead of a window
+ *    --out <prefix>        save headless frames as <prefix>0000.png ...
+ *    --profile <file>      where to save frame timing, profile.csv by default
+ *    --trace <file>        where to save a trace, trace.json by default
+ *    --until <days>        simulate this far as fast as possible first
+ *    --integrator <name>   euler, verlet, or rk4 to move the satellites
+ *    --scenario <name>     start with walker, meo, debris, or a mix of them
+ *    --objects <count>     how many the scenario has, 1000 by default
+ *    --seed <number>       which of the scenarios, 1 by default
+ *    --catalog <file>      add the satellites in a two-line element file
+ *    --checkpoint <file>   save everything there every so often
+ *    --checkpoint-every <seconds>  how often, in wall time, 300 by default
+ *    --restore <file>      start from a checkpoint instead
+ *    --trajectory <file>   record where everything is as it goes
+ *    --trajectory-every <ticks>  how often, every tick by default
+ *    --screen <hours>      list the close approaches coming up
+ *    --screen-distance <meters>  how close, 10000 by default
+ *    --receivers <count>   GPS receivers, half on the ground and half in
+ *                          low orbit, working out where they are
+ *    --receivers-noise <meters>  how far off their ranges are, 5 by default
+ *    --links <meters>      link Starlink satellites this close that can see
+ *                          each other
+ *    --route <from> <to>   keep the quickest way between two of them, by
+ *                          the order they were made, over and over
+ *    --test                run the unit tests and nothing else
  *********************************/
 #ifdef _WIN32_X
 #include <windows.h>
@@ -212,21 +964,183 @@ int WINAPI wWinMain(
 int main(int argc, char** argv)
 #endif // !_WIN32
 {
-   // Run unit tests first
-   testRunner();
+   timeStarted = chrono::steady_clock::now();
+   TRACE_THREAD("main");
    
    // Initialize OpenGL
    Position ptUpperRight;
    ptUpperRight.setZoom(128000.0);
    ptUpperRight.setPixelsX(1000.0);
    ptUpperRight.setPixelsY(1000.0);
-   
+
+   // Command line options
+   int numHeadless = -1;
+   const char* prefix = NULL;
+   double daysUntil = 0.0;
+   const char* scenarioName = NULL;
+   const char* catalogName = NULL;
+   int numObjects = 1000;
+   unsigned long long seed = 1;
+   int ticksTrajectory = 1;
+   int numReceivers = 0;
+   double noiseReceivers = 5.0;
+   double rangeLinks = 0.0;
+   vector<pair<int, int>> routes;
+   for (int i = 1; i < argc; i++)
+      if (strcmp(argv[i], "--headless") == 0 && i + 1 < argc)
+         numHeadless = atoi(argv[++i]);
+      else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+         prefix = argv[++i];
+      else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc)
+         profileFileName = argv[++i];
+      else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+         traceFileName = argv[++i];
+      else if (strcmp(argv[i], "--until") == 0 && i + 1 < argc)
+         daysUntil = atof(argv[++i]);
+      else if (strcmp(argv[i], "--integrator") == 0 && i + 1 < argc)
+      {
+         Integrator::Method method = Integrator::getMethod(argv[++i]);
+         if (method == Integrator::NUM_METHODS)
+            cerr << "No integrator called " << argv[i] << endl;
+         else
+            Satellite::setIntegrator(method);
+      }
+      else if (strcmp(argv[i], "--scenario") == 0 && i + 1 < argc)
+         scenarioName = argv[++i];
+      else if (strcmp(argv[i], "--objects") == 0 && i + 1 < argc)
+         numObjects = atoi(argv[++i]);
+      else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+         seed = strtoull(argv[++i], NULL, 10);
+      else if (strcmp(argv[i], "--catalog") == 0 && i + 1 < argc)
+         catalogName = argv[++i];
+      else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc)
+         checkpointFileName = argv[++i];
+      else if (strcmp(argv[i], "--checkpoint-every") == 0 && i + 1 < argc)
+         secondsCheckpoint = atof(argv[++i]);
+      else if (strcmp(argv[i], "--restore") == 0 && i + 1 < argc)
+         restoreFileName = argv[++i];
+      else if (strcmp(argv[i], "--trajectory") == 0 && i + 1 < argc)
+         trajectoryFileName = argv[++i];
+      else if (strcmp(argv[i], "--trajectory-every") == 0 && i + 1 < argc)
+         ticksTrajectory = atoi(argv[++i]);
+      else if (strcmp(argv[i], "--screen") == 0 && i + 1 < argc)
+         hoursScreen = atof(argv[++i]);
+      else if (strcmp(argv[i], "--screen-distance") == 0 && i + 1 < argc)
+         distanceScreen = atof(argv[++i]);
+      else if (strcmp(argv[i], "--receivers") == 0 && i + 1 < argc)
+         numReceivers = atoi(argv[++i]);
+      else if (strcmp(argv[i], "--receivers-noise") == 0 && i + 1 < argc)
+         noiseReceivers = atof(argv[++i]);
+      else if (strcmp(argv[i], "--links") == 0 && i + 1 < argc)
+         rangeLinks = atof(argv[++i]);
+      else if (strcmp(argv[i], "--route") == 0 && i + 2 < argc)
+      {
+         int from = atoi(argv[++i]);
+         routes.push_back({ from, atoi(argv[++i]) });
+      }
+      else if (strcmp(argv[i], "--test") == 0)
+      {
+         testRunner();
+         return 0;
+      }
+
+   // Make up a sky of our own, if asked to
+   Scenario scenario(seed);
+   if (scenarioName)
+   {
+      auto start = chrono::steady_clock::now();
+      if (!scenario.add(scenarioName, numObjects))
+      {
+         cerr << "No scenario called " << scenarioName << endl;
+         return 1;
+      }
+      cout << "Made " << scenario.size() << " objects in " << fixed << setprecision(1)
+           << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count()
+           << " ms\n";
+   }
+
+   // and the real one, all where they were at the newest epoch in the file
+   if (catalogName)
+   {
+      auto start = chrono::steady_clock::now();
+      Catalog catalog;
+      if (!catalog.load(catalogName))
+      {
+         cerr << "Unable to read " << catalogName << endl;
+         return 1;
+      }
+      scenario.addCatalog(catalog, catalog.getEpochLatest());
+      cout << "Loaded " << catalog.size() << " objects from " << catalogName << " in "
+           << fixed << setprecision(1)
+           << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count()
+           << " ms (" << catalog.getNumRejected() << " rejected)\n";
+   }
+   const Scenario* pScenario = scenarioName || catalogName ? &scenario : NULL;
+
+   // Record where everything goes, if asked to
+   TrajectoryRecorder trajectory;
+   if (trajectoryFileName)
+   {
+      if (!trajectory.open(trajectoryFileName, ticksTrajectory))
+      {
+         cerr << "Unable to write " << trajectoryFileName << endl;
+         return 1;
+      }
+      pTrajectory = &trajectory;
+   }
+
+   // Put GPS receivers to work, if asked to
+   Receivers receivers(noiseReceivers);
+   if (numReceivers > 0)
+   {
+      receivers.addGround(numReceivers / 2);
+      receivers.addOrbit(numReceivers - numReceivers / 2, RECEIVER_ALTITUDE);
+      pReceivers = &receivers;
+   }
+
+   // and link Starlink
+   LinkGraph links(rangeLinks);
+   if (rangeLinks > 0.0)
+   {
+      for (const pair<int, int>& route : routes)
+         links.addRoute(route.first, route.second);
+      pLinks = &links;
+   }
+
+   if (numHeadless >= 0)
+      return runHeadless(ptUpperRight, numHeadless, prefix, daysUntil, pScenario) ? 0 : 1;
+
    // Initialize the game
    Interface ui(argc, argv, "Orbital Simulator", ptUpperRight);
-   Simulator sim(ptUpperRight);
+   Simulator sim(ptUpperRight, pScenario);
+   if (!startCheckpoints(sim))
+      return 1;
+   screenConjunctions(sim);
+   sim.setTrajectory(pTrajectory);
+   sim.setReceivers(pReceivers);
+   sim.setLinks(pLinks);
+   Profiler profiler;
+   SimulationThread simulation(sim, TICKS_PER_SECOND, &profiler);
+   ui.setFramesPerSecond(FRAMES_PER_SECOND);
+   ui.setProfiler(&profiler);
+   pSimulationThread = &simulation;
+   pProfiler = &profiler;
+   atexit(shutDown);
+   if (daysUntil > 0.0)
+      simulation.fastForward(daysUntil * SECONDS_PER_DAY);
+   simulation.start();
    
    // Play the game
-   ui.run(callBack, &sim);
+   ui.run(callBack, &simulation);
+
+   // GLUT exits from its loop, but GLFW comes back here when the window
+   // closes. Shut down while everything is still around
+   shutDown();
+   pSimulationThread = NULL;
+   pProfiler = NULL;
+   pTrajectory = NULL;
+   pReceivers = NULL;
+   pLinks = NULL;
    
    return 0;
 }
@@ -23,6 +23,7 @@ class Sputnik : public Satellite
 {
 public:
     friend TestSputnik;
+    virtual Kind getKind() const override { return SPUTNIK; }
     Sputnik() : Satellite(0, 4.0, 0.001)  // age=0, radius=4.0, angularVelocity=0.1
     {
         // Initial position and velocity for retrograde orbit
@@ -32,16 +33,12 @@ public:
         velocity.setDX(2050.0);  // m/s
         velocity.setDY(2684.68); // m/s
 
-        timeDilation = 48.0; // Slowed down from 1440 for better visualization
     }
 
     virtual void move(double time) override
     {
-        // Scale time by dilation factor for orbital motion
-        Satellite::move(time * timeDilation);
-
-        // Reset angle change to remove time dilation effect on rotation
-        angle.add(-angularVelocity * (timeDilation - 1.0));  // Counteract the extra rotation
+        // Every tick covers the same simulated time, whatever the object
+        Satellite::move(time * getTimeWarp());
     }
 
 
@@ -55,6 +52,7 @@ public:
     // Draw the Sputnik satellite
     virtual void destroy(std::list<Satellite*>& satellites) override
     {
+        TRACE_SCOPE("Sputnik::destroy");
         if (!isInvisible() && !isDead())
         {
             // Create 4 fragments
@@ -67,10 +65,6 @@ public:
             kill();
         }
     }
-
-
-private:
-    double timeDilation;  // Time scaling factor for this satellite
 };
 
 
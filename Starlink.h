@@ -18,13 +18,14 @@ class TestStarlink;
 // Components
 class StarlinkBody : public Satellite {
 public:
+    virtual Kind getKind() const override { return STARLINK_BODY; }
     StarlinkBody(const Satellite& parent) : Satellite(0, 2.0, 0.0) {
         pos = parent.getPosition();
         velocity = Velocity();
-        timeDilation = 48.0;
     }
 
     void destroy(std::list<Satellite*>& satellites) override {
+        TRACE_SCOPE("StarlinkBody::destroy");
         if (!isInvisible() && !isDead()) {
             for (int i = 0; i < 3; i++) {
                 Angle angle;
@@ -39,20 +40,18 @@ public:
         if (!isInvisible() && !isDead())
             gout.drawStarlinkBody(pos, angle.getRadians());
     }
-
-private:
-    double timeDilation;
 };
 
 class StarlinkArray : public Satellite {
 public:
+    virtual Kind getKind() const override { return STARLINK_ARRAY; }
     StarlinkArray(const Satellite& parent) : Satellite(0, 4.0, 0.0) {
         pos = parent.getPosition();
         velocity = Velocity();
-        timeDilation = 48.0;
     }
 
     void destroy(std::list<Satellite*>& satellites) override {
+        TRACE_SCOPE("StarlinkArray::destroy");
         if (!isInvisible() && !isDead()) {
             for (int i = 0; i < 3; i++) {
                 Angle angle;
@@ -67,9 +66,6 @@ public:
         if (!isInvisible() && !isDead())
             gout.drawStarlinkArray(pos, angle.getRadians());
     }
-
-private:
-    double timeDilation;
 };
 
 
@@ -81,6 +77,7 @@ class Starlink : public Satellite
 {
 public:
     friend TestStarlink;
+    virtual Kind getKind() const override { return STARLINK; }
     Starlink() : Satellite(0, 6.0, 0.0002)  // age=0, radius=6.0, angularVelocity=0.0002
     {
         // Initial position at lower orbit (low Earth orbit, ~550km altitude)
@@ -91,19 +88,16 @@ public:
         velocity.setDX(5800.0);  // m/s
         velocity.setDY(0.0);      // m/s
 
-        timeDilation = 48.0; // Same time dilation as other satellites for consistency
     }
 
     virtual void move(double time) override
     {
-        // Scale time by dilation factor for orbital motion
-        Satellite::move(time * timeDilation);
-
-        // Reset angle change to remove time dilation effect on rotation
-        angle.add(-angularVelocity * (timeDilation - 1.0));
+        // Every tick covers the same simulated time, whatever the object
+        Satellite::move(time * getTimeWarp());
     }
 
     void destroy(std::list<Satellite*>& satellites) override {
+        TRACE_SCOPE("Starlink::destroy");
         if (!isInvisible() && !isDead()) {
             satellites.push_back(new StarlinkBody(*this));
             satellites.push_back(new StarlinkArray(*this));
@@ -124,8 +118,5 @@ public:
         if (!isInvisible() && !isDead())
             gout.drawStarlink(pos, angle.getRadians());
     }
-
-private:
-    double timeDilation;  // Time scaling factor for this satellite
 };
 
@@ -0,0 +1,198 @@
+/***********************************************************************
+ * Header File:
+ *    TEST BROAD PHASE
+ * Author:
+ *    Chris Mijango & Seth Chen
+ * Summary:
+ *    Unit tests for the BroadPhase class
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+#include "broadPhase.h"
+#include <vector>
+#include <random>
+
+/*******************************
+ * TEST BROAD PHASE
+ * A friend class for BroadPhase which contains its unit tests
+ ********************************/
+class TestBroadPhase : public UnitTest
+{
+public:
+   void run()
+   {
+      findPairs_empty();
+      findPairs_touching();
+      findPairs_apart();
+      findPairs_acrossCells();
+      findPairs_sameAsEveryPair();
+      findPairs_sameOnAnyThreads();
+
+      report("BroadPhase");
+   }
+
+private:
+   // Lots of circles of different sizes crowded into a small space
+   std::vector<BroadPhase::Circle> getCrowd(int num)
+   {
+      std::mt19937 generator(5);
+      std::vector<BroadPhase::Circle> circles(num);
+      for (BroadPhase::Circle& circle : circles)
+      {
+         circle.x = (double)(generator() % 200000) - 100000.0;
+         circle.y = (double)(generator() % 200000) - 100000.0;
+         circle.radius = (double)(generator() % 1000);
+      }
+      return circles;
+   }
+
+   /*********************************************
+    * name:    FIND PAIRS with nothing
+    * input:   no circles, no build at all, and no circles after a pair
+    * output:  no pairs
+    *********************************************/
+   void findPairs_empty()
+   {
+      // setup
+      BroadPhase unbuilt;
+      BroadPhase broadPhase;
+      BroadPhase emptied;
+      std::vector<BroadPhase::Circle> circles;
+      std::vector<BroadPhase::Circle> circlesGone = { { 0.0, 0.0, 10.0 }, { 5.0, 0.0, 10.0 } };
+      std::vector<BroadPhase::Pair> pairs = { { 0, 1 } };
+      std::vector<BroadPhase::Pair> pairsUnbuilt = { { 0, 1 } };
+      std::vector<BroadPhase::Pair> pairsEmptied;
+      emptied.build(circlesGone);
+      emptied.findPairs(pairsEmptied);
+      circlesGone.clear();
+      // exercise
+      broadPhase.build(circles);
+      broadPhase.findPairs(pairs);
+      unbuilt.findPairs(pairsUnbuilt);
+      emptied.build(circlesGone);
+      emptied.findPairs(pairsEmptied);
+      // verify
+      assertUnit(pairs.empty());
+      assertUnit(pairsUnbuilt.empty());
+      assertUnit(pairsEmptied.empty());
+   }  // teardown
+
+   /*********************************************
+    * name:    FIND PAIRS of two overlapping
+    * input:   radius 10 at 0 and radius 5 at 14,0
+    * output:  the one pair, lower first
+    *********************************************/
+   void findPairs_touching()
+   {
+      // setup
+      BroadPhase broadPhase;
+      std::vector<BroadPhase::Circle> circles = { { 14.0, 0.0, 5.0 }, { 0.0, 0.0, 10.0 } };
+      std::vector<BroadPhase::Pair> pairs;
+      // exercise
+      broadPhase.build(circles);
+      broadPhase.findPairs(pairs);
+      // verify
+      assertUnit(pairs.size() == 1);
+      assertUnit(pairs.size() == 1 && pairs[0].i == 0 && pairs[0].j == 1);
+      assertEquals(broadPhase.cellSize, 20.0);
+   }  // teardown
+
+   /*********************************************
+    * name:    FIND PAIRS of two just apart
+    * input:   radius 10 at 0 and radius 5 at 0,16
+    * output:  no pairs
+    *********************************************/
+   void findPairs_apart()
+   {
+      // setup
+      BroadPhase broadPhase;
+      std::vector<BroadPhase::Circle> circles = { { 0.0, 0.0, 10.0 }, { 0.0, 16.0, 5.0 } };
+      std::vector<BroadPhase::Pair> pairs;
+      // exercise
+      broadPhase.build(circles);
+      broadPhase.findPairs(pairs);
+      // verify
+      assertUnit(pairs.empty());
+   }  // teardown
+
+   /*********************************************
+    * name:    FIND PAIRS across the corner of a cell
+    * input:   two circles of radius 10 either side of 0,0
+    * output:  found, though they are in diagonal cells
+    *********************************************/
+   void findPairs_acrossCells()
+   {
+      // setup
+      BroadPhase broadPhase;
+      std::vector<BroadPhase::Circle> circles = { { -1.0, -1.0, 10.0 }, { 1.0, 1.0, 10.0 } };
+      std::vector<BroadPhase::Pair> pairs;
+      // exercise
+      broadPhase.build(circles);
+      broadPhase.findPairs(pairs);
+      // verify
+      assertUnit(broadPhase.cols[0] != broadPhase.cols[1]);
+      assertUnit(broadPhase.rows[0] != broadPhase.rows[1]);
+      assertUnit(pairs.size() == 1);
+   }  // teardown
+
+   /*********************************************
+    * name:    FIND PAIRS against checking every pair
+    * input:   3000 circles in a crowd
+    * output:  exactly the pairs checking every pair finds, in order
+    *********************************************/
+   void findPairs_sameAsEveryPair()
+   {
+      // setup
+      std::vector<BroadPhase::Circle> circles = getCrowd(3000);
+      std::vector<BroadPhase::Pair> expected;
+      for (int i = 0; i < (int)circles.size(); i++)
+         for (int j = i + 1; j < (int)circles.size(); j++)
+         {
+            double dx = circles[i].x - circles[j].x;
+            double dy = circles[i].y - circles[j].y;
+            double reach = circles[i].radius + circles[j].radius;
+            if (dx * dx + dy * dy < reach * reach)
+               expected.push_back({ i, j });
+         }
+      BroadPhase broadPhase(1);
+      std::vector<BroadPhase::Pair> pairs;
+      // exercise
+      broadPhase.build(circles);
+      broadPhase.findPairs(pairs);
+      // verify
+      assertUnit(expected.size() > 100);
+      assertUnit(pairs.size() == expected.size());
+      bool isSame = pairs.size() == expected.size();
+      for (size_t k = 0; isSame && k < pairs.size(); k++)
+         isSame = pairs[k].i == expected[k].i && pairs[k].j == expected[k].j;
+      assertUnit(isSame);
+   }  // teardown
+
+   /*********************************************
+    * name:    FIND PAIRS on one thread and on four
+    * input:   20000 circles in a crowd
+    * output:  the same pairs in the same order
+    *********************************************/
+   void findPairs_sameOnAnyThreads()
+   {
+      // setup
+      std::vector<BroadPhase::Circle> circles = getCrowd(20000);
+      BroadPhase one(1);
+      BroadPhase four(4);
+      std::vector<BroadPhase::Pair> pairsOne;
+      std::vector<BroadPhase::Pair> pairsFour;
+      // exercise
+      one.build(circles);
+      one.findPairs(pairsOne);
+      four.build(circles);
+      four.findPairs(pairsFour);
+      // verify
+      assertUnit(pairsOne.size() == pairsFour.size());
+      bool isSame = pairsOne.size() == pairsFour.size();
+      for (size_t k = 0; isSame && k < pairsOne.size(); k++)
+         isSame = pairsOne[k].i == pairsFour[k].i && pairsOne[k].j == pairsFour[k].j;
+      assertUnit(isSame);
+   }  // teardown
+};
@@ -0,0 +1,300 @@
+/***********************************************************************
+ * Header File:
+ *    TEST CAMERA
+ * Author:
+ *    Chris Mijango & Seth Chen
+ * Summary:
+ *    Unit tests for the Camera class
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+#include "camera.h"
+#include "position.h"
+
+/*******************************
+ * TEST CAMERA
+ * A friend class for Camera which contains the Camera unit tests
+ ********************************/
+class TestCamera : public UnitTest
+{
+public:
+   void run()
+   {
+      construct_screen();
+      isVisible_center();
+      isVisible_offScreen();
+      isVisible_margin();
+      pan_pixels();
+      zoomIn_twice();
+      isVisible_zoomedIn();
+      reset_home();
+      apply_zoom();
+      getDetail_sprite();
+      getDetail_point();
+      getDetail_heatmap();
+
+      report("Camera");
+   }
+
+private:
+   // A 1000 x 800 pixel screen where a pixel is 100 meters
+   Position screen() const
+   {
+      Position pt(100000.0, 80000.0);
+      return pt;
+   }
+
+   /*********************************************
+    * name:    CONSTRUCTOR
+    * input:   1000 x 800 pixels at 100 meters per pixel
+    * output:  looking at the origin at that zoom
+    *********************************************/
+   void construct_screen()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(100.0);
+      // exercise
+      Camera camera(screen());
+      // verify
+      assertEquals(camera.zoom, 100.0);
+      assertEquals(camera.zoomHome, 100.0);
+      assertEquals(camera.halfWidth, 500.0);
+      assertEquals(camera.halfHeight, 400.0);
+      assertEquals(camera.center.getMetersX(), 0.0);
+      assertEquals(camera.center.getMetersY(), 0.0);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    IS VISIBLE in the middle
+    * input:   the origin
+    * output:  visible
+    *********************************************/
+   void isVisible_center()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(100.0);
+      Camera camera(screen());
+      // exercise and verify
+      assertUnit(camera.isVisible(Position(), 0.0));
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    IS VISIBLE off to the right
+    * input:   600 pixels right, 0 up
+    * output:  not visible
+    *********************************************/
+   void isVisible_offScreen()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(100.0);
+      Camera camera(screen());
+      // exercise and verify
+      assertUnit(!camera.isVisible(Position(60000.0, 0.0), 0.0));
+      assertUnit(!camera.isVisible(Position(0.0, -45000.0), 0.0));
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    IS VISIBLE just off screen with a margin
+    * input:   510 pixels right, with 20 pixels of sprite
+    * output:  visible since the sprite pokes onto the screen
+    *********************************************/
+   void isVisible_margin()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(100.0);
+      Camera camera(screen());
+      // exercise and verify
+      assertUnit(!camera.isVisible(Position(51000.0, 0.0), 0.0));
+      assertUnit(camera.isVisible(Position(51000.0, 0.0), 20.0));
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    PAN
+    * input:   right 10 pixels, down 20 pixels
+    * output:  center at (1000, -2000) meters
+    *********************************************/
+   void pan_pixels()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(100.0);
+      Camera camera(screen());
+      // exercise
+      camera.pan(10.0, -20.0);
+      // verify
+      assertEquals(camera.center.getMetersX(), 1000.0);
+      assertEquals(camera.center.getMetersY(), -2000.0);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    ZOOM IN twice
+    * input:   factor of 2 then 5
+    * output:  10 meters per pixel
+    *********************************************/
+   void zoomIn_twice()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(100.0);
+      Camera camera(screen());
+      // exercise
+      camera.zoomIn(2.0);
+      camera.zoomIn(5.0);
+      // verify
+      assertEquals(camera.zoom, 10.0);
+      assertEquals(camera.zoomHome, 100.0);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    IS VISIBLE zoomed in
+    * input:   zoomed in 10x, a point 100 pixels out at the old zoom
+    * output:  now 1000 pixels out, so not visible
+    *********************************************/
+   void isVisible_zoomedIn()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(100.0);
+      Camera camera(screen());
+      Position pt(10000.0, 0.0);
+      // exercise
+      camera.zoomIn(10.0);
+      // verify
+      assertUnit(!camera.isVisible(pt, 0.0));
+      camera.pan(1000.0, 0.0);
+      assertUnit(camera.isVisible(pt, 0.0));
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    RESET
+    * input:   panned and zoomed
+    * output:  back at the origin at the starting zoom
+    *********************************************/
+   void reset_home()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(100.0);
+      Camera camera(screen());
+      camera.pan(50.0, 50.0);
+      camera.zoomIn(3.0);
+      // exercise
+      camera.reset();
+      // verify
+      assertEquals(camera.zoom, 100.0);
+      assertEquals(camera.center.getMetersX(), 0.0);
+      assertEquals(camera.center.getMetersY(), 0.0);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    APPLY
+    * input:   camera at 25 meters per pixel, global zoom 100
+    * output:  global zoom 25, old zoom 100 handed back
+    *********************************************/
+   void apply_zoom()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(100.0);
+      Camera camera(screen());
+      camera.setZoom(25.0);
+      // exercise
+      double zoomOld = camera.apply();
+      // verify
+      assertEquals(zoomOld, 100.0);
+      assertEquals(ptZoom.getZoom(), 25.0);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    GET DETAIL at the starting zoom
+    * input:   32 pixel sprites, 10 on the screen
+    * output:  sprites
+    *********************************************/
+   void getDetail_sprite()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(100.0);
+      Camera camera(screen());
+      // exercise and verify
+      assertUnit(camera.getDetail(32.0, 10) == Camera::SPRITE);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    GET DETAIL zoomed way out
+    * input:   32 pixel sprites at a quarter of the size, then an eighth
+    * output:  still sprites at 8 pixels, points at 4
+    *********************************************/
+   void getDetail_point()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(100.0);
+      Camera camera(screen());
+      // exercise
+      camera.zoomIn(0.25);
+      // verify
+      assertEquals(camera.getScale(), 0.25);
+      assertUnit(camera.getDetail(32.0, 10) == Camera::SPRITE);
+      camera.zoomIn(0.5);
+      assertUnit(camera.getDetail(32.0, 10) == Camera::POINT);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    GET DETAIL with a crowd
+    * input:   2000 then 2001 on the screen
+    * output:  heatmap only past 2000
+    *********************************************/
+   void getDetail_heatmap()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(100.0);
+      Camera camera(screen());
+      // exercise and verify
+      assertUnit(camera.getDetail(32.0, 2000) == Camera::SPRITE);
+      assertUnit(camera.getDetail(32.0, 2001) == Camera::HEATMAP);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+};
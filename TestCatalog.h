@@ -0,0 +1,374 @@
+/***********************************************************************
+ * Header File:
+ *    TEST CATALOG
+ * Author:
+ *    Chris Mijango & Seth Chen
+ * Summary:
+ *    Unit tests for the Catalog class
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+#include "catalog.h"
+#include "scenario.h"
+#include <filesystem>   // for a scratch file
+#include <fstream>
+#include <string>
+#include <cstring>      // for strcmp() and strcpy()
+#include <cstdio>       // for remove() and snprintf()
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+/*******************************
+ * TEST CATALOG
+ * A friend class for Catalog which contains its unit tests
+ ********************************/
+class TestCatalog : public UnitTest
+{
+public:
+   void run()
+   {
+      parse_fields();
+      parse_badChecksum();
+      parse_alpha5();
+      parse_names();
+      parse_threads();
+      load_file();
+      load_missing();
+      getState_visViva();
+      getState_circle();
+      getState_retrograde();
+      getDaysToYear_leapYears();
+      addCatalog_kinds();
+
+      report("Catalog");
+   }
+
+private:
+   // The International Space Station in September 2008
+   const std::string ISS1 = "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927";
+   const std::string ISS2 = "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537";
+
+   // Put the checksum right after changing a line
+   std::string fixChecksum(std::string line) const
+   {
+      int sum = 0;
+      for (int i = 0; i < 68; i++)
+         sum += line[i] >= '0' && line[i] <= '9' ? line[i] - '0' : (line[i] == '-' ? 1 : 0);
+      line[68] = (char)('0' + sum % 10);
+      return line;
+   }
+
+   // A line with a different catalog number, five characters
+   std::string setNumber(std::string line, const char* number) const
+   {
+      line.replace(2, 5, number);
+      return fixChecksum(line);
+   }
+
+   // A line with a field of the second line changed
+   std::string setField(std::string line, size_t column, const char* value) const
+   {
+      line.replace(column - 1, strlen(value), value);
+      return fixChecksum(line);
+   }
+
+   double getRadius(const Integrator::State& state) const
+   {
+      return sqrt(state.x * state.x + state.y * state.y);
+   }
+
+   double getSpeed(const Integrator::State& state) const
+   {
+      return sqrt(state.dx * state.dx + state.dy * state.dy);
+   }
+
+   /*********************************************
+    * name:    PARSE the fields of a set
+    * input:   the space station, named
+    * output:  every field in days since 2000 and radians
+    *********************************************/
+   void parse_fields()
+   {
+      // setup
+      Catalog::Elements elements;
+      const char* name = "0 ISS (ZARYA)  ";
+      // exercise
+      bool isParsed = Catalog::parse(ISS1.c_str(), ISS2.c_str(), name, strlen(name), elements);
+      // verify
+      assertUnit(isParsed);
+      assertUnit(strcmp(elements.name, "ISS (ZARYA)") == 0);
+      assertUnit(elements.number == 25544);
+      assertEquals(elements.epoch, 2922.0 + 263.51782528);
+      assertEquals(elements.inclination, 51.6416 * M_PI / 180.0);
+      assertEquals(elements.ascending, 247.4627 * M_PI / 180.0);
+      assertEquals(elements.eccentricity, 0.0006703);
+      assertEquals(elements.perigee, 130.5360 * M_PI / 180.0);
+      assertEquals(elements.meanAnomaly, 325.0288 * M_PI / 180.0);
+      assertEquals(elements.meanMotion * 86400.0 / (2.0 * M_PI), 15.72125391);
+   }  // teardown
+
+   /*********************************************
+    * name:    PARSE lines that do not add up
+    * input:   a digit changed without its checksum, and two lines with
+    *          different catalog numbers
+    * output:  both refused
+    *********************************************/
+   void parse_badChecksum()
+   {
+      // setup
+      std::string changed = ISS2;
+      changed[10] = '2';
+      std::string other = setNumber(ISS2, "25545");
+      Catalog::Elements elements;
+      // exercise
+      bool isChanged = Catalog::parse(ISS1.c_str(), changed.c_str(), NULL, 0, elements);
+      bool isOther = Catalog::parse(ISS1.c_str(), other.c_str(), NULL, 0, elements);
+      // verify
+      assertUnit(!isChanged);
+      assertUnit(!isOther);
+   }  // teardown
+
+   /*********************************************
+    * name:    PARSE catalog numbers past 99999
+    * input:   A0001 and Z9999
+    * output:  100001 and 339999, since I and O are left out
+    *********************************************/
+   void parse_alpha5()
+   {
+      // setup
+      Catalog::Elements elementsA;
+      Catalog::Elements elementsZ;
+      // exercise
+      bool isA = Catalog::parse(setNumber(ISS1, "A0001").c_str(),
+                                setNumber(ISS2, "A0001").c_str(), NULL, 0, elementsA);
+      bool isZ = Catalog::parse(setNumber(ISS1, "Z9999").c_str(),
+                                setNumber(ISS2, "Z9999").c_str(), NULL, 0, elementsZ);
+      // verify
+      assertUnit(isA && elementsA.number == 100001);
+      assertUnit(isZ && elementsZ.number == 339999);
+      assertUnit(elementsA.name[0] == '\0');
+   }  // teardown
+
+   /*********************************************
+    * name:    PARSE text with and without names
+    * input:   a named set with Windows line ends, a set right after it
+    *          with no name, a line 1 on its own, and a last line with
+    *          no line end at all
+    * output:  two sets, the first named, and one rejected
+    *********************************************/
+   void parse_names()
+   {
+      // setup
+      std::string text = "ISS (ZARYA)   \r\n" + ISS1 + "\r\n" + ISS2 + "\r\n" +
+                         ISS1 + "\n" +
+                         setNumber(ISS1, "00005") + "\n" + setNumber(ISS2, "00005");
+      Catalog catalog;
+      // exercise
+      catalog.parse(text.c_str(), text.size(), 1);
+      // verify
+      assertUnit(catalog.size() == 2);
+      assertUnit(catalog.getNumRejected() == 1);
+      assertUnit(strcmp(catalog.getElements()[0].name, "ISS (ZARYA)") == 0);
+      assertUnit(catalog.getElements()[1].number == 5);
+      assertUnit(catalog.getElements()[1].name[0] == '\0');
+   }  // teardown
+
+   /*********************************************
+    * name:    PARSE on several threads
+    * input:   3000 named sets, every hundredth with a bad checksum,
+    *          on one thread and on four
+    * output:  the same 2970 sets in the same order, named the same
+    *********************************************/
+   void parse_threads()
+   {
+      // setup
+      std::string text;
+      char number[8];
+      for (int i = 0; i < 3000; i++)
+      {
+         snprintf(number, sizeof(number), "%05d", i + 1);
+         std::string line2 = setNumber(ISS2, number);
+         if (i % 100 == 50)
+            line2[10] = line2[10] == '1' ? '2' : '1';
+         text += "0 OBJECT " + std::string(number) + "\n" + setNumber(ISS1, number) + "\n" +
+                 line2 + "\n";
+      }
+      Catalog single;
+      Catalog several;
+      // exercise
+      single.parse(text.c_str(), text.size(), 1);
+      several.parse(text.c_str(), text.size(), 4);
+      // verify
+      assertUnit(several.pieces.size() > 1);
+      assertUnit(single.size() == 2970);
+      assertUnit(several.size() == 2970);
+      assertUnit(several.getNumRejected() == 30);
+      bool isSame = single.size() == several.size();
+      for (size_t i = 0; isSame && i < single.size(); i++)
+         isSame = single.getElements()[i].number == several.getElements()[i].number &&
+                  strcmp(single.getElements()[i].name, several.getElements()[i].name) == 0 &&
+                  strncmp(several.getElements()[i].name, "OBJECT ", 7) == 0;
+      assertUnit(isSame);
+   }  // teardown
+
+   /*********************************************
+    * name:    LOAD a file
+    * input:   a file with two sets
+    * output:  both, the later epoch the latest
+    *********************************************/
+   void load_file()
+   {
+      // setup
+      std::string fileName = (std::filesystem::temp_directory_path() / "orbitTestCatalog.tle").string();
+      {
+         std::ofstream fout(fileName, std::ios::binary);
+         fout << ISS1 << "\n" << ISS2 << "\n"
+              << setField(setNumber(ISS1, "00007"), 21, "300") << "\n"
+              << setNumber(ISS2, "00007") << "\n";
+      }
+      Catalog catalog;
+      // exercise
+      bool isLoaded = catalog.load(fileName.c_str());
+      // verify
+      assertUnit(isLoaded);
+      assertUnit(catalog.size() == 2);
+      assertEquals(catalog.getEpochLatest(), 2922.0 + 299.51782528);
+      // teardown
+      remove(fileName.c_str());
+   }
+
+   /*********************************************
+    * name:    LOAD a file that is not there
+    * input:   a made-up name
+    * output:  false, and nothing loaded
+    *********************************************/
+   void load_missing()
+   {
+      // setup
+      Catalog catalog;
+      // exercise
+      bool isLoaded = catalog.load("no such catalog.tle");
+      // verify
+      assertUnit(!isLoaded);
+      assertUnit(catalog.size() == 0);
+   }  // teardown
+
+   /*********************************************
+    * name:    GET STATE of an eccentric orbit, a day on
+    * input:   the space station with eccentricity 0.1
+    * output:  the speed vis-viva says for that distance, and the
+    *          distance between perigee and apogee
+    *********************************************/
+   void getState_visViva()
+   {
+      // setup
+      Catalog::Elements elements;
+      Catalog::parse(ISS1.c_str(), setField(ISS2, 27, "1000000").c_str(), NULL, 0, elements);
+      double a = cbrt(Integrator::MU / (elements.meanMotion * elements.meanMotion));
+      // exercise
+      Integrator::State state = Catalog::getState(elements, elements.epoch + 1.0);
+      // verify
+      double r = getRadius(state);
+      double v = getSpeed(state);
+      assertUnit(elements.eccentricity == 0.1);
+      assertUnit(fabs(v * v - Integrator::MU * (2.0 / r - 1.0 / a)) < 1.0e-6 * v * v);
+      assertUnit(r > 0.9 * a - 1.0 && r < 1.1 * a + 1.0);
+      assertUnit(Integrator::getAngularMomentum(state) > 0.0);
+   }  // teardown
+
+   /*********************************************
+    * name:    GET STATE of a circular orbit
+    * input:   the space station with no eccentricity, at its epoch
+    * output:  the altitude its period gives, the speed for a circle,
+    *          and the angle of the node, perigee, and mean anomaly
+    *********************************************/
+   void getState_circle()
+   {
+      // setup
+      Catalog::Elements elements;
+      Catalog::parse(ISS1.c_str(), setField(ISS2, 27, "0000000").c_str(), NULL, 0, elements);
+      double a = cbrt(Integrator::MU / (elements.meanMotion * elements.meanMotion));
+      // exercise
+      Integrator::State state = Catalog::getState(elements, elements.epoch);
+      // verify
+      assertUnit(fabs(getRadius(state) - a) < 1.0e-6);
+      assertUnit(a - Integrator::EARTH_RADIUS > 300000.0 && a - Integrator::EARTH_RADIUS < 400000.0);
+      assertUnit(fabs(Integrator::getAngularMomentum(state) - sqrt(Integrator::MU * a)) < 1.0e-3);
+      double angle = (247.4627 + 130.5360 + 325.0288) * M_PI / 180.0;
+      assertUnit(fabs(state.x - a * cos(angle)) < 1.0e-3);
+      assertUnit(fabs(state.y - a * sin(angle)) < 1.0e-3);
+   }  // teardown
+
+   /*********************************************
+    * name:    GET STATE of an orbit going the other way
+    * input:   the space station inclined 128.3584 degrees
+    * output:  going round clockwise instead
+    *********************************************/
+   void getState_retrograde()
+   {
+      // setup
+      Catalog::Elements elements;
+      Catalog::parse(ISS1.c_str(), setField(ISS2, 9, "128.3584").c_str(), NULL, 0, elements);
+      // exercise
+      Integrator::State state = Catalog::getState(elements, elements.epoch);
+      // verify
+      assertUnit(elements.inclination > M_PI / 2.0);
+      assertUnit(Integrator::getAngularMomentum(state) < 0.0);
+   }  // teardown
+
+   /*********************************************
+    * name:    GET DAYS TO YEAR across leap years
+    * input:   2000, 2001, 2024, and 1999
+    * output:  0, 366 since 2000 was one, 8766, and -365
+    *********************************************/
+   void getDaysToYear_leapYears()
+   {
+      // setup
+      // exercise
+      double days2000 = Catalog::getDaysToYear(2000);
+      double days2001 = Catalog::getDaysToYear(2001);
+      double days2024 = Catalog::getDaysToYear(2024);
+      double days1999 = Catalog::getDaysToYear(1999);
+      // verify
+      assertEquals(days2000, 0.0);
+      assertEquals(days2001, 366.0);
+      assertEquals(days2024, 8766.0);
+      assertEquals(days1999, -365.0);
+   }  // teardown
+
+   /*********************************************
+    * name:    ADD CATALOG to a scenario
+    * input:   the space station, a piece of debris, a rocket body, and
+    *          something going round twice a day
+    * output:  a Starlink, two debris, and a MEO, where getState() puts them
+    *********************************************/
+   void addCatalog_kinds()
+   {
+      // setup
+      Catalog catalog;
+      Catalog::Elements elements;
+      Catalog::parse(ISS1.c_str(), ISS2.c_str(), NULL, 0, elements);
+      catalog.elements.push_back(elements);
+      strcpy(elements.name, "COSMOS 2251 DEB");
+      catalog.elements.push_back(elements);
+      strcpy(elements.name, "SL-16 R/B");
+      catalog.elements.push_back(elements);
+      strcpy(elements.name, "NAVSTAR 43");
+      elements.meanMotion = 2.0 * 2.0 * M_PI / 86400.0;
+      catalog.elements.push_back(elements);
+      Scenario scenario;
+      // exercise
+      scenario.addCatalog(catalog, elements.epoch + 0.5);
+      // verify
+      assertUnit(scenario.size() == 4);
+      const std::vector<Scenario::Object>& objects = scenario.getObjects();
+      assertUnit(objects[0].kind == Scenario::WALKER);
+      assertUnit(objects[1].kind == Scenario::DEBRIS);
+      assertUnit(objects[2].kind == Scenario::DEBRIS);
+      assertUnit(objects[3].kind == Scenario::MEO);
+      Integrator::State state = Catalog::getState(elements, elements.epoch + 0.5);
+      assertUnit(objects[3].state.x == state.x && objects[3].state.y == state.y);
+   }  // teardown
+};
@@ -0,0 +1,404 @@
+/***********************************************************************
+ * Header File:
+ *    TEST CHECKPOINT
+ * Author:
+ *    Chris Mijango & Seth Chen
+ * Summary:
+ *    Unit tests for the Checkpoint class
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+#include "checkpoint.h"
+#include "Satellite.h"
+#include "uiDraw.h"
+#include <filesystem>   // for a scratch file
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <vector>
+#include <string>
+#include <cstdio>       // for remove()
+#include <cstring>      // for memcmp()
+#include <cstddef>      // for offsetof()
+
+/*******************************
+ * TEST CHECKPOINT
+ * A friend class for Checkpoint which contains its unit tests
+ ********************************/
+class TestCheckpoint : public UnitTest
+{
+public:
+   void run()
+   {
+      create_everyKind();
+      create_unknownKind();
+      createAll_ship();
+      createAll_unknownKind();
+      getLayout_aligned();
+      write_read();
+      read_missing();
+      read_corrupt();
+      read_corruptHeader();
+      read_wrongVersion();
+      read_truncated();
+      random_sameAgain();
+
+      report("Checkpoint");
+   }
+
+private:
+   std::string getFileName() const
+   {
+      return (std::filesystem::temp_directory_path() / "orbitTestCheckpoint.bin").string();
+   }
+
+   // A little of everything, with nothing left at zero
+   Checkpoint getCheckpoint() const
+   {
+      Checkpoint checkpoint;
+      checkpoint.secondsSimulated = 86400.5;
+      checkpoint.timeWarp = 96.0;
+      checkpoint.cameraX = -1000.0;
+      checkpoint.cameraY = 2000.0;
+      checkpoint.cameraZoom = 64000.0;
+      checkpoint.integrator = 2;
+      checkpoint.shipIndex = 1;
+      checkpoint.records.push_back({ Satellite::SPUTNIK, 0, 0, 0,
+                                     1.0, 2.0, 3.0, 4.0, 0.5, 0.01, 4.0, { 0.0, 0.0 } });
+      checkpoint.records.push_back({ Satellite::SHIP, Checkpoint::DEAD, 7, 0,
+                                     5.0, 6.0, 7.0, 8.0, 1.5, -0.02, 10.0, { 1.0, -2.0 } });
+      checkpoint.records.push_back({ Satellite::DEBRIS, 0, 3, 0,
+                                     9.0, 10.0, 11.0, 12.0, 2.5, 0.03, 0.0, { 0.0, 0.0 } });
+      checkpoint.stars.push_back({ 100.0, -100.0, 200, 0 });
+      checkpoint.random = getRandomState();
+      return checkpoint;
+   }
+
+   std::vector<char> readFile(const std::string& fileName) const
+   {
+      std::ifstream fin(fileName, std::ios::binary);
+      return std::vector<char>(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+   }
+
+   void writeFile(const std::string& fileName, const std::vector<char>& bytes) const
+   {
+      std::ofstream fout(fileName, std::ios::binary | std::ios::trunc);
+      fout.write(bytes.data(), bytes.size());
+   }
+
+   /*********************************************
+    * name:    CREATE each kind and ADD it back
+    * input:   a record of every kind, the ship's with thrust, all dead
+    * output:  a satellite of that kind whose record is the same, bit for bit
+    *********************************************/
+   void create_everyKind()
+   {
+      for (uint32_t kind = 0; kind < Satellite::NUM_KINDS; kind++)
+      {
+         // setup
+         Checkpoint::Record record = { kind, Checkpoint::DEAD, 11, 0,
+                                       -6500000.0, 1234567.0, 12.5, -7500.25,
+                                       1.25, 0.125, 8.0, { 0.0, 0.0 } };
+         if (kind == Satellite::SHIP)
+         {
+            record.extra[0] = 1.5;
+            record.extra[1] = -0.5;
+         }
+         Checkpoint checkpoint;
+         // exercise
+         Satellite* pSatellite = Checkpoint::create(record);
+         if (pSatellite)
+            checkpoint.add(*pSatellite);
+         // verify
+         assertUnit(pSatellite != NULL);
+         assertUnit(pSatellite && pSatellite->getKind() == (Satellite::Kind)kind);
+         assertUnit(pSatellite && pSatellite->isDead());
+         assertUnit(checkpoint.records.size() == 1);
+         assertUnit(checkpoint.records.size() == 1 &&
+                    memcmp(&checkpoint.records[0], &record, sizeof(record)) == 0);
+         // teardown
+         delete pSatellite;
+      }
+   }
+
+   /*********************************************
+    * name:    CREATE of a kind that does not exist
+    * input:   kind NUM_KINDS
+    * output:  NULL
+    *********************************************/
+   void create_unknownKind()
+   {
+      // setup
+      Checkpoint::Record record = {};
+      record.kind = Satellite::NUM_KINDS;
+      // exercise
+      Satellite* pSatellite = Checkpoint::create(record);
+      // verify
+      assertUnit(pSatellite == NULL);
+   }  // teardown
+
+   /*********************************************
+    * name:    CREATE ALL with a ship
+    * input:   a Sputnik and then the ship, which is record 1
+    * output:  both, in order, and the second is the ship
+    *********************************************/
+   void createAll_ship()
+   {
+      // setup
+      Checkpoint checkpoint;
+      checkpoint.records = { { Satellite::SPUTNIK }, { Satellite::SHIP } };
+      checkpoint.shipIndex = 1;
+      std::list<Satellite*> satellites;
+      Satellite* pShip = NULL;
+      // exercise
+      bool isGood = checkpoint.createAll(satellites, pShip);
+      // verify
+      assertUnit(isGood);
+      assertUnit(satellites.size() == 2);
+      assertUnit(satellites.size() == 2 && satellites.front()->getKind() == Satellite::SPUTNIK);
+      assertUnit(satellites.size() == 2 && satellites.back() == pShip);
+      assertUnit(pShip && pShip->getKind() == Satellite::SHIP);
+      // teardown
+      for (Satellite* pSatellite : satellites)
+         delete pSatellite;
+   }
+
+   /*********************************************
+    * name:    CREATE ALL with a kind that does not exist
+    * input:   a checkpoint that reads back fine, but with an unknown
+    *          kind ahead of the ship, which is the last record
+    * output:  false, with nothing made and no ship
+    *********************************************/
+   void createAll_unknownKind()
+   {
+      // setup
+      std::string fileName = getFileName();
+      Checkpoint checkpointWrite = getCheckpoint();
+      checkpointWrite.records = { { Satellite::SPUTNIK }, { Satellite::NUM_KINDS }, { Satellite::SHIP } };
+      checkpointWrite.shipIndex = 2;
+      checkpointWrite.write(fileName.c_str());
+      Checkpoint checkpoint;
+      bool isRead = checkpoint.read(fileName.c_str());
+      std::list<Satellite*> satellites;
+      Satellite* pShip = NULL;
+      // exercise
+      bool isGood = checkpoint.createAll(satellites, pShip);
+      // verify
+      assertUnit(isRead);
+      assertUnit(!isGood);
+      assertUnit(satellites.empty());
+      assertUnit(pShip == NULL);
+      // teardown
+      remove(fileName.c_str());
+   }
+
+   /*********************************************
+    * name:    GET LAYOUT for odd sizes
+    * input:   3 records, 5 stars, 7 bytes of random state
+    * output:  every section on a 64 byte boundary, in order, none overlapping
+    *********************************************/
+   void getLayout_aligned()
+   {
+      // setup
+      // exercise
+      Checkpoint::Header header = Checkpoint::getLayout(3, 5, 7);
+      // verify
+      assertUnit(memcmp(header.magic, "ORBITCKP", 8) == 0);
+      assertUnit(header.version == Checkpoint::VERSION);
+      assertUnit(header.recordsOffset % 64 == 0);
+      assertUnit(header.starsOffset % 64 == 0);
+      assertUnit(header.randomOffset % 64 == 0);
+      assertUnit(header.fileBytes % 64 == 0);
+      assertUnit(header.recordsOffset >= sizeof(Checkpoint::Header));
+      assertUnit(header.starsOffset >= header.recordsOffset + 3 * sizeof(Checkpoint::Record));
+      assertUnit(header.randomOffset >= header.starsOffset + 5 * sizeof(Checkpoint::Star));
+      assertUnit(header.fileBytes >= header.randomOffset + 7);
+   }  // teardown
+
+   /*********************************************
+    * name:    WRITE and READ
+    * input:   a checkpoint saved to a scratch file
+    * output:  everything comes back the same, and no temporary file is left
+    *********************************************/
+   void write_read()
+   {
+      // setup
+      std::string fileName = getFileName();
+      Checkpoint checkpointWrite = getCheckpoint();
+      Checkpoint checkpointRead;
+      // exercise
+      bool written = checkpointWrite.write(fileName.c_str());
+      bool read = checkpointRead.read(fileName.c_str());
+      // verify
+      assertUnit(written);
+      assertUnit(read);
+      assertUnit(!std::filesystem::exists(fileName + ".tmp"));
+      assertUnit(std::filesystem::file_size(fileName) % 64 == 0);
+      assertEquals(checkpointRead.secondsSimulated, 86400.5);
+      assertEquals(checkpointRead.timeWarp, 96.0);
+      assertEquals(checkpointRead.cameraX, -1000.0);
+      assertEquals(checkpointRead.cameraY, 2000.0);
+      assertEquals(checkpointRead.cameraZoom, 64000.0);
+      assertUnit(checkpointRead.integrator == 2);
+      assertUnit(checkpointRead.shipIndex == 1);
+      assertUnit(checkpointRead.records.size() == 3);
+      assertUnit(checkpointRead.records.size() == 3 &&
+                 memcmp(checkpointRead.records.data(), checkpointWrite.records.data(),
+                        3 * sizeof(Checkpoint::Record)) == 0);
+      assertUnit(checkpointRead.stars.size() == 1);
+      assertUnit(checkpointRead.stars.size() == 1 && checkpointRead.stars[0].phase == 200);
+      assertUnit(checkpointRead.random == checkpointWrite.random);
+      // teardown
+      remove(fileName.c_str());
+   }
+
+   /*********************************************
+    * name:    READ a file that is not there
+    * input:   a bogus file name
+    * output:  false, nothing changed
+    *********************************************/
+   void read_missing()
+   {
+      // setup
+      Checkpoint checkpoint;
+      checkpoint.shipIndex = 4;
+      // exercise
+      bool read = checkpoint.read("/no/such/directory/orbit.bin");
+      // verify
+      assertUnit(!read);
+      assertUnit(checkpoint.shipIndex == 4);
+      assertUnit(checkpoint.records.empty());
+   }  // teardown
+
+   /*********************************************
+    * name:    READ a damaged file
+    * input:   one byte of a record changed after writing
+    * output:  false from the checksum, nothing changed
+    *********************************************/
+   void read_corrupt()
+   {
+      // setup
+      std::string fileName = getFileName();
+      getCheckpoint().write(fileName.c_str());
+      std::vector<char> bytes = readFile(fileName);
+      bytes[Checkpoint::getLayout(3, 1, 0).recordsOffset + 20] ^= 0x10;
+      writeFile(fileName, bytes);
+      Checkpoint checkpoint;
+      checkpoint.timeWarp = 3.0;
+      // exercise
+      bool read = checkpoint.read(fileName.c_str());
+      // verify
+      assertUnit(!read);
+      assertEquals(checkpoint.timeWarp, 3.0);
+      assertUnit(checkpoint.records.empty());
+      // teardown
+      remove(fileName.c_str());
+   }
+
+   /*********************************************
+    * name:    READ a file with a damaged header
+    * input:   one byte of the time warp changed after writing
+    * output:  false from the checksum, nothing changed
+    *********************************************/
+   void read_corruptHeader()
+   {
+      // setup
+      std::string fileName = getFileName();
+      getCheckpoint().write(fileName.c_str());
+      std::vector<char> bytes = readFile(fileName);
+      bytes[offsetof(Checkpoint::Header, timeWarp) + 3] ^= 0x10;
+      writeFile(fileName, bytes);
+      Checkpoint checkpoint;
+      checkpoint.timeWarp = 3.0;
+      // exercise
+      bool read = checkpoint.read(fileName.c_str());
+      // verify
+      assertUnit(!read);
+      assertEquals(checkpoint.timeWarp, 3.0);
+      assertUnit(checkpoint.records.empty());
+      // teardown
+      remove(fileName.c_str());
+   }
+
+   /*********************************************
+    * name:    READ from another version or something else entirely
+    * input:   the version changed, then the magic changed
+    * output:  false both times
+    *********************************************/
+   void read_wrongVersion()
+   {
+      // setup
+      std::string fileName = getFileName();
+      getCheckpoint().write(fileName.c_str());
+      std::vector<char> bytes = readFile(fileName);
+      Checkpoint checkpoint;
+      // exercise
+      bytes[8] ^= 0x01;            // version
+      writeFile(fileName, bytes);
+      bool readVersion = checkpoint.read(fileName.c_str());
+      bytes[8] ^= 0x01;
+      bytes[0] = 'X';              // magic
+      writeFile(fileName, bytes);
+      bool readMagic = checkpoint.read(fileName.c_str());
+      // verify
+      assertUnit(!readVersion);
+      assertUnit(!readMagic);
+      assertUnit(checkpoint.records.empty());
+      // teardown
+      remove(fileName.c_str());
+   }
+
+   /*********************************************
+    * name:    READ a file cut short
+    * input:   the last 64 bytes gone
+    * output:  false, nothing changed
+    *********************************************/
+   void read_truncated()
+   {
+      // setup
+      std::string fileName = getFileName();
+      getCheckpoint().write(fileName.c_str());
+      std::vector<char> bytes = readFile(fileName);
+      bytes.resize(bytes.size() - 64);
+      writeFile(fileName, bytes);
+      Checkpoint checkpoint;
+      // exercise
+      bool read = checkpoint.read(fileName.c_str());
+      // verify
+      assertUnit(!read);
+      assertUnit(checkpoint.records.empty());
+      // teardown
+      remove(fileName.c_str());
+   }
+
+   /*********************************************
+    * name:    RANDOM after its state is put back
+    * input:   the state saved through a checkpoint, then ten draws
+    * output:  the same ten draws again
+    *********************************************/
+   void random_sameAgain()
+   {
+      // setup
+      std::string fileName = getFileName();
+      Checkpoint checkpointWrite = getCheckpoint();
+      checkpointWrite.write(fileName.c_str());
+      std::vector<int> first;
+      for (int i = 0; i < 10; i++)
+         first.push_back(random(0, 1000000));
+      Checkpoint checkpointRead;
+      checkpointRead.read(fileName.c_str());
+      // exercise
+      bool isSet = setRandomState(checkpointRead.random);
+      std::vector<int> second;
+      for (int i = 0; i < 10; i++)
+         second.push_back(random(0, 1000000));
+      // verify
+      assertUnit(isSet);
+      assertUnit(first == second);
+      assertUnit(!setRandomState("not a generator"));
+      // teardown
+      remove(fileName.c_str());
+   }
+};
@@ -0,0 +1,306 @@
+/***********************************************************************
+ * Header File:
+ *    TEST CONJUNCTION
+ * Author:
+ *    Chris Mijango & Seth Chen
+ * Summary:
+ *    Unit tests for the ConjunctionScreen class
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+#include "conjunction.h"
+#include "scenario.h"
+#include <vector>
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+/*******************************
+ * TEST CONJUNCTION
+ * A friend class for ConjunctionScreen which contains its unit tests
+ ********************************/
+class TestConjunction : public UnitTest
+{
+public:
+   void run()
+   {
+      isOnPath_apart();
+      isOnPath_crossing();
+      getAligned_drifting();
+      getAligned_inOrder();
+      getArcs_crossing();
+      screen_headOn();
+      screen_bands();
+      screen_closestFirst();
+      screen_open();
+      screen_threads();
+
+      report("Conjunction");
+   }
+
+private:
+   // Going round in a circle this far out, this far round, either way
+   Integrator::State getCircle(double radius, double angle, bool isClockwise = false) const
+   {
+      double speed = sqrt(Integrator::MU / radius) * (isClockwise ? -1.0 : 1.0);
+      return { radius * cos(angle), radius * sin(angle),
+               -speed * sin(angle), speed * cos(angle) };
+   }
+
+   // Starting at periapsis on +x, this much faster than a circle
+   Integrator::State getEllipse(double radius, double faster) const
+   {
+      return { radius, 0.0, 0.0, faster * sqrt(Integrator::MU / radius) };
+   }
+
+   // Whether an angle is in any of the arcs, however many turns round
+   bool isInside(const std::vector<ConjunctionScreen::Interval>& arcs, double angle) const
+   {
+      for (const ConjunctionScreen::Interval& arc : arcs)
+      {
+         double past = angle - arc.first;
+         past -= 2.0 * M_PI * floor(past / (2.0 * M_PI));
+         if (past <= arc.second - arc.first)
+            return true;
+      }
+      return false;
+   }
+
+   /*********************************************
+    * name:    IS ON PATH for circles 100 km apart
+    * input:   7000 km and 7100 km, within 10 km and within 150 km
+    * output:  not the first, the second
+    *********************************************/
+   void isOnPath_apart()
+   {
+      // setup
+      ConjunctionScreen near(10000.0);
+      ConjunctionScreen far(150000.0);
+      ConjunctionScreen::Orbit lhs = ConjunctionScreen::getOrbit(getCircle(7000000.0, 0.0), 0);
+      ConjunctionScreen::Orbit rhs = ConjunctionScreen::getOrbit(getCircle(7100000.0, 1.0), 1);
+      // exercise
+      bool isNear = near.isOnPath(lhs, rhs);
+      bool isFar = far.isOnPath(lhs, rhs);
+      // verify
+      assertUnit(!isNear);
+      assertUnit(isFar);
+   }  // teardown
+
+   /*********************************************
+    * name:    IS ON PATH for an ellipse crossing a circle
+    * input:   periapsis at 7000 km, apoapsis past 7500 km, and a circle
+    *          at 7200 km
+    * output:  they cross
+    *********************************************/
+   void isOnPath_crossing()
+   {
+      // setup
+      ConjunctionScreen screen(1000.0);
+      ConjunctionScreen::Orbit lhs = ConjunctionScreen::getOrbit(getEllipse(7000000.0, 1.05), 0);
+      ConjunctionScreen::Orbit rhs = ConjunctionScreen::getOrbit(getCircle(7200000.0, 2.0), 1);
+      // exercise
+      bool isOnPath = screen.isOnPath(lhs, rhs);
+      // verify
+      assertUnit(lhs.apogee > 7500000.0);
+      assertUnit(isOnPath);
+   }  // teardown
+
+   /*********************************************
+    * name:    GET ALIGNED for two circles on the same path
+    * input:   half a turn apart, and 0.001 radians apart
+    * output:  never for the first, the whole span for the second
+    *********************************************/
+   void getAligned_drifting()
+   {
+      // setup
+      ConjunctionScreen screen(10000.0);
+      ConjunctionScreen::Orbit start = ConjunctionScreen::getOrbit(getCircle(7000000.0, 0.0), 0);
+      ConjunctionScreen::Orbit opposite = ConjunctionScreen::getOrbit(getCircle(7000000.0, M_PI), 1);
+      ConjunctionScreen::Orbit close = ConjunctionScreen::getOrbit(getCircle(7000000.0, 0.001), 2);
+      std::vector<ConjunctionScreen::Interval> never;
+      std::vector<ConjunctionScreen::Interval> always;
+      // exercise
+      screen.getAligned(start, opposite, 86400.0, never);
+      screen.getAligned(start, close, 86400.0, always);
+      // verify
+      assertUnit(never.empty());
+      assertUnit(always.size() == 1);
+      assertEquals(always[0].first, 0.0);
+      assertEquals(always[0].second, 86400.0);
+   }  // teardown
+
+   /*********************************************
+    * name:    GET ALIGNED with the first falling behind
+    * input:   a high circle and a low one, the high one first
+    * output:  several times, earliest first, none outside the span
+    *********************************************/
+   void getAligned_inOrder()
+   {
+      // setup
+      ConjunctionScreen screen(10000.0);
+      ConjunctionScreen::Orbit high = ConjunctionScreen::getOrbit(getCircle(10000000.0, 0.0), 0);
+      ConjunctionScreen::Orbit low = ConjunctionScreen::getOrbit(getCircle(7000000.0, 1.0), 1);
+      std::vector<ConjunctionScreen::Interval> aligned;
+      // exercise
+      screen.getAligned(high, low, 86400.0, aligned);
+      // verify
+      assertUnit(aligned.size() > 2);
+      for (size_t i = 0; i < aligned.size(); i++)
+      {
+         assertUnit(aligned[i].first < aligned[i].second);
+         assertUnit(aligned[i].first >= 0.0 && aligned[i].second <= 86400.0);
+         if (i > 0)
+            assertUnit(aligned[i - 1].second < aligned[i].first);
+      }
+   }  // teardown
+
+   /*********************************************
+    * name:    GET ARCS for an ellipse crossing a circle
+    * input:   periapsis at 7000 km on +x, 5% faster than a circle, and
+    *          a circle at 7200 km
+    * output:  two narrow arcs, one round each crossing, and none at
+    *          periapsis or apoapsis
+    *********************************************/
+   void getArcs_crossing()
+   {
+      // setup
+      ConjunctionScreen screen(1000.0);
+      ConjunctionScreen::Orbit lhs = ConjunctionScreen::getOrbit(getEllipse(7000000.0, 1.05), 0);
+      ConjunctionScreen::Orbit rhs = ConjunctionScreen::getOrbit(getCircle(7200000.0, 2.0), 1);
+      std::vector<ConjunctionScreen::Interval> arcs;
+      double e = lhs.kepler.getEccentricity();
+      double p = lhs.kepler.getSemiMajorAxis() * (1.0 - e * e);
+      double crossing = acos((p / 7200000.0 - 1.0) / e);
+      // exercise
+      screen.getArcs(lhs, rhs, arcs);
+      // verify
+      assertUnit(arcs.size() == 2);
+      assertUnit(isInside(arcs, crossing));
+      assertUnit(isInside(arcs, -crossing));
+      assertUnit(!isInside(arcs, 0.0));
+      assertUnit(!isInside(arcs, M_PI));
+      for (const ConjunctionScreen::Interval& arc : arcs)
+         assertUnit(arc.second - arc.first < 0.1);
+   }  // teardown
+
+   /*********************************************
+    * name:    SCREEN two going opposite ways round one circle
+    * input:   at 7000 km, 0.5 radians either side of +x, for half an
+    *          hour
+    * output:  they meet on +x once each has gone half a radian, at twice
+    *          the speed of either
+    *********************************************/
+   void screen_headOn()
+   {
+      // setup
+      ConjunctionScreen screen(10000.0);
+      std::vector<Integrator::State> states = { getCircle(7000000.0, -0.5),
+                                                getCircle(7000000.0, 0.5, true /*isClockwise*/) };
+      double speed = sqrt(Integrator::MU / 7000000.0);
+      // exercise
+      screen.screen(states, 1800.0, 1);
+      // verify
+      assertUnit(screen.getApproaches().size() == 1);
+      const ConjunctionScreen::Approach& approach = screen.getApproaches().front();
+      assertUnit(approach.first == 0 && approach.second == 1);
+      assertUnit(fabs(approach.seconds - 0.5 * 7000000.0 / speed) < 0.01);
+      assertUnit(approach.distance < 1.0);
+      assertUnit(fabs(approach.speed - 2.0 * speed) < 0.01);
+      assertUnit(screen.getNumAligned() == 1);
+   }  // teardown
+
+   /*********************************************
+    * name:    SCREEN circles a long way apart
+    * input:   7000 km and 8000 km, for a day
+    * output:  the band filter stops them
+    *********************************************/
+   void screen_bands()
+   {
+      // setup
+      ConjunctionScreen screen(10000.0);
+      std::vector<Integrator::State> states = { getCircle(8000000.0, 0.0),
+                                                getCircle(7000000.0, 0.0) };
+      // exercise
+      screen.screen(states, 86400.0, 1);
+      // verify
+      assertUnit(screen.getNumPairs() == 1);
+      assertUnit(screen.getNumInBand() == 0);
+      assertUnit(screen.getApproaches().empty());
+   }  // teardown
+
+   /*********************************************
+    * name:    SCREEN three circling one way and three the other
+    * input:   spread round so only those going opposite ways meet, each
+    *          pair head on at a different height
+    * output:  all nine meetings, closest first
+    *********************************************/
+   void screen_closestFirst()
+   {
+      // setup
+      ConjunctionScreen screen(10000.0);
+      std::vector<Integrator::State> states;
+      for (int i = 0; i < 3; i++)
+         states.push_back(getCircle(7000000.0 + 3000.0 * i, -0.3 * (i + 1)));
+      for (int i = 0; i < 3; i++)
+         states.push_back(getCircle(7000000.0 + 1000.0 * i, 0.3 * (i + 1), true /*isClockwise*/));
+      // exercise
+      screen.screen(states, 1200.0, 1);
+      // verify
+      const std::vector<ConjunctionScreen::Approach>& approaches = screen.getApproaches();
+      assertUnit(approaches.size() == 9);
+      for (size_t i = 1; i < approaches.size(); i++)
+         assertUnit(approaches[i - 1].distance <= approaches[i].distance);
+      assertUnit(approaches.front().distance < 1.0);
+      assertUnit(fabs(approaches.back().distance - 6000.0) < 10.0);
+   }  // teardown
+
+   /*********************************************
+    * name:    SCREEN something on its way out
+    * input:   a circle, and something faster than escape right on it
+    * output:  skipped, and nothing found
+    *********************************************/
+   void screen_open()
+   {
+      // setup
+      ConjunctionScreen screen(10000.0);
+      Integrator::State escaping = getCircle(7000000.0, 0.0);
+      escaping.dy *= 1.5;
+      std::vector<Integrator::State> states = { getCircle(7000000.0, 0.0), escaping };
+      // exercise
+      screen.screen(states, 3600.0, 1);
+      // verify
+      assertUnit(screen.getNumSkipped() == 1);
+      assertUnit(screen.getNumPairs() == 0);
+      assertUnit(screen.getApproaches().empty());
+   }  // teardown
+
+   /*********************************************
+    * name:    SCREEN on one thread and on four
+    * input:   the mix of 300 objects, within 50 km for 6 hours
+    * output:  the very same approaches
+    *********************************************/
+   void screen_threads()
+   {
+      // setup
+      Scenario scenario(1);
+      scenario.addMix(300);
+      std::vector<Integrator::State> states;
+      for (const Scenario::Object& object : scenario.getObjects())
+         states.push_back(object.state);
+      ConjunctionScreen one(50000.0);
+      ConjunctionScreen four(50000.0);
+      // exercise
+      one.screen(states, 6.0 * 3600.0, 1);
+      four.screen(states, 6.0 * 3600.0, 4);
+      // verify
+      assertUnit(!one.getApproaches().empty());
+      assertUnit(one.getApproaches().size() == four.getApproaches().size());
+      bool isSame = one.getNumAligned() == four.getNumAligned();
+      for (size_t i = 0; isSame && i < one.getApproaches().size(); i++)
+         isSame = one.getApproaches()[i].first == four.getApproaches()[i].first &&
+                  one.getApproaches()[i].second == four.getApproaches()[i].second &&
+                  one.getApproaches()[i].seconds == four.getApproaches()[i].seconds;
+      assertUnit(isSame);
+   }  // teardown
+};
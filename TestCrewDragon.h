@@ -218,10 +218,12 @@ private:
 
         // Exercise - move with and without time dilation
         CrewDragon cd2;
-        cd2.timeDilation = 1.0;  // No dilation
+        double warp = Satellite::getTimeWarp();
 
         cd.move(1.0);
+        Satellite::setTimeWarp(1.0);  // No dilation
         cd2.move(1.0);
+        Satellite::setTimeWarp(warp);
 
         // Verify different distances traveled
         Position pos2 = cd.getPosition();
@@ -0,0 +1,295 @@
+/***********************************************************************
+ * Header File:
+ *    TEST EPHEMERIS
+ * Author:
+ *    Chris Mijango & Seth Chen
+ * Summary:
+ *    Unit tests for the Ephemeris class
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+#include "ephemeris.h"
+#include "trajectory.h"
+#include <filesystem>   // for a scratch file
+#include <vector>
+#include <string>
+#include <cstdio>       // for remove()
+#include <cmath>
+
+/*******************************
+ * TEST EPHEMERIS
+ * A friend class for Ephemeris which contains its unit tests
+ ********************************/
+class TestEphemeris : public UnitTest
+{
+public:
+   void run()
+   {
+      getProjection_polynomial();
+      add_wrongCount();
+      add_wrongTime();
+      getState_outside();
+      getState_cubic();
+      propagate_kepler();
+      finish_shortLastWindow();
+      fit_recording();
+
+      report("Ephemeris");
+   }
+
+private:
+   // Going round in a circle this far out
+   Integrator::State getCircle(double radius) const
+   {
+      return { radius, 0.0, 0.0, sqrt(Integrator::MU / radius) };
+   }
+
+   double getDistance(const Integrator::State& lhs, const Integrator::State& rhs) const
+   {
+      return hypot(lhs.x - rhs.x, lhs.y - rhs.y);
+   }
+
+   double getSpeedDifference(const Integrator::State& lhs, const Integrator::State& rhs) const
+   {
+      return hypot(lhs.dx - rhs.dx, lhs.dy - rhs.dy);
+   }
+
+   /*********************************************
+    * name:    GET PROJECTION of a polynomial it can hold
+    * input:   9 samples of 3 tau^3 - tau + 2, fit to degree 4
+    * output:  2 - tau + 3 tau^3 is 2 T0 + 1.25 T1 + 0.75 T3, and no T2
+    *          or T4
+    *********************************************/
+   void getProjection_polynomial()
+   {
+      // setup
+      std::vector<double> projection;
+      std::vector<double> samples;
+      for (int j = 0; j < 9; j++)
+      {
+         double tau = -1.0 + j / 4.0;
+         samples.push_back(3.0 * tau * tau * tau - tau + 2.0);
+      }
+      double c[5] = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+      // exercise
+      Ephemeris::getProjection(9, 4, projection);
+      for (int k = 0; k < 5; k++)
+         for (int j = 0; j < 9; j++)
+            c[k] += projection[k * 9 + j] * samples[j];
+      // verify
+      assertUnit(projection.size() == 45);
+      assertEquals(c[0], 2.0);
+      assertEquals(c[1], 1.25);
+      assertEquals(c[2], 0.0);
+      assertEquals(c[3], 0.75);
+      assertEquals(c[4], 0.0);
+   }  // teardown
+
+   /*********************************************
+    * name:    ADD the wrong number of objects
+    * input:   started for two, given three
+    * output:  refused
+    *********************************************/
+   void add_wrongCount()
+   {
+      // setup
+      Ephemeris ephemeris(4, 3, 1);
+      double x[3] = { 1.0, 2.0, 3.0 };
+      ephemeris.start(2);
+      // exercise
+      bool isAdded = ephemeris.add(0.0, x, x, 3);
+      // verify
+      assertUnit(!isAdded);
+      assertUnit(ephemeris.numSamples == 0);
+   }  // teardown
+
+   /*********************************************
+    * name:    ADD samples out of step
+    * input:   0, 10, then 25 seconds, then 20, and one after finishing
+    * output:  25 refused, 20 taken, and nothing after finishing
+    *********************************************/
+   void add_wrongTime()
+   {
+      // setup
+      Ephemeris ephemeris(4, 3, 1);
+      double x = 1.0;
+      ephemeris.start(1);
+      ephemeris.add(0.0, &x, &x, 1);
+      ephemeris.add(10.0, &x, &x, 1);
+      // exercise
+      bool isLate = ephemeris.add(25.0, &x, &x, 1);
+      bool isOnTime = ephemeris.add(20.0, &x, &x, 1);
+      ephemeris.finish();
+      bool isAfter = ephemeris.add(30.0, &x, &x, 1);
+      // verify
+      assertUnit(!isLate);
+      assertUnit(isOnTime);
+      assertUnit(!isAfter);
+      assertEquals(ephemeris.secondsStep, 10.0);
+      assertEquals(ephemeris.getSecondsEnd(), 20.0);
+   }  // teardown
+
+   /*********************************************
+    * name:    GET STATE outside what was fit
+    * input:   a minute fit from 100 seconds, asked about 99, 161, and
+    *          an object that is not there
+    * output:  false for all three, true at either end
+    *********************************************/
+   void getState_outside()
+   {
+      // setup
+      Ephemeris ephemeris(4, 3, 1);
+      ephemeris.propagate({ getCircle(7000000.0) }, 100.0, 60.0, 10.0);
+      Integrator::State state;
+      // exercise
+      bool isBefore = ephemeris.getState(0, 99.0, state);
+      bool isAfter = ephemeris.getState(0, 161.0, state);
+      bool isOther = ephemeris.getState(1, 130.0, state);
+      bool isStart = ephemeris.getState(0, 100.0, state);
+      bool isEnd = ephemeris.getState(0, 160.0, state);
+      // verify
+      assertUnit(!isBefore);
+      assertUnit(!isAfter);
+      assertUnit(!isOther);
+      assertUnit(isStart);
+      assertUnit(isEnd);
+   }  // teardown
+
+   /*********************************************
+    * name:    GET STATE of a path a cubic can hold exactly
+    * input:   x = t^3 and y = 5 - 2t sampled every second for 20 seconds
+    *          in windows of 8, degree 3
+    * output:  exact anywhere between, velocity too, across windows
+    *********************************************/
+   void getState_cubic()
+   {
+      // setup
+      Ephemeris ephemeris(8, 3, 1);
+      ephemeris.start(1);
+      for (int t = 0; t <= 20; t++)
+      {
+         double x = (double)t * t * t;
+         double y = 5.0 - 2.0 * t;
+         ephemeris.add(t, &x, &y, 1);
+      }
+      ephemeris.finish();
+      Integrator::State at3;
+      Integrator::State at17;
+      // exercise
+      ephemeris.getState(0, 3.5, at3);
+      ephemeris.getState(0, 17.25, at17);
+      // verify
+      assertUnit(ephemeris.getNumWindows() == 3);
+      assertEquals(at3.x, 3.5 * 3.5 * 3.5);
+      assertEquals(at3.y, -2.0);
+      assertEquals(at3.dx, 3.0 * 3.5 * 3.5);
+      assertEquals(at3.dy, -2.0);
+      assertEquals(at17.x, 17.25 * 17.25 * 17.25);
+      assertEquals(at17.dx, 3.0 * 17.25 * 17.25);
+   }  // teardown
+
+   /*********************************************
+    * name:    PROPAGATE a low and a high orbit for a day
+    * input:   circles 550 km and 20,180 km up, and an ellipse, sampled
+    *          every 48 seconds
+    * output:  within 10 cm and 1 cm/s of Kepler between the samples
+    *********************************************/
+   void propagate_kepler()
+   {
+      // setup
+      Integrator::State ellipse = getCircle(7000000.0);
+      ellipse.dy *= 1.1;
+      std::vector<Integrator::State> states = { getCircle(Integrator::EARTH_RADIUS + 550000.0),
+                                                getCircle(Integrator::EARTH_RADIUS + 20180000.0),
+                                                ellipse };
+      Ephemeris ephemeris;
+      double errorPosition = 0.0;
+      double errorSpeed = 0.0;
+      // exercise
+      ephemeris.propagate(states, 0.0, 86400.0, 48.0);
+      // verify
+      for (size_t i = 0; i < states.size(); i++)
+      {
+         Kepler kepler(states[i]);
+         for (double t = 7.0; t < 86400.0; t += 397.0)
+         {
+            Integrator::State state;
+            ephemeris.getState(i, t, state);
+            errorPosition = std::max(errorPosition, getDistance(state, kepler.getState(t)));
+            errorSpeed = std::max(errorSpeed, getSpeedDifference(state, kepler.getState(t)));
+         }
+      }
+      assertUnit(errorPosition < 0.1);
+      assertUnit(errorSpeed < 0.01);
+      assertUnit(ephemeris.getNumWindows() == 113);
+   }  // teardown
+
+   /*********************************************
+    * name:    FINISH with two steps left over
+    * input:   an orbit for 18 steps in windows of 16
+    * output:  the last window a whole one, overlapping the first, and
+    *          as close in its last steps as anywhere
+    *********************************************/
+   void finish_shortLastWindow()
+   {
+      // setup
+      Integrator::State start = getCircle(Integrator::EARTH_RADIUS + 550000.0);
+      Ephemeris ephemeris;
+      Kepler kepler(start);
+      Integrator::State state;
+      // exercise
+      ephemeris.propagate({ start }, 0.0, 18 * 48.0, 48.0);
+      ephemeris.getState(0, 17.5 * 48.0, state);
+      // verify
+      assertUnit(ephemeris.getNumWindows() == 2);
+      assertEquals(ephemeris.secondsLastWindow, 2 * 48.0);
+      assertUnit(getDistance(state, kepler.getState(17.5 * 48.0)) < 0.01);
+   }  // teardown
+
+   /*********************************************
+    * name:    FIT a recording
+    * input:   40 samples of 3 circles, 48 seconds apart, then a sample
+    *          with a fourth
+    * output:  fit as far as the three went, close to where they were
+    *********************************************/
+   void fit_recording()
+   {
+      // setup
+      std::string fileName = (std::filesystem::temp_directory_path() / "orbitTestEphemeris.trj").string();
+      TrajectoryRecorder recorder;
+      recorder.open(fileName.c_str());
+      std::vector<Integrator::State> starts;
+      for (int i = 0; i < 3; i++)
+         starts.push_back(getCircle(7000000.0 + 1000000.0 * i));
+      for (int tick = 0; tick <= 40; tick++)
+      {
+         TrajectoryCodec::Sample* pSample = recorder.getStageIfDue(tick * 48.0);
+         for (const Integrator::State& start : starts)
+         {
+            Integrator::State state = Kepler(start).getState(tick * 48.0);
+            pSample->add(0, state.x, state.y, state.dx, state.dy);
+         }
+         if (tick == 40)
+            pSample->add(0, 0.0, 0.0, 0.0, 0.0);
+         recorder.submit();
+      }
+      recorder.close();
+      TrajectoryReader reader;
+      reader.open(fileName.c_str());
+      Ephemeris ephemeris;
+      Integrator::State state;
+      // exercise
+      bool isFit = ephemeris.fit(reader);
+      ephemeris.getState(2, 1000.0, state);
+      // verify
+      assertUnit(!isFit);
+      assertUnit(ephemeris.getNumObjects() == 3);
+      assertEquals(ephemeris.getSecondsEnd(), 39 * 48.0);
+      assertUnit(getDistance(state, Kepler(starts[2]).getState(1000.0)) < 0.01);
+      // teardown
+      reader.close();
+      remove(fileName.c_str());
+   }
+};
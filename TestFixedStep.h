@@ -0,0 +1,168 @@
+/***********************************************************************
+ * Header File:
+ *    TEST FIXED STEP
+ * Author:
+ *    Chris Mijango & Seth Chen
+ * Summary:
+ *    Unit tests for the FixedStep class
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+#include "fixedStep.h"
+
+/*******************************
+ * TEST FIXED STEP
+ * A friend class for FixedStep which contains its unit tests
+ ********************************/
+class TestFixedStep : public UnitTest
+{
+public:
+   void run()
+   {
+      construct_empty();
+      advance_lessThanTick();
+      advance_oneTick();
+      advance_carriesRemainder();
+      advance_severalTicks();
+      advance_boundedCatchUp();
+      advance_backwards();
+      getSecondsToNext_half();
+
+      report("FixedStep");
+   }
+
+private:
+   /*********************************************
+    * name:    CONSTRUCTOR
+    * input:   ticks of 0.1 seconds, at most 3 at once
+    * output:  nothing accumulated
+    *********************************************/
+   void construct_empty()
+   {
+      // exercise
+      FixedStep step(0.1, 3);
+      // verify
+      assertEquals(step.secondsPerTick, 0.1);
+      assertUnit(step.maxTicks == 3);
+      assertEquals(step.accumulated, 0.0);
+      assertUnit(step.numDropped == 0);
+   }  // teardown
+
+   /*********************************************
+    * name:    ADVANCE less than a tick
+    * input:   0.04 seconds of 0.1 second ticks
+    * output:  no ticks, 0.4 of the way to the next
+    *********************************************/
+   void advance_lessThanTick()
+   {
+      // setup
+      FixedStep step(0.1, 3);
+      // exercise
+      int ticks = step.advance(0.04);
+      // verify
+      assertUnit(ticks == 0);
+      assertEquals(step.getAlpha(), 0.4);
+   }  // teardown
+
+   /*********************************************
+    * name:    ADVANCE one tick
+    * input:   0.1 seconds of 0.1 second ticks
+    * output:  one tick, nothing left
+    *********************************************/
+   void advance_oneTick()
+   {
+      // setup
+      FixedStep step(0.1, 3);
+      // exercise
+      int ticks = step.advance(0.1);
+      // verify
+      assertUnit(ticks == 1);
+      assertEquals(step.getAlpha(), 0.0);
+   }  // teardown
+
+   /*********************************************
+    * name:    ADVANCE a little at a time
+    * input:   0.06 seconds twice, 0.1 second ticks
+    * output:  nothing, then one tick with 0.02 left over
+    *********************************************/
+   void advance_carriesRemainder()
+   {
+      // setup
+      FixedStep step(0.1, 3);
+      // exercise
+      int ticksFirst = step.advance(0.06);
+      int ticksSecond = step.advance(0.06);
+      // verify
+      assertUnit(ticksFirst == 0);
+      assertUnit(ticksSecond == 1);
+      assertEquals(step.accumulated, 0.02);
+   }  // teardown
+
+   /*********************************************
+    * name:    ADVANCE by a few ticks
+    * input:   0.25 seconds of 0.1 second ticks
+    * output:  two ticks, halfway to the third
+    *********************************************/
+   void advance_severalTicks()
+   {
+      // setup
+      FixedStep step(0.1, 3);
+      // exercise
+      int ticks = step.advance(0.25);
+      // verify
+      assertUnit(ticks == 2);
+      assertEquals(step.getAlpha(), 0.5);
+      assertUnit(step.getNumDropped() == 0);
+   }  // teardown
+
+   /*********************************************
+    * name:    ADVANCE after a long stall
+    * input:   10 seconds of 0.1 second ticks, at most 3 at once
+    * output:  three ticks, the other 97 dropped, nothing owed
+    *********************************************/
+   void advance_boundedCatchUp()
+   {
+      // setup
+      FixedStep step(0.1, 3);
+      // exercise
+      int ticks = step.advance(10.0);
+      // verify
+      assertUnit(ticks == 3);
+      assertUnit(step.getNumDropped() == 97);
+      assertEquals(step.accumulated, 0.0);
+      assertUnit(step.advance(0.0) == 0);
+   }  // teardown
+
+   /*********************************************
+    * name:    ADVANCE with time going backwards
+    * input:   0.05 seconds, then -1.0 seconds
+    * output:  no ticks and nothing taken away
+    *********************************************/
+   void advance_backwards()
+   {
+      // setup
+      FixedStep step(0.1, 3);
+      step.advance(0.05);
+      // exercise
+      int ticks = step.advance(-1.0);
+      // verify
+      assertUnit(ticks == 0);
+      assertEquals(step.accumulated, 0.05);
+   }  // teardown
+
+   /*********************************************
+    * name:    GET SECONDS TO NEXT
+    * input:   0.03 seconds into a 0.1 second tick
+    * output:  0.07 seconds to go
+    *********************************************/
+   void getSecondsToNext_half()
+   {
+      // setup
+      FixedStep step(0.1, 3);
+      step.advance(0.03);
+      // exercise and verify
+      assertEquals(step.getSecondsToNext(), 0.07);
+   }  // teardown
+};
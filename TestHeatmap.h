@@ -0,0 +1,221 @@
+/***********************************************************************
+ * Header File:
+ *    TEST HEATMAP
+ * Author:
+ *    Chris Mijango & Seth Chen
+ * Summary:
+ *    Unit tests for the Heatmap class
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+#include "heatmap.h"
+#include "camera.h"
+#include "uiRaster.h"
+#include "position.h"
+#include <vector>
+
+/*******************************
+ * TEST HEATMAP
+ * A friend class for Heatmap which contains the Heatmap unit tests
+ ********************************/
+class TestHeatmap : public UnitTest
+{
+public:
+   void run()
+   {
+      construct_cells();
+      accumulate_center();
+      accumulate_offScreen();
+      accumulate_again();
+      accumulate_sameForAnyThreads();
+      draw_oneCell();
+
+      report("Heatmap");
+   }
+
+private:
+   // A 64 x 32 pixel screen where a pixel is 1 meter
+   Position screen() const
+   {
+      Position pt(64.0, 32.0);
+      return pt;
+   }
+
+   // total of every cell
+   int countAll(const Heatmap& heatmap) const
+   {
+      int total = 0;
+      for (int row = 0; row < heatmap.getRows(); row++)
+         for (int col = 0; col < heatmap.getCols(); col++)
+            total += heatmap.getCount(col, row);
+      return total;
+   }
+
+   /*********************************************
+    * name:    CONSTRUCTOR
+    * input:   64 x 32 pixels with 8 pixel cells
+    * output:  8 x 4 cells, all empty
+    *********************************************/
+   void construct_cells()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      // exercise
+      Heatmap heatmap(screen(), 8, 1);
+      // verify
+      assertUnit(heatmap.getCols() == 8);
+      assertUnit(heatmap.getRows() == 4);
+      assertUnit(heatmap.getMax() == 0);
+      assertUnit(countAll(heatmap) == 0);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    ACCUMULATE around the middle
+    * input:   three points just up and right of the center, one just down and left
+    * output:  3 in cell (4, 2), 1 in cell (3, 1)
+    *********************************************/
+   void accumulate_center()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      Camera camera(screen());
+      Heatmap heatmap(screen(), 8, 1);
+      std::vector<Position> points =
+      {
+         Position(1.0, 1.0), Position(2.0, 3.0), Position(7.0, 7.0), Position(-1.0, -1.0)
+      };
+      // exercise
+      heatmap.accumulate(points, camera);
+      // verify
+      assertUnit(heatmap.getCount(4, 2) == 3);
+      assertUnit(heatmap.getCount(3, 1) == 1);
+      assertUnit(heatmap.getMax() == 3);
+      assertUnit(countAll(heatmap) == 4);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    ACCUMULATE off the screen
+    * input:   points past every edge
+    * output:  nothing counted
+    *********************************************/
+   void accumulate_offScreen()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      Camera camera(screen());
+      Heatmap heatmap(screen(), 8, 1);
+      std::vector<Position> points =
+      {
+         Position(33.0, 0.0), Position(-33.0, 0.0), Position(0.0, 17.0), Position(0.0, -17.0)
+      };
+      // exercise
+      heatmap.accumulate(points, camera);
+      // verify
+      assertUnit(countAll(heatmap) == 0);
+      assertUnit(heatmap.getMax() == 0);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    ACCUMULATE twice
+    * input:   two points, then one
+    * output:  only the last one is counted
+    *********************************************/
+   void accumulate_again()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      Camera camera(screen());
+      Heatmap heatmap(screen(), 8, 1);
+      heatmap.accumulate({ Position(1.0, 1.0), Position(1.0, 1.0) }, camera);
+      // exercise
+      heatmap.accumulate({ Position(-20.0, 10.0) }, camera);
+      // verify
+      assertUnit(countAll(heatmap) == 1);
+      assertUnit(heatmap.getCount(4, 2) == 0);
+      assertUnit(heatmap.getCount(1, 3) == 1);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    ACCUMULATE with one thread and with four
+    * input:   10,000 points spread over the screen and beyond
+    * output:  identical counts
+    *********************************************/
+   void accumulate_sameForAnyThreads()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      Camera camera(screen());
+      Heatmap heatmapSerial(screen(), 8, 1);
+      Heatmap heatmapParallel(screen(), 8, 4);
+      std::vector<Position> points;
+      for (int i = 0; i < 10000; i++)
+         points.push_back(Position((i * 37 % 80) - 40.0, (i * 11 % 40) - 20.0));
+      // exercise
+      heatmapSerial.accumulate(points, camera);
+      heatmapParallel.accumulate(points, camera);
+      // verify
+      bool same = true;
+      for (int row = 0; row < 4; row++)
+         for (int col = 0; col < 8; col++)
+            if (heatmapSerial.getCount(col, row) != heatmapParallel.getCount(col, row))
+               same = false;
+      assertUnit(same);
+      assertUnit(heatmapParallel.partials.size() == 4);
+      assertUnit(heatmapSerial.getMax() == heatmapParallel.getMax());
+      assertUnit(countAll(heatmapSerial) > 5000);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    DRAW a single crowded cell
+    * input:   one point in cell (4, 2)
+    * output:  exactly that 8 x 8 square is lit
+    *********************************************/
+   void draw_oneCell()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      Camera camera(screen());
+      Heatmap heatmap(screen(), 8, 1);
+      heatmap.accumulate({ Position(1.0, 1.0) }, camera);
+      ogstreamRaster gout(64, 32, 1);
+      // exercise
+      heatmap.draw(gout, camera);
+      gout.render();
+      // verify
+      int numLit = 0;
+      for (int y = 0; y < 32; y++)
+         for (int x = 0; x < 64; x++)
+            if (gout.getPixel(x, y)[0] || gout.getPixel(x, y)[1] || gout.getPixel(x, y)[2])
+               numLit++;
+      assertUnit(numLit == 64);
+      assertUnit(gout.getPixel(32, 8)[0] == 255);   // hot is yellow
+      assertUnit(gout.getPixel(32, 8)[1] == 255);
+      assertUnit(gout.getPixel(31, 8)[0] == 0);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+};
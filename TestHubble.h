@@ -219,10 +219,12 @@ private:
 
         // Exercise - move with and without time dilation
         Hubble h2;
-        h2.timeDilation = 1.0;  // No dilation
+        double warp = Satellite::getTimeWarp();
 
         h.move(1.0);
+        Satellite::setTimeWarp(1.0);  // No dilation
         h2.move(1.0);
+        Satellite::setTimeWarp(warp);
 
         // Verify different distances traveled
         Position pos2 = h.getPosition();
@@ -0,0 +1,223 @@
+/***********************************************************************
+ * Header File:
+ *    TEST INTEGRATOR
+ * Author:
+ *    Chris Mijango & Seth Chen
+ * Summary:
+ *    Unit tests for the Integrator and Kepler classes
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+#include "integrator.h"
+#include "Satellite.h"
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <algorithm>   // for max()
+
+/*******************************
+ * TEST INTEGRATOR
+ * A friend class for Integrator and Kepler which contains their unit tests
+ ********************************/
+class TestIntegrator : public UnitTest
+{
+public:
+   void run()
+   {
+      step_eulerSameAsSatellite();
+      getEnergy_circle();
+      kepler_halfPeriod();
+      kepler_clockwise();
+      kepler_shapeClockwise();
+      step_verletKeepsEnergy();
+      step_rk4BeatsEuler();
+      getMethod_names();
+
+      report("Integrator");
+   }
+
+private:
+   // A circle 7000 km out, going counterclockwise
+   Integrator::State getCircle()
+   {
+      double r = 7000000.0;
+      return { r, 0.0, 0.0, sqrt(Integrator::MU / r) };
+   }
+
+   // How far apart two states are, in meters
+   double getDistance(const Integrator::State& lhs, const Integrator::State& rhs)
+   {
+      return sqrt((lhs.x - rhs.x) * (lhs.x - rhs.x) + (lhs.y - rhs.y) * (lhs.y - rhs.y));
+   }
+
+   /*********************************************
+    * name:    STEP with symplectic Euler
+    * input:   a satellite, and its state, moved 480 seconds
+    * output:  exactly the same place and speed
+    *********************************************/
+   void step_eulerSameAsSatellite()
+   {
+      // setup
+      Satellite satellite;
+      satellite.pos.setMetersX(0.0);
+      satellite.pos.setMetersY(-13020000.0);
+      satellite.velocity.setDX(5800.0);
+      satellite.velocity.setDY(0.0);
+      Integrator::State state = { 0.0, -13020000.0, 5800.0, 0.0 };
+      // exercise
+      satellite.move(480.0);
+      for (int i = 0; i < 10; i++)
+         Integrator::step(Integrator::SYMPLECTIC_EULER, state, 48.0);
+      // verify
+      assertUnit(satellite.getPosition().getMetersX() == state.x);
+      assertUnit(satellite.getPosition().getMetersY() == state.y);
+      assertUnit(satellite.getVelocity().getDX() == state.dx);
+      assertUnit(satellite.getVelocity().getDY() == state.dy);
+   }  // teardown
+
+   /*********************************************
+    * name:    GET ENERGY of a circle
+    * input:   a circle of radius r
+    * output:  -mu / 2r, and angular momentum r v
+    *********************************************/
+   void getEnergy_circle()
+   {
+      // setup
+      Integrator::State state = getCircle();
+      // exercise
+      double energy = Integrator::getEnergy(state);
+      double momentum = Integrator::getAngularMomentum(state);
+      // verify
+      assertUnit(fabs(energy - -Integrator::MU / (2.0 * 7000000.0)) < 1.0e-6);
+      assertUnit(fabs(momentum - 7000000.0 * state.dy) < 1.0e-3);
+   }  // teardown
+
+   /*********************************************
+    * name:    KEPLER half way round an ellipse
+    * input:   periapsis at 7000 km on +x, 10% faster than a circle
+    * output:  apoapsis on -x, going the other way, half a period later
+    *********************************************/
+   void kepler_halfPeriod()
+   {
+      // setup
+      Integrator::State start = getCircle();
+      start.dy *= 1.1;
+      Kepler kepler(start);
+      // exercise
+      Integrator::State half = kepler.getState(kepler.getPeriod() / 2.0);
+      Integrator::State full = kepler.getState(kepler.getPeriod());
+      // verify
+      assertUnit(kepler.isClosed());
+      assertUnit(fabs(kepler.e - 0.21) < 1.0e-9);
+      assertUnit(half.x < -7000000.0);
+      assertUnit(fabs(half.y) < 1.0e-3);
+      assertUnit(half.dy < 0.0);
+      assertUnit(getDistance(full, start) < 1.0e-3);
+   }  // teardown
+
+   /*********************************************
+    * name:    KEPLER going clockwise
+    * input:   the circle going the other way, a quarter period on
+    * output:  a quarter of the way round clockwise, at -y
+    *********************************************/
+   void kepler_clockwise()
+   {
+      // setup
+      Integrator::State start = getCircle();
+      start.dy = -start.dy;
+      Kepler kepler(start);
+      // exercise
+      Integrator::State quarter = kepler.getState(kepler.getPeriod() / 4.0);
+      // verify
+      assertUnit(kepler.isClockwise);
+      assertUnit(fabs(quarter.x) < 1.0e-3);
+      assertUnit(fabs(quarter.y - -7000000.0) < 1.0e-3);
+   }  // teardown
+
+   /*********************************************
+    * name:    KEPLER shape of an ellipse going clockwise
+    * input:   periapsis at 7000 km on +y, 10% faster than a circle,
+    *          heading +x
+    * output:  the periapsis at +y, the mean motion less than zero, and
+    *          the mean longitude half a turn back half a period on
+    *********************************************/
+   void kepler_shapeClockwise()
+   {
+      // setup
+      Integrator::State start = { 0.0, 7000000.0, 1.1 * sqrt(Integrator::MU / 7000000.0), 0.0 };
+      Kepler kepler(start);
+      // exercise
+      double periapsis = kepler.getPeriapsis();
+      double longitudeStart = kepler.getMeanLongitude(0.0);
+      double longitudeHalf = kepler.getMeanLongitude(kepler.getPeriod() / 2.0);
+      // verify
+      assertEquals(kepler.getEccentricity(), 0.21);
+      assertUnit(fabs(kepler.getSemiMajorAxis() - 7000000.0 / 0.79) < 1.0e-3);
+      assertEquals(remainder(periapsis - M_PI / 2.0, 2.0 * M_PI), 0.0);
+      assertEquals(remainder(longitudeStart - periapsis, 2.0 * M_PI), 0.0);
+      assertEquals(longitudeHalf - longitudeStart, -M_PI);
+      assertEquals(kepler.getMeanMotion(), -2.0 * M_PI / kepler.getPeriod());
+   }  // teardown
+
+   /*********************************************
+    * name:    STEP with Verlet once around
+    * input:   the circle, 10 second steps for one period
+    * output:  the energy is about where it started, and it never
+    *          strays a kilometer from the circle
+    *********************************************/
+   void step_verletKeepsEnergy()
+   {
+      // setup
+      Integrator::State state = getCircle();
+      double energy = Integrator::getEnergy(state);
+      int steps = (int)(Kepler(state).getPeriod() / 10.0);
+      double worst = 0.0;
+      // exercise
+      for (int i = 0; i < steps; i++)
+      {
+         Integrator::step(Integrator::VELOCITY_VERLET, state, 10.0);
+         worst = std::max(worst, fabs(sqrt(state.x * state.x + state.y * state.y) - 7000000.0));
+      }
+      // verify
+      assertUnit(fabs((Integrator::getEnergy(state) - energy) / energy) < 1.0e-6);
+      assertUnit(worst < 1000.0);
+   }  // teardown
+
+   /*********************************************
+    * name:    STEP with RK4 against Euler
+    * input:   the circle, 10 second steps for one period each way
+    * output:  RK4 ends much closer to Kepler
+    *********************************************/
+   void step_rk4BeatsEuler()
+   {
+      // setup
+      Integrator::State euler = getCircle();
+      Integrator::State rk4 = getCircle();
+      Kepler kepler(euler);
+      int steps = (int)(kepler.getPeriod() / 10.0);
+      // exercise
+      for (int i = 0; i < steps; i++)
+      {
+         Integrator::step(Integrator::SYMPLECTIC_EULER, euler, 10.0);
+         Integrator::step(Integrator::RK4, rk4, 10.0);
+      }
+      // verify
+      Integrator::State exact = kepler.getState(steps * 10.0);
+      assertUnit(getDistance(rk4, exact) < 1.0);
+      assertUnit(getDistance(rk4, exact) * 1000.0 < getDistance(euler, exact));
+   }  // teardown
+
+   /*********************************************
+    * name:    GET METHOD from its name
+    * input:   every name, and one that is not
+    * output:  the method back, and NUM_METHODS for the stranger
+    *********************************************/
+   void getMethod_names()
+   {
+      // exercise and verify
+      for (int method = 0; method < Integrator::NUM_METHODS; method++)
+         assertUnit(Integrator::getMethod(Integrator::getName((Integrator::Method)method)) == method);
+      assertUnit(Integrator::getMethod("leapfrog") == Integrator::NUM_METHODS);
+   }  // teardown
+};
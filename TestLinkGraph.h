@@ -0,0 +1,312 @@
+/***********************************************************************
+ * Header File:
+ *    TEST LINK GRAPH
+ * Author:
+ *    Chris Mijango & Seth Chen
+ * Summary:
+ *    Unit tests for the LinkGraph class
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+#include "linkGraph.h"
+#include "scenario.h"
+#include <vector>
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+/*******************************
+ * TEST LINK GRAPH
+ * A friend class for LinkGraph which contains its unit tests
+ ********************************/
+class TestLinkGraph : public UnitTest
+{
+public:
+   void run()
+   {
+      update_range();
+      update_earth();
+      update_madeBroken();
+      route_chain();
+      route_broken();
+      route_shortcut();
+      route_resized();
+      route_matchesDijkstra();
+
+      report("LinkGraph");
+   }
+
+private:
+   // Sitting still here
+   Integrator::State getStill(double x, double y) const
+   {
+      return { x, y, 0.0, 0.0 };
+   }
+
+   // Whether a route's tree has every satellite with a way in it once,
+   // parents first, each as far as its parent and the link between
+   bool isTree(const LinkGraph& graph, int route) const
+   {
+      const LinkGraph::Route& tree = graph.routes[route];
+      std::vector<int> place(graph.size(), -1);
+      for (size_t k = 0; k < tree.order.size(); k++)
+         place[tree.order[k]] = (int)k;
+      for (int v = 0; v < (int)graph.size(); v++)
+      {
+         int parent = tree.parents[v];
+         if ((tree.distances[v] == HUGE_VAL) != (place[v] < 0))
+            return false;
+         if (parent < 0)
+            continue;
+         if (place[parent] < 0 || place[parent] >= place[v] ||
+             fabs(tree.distances[parent] + graph.getLength(parent, v) - tree.distances[v]) > 1.0e-6)
+            return false;
+      }
+      return true;
+   }
+
+   /*********************************************
+    * name:    UPDATE with some in range and some not
+    * input:   three in a row 600 km apart, with a 1000 km range
+    * output:  the two next to each other are linked, the ends are not
+    *********************************************/
+   void update_range()
+   {
+      // setup
+      double r = 7000000.0;
+      LinkGraph graph(1000000.0, 1);
+      std::vector<Integrator::State> nodes = { getStill(r, 0.0),
+                                               getStill(r, 600000.0),
+                                               getStill(r, 1200000.0) };
+      // exercise
+      graph.update(nodes);
+      // verify
+      assertUnit(graph.getLinks().size() == 2);
+      assertUnit(graph.getLinks()[0].i == 0 && graph.getLinks()[0].j == 1);
+      assertUnit(graph.getLinks()[1].i == 1 && graph.getLinks()[1].j == 2);
+      assertEquals(graph.getLength(0, 1), 600000.0);
+      assertUnit(graph.getLength(0, 2) < 0.0);
+   }  // teardown
+
+   /*********************************************
+    * name:    UPDATE with the Earth between two
+    * input:   at 7000 km on either side of the Earth, and two 30 degrees
+    *          apart, with a range wider than the Earth
+    * output:  the two either side cannot see each other, the others can
+    *********************************************/
+   void update_earth()
+   {
+      // setup
+      double r = 7000000.0;
+      LinkGraph graph(20000000.0, 1);
+      std::vector<Integrator::State> nodes = { getStill(r, 0.0),
+                                               getStill(-r, 0.0),
+                                               getStill(r * cos(M_PI / 6.0), r * sin(M_PI / 6.0)) };
+      // exercise
+      graph.update(nodes);
+      // verify
+      assertUnit(graph.getLinks().size() == 1);
+      assertUnit(!graph.getLinks().empty() &&
+                 graph.getLinks()[0].i == 0 && graph.getLinks()[0].j == 2);
+   }  // teardown
+
+   /*********************************************
+    * name:    UPDATE twice, with one moving
+    * input:   three in a row 600 km apart, then the last moves next to
+    *          the first
+    * output:  the first time two made; the second one made and one broken
+    *********************************************/
+   void update_madeBroken()
+   {
+      // setup
+      double r = 7000000.0;
+      LinkGraph graph(1000000.0, 1);
+      std::vector<Integrator::State> nodes = { getStill(r, 0.0),
+                                               getStill(r, 600000.0),
+                                               getStill(r, 1200000.0) };
+      graph.update(nodes);
+      assertUnit(graph.getNumMade() == 2 && graph.getNumBroken() == 0);
+      nodes[2] = getStill(r, -600000.0);
+      // exercise
+      graph.update(nodes);
+      // verify
+      assertUnit(graph.getNumMade() == 1);
+      assertUnit(graph.getNumBroken() == 1);
+      assertUnit(graph.getLinks().size() == 2);
+   }  // teardown
+
+   /*********************************************
+    * name:    ROUTE down a chain
+    * input:   five in a row 600 km apart, from the first to the last
+    * output:  four hops, 2400 km, at the speed of light
+    *********************************************/
+   void route_chain()
+   {
+      // setup
+      double r = 7000000.0;
+      LinkGraph graph(1000000.0, 1);
+      std::vector<Integrator::State> nodes;
+      for (int i = 0; i < 5; i++)
+         nodes.push_back(getStill(r, 600000.0 * i));
+      int route = graph.addRoute(0, 4);
+      std::vector<int> path;
+      // exercise
+      graph.update(nodes);
+      graph.getPath(route, path);
+      // verify
+      assertUnit(graph.getNumHops(route) == 4);
+      assertEquals(graph.getLatency(route) * 1000.0, 2400000.0 / 299792458.0 * 1000.0);
+      assertUnit(path == std::vector<int>({ 0, 1, 2, 3, 4 }));
+   }  // teardown
+
+   /*********************************************
+    * name:    ROUTE down a chain that breaks
+    * input:   five in a row, then the middle one moves away
+    * output:  no way the second time
+    *********************************************/
+   void route_broken()
+   {
+      // setup
+      double r = 7000000.0;
+      LinkGraph graph(1000000.0, 1);
+      std::vector<Integrator::State> nodes;
+      for (int i = 0; i < 5; i++)
+         nodes.push_back(getStill(r, 600000.0 * i));
+      int route = graph.addRoute(0, 4);
+      graph.update(nodes);
+      nodes[2] = getStill(-r, 0.0);
+      std::vector<int> path;
+      // exercise
+      graph.update(nodes);
+      graph.getPath(route, path);
+      // verify
+      assertUnit(graph.getLatency(route) < 0.0);
+      assertUnit(graph.getNumHops(route) == -1);
+      assertUnit(path.empty());
+      assertUnit(isTree(graph, route));
+   }  // teardown
+
+   /*********************************************
+    * name:    ROUTE when a shorter way opens
+    * input:   a U of five 900 km apart on each side, and one out of
+    *          range that then moves in across the top of the U
+    * output:  four hops and 3600 km, then two hops and 1800 km, with
+    *          only the two that got closer put on the heap
+    *********************************************/
+   void route_shortcut()
+   {
+      // setup
+      double r = 7000000.0;
+      LinkGraph graph(1000000.0, 1);
+      std::vector<Integrator::State> nodes = { getStill(r, 0.0),
+                                               getStill(r + 900000.0, 0.0),
+                                               getStill(r + 900000.0, 900000.0),
+                                               getStill(r + 900000.0, 1800000.0),
+                                               getStill(r, 1800000.0),
+                                               getStill(r, 10000000.0) };
+      int route = graph.addRoute(0, 4);
+      graph.update(nodes);
+      int hopsBefore = graph.getNumHops(route);
+      double latencyBefore = graph.getLatency(route);
+      nodes[5] = getStill(r, 900000.0);
+      // exercise
+      graph.update(nodes);
+      // verify
+      assertUnit(hopsBefore == 4);
+      assertEquals(latencyBefore * 1000.0, 3600000.0 / 299792458.0 * 1000.0);
+      assertUnit(graph.getNumHops(route) == 2);
+      assertEquals(graph.getLatency(route) * 1000.0, 1800000.0 / 299792458.0 * 1000.0);
+      assertUnit(graph.getNumRelaxed() == 2);
+      assertUnit(isTree(graph, route));
+   }  // teardown
+
+   /*********************************************
+    * name:    ROUTE when a satellite goes
+    * input:   five in a row, then the last is taken off the list
+    * output:  the route to it has no way, and comes back when it does
+    *********************************************/
+   void route_resized()
+   {
+      // setup
+      double r = 7000000.0;
+      LinkGraph graph(1000000.0, 1);
+      std::vector<Integrator::State> nodes;
+      for (int i = 0; i < 5; i++)
+         nodes.push_back(getStill(r, 600000.0 * i));
+      int route = graph.addRoute(0, 4);
+      graph.update(nodes);
+      Integrator::State last = nodes.back();
+      nodes.pop_back();
+      // exercise
+      graph.update(nodes);
+      double latencyGone = graph.getLatency(route);
+      nodes.push_back(last);
+      graph.update(nodes);
+      // verify
+      assertUnit(latencyGone < 0.0);
+      assertUnit(graph.getNumBroken() == 3);
+      assertUnit(graph.getNumHops(route) == 4);
+   }  // teardown
+
+   /*********************************************
+    * name:    ROUTE through a moving constellation, patched and afresh
+    * input:   a Walker constellation of 2000 in 20 shells, for 30
+    *          minutes a minute at a time, on four routes
+    * output:  every distance the same both ways, every tick, and less
+    *          put on the heap patching
+    *********************************************/
+   void route_matchesDijkstra()
+   {
+      // setup
+      Scenario scenario(1);
+      scenario.addWalker(2000, 20, 1, 550000.0, 10000.0);
+      std::vector<Kepler> orbits;
+      for (const Scenario::Object& object : scenario.getObjects())
+         orbits.push_back(Kepler(object.state));
+      LinkGraph patched(300000.0, 2);
+      LinkGraph afresh(300000.0, 2);
+      afresh.setIncremental(false);
+      for (int to : { 1000, 37, 1999, 500 })
+      {
+         patched.addRoute(0, to);
+         afresh.addRoute(0, to);
+      }
+      patched.addRoute(1234, 42);
+      afresh.addRoute(1234, 42);
+      bool isSame = true;
+      uint64_t numPatched = 0;
+      uint64_t numAfresh = 0;
+      size_t numChanged = 0;
+      // exercise
+      for (int minute = 0; minute <= 30; minute++)
+      {
+         std::vector<Integrator::State> nodes;
+         for (const Kepler& orbit : orbits)
+            nodes.push_back(orbit.getState(60.0 * minute));
+         patched.update(nodes);
+         afresh.update(nodes);
+         if (minute > 0)
+         {
+            numPatched += patched.getNumRelaxed();
+            numAfresh += afresh.getNumRelaxed();
+            numChanged += patched.getNumMade() + patched.getNumBroken();
+         }
+         for (int route = 0; route < (int)patched.getNumRoutes(); route++)
+            for (size_t v = 0; v < nodes.size(); v++)
+            {
+               double lhs = patched.routes[route].distances[v];
+               double rhs = afresh.routes[route].distances[v];
+               if (lhs != rhs && fabs(lhs - rhs) > 1.0e-6)
+                  isSame = false;
+            }
+      }
+      // verify
+      assertUnit(isSame);
+      assertUnit(numChanged > 0);
+      assertUnit(numPatched < numAfresh);
+      assertUnit(patched.getLatency(0) > 0.0);
+      for (int route = 0; route < (int)patched.getNumRoutes(); route++)
+         assertUnit(isTree(patched, route));
+   }  // teardown
+};
@@ -0,0 +1,159 @@
+/***********************************************************************
+ * Header File:
+ *    TEST PHASES
+ * Author:
+ *    Chris Mijango & Seth Chen
+ * Summary:
+ *    Unit tests for the Phases class
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+#include "phases.h"
+#include "Satellite.h"
+#include "camera.h"
+#include "position.h"
+#include "uiInteract.h"
+#include <list>
+#include <vector>
+#include <iterator>   // for next()
+
+/*******************************
+ * TEST PHASES
+ * A friend class for Phases which contains its unit tests
+ ********************************/
+class TestPhases : public UnitTest
+{
+public:
+   void run()
+   {
+      move_skipsDead();
+      cull_inOrder();
+      cull_sameOnAnyThreads();
+
+      report("Phases");
+   }
+
+private:
+   // Stays put and counts its moves
+   class Dummy : public Satellite
+   {
+   public:
+      Dummy(double x, double y, double radius = 10.0) : Satellite(20, radius), numMoves(0)
+      {
+         pos.setMetersX(x);
+         pos.setMetersY(y);
+      }
+      void move(double time) override { numMoves++; }
+      int numMoves;
+   };
+
+   // Well out from the earth
+   static constexpr double ORBIT = 20000000.0;
+
+   static void clear(std::list<Satellite*>& satellites)
+   {
+      for (Satellite* pSatellite : satellites)
+         delete pSatellite;
+      satellites.clear();
+   }
+
+   /*********************************************
+    * name:    MOVE skips the dead
+    * input:   three, the middle one dead
+    * output:  the other two move once
+    *********************************************/
+   void move_skipsDead()
+   {
+      // setup
+      Phases phases(1);
+      Interface ui;
+      Dummy* pFirst = new Dummy(ORBIT, 0.0);
+      Dummy* pDead = new Dummy(-ORBIT, 0.0);
+      Dummy* pLast = new Dummy(0.0, ORBIT);
+      pDead->kill();
+      std::list<Satellite*> satellites = { pFirst, pDead, pLast };
+      // exercise
+      phases.move(satellites, ui);
+      // verify
+      assertUnit(pFirst->numMoves == 1);
+      assertUnit(pDead->numMoves == 0);
+      assertUnit(pLast->numMoves == 1);
+      assertUnit(satellites.size() == 3);
+      // teardown
+      clear(satellites);
+   }
+
+   // A row across the middle of the screen, every other one dead
+   std::list<Satellite*> getRow(int num)
+   {
+      std::list<Satellite*> satellites;
+      for (int i = 0; i < num; i++)
+      {
+         Dummy* pDummy = new Dummy((double)(i - num / 2) * 30.0, 0.0);
+         if (i % 2)
+            pDummy->kill();
+         satellites.push_back(pDummy);
+      }
+      return satellites;
+   }
+
+   /*********************************************
+    * name:    CULL in order
+    * input:   a row, some of it off the screen, every other one dead,
+    *          and one of them skipped
+    * output:  the live ones on the screen, less the one skipped, in order
+    *********************************************/
+   void cull_inOrder()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(100.0);
+      Camera camera(Position(100000.0, 80000.0));   // 1000 x 800 pixels
+      Phases phases(4);
+      std::list<Satellite*> satellites = getRow(5000);
+      const Satellite* pSkip = *std::next(satellites.begin(), 2500);
+      // exercise
+      const std::vector<Satellite*>& visible = phases.cull(satellites, camera, 0.0, pSkip);
+      // verify
+      std::vector<Satellite*> expected;
+      for (Satellite* pSatellite : satellites)
+         if (pSatellite != pSkip && !pSatellite->isDead() &&
+             camera.isVisible(pSatellite->getPosition(), 0.0))
+            expected.push_back(pSatellite);
+      assertUnit(!expected.empty());
+      assertUnit(expected.size() < satellites.size() / 2);
+      assertUnit(visible == expected);
+      // teardown
+      clear(satellites);
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    CULL the same on any number of threads
+    * input:   a long row, culled on one thread and on four
+    * output:  the same satellites in the same order
+    *********************************************/
+   void cull_sameOnAnyThreads()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      Camera camera(Position(100000.0, 80000.0));
+      Phases one(1);
+      Phases four(4);
+      std::list<Satellite*> satellites = getRow(20000);
+      // exercise
+      std::vector<Satellite*> visibleOne = one.cull(satellites, camera, 16.0, nullptr);
+      std::vector<Satellite*> visibleFour = four.cull(satellites, camera, 16.0, nullptr);
+      // verify
+      assertUnit(!visibleOne.empty());
+      assertUnit(visibleOne == visibleFour);
+      // teardown
+      clear(satellites);
+      ptZoom.setZoom(zoom);
+   }
+};
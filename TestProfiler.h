@@ -0,0 +1,163 @@
+/***********************************************************************
+ * Header File:
+ *    TEST PROFILER
+ * Author:
+ *    Chris Mijango & Seth Chen
+ * Summary:
+ *    Unit tests for the Profiler class
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+#include "profiler.h"
+#include "uiRecord.h"
+#include <cmath>
+
+/*******************************
+ * TEST PROFILER
+ * A friend class for Profiler which contains its unit tests
+ ********************************/
+class TestProfiler : public UnitTest
+{
+public:
+   void run()
+   {
+      construct_empty();
+      bucket_withinFivePercent();
+      bucket_tooShort();
+      add_percentiles();
+      add_rollsOver();
+      getMean_allTime();
+      draw_lineEach();
+
+      report("Profiler");
+   }
+
+private:
+   // Are two times within the width of a bucket of each other?
+   bool isClose(double seconds, double secondsExpected)
+   {
+      return std::fabs(seconds - secondsExpected) <= 0.05 * secondsExpected;
+   }
+
+   /*********************************************
+    * name:    CONSTRUCTOR
+    * input:   a window of 10 frames
+    * output:  nothing recorded, all percentiles zero
+    *********************************************/
+   void construct_empty()
+   {
+      // exercise
+      Profiler profiler(10);
+      // verify
+      assertUnit(profiler.numSamples == 10);
+      assertUnit(profiler.getCount(Profiler::UPDATE) == 0);
+      assertEquals(profiler.getPercentile(Profiler::DRAW, 0.5), 0.0);
+      assertEquals(profiler.getWorst(Profiler::SLEEP), 0.0);
+   }  // teardown
+
+   /*********************************************
+    * name:    BUCKET round trip
+    * input:   5us, 1ms, 16.7ms, and 2s
+    * output:  the middle of each bucket is within 5%
+    *********************************************/
+   void bucket_withinFivePercent()
+   {
+      for (double seconds : { 0.000005, 0.001, 0.0167, 2.0 })
+         assertUnit(isClose(Profiler::secondsFor(Profiler::bucketFor(seconds)), seconds));
+   }
+
+   /*********************************************
+    * name:    BUCKET under a microsecond
+    * input:   zero and a nanosecond
+    * output:  bucket 0, which reads as zero
+    *********************************************/
+   void bucket_tooShort()
+   {
+      assertUnit(Profiler::bucketFor(0.0) == 0);
+      assertUnit(Profiler::bucketFor(0.000000001) == 0);
+      assertEquals(Profiler::secondsFor(0), 0.0);
+   }
+
+   /*********************************************
+    * name:    ADD then read percentiles
+    * input:   90 frames of 1ms, 9 of 10ms, and 1 of 100ms
+    * output:  p50 is 1ms, p95 and p99 are 10ms
+    *********************************************/
+   void add_percentiles()
+   {
+      // setup
+      Profiler profiler(100);
+      for (int i = 0; i < 90; i++)
+         profiler.add(Profiler::UPDATE, 0.001);
+      for (int i = 0; i < 9; i++)
+         profiler.add(Profiler::UPDATE, 0.010);
+      profiler.add(Profiler::UPDATE, 0.100);
+      // exercise and verify
+      assertUnit(isClose(profiler.getPercentile(Profiler::UPDATE, 0.50), 0.001));
+      assertUnit(isClose(profiler.getPercentile(Profiler::UPDATE, 0.95), 0.010));
+      assertUnit(isClose(profiler.getPercentile(Profiler::UPDATE, 0.99), 0.010));
+      assertUnit(isClose(profiler.getPercentile(Profiler::UPDATE, 1.00), 0.100));
+      assertUnit(profiler.getCount(Profiler::DRAW) == 0);
+   }  // teardown
+
+   /*********************************************
+    * name:    ADD more than the window holds
+    * input:   a window of 4, four frames of 10ms then four of 1ms
+    * output:  only the 1ms frames are left, but the worst is remembered
+    *********************************************/
+   void add_rollsOver()
+   {
+      // setup
+      Profiler profiler(4);
+      for (int i = 0; i < 4; i++)
+         profiler.add(Profiler::SWAP, 0.010);
+      // exercise
+      for (int i = 0; i < 4; i++)
+         profiler.add(Profiler::SWAP, 0.001);
+      // verify
+      assertUnit(isClose(profiler.getPercentile(Profiler::SWAP, 0.99), 0.001));
+      assertUnit(profiler.histograms[Profiler::SWAP].size == 4);
+      assertUnit(profiler.getCount(Profiler::SWAP) == 8);
+      assertEquals(profiler.getWorst(Profiler::SWAP), 0.010);
+   }  // teardown
+
+   /*********************************************
+    * name:    GET MEAN
+    * input:   a window of 2, frames of 1ms, 2ms, and 6ms
+    * output:  3ms, counting the frame that rolled out
+    *********************************************/
+   void getMean_allTime()
+   {
+      // setup
+      Profiler profiler(2);
+      profiler.add(Profiler::DRAW, 0.001);
+      profiler.add(Profiler::DRAW, 0.002);
+      profiler.add(Profiler::DRAW, 0.006);
+      // exercise and verify
+      assertEquals(profiler.getMean(Profiler::DRAW), 0.003);
+   }  // teardown
+
+   /*********************************************
+    * name:    DRAW
+    * input:   a recording stream
+    * output:  a heading and a line of text for each phase
+    *********************************************/
+   void draw_lineEach()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      Profiler profiler;
+      profiler.add(Profiler::DRAW, 0.002);
+      ogstreamRecord gout;
+      // exercise
+      profiler.draw(gout, Position(-490.0, 480.0));
+      // verify
+      assertUnit(gout.getNumCommands() == 1 + Profiler::NUM_PHASES);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+};
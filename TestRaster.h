@@ -0,0 +1,291 @@
+/***********************************************************************
+ * Header File:
+ *    TEST RASTER
+ * Author:
+ *    Chris Mijango & Seth Chen
+ * Summary:
+ *    Unit tests for the software rasterizer graphics stream
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+#include "uiRaster.h"
+#include "position.h"
+
+/*******************************
+ * TEST RASTER
+ * A friend class for ogstreamRaster which contains its unit tests
+ ********************************/
+class TestRaster : public UnitTest
+{
+public:
+   void run()
+   {
+      // Frame buffer
+      construct_black();
+      clear_dropsQueue();
+
+      // Primitives
+      drawDot_center();
+      drawDot_offScreen();
+      drawTriangleFan_square();
+      drawTriangleFan_sharedEdge();
+      drawLine_horizontal();
+      drawText_lit();
+
+      // Tiles and threads
+      render_sameForAnyThreads();
+
+      report("Raster");
+   }
+
+private:
+   // count how many pixels are not black
+   int countLit(const ogstreamRaster& gout) const
+   {
+      int count = 0;
+      for (int y = 0; y < gout.getHeight(); y++)
+         for (int x = 0; x < gout.getWidth(); x++)
+         {
+            const unsigned char* pixel = gout.getPixel(x, y);
+            if (pixel[0] || pixel[1] || pixel[2])
+               count++;
+         }
+      return count;
+   }
+
+   /*********************************************
+    * name:    CONSTRUCTOR
+    * input:   64 x 48
+    * output:  every pixel black and opaque
+    *********************************************/
+   void construct_black()
+   {
+      // exercise
+      ogstreamRaster gout(64, 48, 1);
+      // verify
+      assertUnit(gout.getWidth() == 64);
+      assertUnit(gout.getHeight() == 48);
+      assertUnit(countLit(gout) == 0);
+      assertUnit(gout.getPixel(10, 10)[3] == 255);
+      assertUnit(gout.primitives.empty());
+   }  // teardown
+
+   /*********************************************
+    * name:    CLEAR
+    * input:   a queued dot that was never rendered
+    * output:  nothing queued, nothing lit
+    *********************************************/
+   void clear_dropsQueue()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      const int rgb[] = { 255, 255, 255 };
+      ogstreamRaster gout(64, 64, 1);
+      gout.drawDot(Position(), rgb);
+      // exercise
+      gout.clear();
+      gout.render();
+      // verify
+      assertUnit(gout.primitives.empty());
+      assertUnit(countLit(gout) == 0);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    DRAW DOT at the origin
+    * input:   (0, 0) on a 64 x 64 frame
+    * output:  pixel (32, 32) lit, nothing else
+    *********************************************/
+   void drawDot_center()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      const int rgb[] = { 10, 20, 30 };
+      ogstreamRaster gout(64, 64, 1);
+      // exercise
+      gout.drawDot(Position(), rgb);
+      gout.render();
+      // verify
+      assertUnit(gout.getPixel(32, 32)[0] == 10);
+      assertUnit(gout.getPixel(32, 32)[1] == 20);
+      assertUnit(gout.getPixel(32, 32)[2] == 30);
+      assertUnit(countLit(gout) == 1);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    DRAW DOT off the screen
+    * input:   (1000, 1000) on a 64 x 64 frame
+    * output:  never even queued
+    *********************************************/
+   void drawDot_offScreen()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      const int rgb[] = { 255, 255, 255 };
+      ogstreamRaster gout(64, 64, 1);
+      // exercise
+      gout.drawDot(Position(1000.0, 1000.0), rgb);
+      // verify
+      assertUnit(gout.primitives.empty());
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    DRAW TRIANGLE FAN as a square
+    * input:   (-4,-4) (4,-4) (4,4) (-4,4)
+    * output:  exactly the 8 x 8 pixels inside
+    *********************************************/
+   void drawTriangleFan_square()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      const int rgb[] = { 255, 0, 0 };
+      Position points[4] =
+      {
+         Position(-4.0, -4.0), Position(4.0, -4.0), Position(4.0, 4.0), Position(-4.0, 4.0)
+      };
+      ogstreamRaster gout(64, 64, 1);
+      // exercise
+      gout.drawTriangleFan(points, 4, rgb);
+      gout.render();
+      // verify
+      assertUnit(countLit(gout) == 64);
+      assertUnit(gout.getPixel(28, 28)[0] == 255);
+      assertUnit(gout.getPixel(35, 35)[0] == 255);
+      assertUnit(gout.getPixel(36, 35)[0] == 0);
+      assertUnit(gout.getPixel(27, 28)[0] == 0);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    DRAW TRIANGLE FAN with a diagonal shared edge
+    * input:   a square split down the diagonal, two colors
+    * output:  every pixel drawn exactly once, so no gap and no seam
+    *********************************************/
+   void drawTriangleFan_sharedEdge()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      const int rgbLower[] = { 255, 0, 0 };
+      const int rgbUpper[] = { 0, 255, 0 };
+      Position lower[3] = { Position(-8.0, -8.0), Position(8.0, -8.0), Position(8.0, 8.0) };
+      Position upper[3] = { Position(-8.0, -8.0), Position(8.0, 8.0), Position(-8.0, 8.0) };
+      ogstreamRaster gout(64, 64, 1);
+      // exercise
+      gout.drawTriangleFan(lower, 3, rgbLower);
+      gout.drawTriangleFan(upper, 3, rgbUpper);
+      gout.render();
+      // verify
+      int numRed = 0;
+      int numGreen = 0;
+      for (int y = 0; y < 64; y++)
+         for (int x = 0; x < 64; x++)
+         {
+            numRed += gout.getPixel(x, y)[0] ? 1 : 0;
+            numGreen += gout.getPixel(x, y)[1] ? 1 : 0;
+         }
+      assertUnit(numRed + numGreen == 256);
+      assertUnit(countLit(gout) == 256);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    DRAW LINE horizontal
+    * input:   (-5, 0) to (5, 0)
+    * output:  eleven pixels on row 32
+    *********************************************/
+   void drawLine_horizontal()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      const int rgb[] = { 255, 255, 255 };
+      ogstreamRaster gout(64, 64, 1);
+      // exercise
+      gout.drawLine(Position(-5.0, 0.0), Position(5.0, 0.0), rgb);
+      gout.render();
+      // verify
+      assertUnit(countLit(gout) == 11);
+      assertUnit(gout.getPixel(27, 32)[0] == 255);
+      assertUnit(gout.getPixel(37, 32)[0] == 255);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    DRAW TEXT
+    * input:   "I" at the origin
+    * output:  a column of nine pixels above the baseline
+    *********************************************/
+   void drawText_lit()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      ogstreamRaster gout(64, 64, 1);
+      // exercise
+      gout.setPosition(Position());
+      gout << "I";
+      gout.render();
+      // verify
+      assertUnit(countLit(gout) == 9);
+      assertUnit(gout.getPixel(33, 31)[0] == 255);
+      assertUnit(gout.getPixel(33, 32)[0] == 0);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    RENDER with one thread and with four
+    * input:   Earth, a ship, and Sputnik spread over many tiles
+    * output:  identical frame buffers
+    *********************************************/
+   void render_sameForAnyThreads()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      ogstreamRaster goutSerial(200, 150, 1);
+      ogstreamRaster goutParallel(200, 150, 4);
+      // exercise
+      for (ogstreamRaster* pGout : { &goutSerial, &goutParallel })
+      {
+         pGout->drawEarth(Position(), 0.3);
+         pGout->drawShip(Position(-60.0, 40.0), 1.0, false);
+         pGout->drawSputnik(Position(70.0, -30.0), 2.0);
+         pGout->render();
+      }
+      // verify
+      bool same = true;
+      for (int y = 0; y < 150; y++)
+         for (int x = 0; x < 200; x++)
+            for (int c = 0; c < 4; c++)
+               if (goutSerial.getPixel(x, y)[c] != goutParallel.getPixel(x, y)[c])
+                  same = false;
+      assertUnit(same);
+      assertUnit(countLit(goutSerial) > 1000);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+};
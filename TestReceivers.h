@@ -0,0 +1,246 @@
+/***********************************************************************
+ * Header File:
+ *    TEST RECEIVERS
+ * Author:
+ *    Chris Mijango & Seth Chen
+ * Summary:
+ *    Unit tests for the Receivers class
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+#include "receivers.h"
+#include "scenario.h"
+#include <vector>
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+/*******************************
+ * TEST RECEIVERS
+ * A friend class for Receivers which contains its unit tests
+ ********************************/
+class TestReceivers : public UnitTest
+{
+public:
+   void run()
+   {
+      getNormal_bellCurve();
+      solve_hidden();
+      solve_exact();
+      solve_tooFew();
+      solve_dop();
+      solve_constellation();
+      solve_threads();
+
+      report("Receivers");
+   }
+
+private:
+   // Sitting still here
+   Integrator::State getStill(double x, double y) const
+   {
+      return { x, y, 0.0, 0.0 };
+   }
+
+   // The GPS constellation, where it starts
+   std::vector<Integrator::State> getConstellation() const
+   {
+      Scenario scenario(1);
+      scenario.addMEO(24);
+      std::vector<Integrator::State> satellites;
+      for (const Scenario::Object& object : scenario.getObjects())
+         satellites.push_back(object.state);
+      return satellites;
+   }
+
+   /*********************************************
+    * name:    GET NORMAL for many counters
+    * input:   100,000 of them
+    * output:  a mean of about 0 and a standard deviation of about 1
+    *********************************************/
+   void getNormal_bellCurve()
+   {
+      // setup
+      Receivers receivers(0.0, 1, 7);
+      double sum = 0.0;
+      double sumSquared = 0.0;
+      const int count = 100000;
+      // exercise
+      for (int i = 0; i < count; i++)
+      {
+         double value = receivers.getNormal(i);
+         sum += value;
+         sumSquared += value * value;
+      }
+      // verify
+      double mean = sum / count;
+      assertUnit(fabs(mean) < 0.01);
+      assertUnit(fabs(sqrt(sumSquared / count - mean * mean) - 1.0) < 0.01);
+      assertUnit(receivers.getNormal(5) == receivers.getNormal(5));
+   }  // teardown
+
+   /*********************************************
+    * name:    SOLVE on the ground with the Earth in the way
+    * input:   a receiver on +x, and satellites out on +x, -x, and +y
+    * output:  only the one on +x is in sight, so no fix
+    *********************************************/
+   void solve_hidden()
+   {
+      // setup
+      double r = Integrator::EARTH_RADIUS;
+      Receivers receivers(0.0, 1);
+      receivers.add(getStill(r, 0.0), true /*isGround*/, 0.0);
+      std::vector<Integrator::State> satellites = { getStill(2.0 * r, 0.0),
+                                                    getStill(-2.0 * r, 0.0),
+                                                    getStill(0.0, 2.0 * r) };
+      // exercise
+      receivers.solve(0.0, satellites);
+      // verify
+      assertUnit(receivers.getFix(0).numVisible == 1);
+      assertUnit(!receivers.getFix(0).isFixed);
+      assertUnit(receivers.weights[0] == 1.0);
+      assertUnit(receivers.weights[receivers.stride] == 0.0);
+      assertUnit(receivers.weights[2 * receivers.stride] == 0.0);
+   }  // teardown
+
+   /*********************************************
+    * name:    SOLVE with four satellites and no noise
+    * input:   a receiver on +x with its clock 30 km off, and four
+    *          satellites 26,560 km out spread across its sky
+    * output:  exactly where it is, and its clock
+    *********************************************/
+   void solve_exact()
+   {
+      // setup
+      double r = Integrator::EARTH_RADIUS;
+      double radius = 26560000.0;
+      Receivers receivers(0.0, 1);
+      receivers.add(getStill(r, 0.0), true /*isGround*/, 30000.0);
+      std::vector<Integrator::State> satellites;
+      for (double degrees : { -40.0, -15.0, 15.0, 40.0 })
+         satellites.push_back(getStill(radius * cos(degrees * M_PI / 180.0),
+                                       radius * sin(degrees * M_PI / 180.0)));
+      // exercise
+      receivers.solve(0.0, satellites);
+      // verify
+      const Receivers::Fix& fix = receivers.getFix(0);
+      assertUnit(fix.numVisible == 4);
+      assertUnit(fix.isFixed);
+      assertUnit(fix.error < 0.001);
+      assertEquals(fix.bias, 30000.0);
+      assertUnit(fix.pdop > 1.0);
+   }  // teardown
+
+   /*********************************************
+    * name:    SOLVE with two satellites in sight
+    * input:   a receiver on +x and two satellites above it
+    * output:  no fix, and it has not wandered off to infinity
+    *********************************************/
+   void solve_tooFew()
+   {
+      // setup
+      double r = Integrator::EARTH_RADIUS;
+      Receivers receivers(0.0, 1);
+      receivers.add(getStill(r, 0.0), true /*isGround*/, 0.0);
+      std::vector<Integrator::State> satellites = { getStill(4.0 * r, r),
+                                                    getStill(4.0 * r, -r) };
+      // exercise
+      receivers.solve(0.0, satellites);
+      // verify
+      const Receivers::Fix& fix = receivers.getFix(0);
+      assertUnit(fix.numVisible == 2);
+      assertUnit(!fix.isFixed);
+      assertUnit(fix.pdop == 0.0);
+      assertUnit(std::isfinite(fix.x) && std::isfinite(fix.y));
+   }  // teardown
+
+   /*********************************************
+    * name:    SOLVE with satellites square round the receiver
+    * input:   a receiver 40,000 km out on +y, and satellites 10,000 km
+    *          from it on each side. The ground is no place to start from
+    *          out there, so it starts a kilometer off
+    * output:  H'H is diagonal, 2, 2, and 4, so PDOP is 1, TDOP is 1/2,
+    *          and GDOP is the root of 5/4
+    *********************************************/
+   void solve_dop()
+   {
+      // setup
+      Receivers receivers(0.0, 1);
+      receivers.add(getStill(0.0, 40000000.0), true /*isGround*/, 0.0);
+      receivers.estimateX[0] = 1000.0;
+      receivers.estimateY[0] = 40001000.0;
+      receivers.fixes[0].isFixed = true;
+      std::vector<Integrator::State> satellites = { getStill(10000000.0, 40000000.0),
+                                                    getStill(-10000000.0, 40000000.0),
+                                                    getStill(0.0, 50000000.0),
+                                                    getStill(0.0, 30000000.0) };
+      // exercise
+      receivers.solve(0.0, satellites);
+      // verify
+      const Receivers::Fix& fix = receivers.getFix(0);
+      assertUnit(fix.isFixed);
+      assertEquals(fix.pdop, 1.0);
+      assertEquals(fix.tdop, 0.5);
+      assertEquals(fix.gdop, sqrt(1.25));
+   }  // teardown
+
+   /*********************************************
+    * name:    SOLVE on the ground and in orbit under the GPS constellation
+    * input:   100 on the ground and 100 at 550 km, an hour after they
+    *          were added, twice, with no noise
+    * output:  every one fixed, exactly, the second time from the first
+    *********************************************/
+   void solve_constellation()
+   {
+      // setup
+      Receivers receivers(0.0, 1);
+      receivers.addGround(100);
+      receivers.addOrbit(100, 550000.0);
+      std::vector<Integrator::State> satellites = getConstellation();
+      // exercise
+      receivers.solve(3600.0, satellites);
+      Receivers::Summary first = receivers.getSummary();
+      receivers.solve(3601.0, satellites);
+      Receivers::Summary second = receivers.getSummary();
+      // verify
+      assertUnit(first.numFixed == 200);
+      assertUnit(first.maxError < 0.001);
+      assertUnit(second.numFixed == 200);
+      assertUnit(second.maxError < 0.001);
+      assertUnit(first.meanVisible >= 3.0);
+   }  // teardown
+
+   /*********************************************
+    * name:    SOLVE with noise on one thread and on four
+    * input:   3000 receivers, 5 m of noise, twice
+    * output:  the very same fixes, a few meters off
+    *********************************************/
+   void solve_threads()
+   {
+      // setup
+      Receivers one(5.0, 1);
+      Receivers four(5.0, 4);
+      one.addGround(1500);
+      one.addOrbit(1500, 550000.0);
+      four.addGround(1500);
+      four.addOrbit(1500, 550000.0);
+      std::vector<Integrator::State> satellites = getConstellation();
+      // exercise
+      for (double seconds : { 0.0, 1.0 })
+      {
+         one.solve(seconds, satellites);
+         four.solve(seconds, satellites);
+      }
+      // verify
+      bool isSame = one.size() == four.size();
+      for (size_t i = 0; isSame && i < one.size(); i++)
+         isSame = one.getFix(i).x == four.getFix(i).x &&
+                  one.getFix(i).y == four.getFix(i).y &&
+                  one.getFix(i).isFixed == four.getFix(i).isFixed;
+      assertUnit(isSame);
+      Receivers::Summary summary = one.getSummary();
+      assertUnit(summary.numFixed == 3000);
+      assertUnit(summary.rmsError > 1.0 && summary.rmsError < 20.0);
+   }  // teardown
+};
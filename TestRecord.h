@@ -0,0 +1,425 @@
+/***********************************************************************
+ * Header File:
+ *    TEST RECORD
+ * Author:
+ *    Chris Mijango & Seth Chen
+ * Summary:
+ *    Unit tests for the recording graphics stream
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+#include "uiRecord.h"
+#include "uiRaster.h"
+#include "position.h"
+#include <filesystem>   // for a scratch file
+#include <cstdio>       // for remove()
+#include <cstring>      // for memcpy()
+
+/*******************************
+ * TEST RECORD
+ * A friend class for ogstreamRecord which contains its unit tests
+ ********************************/
+class TestRecord : public UnitTest
+{
+public:
+   void run()
+   {
+      construct_empty();
+      drawSputnik_oneCommand();
+      drawSputnik_zoomOnce();
+      clear_empty();
+      replay_sameCommands();
+      replay_sameAsDirect();
+      replay_restoresZoom();
+      replay_text();
+      replay_blendHalfway();
+      replay_blendShortWay();
+      replay_blendDifferentShape();
+      save_load();
+      load_missing();
+      load_badSize();
+
+      report("Record");
+   }
+
+private:
+   // Draw a little of everything
+   void drawScene(ogstream& gout) const
+   {
+      gout.setView(Position(5.0, -5.0));
+      gout.drawEarth(Position(), 0.3);
+      gout.drawGPS(Position(-60.0, 40.0), 1.0);
+      gout.drawHubbleLeft(Position(60.0, 40.0), 0.5, Position(3.0, 1.0));
+      gout.drawShip(Position(-40.0, -40.0), 2.0, false);  // the flame is random
+      gout.drawStar(Position(50.0, -50.0), 200);
+      gout.drawHeat(Position(0.0, 60.0), 8.0, 0.75);
+   }
+
+   // pull a double back out of a command buffer
+   double getDouble(const ogstreamRecord& gout, size_t offset) const
+   {
+      double value;
+      memcpy(&value, &gout.getBuffer()[offset], sizeof(value));
+      return value;
+   }
+
+   // are two frame buffers the same?
+   bool isSame(const ogstreamRaster& lhs, const ogstreamRaster& rhs) const
+   {
+      for (int y = 0; y < lhs.getHeight(); y++)
+         for (int x = 0; x < lhs.getWidth(); x++)
+            for (int c = 0; c < 4; c++)
+               if (lhs.getPixel(x, y)[c] != rhs.getPixel(x, y)[c])
+                  return false;
+      return true;
+   }
+
+   /*********************************************
+    * name:    CONSTRUCTOR
+    * input:   nothing
+    * output:  no commands
+    *********************************************/
+   void construct_empty()
+   {
+      // exercise
+      ogstreamRecord gout;
+      // verify
+      assertUnit(gout.getNumCommands() == 0);
+      assertUnit(gout.getBuffer().empty());
+   }  // teardown
+
+   /*********************************************
+    * name:    DRAW SPUTNIK
+    * input:   one Sputnik
+    * output:  a zoom command, then a Sputnik command with a center and rotation
+    *********************************************/
+   void drawSputnik_oneCommand()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      ogstreamRecord gout;
+      // exercise
+      gout.drawSputnik(Position(10.0, 20.0), 0.5);
+      // verify
+      assertUnit(gout.getNumCommands() == 1);
+      assertUnit(gout.getBuffer().size() == (1 + 8) + (1 + 8 + 8 + 8));
+      assertUnit(gout.getBuffer()[0] == ogstreamRecord::ZOOM);
+      assertUnit(gout.getBuffer()[9] == ogstreamRecord::SPUTNIK);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    DRAW SPUTNIK twice at the same zoom
+    * input:   two Sputniks
+    * output:  only one zoom command
+    *********************************************/
+   void drawSputnik_zoomOnce()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      ogstreamRecord gout;
+      // exercise
+      gout.drawSputnik(Position(10.0, 20.0), 0.5);
+      gout.drawSputnik(Position(30.0, 40.0), 0.5);
+      // verify
+      assertUnit(gout.getNumCommands() == 2);
+      assertUnit(gout.getBuffer().size() == (1 + 8) + 2 * (1 + 8 + 8 + 8));
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    CLEAR
+    * input:   a recorded Sputnik
+    * output:  nothing recorded
+    *********************************************/
+   void clear_empty()
+   {
+      // setup
+      ogstreamRecord gout;
+      gout.drawSputnik(Position(10.0, 20.0), 0.5);
+      // exercise
+      gout.clear();
+      // verify
+      assertUnit(gout.getNumCommands() == 0);
+      assertUnit(gout.getBuffer().empty());
+      assertUnit(gout.zoom == 0.0);
+   }  // teardown
+
+   /*********************************************
+    * name:    REPLAY into another recording
+    * input:   a scene
+    * output:  the exact same command buffer
+    *********************************************/
+   void replay_sameCommands()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      ogstreamRecord goutFirst;
+      ogstreamRecord goutSecond;
+      drawScene(goutFirst);
+      // exercise
+      goutFirst.replay(goutSecond);
+      // verify
+      assertUnit(goutFirst.getNumCommands() == 7);
+      assertUnit(goutSecond.getNumCommands() == 7);
+      assertUnit(goutFirst.getBuffer() == goutSecond.getBuffer());
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    REPLAY into a raster
+    * input:   a scene drawn directly, and the same scene replayed
+    * output:  identical frame buffers
+    *********************************************/
+   void replay_sameAsDirect()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      ogstreamRaster goutDirect(200, 150, 1);
+      ogstreamRaster goutReplay(200, 150, 1);
+      ogstreamRecord goutRecord;
+      drawScene(goutDirect);
+      drawScene(goutRecord);
+      // exercise
+      goutRecord.replay(goutReplay);
+      goutDirect.render();
+      goutReplay.render();
+      // verify
+      assertUnit(isSame(goutDirect, goutReplay));
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    REPLAY at a different zoom
+    * input:   recorded at 1 meter per pixel, replayed at 5
+    * output:  drawn at 1 meter per pixel, zoom still 5 afterwards
+    *********************************************/
+   void replay_restoresZoom()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      ogstreamRaster goutDirect(200, 150, 1);
+      ogstreamRaster goutReplay(200, 150, 1);
+      ogstreamRecord goutRecord;
+      drawScene(goutDirect);
+      drawScene(goutRecord);
+      goutDirect.render();
+      ptZoom.setZoom(5.0);
+      // exercise
+      goutRecord.replay(goutReplay);
+      // verify
+      assertEquals(ptZoom.getZoom(), 5.0);
+      ptZoom.setZoom(1.0);
+      goutReplay.render();
+      assertUnit(isSame(goutDirect, goutReplay));
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    REPLAY text
+    * input:   two lines of text
+    * output:  two text commands, drawn just like the original
+    *********************************************/
+   void replay_text()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      ogstreamRaster goutDirect(100, 60, 1);
+      ogstreamRaster goutReplay(100, 60, 1);
+      ogstreamRecord goutRecord;
+      goutDirect.setPosition(Position(-40.0, 10.0));
+      goutDirect << "Orbit\nV2";
+      goutRecord.setPosition(Position(-40.0, 10.0));
+      goutRecord << "Orbit\nV2";
+      goutRecord.flush();
+      // exercise
+      goutRecord.replay(goutReplay);
+      goutDirect.render();
+      goutReplay.render();
+      // verify
+      assertUnit(goutRecord.getNumCommands() == 2);
+      assertUnit(isSame(goutDirect, goutReplay));
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    SAVE and LOAD
+    * input:   a scene saved to a scratch file
+    * output:  the same buffer and command count come back
+    *********************************************/
+   void save_load()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      std::string fileName =
+         (std::filesystem::temp_directory_path() / "orbitTestRecord.ogsr").string();
+      ogstreamRecord goutSave;
+      ogstreamRecord goutLoad;
+      drawScene(goutSave);
+      goutLoad.drawSputnik(Position(), 0.0);
+      // exercise
+      bool saved = goutSave.save(fileName.c_str());
+      bool loaded = goutLoad.load(fileName.c_str());
+      // verify
+      assertUnit(saved);
+      assertUnit(loaded);
+      assertUnit(goutLoad.getNumCommands() == goutSave.getNumCommands());
+      assertUnit(goutLoad.getBuffer() == goutSave.getBuffer());
+      // teardown
+      remove(fileName.c_str());
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    LOAD a file that is not there
+    * input:   a bogus file name
+    * output:  false, nothing recorded
+    *********************************************/
+   void load_missing()
+   {
+      // setup
+      ogstreamRecord gout;
+      // exercise
+      bool loaded = gout.load("/no/such/directory/orbit.ogsr");
+      // verify
+      assertUnit(!loaded);
+      assertUnit(gout.getNumCommands() == 0);
+   }  // teardown
+
+   /*********************************************
+    * name:    LOAD a file claiming more than it holds
+    * input:   a saved scene with its size changed to an exabyte
+    * output:  false, nothing recorded, and no attempt to allocate it
+    *********************************************/
+   void load_badSize()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      std::string fileName =
+         (std::filesystem::temp_directory_path() / "orbitTestRecordBad.ogsr").string();
+      ogstreamRecord goutSave;
+      ogstreamRecord goutLoad;
+      drawScene(goutSave);
+      goutSave.save(fileName.c_str());
+      std::vector<char> bytes(std::filesystem::file_size(fileName));
+      FILE* file = fopen(fileName.c_str(), "rb");
+      fread(bytes.data(), bytes.size(), 1, file);
+      fclose(file);
+      unsigned long long size = 1ull << 60;
+      memcpy(&bytes[bytes.size() - goutSave.getBuffer().size() - sizeof(size)], &size, sizeof(size));
+      file = fopen(fileName.c_str(), "wb");
+      fwrite(bytes.data(), bytes.size(), 1, file);
+      fclose(file);
+      goutLoad.drawSputnik(Position(), 0.0);
+      // exercise
+      bool loaded = goutLoad.load(fileName.c_str());
+      // verify
+      assertUnit(!loaded);
+      assertUnit(goutLoad.getNumCommands() == 0);
+      // teardown
+      remove(fileName.c_str());
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    REPLAY halfway between two frames
+    * input:   Sputnik at (0, 0) rotated 0.0, then at (10, 20) rotated 1.0
+    * output:  Sputnik at (5, 10) rotated 0.5
+    *********************************************/
+   void replay_blendHalfway()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      ogstreamRecord goutPrevious;
+      ogstreamRecord goutLatest;
+      ogstreamRecord goutBlend;
+      goutPrevious.drawSputnik(Position(0.0, 0.0), 0.0);
+      goutLatest.drawSputnik(Position(10.0, 20.0), 1.0);
+      // exercise
+      goutLatest.replay(goutBlend, goutPrevious, 0.5);
+      // verify
+      assertUnit(goutLatest.isSameShape(goutPrevious));
+      assertUnit(goutBlend.getNumCommands() == 1);
+      assertEquals(getDouble(goutBlend, 10), 5.0);    // x
+      assertEquals(getDouble(goutBlend, 18), 10.0);   // y
+      assertEquals(getDouble(goutBlend, 26), 0.5);    // rotation
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    REPLAY blending across a full turn
+    * input:   rotated 6.2 radians, then 0.1 radians
+    * output:  halfway the short way round, 6.2916, not 3.15
+    *********************************************/
+   void replay_blendShortWay()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      ogstreamRecord goutPrevious;
+      ogstreamRecord goutLatest;
+      ogstreamRecord goutBlend;
+      goutPrevious.drawSputnik(Position(), 6.2);
+      goutLatest.drawSputnik(Position(), 0.1);
+      // exercise
+      goutLatest.replay(goutBlend, goutPrevious, 0.5);
+      // verify
+      assertEquals(getDouble(goutBlend, 26), 6.2916);
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+
+   /*********************************************
+    * name:    REPLAY blending when something appeared
+    * input:   one Sputnik, then two
+    * output:  no blending, just the latest
+    *********************************************/
+   void replay_blendDifferentShape()
+   {
+      // setup
+      Position ptZoom;
+      double zoom = ptZoom.getZoom();
+      ptZoom.setZoom(1.0);
+      ogstreamRecord goutPrevious;
+      ogstreamRecord goutLatest;
+      ogstreamRecord goutBlend;
+      goutPrevious.drawSputnik(Position(0.0, 0.0), 0.0);
+      goutLatest.drawSputnik(Position(10.0, 20.0), 1.0);
+      goutLatest.drawSputnik(Position(30.0, 40.0), 1.0);
+      // exercise
+      goutLatest.replay(goutBlend, goutPrevious, 0.5);
+      // verify
+      assertUnit(!goutLatest.isSameShape(goutPrevious));
+      assertUnit(goutBlend.getBuffer() == goutLatest.getBuffer());
+      // teardown
+      ptZoom.setZoom(zoom);
+   }
+};
@@ -39,6 +39,11 @@ public:
         move_upNorth();
         move_upEast();
         move_rightNorth();
+        move_longSubsteps();
+        move_longStaysInOrbit();
+
+        setTimeWarp_positive();
+        setTimeWarp_ignoresZero();
 
         report("Satellite");
     }
@@ -400,5 +405,67 @@ private:
         assertEquals(s.dead, false);
         assertEquals(s.radius, 0.0);
     }
-};
 
+    // A long move goes the same way as short moves one after the other,
+    // but only spins and ages once
+    void move_longSubsteps()
+    {  // Setup
+        Satellite s1;
+        s1.pos.x = 0.0;
+        s1.pos.y = 26560000.0;
+        s1.velocity.dx = -3880.0;
+        s1.velocity.dy = 0.0;
+        s1.angularVelocity = 0.5;
+        Satellite s2(s1);
+        // Exercise
+        s1.move(2.0 * Satellite::MAX_STEP);
+        s2.move(Satellite::MAX_STEP);
+        s2.move(Satellite::MAX_STEP);
+        // Verify
+        assertEquals(s1.pos.x, s2.pos.x);
+        assertEquals(s1.pos.y, s2.pos.y);
+        assertEquals(s1.velocity.dx, s2.velocity.dx);
+        assertEquals(s1.velocity.dy, s2.velocity.dy);
+        assertEquals(s1.angle.radians, 0.5);                        // one spin
+        assertEquals(s1.age, 1);                                    // one tick older
+    }
+
+    // Half a day in ten big moves still leaves us in a circular orbit
+    void move_longStaysInOrbit()
+    {  // Setup
+        Satellite s;
+        s.pos.x = 0.0;
+        s.pos.y = 26560000.0;      // GPS altitude
+        s.velocity.dx = -3875.53;  // circular orbit there
+        s.velocity.dy = 0.0;
+        // Exercise
+        for (int i = 0; i < 10; i++)
+            s.move(4800.0);
+        // Verify
+        double radius = sqrt(s.pos.x * s.pos.x + s.pos.y * s.pos.y);
+        assertEqualsTolerance(26560000.0, radius, 26560000.0 * 0.01);
+    }
+
+    // Warp changes for everybody
+    void setTimeWarp_positive()
+    {  // Setup
+        double warp = Satellite::getTimeWarp();
+        // Exercise
+        Satellite::setTimeWarp(10000.0);
+        // Verify
+        assertEquals(Satellite::getTimeWarp(), 10000.0);
+        // Teardown
+        Satellite::setTimeWarp(warp);
+    }
+
+    // Time does not stop or run backwards
+    void setTimeWarp_ignoresZero()
+    {  // Setup
+        double warp = Satellite::getTimeWarp();
+        // Exercise
+        Satellite::setTimeWarp(0.0);
+        Satellite::setTimeWarp(-48.0);
+        // Verify
+        assertEquals(Satellite::getTimeWarp(), warp);
+    }
+};
@@ -0,0 +1,250 @@
+/***********************************************************************
+ * Header File:
+ *    TEST SCENARIO
+ * Author:
+ *    Chris Mijango & Seth Chen
+ * Summary:
+ *    Unit tests for the Scenario class
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+#include "scenario.h"
+#include "Starlink.h"
+#include "GPS.h"
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+/*******************************
+ * TEST SCENARIO
+ * A friend class for Scenario which contains its unit tests
+ ********************************/
+class TestScenario : public UnitTest
+{
+public:
+   void run()
+   {
+      addWalker_planes();
+      addWalker_phasing();
+      addMEO_evenlySpaced();
+      addDebris_spread();
+      addMix_sizes();
+      add_sameSeedSameSky();
+      add_unknownName();
+      create_kinds();
+
+      report("Scenario");
+   }
+
+private:
+   double getRadius(const Integrator::State& state)
+   {
+      return sqrt(state.x * state.x + state.y * state.y);
+   }
+
+   /*********************************************
+    * name:    ADD WALKER with planes that do not divide evenly
+    * input:   10 satellites in 3 planes at 550 km, 2 km apart
+    * output:  4, 3, and 3 satellites on circles 550, 552, and 554 km up
+    *********************************************/
+   void addWalker_planes()
+   {
+      // setup
+      Scenario scenario;
+      // exercise
+      scenario.addWalker(10, 3, 1, 550000.0);
+      // verify
+      assertUnit(scenario.size() == 10);
+      const std::vector<Scenario::Object>& objects = scenario.getObjects();
+      double radius = Integrator::EARTH_RADIUS + 550000.0;
+      assertEquals(getRadius(objects[0].state), radius);
+      assertEquals(getRadius(objects[3].state), radius);
+      assertEquals(getRadius(objects[4].state), radius + 2000.0);
+      assertEquals(getRadius(objects[7].state), radius + 4000.0);
+      assertEquals(getRadius(objects[9].state), radius + 4000.0);
+      assertUnit(objects[9].kind == Scenario::WALKER);
+      // going round the right way at the right speed
+      assertEquals(Integrator::getAngularMomentum(objects[0].state),
+                   sqrt(Integrator::MU * radius));
+   }  // teardown
+
+   /*********************************************
+    * name:    ADD WALKER phasing between planes
+    * input:   12 satellites in 2 planes, phasing 3
+    * output:  the first of plane 1 is 3/12 of a turn past plane 0's
+    *********************************************/
+   void addWalker_phasing()
+   {
+      // setup
+      Scenario scenario;
+      // exercise
+      scenario.addWalker(12, 2, 3, 550000.0);
+      // verify
+      const std::vector<Scenario::Object>& objects = scenario.getObjects();
+      double first = atan2(objects[0].state.y, objects[0].state.x);
+      double second = atan2(objects[1].state.y, objects[1].state.x);
+      double plane = atan2(objects[6].state.y, objects[6].state.x);
+      assertEquals(remainder(second - first, 2.0 * M_PI), 2.0 * M_PI / 6.0);
+      assertEquals(remainder(plane - first, 2.0 * M_PI), 2.0 * M_PI * 3.0 / 12.0);
+   }  // teardown
+
+   /*********************************************
+    * name:    ADD MEO
+    * input:   6 satellites
+    * output:  all on the GPS orbit, 60 degrees apart
+    *********************************************/
+   void addMEO_evenlySpaced()
+   {
+      // setup
+      Scenario scenario;
+      // exercise
+      scenario.addMEO(6);
+      // verify
+      const std::vector<Scenario::Object>& objects = scenario.getObjects();
+      assertUnit(scenario.size() == 6);
+      for (const Scenario::Object& object : objects)
+      {
+         assertUnit(object.kind == Scenario::MEO);
+         assertEquals(getRadius(object.state), Integrator::EARTH_RADIUS + 20180000.0);
+      }
+      double first = atan2(objects[0].state.y, objects[0].state.x);
+      double second = atan2(objects[1].state.y, objects[1].state.x);
+      assertEquals(remainder(second - first, 2.0 * M_PI), M_PI / 3.0);
+   }  // teardown
+
+   /*********************************************
+    * name:    ADD DEBRIS
+    * input:   20000 pieces, 10 km and 50 m/s spread
+    * output:  centered on the breakup, spread about that much
+    *********************************************/
+   void addDebris_spread()
+   {
+      // setup
+      Scenario scenario(7);
+      Integrator::State center = Scenario::getCircle(7000000.0, 0.0);
+      // exercise
+      scenario.addDebris(20000, center, 10000.0, 50.0);
+      // verify
+      double sumX = 0.0;
+      double sumXX = 0.0;
+      double sumDY = 0.0;
+      double sumDYDY = 0.0;
+      for (const Scenario::Object& object : scenario.getObjects())
+      {
+         double x = object.state.x - center.x;
+         double dy = object.state.dy - center.dy;
+         sumX += x;
+         sumXX += x * x;
+         sumDY += dy;
+         sumDYDY += dy * dy;
+      }
+      double n = (double)scenario.size();
+      assertUnit(scenario.getObjects()[0].kind == Scenario::DEBRIS);
+      assertUnit(fabs(sumX / n) < 300.0);
+      assertUnit(fabs(sqrt(sumXX / n) - 10000.0) < 300.0);
+      assertUnit(fabs(sumDY / n) < 1.5);
+      assertUnit(fabs(sqrt(sumDYDY / n) - 50.0) < 1.5);
+   }  // teardown
+
+   /*********************************************
+    * name:    ADD MIX of every size
+    * input:   10, 1000, and 12345 objects
+    * output:  exactly that many, six tenths Starlink, a tenth GPS
+    *********************************************/
+   void addMix_sizes()
+   {
+      // exercise and verify
+      for (int total : { 10, 1000, 12345 })
+      {
+         Scenario scenario;
+         scenario.addMix(total);
+         int counts[3] = { 0, 0, 0 };
+         for (const Scenario::Object& object : scenario.getObjects())
+            counts[object.kind]++;
+         assertUnit(scenario.size() == (size_t)total);
+         assertUnit(counts[Scenario::WALKER] == total * 6 / 10);
+         assertUnit(counts[Scenario::MEO] == total / 10);
+      }
+   }  // teardown
+
+   /*********************************************
+    * name:    ADD the same way twice
+    * input:   two mixes with seed 42 and one with seed 43
+    * output:  the first two match exactly, the third does not
+    *********************************************/
+   void add_sameSeedSameSky()
+   {
+      // setup
+      Scenario first(42);
+      Scenario second(42);
+      Scenario other(43);
+      // exercise
+      first.add("mix", 500);
+      second.add("mix", 500);
+      other.add("mix", 500);
+      // verify
+      bool isSame = true;
+      bool isOther = true;
+      for (size_t i = 0; i < first.size(); i++)
+      {
+         const Integrator::State& lhs = first.getObjects()[i].state;
+         const Integrator::State& rhs = second.getObjects()[i].state;
+         const Integrator::State& far = other.getObjects()[i].state;
+         isSame = isSame && lhs.x == rhs.x && lhs.y == rhs.y &&
+                  lhs.dx == rhs.dx && lhs.dy == rhs.dy;
+         isOther = isOther && lhs.x == far.x && lhs.y == far.y;
+      }
+      assertUnit(isSame);
+      assertUnit(!isOther);
+   }  // teardown
+
+   /*********************************************
+    * name:    ADD something we do not know how to make
+    * input:   "comets"
+    * output:  false, and nothing added
+    *********************************************/
+   void add_unknownName()
+   {
+      // setup
+      Scenario scenario;
+      // exercise
+      bool added = scenario.add("comets", 100);
+      // verify
+      assertUnit(!added);
+      assertUnit(scenario.size() == 0);
+   }  // teardown
+
+   /*********************************************
+    * name:    CREATE a satellite of each kind
+    * input:   one object of each kind
+    * output:  a Starlink, a GPS, and debris, each where it should be
+    *********************************************/
+   void create_kinds()
+   {
+      // setup
+      Integrator::State state = Scenario::getCircle(7000000.0, 1.0);
+      Scenario::Object walker = { state, Scenario::WALKER };
+      Scenario::Object meo = { state, Scenario::MEO };
+      Scenario::Object debris = { state, Scenario::DEBRIS };
+      // exercise
+      Satellite* pWalker = Scenario::create(walker);
+      Satellite* pMEO = Scenario::create(meo);
+      Satellite* pDebris = Scenario::create(debris);
+      // verify
+      assertUnit(dynamic_cast<Starlink*>(pWalker) != NULL);
+      assertUnit(dynamic_cast<GPS*>(pMEO) != NULL);
+      assertUnit(dynamic_cast<Debris*>(pDebris) != NULL);
+      assertUnit(pDebris->getRadius() == 0.0);
+      for (Satellite* pSatellite : { pWalker, pMEO, pDebris })
+      {
+         Integrator::State placed = pSatellite->getState();
+         assertUnit(placed.x == state.x && placed.y == state.y &&
+                    placed.dx == state.dx && placed.dy == state.dy);
+      }
+      // teardown
+      delete pWalker;
+      delete pMEO;
+      delete pDebris;
+   }
+};
@@ -158,6 +158,60 @@ void TestShip::input_noInput()
    assertEquals(s.age, 0);
 } // teardown
 
+/*********************************************
+ * MOVE: thrust for one tick
+ * Input:  far enough out that gravity is next to nothing, at rest,
+ *         pointing down with the engine on
+ * Output: x = 1/2 at^2 and v = at over the 48 seconds of the tick
+ *********************************************/
+void TestShip::move_thrust()
+{
+   // Setup
+   Ship s;
+   s.pos.x = 0.0;
+   s.pos.y = 1.0e11;
+   s.velocity.dy = 0.0;
+   s.setThrust(true);
+
+   // Exercise
+   s.move(1.0);
+
+   // Verify
+   assertEquals(s.velocity.dx, 0.0);
+   assertUnit(fabs(s.velocity.dy - -96.0) < 0.01);
+   assertEquals(s.pos.x, 0.0);
+   assertUnit(fabs(s.pos.y - 1.0e11 - -2304.0) < 0.01);
+   assertEquals(s.age, 1);
+}
+
+/*********************************************
+ * MOVE: the same burn at half the time warp
+ * Input:  as above, but two ticks of 24 seconds
+ * Output: just where one tick of 48 seconds goes
+ *********************************************/
+void TestShip::move_thrustAnyWarp()
+{
+   // Setup
+   Ship s;
+   s.pos.x = 0.0;
+   s.pos.y = 1.0e11;
+   s.velocity.dy = 0.0;
+   s.setThrust(true);
+   Satellite::setTimeWarp(24.0);
+
+   // Exercise
+   s.move(1.0);
+   s.move(1.0);
+
+   // Verify
+   assertUnit(fabs(s.velocity.dy - -96.0) < 0.01);
+   assertUnit(fabs(s.pos.y - 1.0e11 - -2304.0) < 0.01);
+   assertEquals(s.age, 2);
+
+   // Teardown
+   Satellite::setTimeWarp(Satellite::DEFAULT_WARP);
+}
+
 /*********************************************
  * INPUT: down once
  * Input:
@@ -172,10 +226,12 @@ void TestShip::input_downOnce()
    s.input(false, false, true, false);
    
     // Verify
+   assertEquals(s.thrust.getDDX(), 0.0);
+   assertEquals(s.thrust.getDDY(), -2.0);
    assertEquals(s.velocity.dx, 0.0);
-   assertEquals(s.velocity.dy, -2096.0);
+   assertEquals(s.velocity.dy, -2000.0);
    assertEquals(s.pos.x, -22500.0);
-   assertEquals(s.pos.y, -75852.0);
+   assertEquals(s.pos.y, 22500.0);
    assertEquals(s.angle.radians, M_PI);
    assertEquals(s.age, 0);
 } // teardown
@@ -195,10 +251,12 @@ void TestShip::input_downTenTimes()
       s.input(false, false, true, false);
    
     // Verify
+   assertEquals(s.thrust.getDDX(), 0.0);
+   assertEquals(s.thrust.getDDY(), -2.0);
    assertEquals(s.velocity.dx, 0.0);
-   assertEquals(s.velocity.dy, -2960.0);
+   assertEquals(s.velocity.dy, -2000.0);
    assertEquals(s.pos.x, -22500.0);
-   assertEquals(s.pos.y, -1168380.0);
+   assertEquals(s.pos.y, 22500.0);
    assertEquals(s.angle.radians, M_PI);
    assertEquals(s.age, 0);
 } // teardown
@@ -22,6 +22,8 @@ public:
       // move tests
       move_oneSecond();
       move_tenSeconds();
+      move_thrust();
+      move_thrustAnyWarp();
       
       // input tests
       input_noInput();
@@ -49,6 +51,8 @@ private:
    void constructor_default();
    void move_oneSecond();
    void move_tenSeconds();
+   void move_thrust();
+   void move_thrustAnyWarp();
    void input_noInput();
    void input_rightOnce();
    void input_rightTenTimes();
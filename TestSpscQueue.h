@@ -0,0 +1,192 @@
+/***********************************************************************
+ * Header File:
+ *    TEST SPSC QUEUE
+ * Author:
+ *    Chris Mijango & Seth Chen
+ * Summary:
+ *    Unit tests for the SpscQueue class
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+#include "spscQueue.h"
+#include <thread>
+
+/*******************************
+ * TEST SPSC QUEUE
+ * A friend class for SpscQueue which contains its unit tests
+ ********************************/
+class TestSpscQueue : public UnitTest
+{
+public:
+   void run()
+   {
+      construct_empty();
+      push_one();
+      pop_inOrder();
+      push_full();
+      push_keepFree();
+      push_wraps();
+      threads_inOrder();
+
+      report("SpscQueue");
+   }
+
+private:
+   /*********************************************
+    * name:    CONSTRUCTOR
+    * input:   nothing
+    * output:  empty, so nothing to peek at
+    *********************************************/
+   void construct_empty()
+   {
+      // exercise
+      SpscQueue<int, 4> queue;
+      // verify
+      assertUnit(queue.isEmpty());
+      assertUnit(queue.peek() == NULL);
+      assertUnit(queue.head == 0);
+      assertUnit(queue.tail == 0);
+   }  // teardown
+
+   /*********************************************
+    * name:    PUSH
+    * input:   push 42
+    * output:  42 at the front, still there after a second peek
+    *********************************************/
+   void push_one()
+   {
+      // setup
+      SpscQueue<int, 4> queue;
+      // exercise
+      bool pushed = queue.push(42);
+      // verify
+      assertUnit(pushed);
+      assertUnit(queue.peek() != NULL && *queue.peek() == 42);
+      assertUnit(queue.peek() != NULL && *queue.peek() == 42);
+      assertUnit(queue.tail == 1);
+      assertUnit(queue.head == 0);
+   }  // teardown
+
+   /*********************************************
+    * name:    POP
+    * input:   push 1, 2, 3 then pop twice
+    * output:  3 at the front
+    *********************************************/
+   void pop_inOrder()
+   {
+      // setup
+      SpscQueue<int, 4> queue;
+      queue.push(1);
+      queue.push(2);
+      queue.push(3);
+      // exercise
+      queue.pop();
+      queue.pop();
+      // verify
+      assertUnit(queue.peek() != NULL && *queue.peek() == 3);
+      assertUnit(queue.head == 2);
+   }  // teardown
+
+   /*********************************************
+    * name:    PUSH when full
+    * input:   four items in a queue of four, then 5
+    * output:  5 is refused and 1 is still at the front
+    *********************************************/
+   void push_full()
+   {
+      // setup
+      SpscQueue<int, 4> queue;
+      for (int i = 1; i <= 4; i++)
+         queue.push(i);
+      // exercise
+      bool pushed = queue.push(5);
+      // verify
+      assertUnit(!pushed);
+      assertUnit(*queue.peek() == 1);
+      assertUnit(queue.tail == 4);
+   }  // teardown
+
+   /*********************************************
+    * name:    PUSH keeping room for something else
+    * input:   a queue of four keeping two free, then 3 with no room kept
+    * output:  1 and 2 fit, 3 only fits when no room is kept
+    *********************************************/
+   void push_keepFree()
+   {
+      // setup
+      SpscQueue<int, 4> queue;
+      // exercise
+      bool pushed1 = queue.push(1, 2);
+      bool pushed2 = queue.push(2, 2);
+      bool pushed3Kept = queue.push(3, 2);
+      bool pushed3 = queue.push(3);
+      // verify
+      assertUnit(pushed1);
+      assertUnit(pushed2);
+      assertUnit(!pushed3Kept);
+      assertUnit(pushed3);
+      assertUnit(queue.tail == 3);
+   }  // teardown
+
+   /*********************************************
+    * name:    PUSH past the end of the ring
+    * input:   push and pop ten items through a queue of four
+    * output:  each comes out as it went in
+    *********************************************/
+   void push_wraps()
+   {
+      // setup
+      SpscQueue<int, 4> queue;
+      queue.push(0);
+      queue.push(1);
+      bool inOrder = true;
+      // exercise
+      for (int i = 2; i < 10; i++)
+      {
+         queue.push(i);
+         inOrder = inOrder && *queue.peek() == i - 2;
+         queue.pop();
+      }
+      // verify
+      assertUnit(inOrder);
+      assertUnit(*queue.peek() == 8);
+      assertUnit(queue.tail == 10);
+   }  // teardown
+
+   /*********************************************
+    * name:    PRODUCER AND CONSUMER on two threads
+    * input:   one thread pushes 0 to 99999, this one pops
+    * output:  everything arrives, once and in order
+    *********************************************/
+   void threads_inOrder()
+   {
+      // setup
+      SpscQueue<int, 64> queue;
+      const int COUNT = 100000;
+      // exercise
+      std::thread producer([&queue]()
+      {
+         for (int i = 0; i < COUNT; i++)
+            while (!queue.push(i))
+               std::this_thread::yield();
+      });
+      bool inOrder = true;
+      for (int expected = 0; expected < COUNT; )
+      {
+         const int* pItem = queue.peek();
+         if (!pItem)
+         {
+            std::this_thread::yield();
+            continue;
+         }
+         inOrder = inOrder && *pItem == expected++;
+         queue.pop();
+      }
+      producer.join();
+      // verify
+      assertUnit(inOrder);
+      assertUnit(queue.isEmpty());
+   }  // teardown
+};
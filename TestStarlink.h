@@ -216,10 +216,12 @@ private:
 
         // Exercise - move with and without time dilation
         Starlink s2;
-        s2.timeDilation = 1.0;  // No dilation
+        double warp = Satellite::getTimeWarp();
 
         s.move(1.0);
+        Satellite::setTimeWarp(1.0);  // No dilation
         s2.move(1.0);
+        Satellite::setTimeWarp(warp);
 
         // Verify different distances traveled
         Position pos2 = s.getPosition();
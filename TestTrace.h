@@ -0,0 +1,204 @@
+/***********************************************************************
+ * Header File:
+ *    TEST TRACE
+ * Author:
+ *    Chris Mijango & Seth Chen
+ * Summary:
+ *    Unit tests for the Trace class
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+#include "trace.h"
+#include <sstream>
+#include <string>
+#include <thread>
+
+/*******************************
+ * TEST TRACE
+ * A friend class for Trace which contains its unit tests
+ ********************************/
+class TestTrace : public UnitTest
+{
+public:
+   void run()
+   {
+      record_one();
+      record_wraps();
+      record_handsBack();
+      writeJSON_scope();
+      writeJSON_threadName();
+      writeJSON_escapes();
+      writeJSON_skipsTorn();
+      clear_empty();
+
+      report("Trace");
+   }
+
+private:
+   // Everything every thread has recorded so far
+   std::string getJSON()
+   {
+      std::ostringstream sout;
+      Trace::writeJSON(sout);
+      return sout.str();
+   }
+
+   /*********************************************
+    * name:    RECORD
+    * input:   one event from 100ns to 350ns
+    * output:  this thread has a buffer with the event at the head
+    *********************************************/
+   void record_one()
+   {
+      // exercise
+      Trace::record("TestTrace::one", 100, 350);
+      // verify
+      assertUnit(Trace::pLocal != nullptr);
+      uint64_t head = Trace::pLocal->head;
+      assertUnit(head >= 1);
+      const Trace::Event& event = Trace::pLocal->events[(head - 1) & (Trace::CAPACITY - 1)];
+      assertUnit(std::string(event.name.load()) == "TestTrace::one");
+      assertUnit(event.start == 100);
+      assertUnit(event.duration == 250);
+   }  // teardown
+
+   /*********************************************
+    * name:    RECORD more than the ring holds
+    * input:   CAPACITY + 5 events
+    * output:  the newest overwrote the oldest
+    *********************************************/
+   void record_wraps()
+   {
+      // setup
+      Trace::record("TestTrace::setup", 0, 0);
+      uint64_t headBefore = Trace::pLocal->head;
+      // exercise
+      for (uint64_t i = 0; i < (uint64_t)Trace::CAPACITY + 5; i++)
+         Trace::record("TestTrace::wrap", i, i + 1);
+      // verify
+      uint64_t head = Trace::pLocal->head;
+      assertUnit(head == headBefore + Trace::CAPACITY + 5);
+      assertUnit(Trace::pLocal->events[(head - 1) & (Trace::CAPACITY - 1)].start == Trace::CAPACITY + 4);
+      assertUnit(Trace::pLocal->events[head & (Trace::CAPACITY - 1)].start == 5);
+   }  // teardown
+
+   /*********************************************
+    * name:    WRITE JSON after a scope
+    * input:   a scope named TestTrace::scope
+    * output:  a complete event by that name
+    *********************************************/
+   void writeJSON_scope()
+   {
+      // setup
+      {
+         TraceScope scope("TestTrace::scope");
+      }
+      // exercise
+      std::string json = getJSON();
+      // verify
+      assertUnit(json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[") == 0);
+      assertUnit(json.find("{\"name\":\"TestTrace::scope\",\"ph\":\"X\"") != std::string::npos);
+      assertUnit(json.find("]}") != std::string::npos);
+   }  // teardown
+
+   /*********************************************
+    * name:    RECORD on a thread after another has finished
+    * input:   two threads, one after the other, each recording an event
+    * output:  the second takes the ring the first left behind
+    *********************************************/
+   void record_handsBack()
+   {
+      // setup
+      Trace::Buffer* pFirst = nullptr;
+      Trace::Buffer* pSecond = nullptr;
+      std::thread first([&]()
+      {
+         Trace::record("TestTrace::first", 0, 1);
+         pFirst = Trace::pLocal;
+      });
+      first.join();
+      size_t numBuffers = Trace::getBuffers().size();
+      // exercise
+      std::thread second([&]()
+      {
+         Trace::record("TestTrace::second", 0, 1);
+         pSecond = Trace::pLocal;
+      });
+      second.join();
+      // verify
+      assertUnit(pFirst != nullptr);
+      assertUnit(pSecond == pFirst);
+      assertUnit(Trace::getBuffers().size() == numBuffers);
+   }  // teardown
+
+   /*********************************************
+    * name:    WRITE JSON with a named thread
+    * input:   a thread called "TestTrace thread" that records one event
+    * output:  its name comes out even though the thread is gone
+    *********************************************/
+   void writeJSON_threadName()
+   {
+      // setup
+      std::thread thread([]()
+      {
+         Trace::setThreadName("TestTrace thread");
+         Trace::record("TestTrace::thread", 0, 10);
+      });
+      thread.join();
+      // exercise
+      std::string json = getJSON();
+      // verify
+      assertUnit(json.find("\"args\":{\"name\":\"TestTrace thread\"}") != std::string::npos);
+      assertUnit(json.find("\"name\":\"TestTrace::thread\"") != std::string::npos);
+   }  // teardown
+
+   /*********************************************
+    * name:    WRITE JSON with quotes in a name
+    * input:   say "hi"
+    * output:  the quotes are escaped
+    *********************************************/
+   void writeJSON_escapes()
+   {
+      // setup
+      Trace::record("say \"hi\"", 0, 1);
+      // exercise
+      std::string json = getJSON();
+      // verify
+      assertUnit(json.find("\"name\":\"say \\\"hi\\\"\"") != std::string::npos);
+   }  // teardown
+
+   /*********************************************
+    * name:    WRITE JSON while an event is half written
+    * input:   TestTrace::torn, with its slot marked as being written
+    * output:  it is left out; the event before it is not
+    *********************************************/
+   void writeJSON_skipsTorn()
+   {
+      // setup
+      Trace::record("TestTrace::whole", 0, 1);
+      Trace::record("TestTrace::torn", 0, 1);
+      uint64_t head = Trace::pLocal->head;
+      Trace::pLocal->events[(head - 1) & (Trace::CAPACITY - 1)].sequence = 0;
+      // exercise
+      std::string json = getJSON();
+      // verify
+      assertUnit(json.find("\"name\":\"TestTrace::whole\"") != std::string::npos);
+      assertUnit(json.find("TestTrace::torn") == std::string::npos);
+   }  // teardown
+
+   /*********************************************
+    * name:    CLEAR
+    * input:   everything the tests above recorded
+    * output:  nothing left, so the tests do not clutter a real trace
+    *********************************************/
+   void clear_empty()
+   {
+      // exercise
+      Trace::clear();
+      // verify
+      assertUnit(Trace::pLocal->head == 0);
+      assertUnit(getJSON() == "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n]}\n");
+   }  // teardown
+};
@@ -0,0 +1,318 @@
+/***********************************************************************
+ * Header File:
+ *    TEST TRAJECTORY
+ * Author:
+ *    Chris Mijango & Seth Chen
+ * Summary:
+ *    Unit tests for the trajectory codec, recorder, and reader
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+#include "trajectory.h"
+#include <filesystem>   // for a scratch file
+#include <vector>
+#include <string>
+#include <limits>
+#include <cmath>        // for cos() and sin()
+#include <cstdio>       // for remove()
+#include <cstring>      // for memcmp()
+
+/*******************************
+ * TEST TRAJECTORY
+ * A friend class for the trajectory classes which contains their unit
+ * tests
+ ********************************/
+class TestTrajectory : public UnitTest
+{
+public:
+   void run()
+   {
+      codec_sameBits();
+      codec_standingStill();
+      codec_freshStart();
+      codec_cutShort();
+      recorder_notOpen();
+      recorder_readBack();
+      reader_seek();
+      reader_noIndex();
+
+      report("Trajectory");
+   }
+
+private:
+   typedef TrajectoryCodec::Sample Sample;
+
+   std::string getFileName() const
+   {
+      return (std::filesystem::temp_directory_path() / "orbitTestTrajectory.trj").string();
+   }
+
+   // So many things going round in circles, tick by tick
+   Sample getCircles(uint64_t tick, int num) const
+   {
+      Sample sample;
+      sample.clear(tick, tick * 48.0);
+      for (int i = 0; i < num; i++)
+      {
+         double radius = 7000000.0 + i * 1000.0;
+         double radians = i * 0.1 + tick * 0.001;
+         sample.add((uint8_t)(i % 20), radius * cos(radians), radius * sin(radians),
+                    -7500.0 * sin(radians), 7500.0 * cos(radians));
+      }
+      return sample;
+   }
+
+   bool isSame(const Sample& lhs, const Sample& rhs) const
+   {
+      size_t bytes = lhs.size() * sizeof(double);
+      return lhs.tick == rhs.tick && lhs.seconds == rhs.seconds &&
+             lhs.kinds == rhs.kinds && lhs.size() == rhs.size() &&
+             memcmp(lhs.x.data(), rhs.x.data(), bytes) == 0 &&
+             memcmp(lhs.y.data(), rhs.y.data(), bytes) == 0 &&
+             memcmp(lhs.dx.data(), rhs.dx.data(), bytes) == 0 &&
+             memcmp(lhs.dy.data(), rhs.dy.data(), bytes) == 0;
+   }
+
+   // What the codec gave back for a block it made
+   bool decode(TrajectoryCodec& codec, const std::vector<unsigned char>& bytes,
+               const Sample& expected, Sample& sample) const
+   {
+      sample.clear(expected.tick, expected.seconds);
+      sample.kinds.resize(expected.size());
+      return codec.decode(bytes.data(), bytes.size(), sample);
+   }
+
+   /*********************************************
+    * name:    CODEC gives back the very same bits
+    * input:   samples growing and shrinking, with zero, minus zero,
+    *          infinity, NaN, and the smallest number there is
+    * output:  every bit the same, sample after sample
+    *********************************************/
+   void codec_sameBits()
+   {
+      // setup
+      std::vector<Sample> samples;
+      for (int tick = 0; tick < 10; tick++)
+         samples.push_back(getCircles(tick, tick < 5 ? 10 + tick : 20 - tick));
+      samples[3].x[0] = -0.0;
+      samples[4].y[1] = std::numeric_limits<double>::infinity();
+      samples[5].dx[2] = std::numeric_limits<double>::quiet_NaN();
+      samples[6].dy[3] = std::numeric_limits<double>::denorm_min();
+      samples[7].x[4] = 0.0;
+      TrajectoryCodec encoder;
+      TrajectoryCodec decoder;
+      bool isGood = true;
+      // exercise
+      for (const Sample& expected : samples)
+      {
+         std::vector<unsigned char> bytes;
+         Sample sample;
+         encoder.encode(expected, bytes);
+         isGood = decode(decoder, bytes, expected, sample) && isSame(sample, expected) && isGood;
+      }
+      // verify
+      assertUnit(isGood);
+   }  // teardown
+
+   /*********************************************
+    * name:    CODEC of things that do not move
+    * input:   the same 101 rows four times
+    * output:  after three to guess from, no bytes but the nibbles
+    *********************************************/
+   void codec_standingStill()
+   {
+      // setup
+      Sample sample = getCircles(1, 101);
+      TrajectoryCodec codec;
+      std::vector<unsigned char> bytes;
+      for (int i = 0; i < 3; i++)
+         codec.encode(sample, bytes);
+      bytes.clear();
+      // exercise
+      codec.encode(sample, bytes);
+      // verify
+      assertUnit(bytes.size() == 4 * 4 + 101 + 4 * 51);
+   }  // teardown
+
+   /*********************************************
+    * name:    CODEC starts afresh every so often
+    * input:   KEY_INTERVAL samples encoded
+    * output:  a fresh start at the first and after the last, not between
+    *********************************************/
+   void codec_freshStart()
+   {
+      // setup
+      TrajectoryCodec codec;
+      std::vector<unsigned char> bytes;
+      bool isKeyFirst = codec.isKey();
+      bool isKeyBetween = false;
+      // exercise
+      for (int tick = 0; tick < TrajectoryCodec::KEY_INTERVAL; tick++)
+      {
+         codec.encode(getCircles(tick, 3), bytes);
+         if (tick < TrajectoryCodec::KEY_INTERVAL - 1)
+            isKeyBetween = isKeyBetween || codec.isKey();
+      }
+      // verify
+      assertUnit(isKeyFirst);
+      assertUnit(!isKeyBetween);
+      assertUnit(codec.isKey());
+      assertUnit(!codec.previous[0].empty());
+   }  // teardown
+
+   /*********************************************
+    * name:    CODEC given a block cut short
+    * input:   a block missing its last byte
+    * output:  false rather than reading past the end
+    *********************************************/
+   void codec_cutShort()
+   {
+      // setup
+      Sample expected = getCircles(5, 10);
+      TrajectoryCodec encoder;
+      TrajectoryCodec decoder;
+      std::vector<unsigned char> bytes;
+      encoder.encode(expected, bytes);
+      bytes.pop_back();
+      Sample sample;
+      // exercise
+      bool isDecoded = decode(decoder, bytes, expected, sample);
+      // verify
+      assertUnit(!isDecoded);
+   }  // teardown
+
+   /*********************************************
+    * name:    RECORDER before it is opened
+    * input:   nothing opened
+    * output:  never due, and closing is fine
+    *********************************************/
+   void recorder_notOpen()
+   {
+      // setup
+      TrajectoryRecorder recorder;
+      // exercise
+      TrajectoryCodec::Sample* pSample = recorder.getStageIfDue(0.0);
+      bool isClosed = recorder.close();
+      // verify
+      assertUnit(pSample == NULL);
+      assertUnit(isClosed);
+      assertUnit(!recorder.isOpen());
+   }  // teardown
+
+   /*********************************************
+    * name:    RECORDER and READER, one after the other
+    * input:   200 ticks of 50 circles, a sample every other tick
+    * output:  100 samples, two fresh starts, all read back the same
+    *********************************************/
+   void recorder_readBack()
+   {
+      // setup
+      std::string fileName = getFileName();
+      TrajectoryRecorder recorder;
+      bool isOpen = recorder.open(fileName.c_str(), 2);
+      // exercise
+      for (uint64_t tick = 0; tick < 200; tick++)
+         if (TrajectoryCodec::Sample* pSample = recorder.getStageIfDue(tick * 48.0))
+         {
+            Sample sample = getCircles(tick, 50);
+            pSample->kinds = sample.kinds;
+            pSample->x = sample.x;
+            pSample->y = sample.y;
+            pSample->dx = sample.dx;
+            pSample->dy = sample.dy;
+            recorder.submit();
+         }
+      bool isClosed = recorder.close();
+      TrajectoryReader reader;
+      bool isRead = reader.open(fileName.c_str());
+      int numSame = 0;
+      Sample sample;
+      while (reader.read(sample))
+         if (isSame(sample, getCircles(sample.tick, 50)) && sample.tick == 2 * (uint64_t)numSame)
+            numSame++;
+      // verify
+      assertUnit(isOpen);
+      assertUnit(isClosed);
+      assertUnit(isRead);
+      assertUnit(recorder.getNumSamples() == 100);
+      assertUnit(recorder.getNumStates() == 5000);
+      assertUnit(recorder.indexTicks.size() == 2);
+      assertUnit(reader.getNumSamples() == 100);
+      assertUnit(reader.getEveryTicks() == 2);
+      assertUnit(numSame == 100);
+      assertUnit(recorder.getBytes() < 5000 * 33);
+      // teardown
+      reader.close();
+      remove(fileName.c_str());
+   }
+
+   /*********************************************
+    * name:    READER going straight to a tick
+    * input:   a sample every tick for 150 ticks, then seeking to
+    *          100, 0, and 150
+    * output:  tick 100 decoded exactly from the fresh start at 64,
+    *          then tick 0, then nothing
+    *********************************************/
+   void reader_seek()
+   {
+      // setup
+      std::string fileName = getFileName();
+      TrajectoryRecorder recorder;
+      recorder.open(fileName.c_str());
+      for (uint64_t tick = 0; tick < 150; tick++)
+      {
+         TrajectoryCodec::Sample* pSample = recorder.getStageIfDue(tick * 48.0);
+         *pSample = getCircles(tick, 20);
+         recorder.submit();
+      }
+      recorder.close();
+      TrajectoryReader reader;
+      reader.open(fileName.c_str());
+      Sample sample100;
+      Sample sample0;
+      Sample sampleEnd;
+      // exercise
+      bool isSeek100 = reader.seek(100);
+      bool isRead100 = reader.read(sample100);
+      bool isSeek0 = reader.seek(0);
+      bool isRead0 = reader.read(sample0);
+      reader.seek(150);
+      bool isReadEnd = reader.read(sampleEnd);
+      // verify
+      assertUnit(isSeek100 && isRead100);
+      assertUnit(isSame(sample100, getCircles(100, 20)));
+      assertUnit(isSeek0 && isRead0);
+      assertUnit(isSame(sample0, getCircles(0, 20)));
+      assertUnit(!isReadEnd);
+      // teardown
+      reader.close();
+      remove(fileName.c_str());
+   }
+
+   /*********************************************
+    * name:    READER of a file never closed properly
+    * input:   a recording with its footer cut off
+    * output:  refused
+    *********************************************/
+   void reader_noIndex()
+   {
+      // setup
+      std::string fileName = getFileName();
+      TrajectoryRecorder recorder;
+      recorder.open(fileName.c_str());
+      *recorder.getStageIfDue(0.0) = getCircles(0, 5);
+      recorder.submit();
+      recorder.close();
+      std::filesystem::resize_file(fileName, std::filesystem::file_size(fileName) - 8);
+      TrajectoryReader reader;
+      // exercise
+      bool isOpen = reader.open(fileName.c_str());
+      // verify
+      assertUnit(!isOpen);
+      assertUnit(reader.getNumSamples() == 0);
+      // teardown
+      remove(fileName.c_str());
+   }
+};
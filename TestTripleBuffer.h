@@ -0,0 +1,170 @@
+/***********************************************************************
+ * Header File:
+ *    TEST TRIPLE BUFFER
+ * Author:
+ *    Chris Mijango & Seth Chen
+ * Summary:
+ *    Unit tests for the TripleBuffer class
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+#include "tripleBuffer.h"
+#include <thread>
+
+/*******************************
+ * TEST TRIPLE BUFFER
+ * A friend class for TripleBuffer which contains its unit tests
+ ********************************/
+class TestTripleBuffer : public UnitTest
+{
+public:
+   void run()
+   {
+      construct_separateSlots();
+      pickUp_nothing();
+      publish_fresh();
+      pickUp_newest();
+      publish_neverTouchesFront();
+      threads_inOrder();
+
+      report("TripleBuffer");
+   }
+
+private:
+   /*********************************************
+    * name:    CONSTRUCTOR
+    * input:   nothing
+    * output:  writer, middle, and reader each have their own slot
+    *********************************************/
+   void construct_separateSlots()
+   {
+      // exercise
+      TripleBuffer<int> buffer;
+      // verify
+      assertUnit(buffer.back != buffer.front);
+      assertUnit(buffer.back != (buffer.middle & TripleBuffer<int>::INDEX));
+      assertUnit(buffer.front != (buffer.middle & TripleBuffer<int>::INDEX));
+      assertUnit(!buffer.isFresh());
+   }  // teardown
+
+   /*********************************************
+    * name:    PICK UP with nothing published
+    * input:   a fresh buffer
+    * output:  false, front unchanged
+    *********************************************/
+   void pickUp_nothing()
+   {
+      // setup
+      TripleBuffer<int> buffer;
+      buffer.getFront() = 7;
+      // exercise
+      bool picked = buffer.pickUp();
+      // verify
+      assertUnit(!picked);
+      assertUnit(buffer.getFront() == 7);
+   }  // teardown
+
+   /*********************************************
+    * name:    PUBLISH
+    * input:   write 42 and publish
+    * output:  fresh, and the writer has a new slot
+    *********************************************/
+   void publish_fresh()
+   {
+      // setup
+      TripleBuffer<int> buffer;
+      int backOld = buffer.back;
+      buffer.getBack() = 42;
+      // exercise
+      buffer.publish();
+      // verify
+      assertUnit(buffer.isFresh());
+      assertUnit(buffer.back != backOld);
+      assertUnit(buffer.back != buffer.front);
+   }  // teardown
+
+   /*********************************************
+    * name:    PICK UP after two publishes
+    * input:   publish 1 then 2
+    * output:  the reader gets 2, and nothing is fresh after
+    *********************************************/
+   void pickUp_newest()
+   {
+      // setup
+      TripleBuffer<int> buffer;
+      buffer.getBack() = 1;
+      buffer.publish();
+      buffer.getBack() = 2;
+      buffer.publish();
+      // exercise
+      bool picked = buffer.pickUp();
+      // verify
+      assertUnit(picked);
+      assertUnit(buffer.getFront() == 2);
+      assertUnit(!buffer.isFresh());
+      assertUnit(!buffer.pickUp());
+      assertUnit(buffer.getFront() == 2);
+   }  // teardown
+
+   /*********************************************
+    * name:    PUBLISH many times while the reader holds on
+    * input:   reader picks up 5, writer publishes ten more
+    * output:  the reader still sees 5 until it picks up again
+    *********************************************/
+   void publish_neverTouchesFront()
+   {
+      // setup
+      TripleBuffer<int> buffer;
+      buffer.getBack() = 5;
+      buffer.publish();
+      buffer.pickUp();
+      // exercise
+      for (int i = 10; i < 20; i++)
+      {
+         assertUnit(buffer.back != buffer.front);
+         buffer.getBack() = i;
+         buffer.publish();
+      }
+      // verify
+      assertUnit(buffer.getFront() == 5);
+      assertUnit(buffer.pickUp());
+      assertUnit(buffer.getFront() == 19);
+   }  // teardown
+
+   /*********************************************
+    * name:    THREADS
+    * input:   a writer publishing 1 through 20,000 while a reader picks up
+    * output:  the reader never goes backwards and ends on 20,000
+    *********************************************/
+   void threads_inOrder()
+   {
+      // setup
+      TripleBuffer<int> buffer;
+      buffer.getFront() = 0;
+      const int NUM = 20000;
+      // exercise
+      std::thread writer([&buffer, NUM]()
+      {
+         for (int i = 1; i <= NUM; i++)
+         {
+            buffer.getBack() = i;
+            buffer.publish();
+         }
+      });
+      bool inOrder = true;
+      int last = 0;
+      while (last < NUM)
+         if (buffer.pickUp())
+         {
+            if (buffer.getFront() < last)
+               inOrder = false;
+            last = buffer.getFront();
+         }
+      writer.join();
+      // verify
+      assertUnit(inOrder);
+      assertUnit(last == NUM);
+   }  // teardown
+};
@@ -0,0 +1,1379 @@
+/***********************************************************************
+ * Source File:
+ *    BENCHMARK
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    How fast and how well the simulation runs, as a program of its own.
+ *    Build it from every source file but Simulator.cpp and testMain.cpp,
+ *    which have their own main():
+ *       g++ -std=gnu++20 -O2 $(ls *.cpp | grep -v Simulator.cpp | grep -v testMain.cpp) \
+ *           -o orbitBenchmark -lglut -lGLU -lGL -lpthread
+ *    Commands:
+ *       accuracy            every integrator and step size against Kepler
+ *          --steps <count>  how many steps each, 1000000 by default
+ *          --csv <file>     save the table
+ *       scenario            how long it takes to make up a sky
+ *          --name <name>    walker, meo, debris, or mix, mix by default
+ *          --objects <n>    how many, 1000000 by default
+ *          --seed <number>  which of them, 1 by default
+ *          --csv <file>     save where everything starts
+ *       scaling             every phase of a tick, by objects and threads
+ *          --min <n>        fewest objects, 100 by default
+ *          --max <n>        most objects, 10000000 by default
+ *          --threads <n>    most threads, all the cores by default
+ *          --seconds <s>    least time to spend timing each, 0.2 by default
+ *          --csv <file>     save every measurement
+ *          --min-efficiency <e>  fail when the most threads on the most
+ *                           objects do worse than this in any phase
+ *       trajectory          recording where everything goes, and reading it back
+ *          --objects <n>    how many, 100000 by default
+ *          --samples <n>    how many samples, 100 by default
+ *          --every <ticks>  ticks between samples, 1 by default
+ *          --file <file>    where to record, trajectory.trj by default
+ *          --min-throughput <states/s>  fail when the writer is slower
+ *       catalog             reading a two-line element file
+ *          --file <file>    which, or one made up in catalog.tle by default
+ *          --objects <n>    how many to make up, 30000 by default
+ *          --threads <n>    most threads, all the cores by default
+ *       ephemeris           fitting orbits and asking where things were
+ *          --objects <n>    how many, 10000 by default
+ *          --hours <h>      how long a span, 6 by default
+ *          --step <s>       seconds between samples, 48 by default
+ *          --queries <n>    how many to ask, 1000000 by default
+ *          --trajectory <file>  fit a recording instead of propagating
+ *          --threads <n>    how many threads, all the cores by default
+ *       conjunction         screening every pair for close approaches
+ *          --objects <n>    how many, 10000 by default
+ *          --hours <h>      how far ahead, 24 by default
+ *          --distance <m>   how close counts, 10000 by default
+ *          --threads <n>    most threads, all the cores by default
+ *       gps                 receivers working out where they are
+ *          --receivers <n>  how many, half on the ground, 10000 by default
+ *          --satellites <n> GPS satellites, 24 by default
+ *          --noise <m>      range error, 5 by default
+ *          --threads <n>    most threads, all the cores by default
+ *       links               laser links across Starlink, and routes over them
+ *          --satellites <n> how many, 40000 by default
+ *          --range <m>      how far a link reaches, 20000 by default
+ *          --routes <n>     how many routes, 8 by default
+ *          --step <s>       seconds between ticks, 10 by default
+ *          --threads <n>    how many threads, all the cores by default
+ ************************************************************************/
+
+#include "integrator.h"
+#include "Satellite.h"
+#include "Sputnik.h"
+#include "GPS.h"
+#include "Starlink.h"
+#include "Hubble.h"
+#include "CrewDragon.h"
+#include "scenario.h"
+#include "broadPhase.h"
+#include "phases.h"
+#include "uiInteract.h"
+#include "camera.h"
+#include "heatmap.h"
+#include "parallel.h"
+#include "trajectory.h"
+#include "catalog.h"
+#include "ephemeris.h"
+#include "conjunction.h"
+#include "receivers.h"
+#include "linkGraph.h"
+#include <iostream>  // for COUT
+#include <iomanip>   // for SETW
+#include <fstream>   // for OFSTREAM
+#include <string>
+#include <vector>
+#include <list>
+#include <atomic>
+#include <new>       // for bad_alloc
+#include <chrono>    // for steady_clock
+#include <random>    // for mt19937_64
+#include <cmath>     // for fabs() and sqrt()
+#include <cstring>   // for strcmp()
+#include <cstdlib>   // for atol(), strtoull(), malloc(), and free()
+#include <cstdio>    // for remove() and snprintf()
+#if defined(_WIN32)
+#include <malloc.h>          // for _msize()
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>   // for malloc_size()
+#else
+#include <malloc.h>          // for malloc_usable_size()
+#endif
+using namespace std;
+
+/*********************************************
+ * GET BLOCK SIZE
+ * How much malloc() really gave for a block, which is what it costs
+ *********************************************/
+static size_t getBlockSize(void* p)
+{
+#if defined(_WIN32)
+   return _msize(p);
+#elif defined(__APPLE__)
+   return malloc_size(p);
+#else
+   return malloc_usable_size(p);
+#endif
+}
+
+/*********************************************
+ * OPERATOR NEW and DELETE
+ * Count what is made and freed, so we know how much memory something
+ * takes. malloc() knows how big each block is, so nothing has to be
+ * kept alongside it. Counting is only switched on while nothing is
+ * being timed: threads adding to one counter would slow each other
+ * down. Only what is freed while counting comes off the count, so count
+ * around code that frees only what it made itself
+ *********************************************/
+static atomic<bool> isCounting(false);
+static atomic<size_t> bytesCounted(0);
+
+void* operator new(size_t size)
+{
+   void* p = malloc(size ? size : 1);
+   if (!p)
+      throw bad_alloc();
+   if (isCounting.load(memory_order_relaxed))
+      bytesCounted.fetch_add(getBlockSize(p), memory_order_relaxed);
+   return p;
+}
+
+void operator delete(void* p) noexcept
+{
+   if (!p)
+      return;
+   if (isCounting.load(memory_order_relaxed))
+      bytesCounted.fetch_sub(getBlockSize(p), memory_order_relaxed);
+   free(p);
+}
+
+void* operator new[](size_t size)                { return operator new(size); }
+void operator delete[](void* p) noexcept         { operator delete(p); }
+void operator delete(void* p, size_t) noexcept   { operator delete(p); }
+void operator delete[](void* p, size_t) noexcept { operator delete(p); }
+
+/*********************************************
+ * BUILT IN
+ * Where one of the built-in satellites starts
+ *********************************************/
+struct BuiltIn
+{
+   string name;
+   Integrator::State state;
+
+   BuiltIn(const string& name, const Satellite& satellite) :
+      name(name), state(satellite.getState()) {}
+};
+
+/*********************************************
+ * GET BUILT INS
+ * Everything the simulator starts with, but the ship
+ *********************************************/
+vector<BuiltIn> getBuiltIns()
+{
+   vector<BuiltIn> builtIns;
+   builtIns.push_back(BuiltIn("sputnik", Sputnik()));
+   for (size_t i = 0; i < sizeof(GPS::INITIAL_STATES) / sizeof(GPS::INITIAL_STATES[0]); i++)
+      builtIns.push_back(BuiltIn("gps" + to_string(i + 1), GPS(GPS::INITIAL_STATES[i])));
+   builtIns.push_back(BuiltIn("starlink", Starlink()));
+   builtIns.push_back(BuiltIn("hubble", Hubble()));
+   builtIns.push_back(BuiltIn("crewdragon", CrewDragon()));
+   return builtIns;
+}
+
+/*********************************************
+ * ACCURACY
+ * What one integrator did to one scenario
+ *********************************************/
+struct Accuracy
+{
+   double energyDrift = 0.0;     // worst relative change in energy
+   double momentumDrift = 0.0;   // worst relative change in angular momentum
+   double closure = 0.0;         // meters from Kepler at the end
+   double nsPerStep = 0.0;
+};
+
+/*********************************************
+ * MEASURE
+ * Step in blocks, timing only the stepping, and check what should be
+ * conserved between blocks
+ *********************************************/
+Accuracy measure(Integrator::Method method, const Integrator::State& start,
+                 double dt, long numSteps)
+{
+   const long BLOCK = 1000;
+   Accuracy accuracy;
+   Integrator::State state = start;
+   double energy = Integrator::getEnergy(start);
+   double momentum = Integrator::getAngularMomentum(start);
+   double seconds = 0.0;
+
+   for (long done = 0; done < numSteps; )
+   {
+      long count = min(BLOCK, numSteps - done);
+      auto begin = chrono::steady_clock::now();
+      for (long i = 0; i < count; i++)
+         Integrator::step(method, state, dt);
+      seconds += chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+      done += count;
+
+      accuracy.energyDrift = max(accuracy.energyDrift,
+         fabs((Integrator::getEnergy(state) - energy) / energy));
+      accuracy.momentumDrift = max(accuracy.momentumDrift,
+         fabs((Integrator::getAngularMomentum(state) - momentum) / momentum));
+   }
+
+   Integrator::State exact = Kepler(start).getState(numSteps * dt);
+   accuracy.closure = sqrt((state.x - exact.x) * (state.x - exact.x) +
+                           (state.y - exact.y) * (state.y - exact.y));
+   accuracy.nsPerStep = seconds * 1.0e9 / numSteps;
+   return accuracy;
+}
+
+/*********************************************
+ * RUN ACCURACY
+ * One table for each integrator and step size, a row for each scenario
+ *********************************************/
+int runAccuracy(int argc, char** argv)
+{
+   long numSteps = 1000000;
+   const char* csvFileName = NULL;
+   for (int i = 2; i < argc; i++)
+      if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc)
+         numSteps = max(1L, atol(argv[++i]));
+      else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc)
+         csvFileName = argv[++i];
+
+   ofstream fout;
+   if (csvFileName)
+   {
+      fout.open(csvFileName);
+      if (!fout)
+      {
+         cerr << "Unable to write " << csvFileName << endl;
+         return 1;
+      }
+      fout << "integrator,dt,scenario,steps,energyDrift,momentumDrift,closure,nsPerStep\n";
+   }
+
+   // 48 seconds is one tick of the simulator at its usual time warp
+   const double STEP_SIZES[] = { 12.0, 48.0, 192.0 };
+   vector<BuiltIn> builtIns = getBuiltIns();
+
+   for (int method = 0; method < Integrator::NUM_METHODS; method++)
+      for (double dt : STEP_SIZES)
+      {
+         const char* name = Integrator::getName((Integrator::Method)method);
+         cout << "\n" << name << ", " << dt << " s steps, " << numSteps << " steps\n"
+              << left << setw(12) << "scenario" << right
+              << setw(14) << "energy" << setw(14) << "momentum"
+              << setw(14) << "closure (m)" << setw(10) << "ns/step" << "\n";
+
+         for (const BuiltIn& builtIn : builtIns)
+         {
+            Accuracy accuracy = measure((Integrator::Method)method, builtIn.state, dt, numSteps);
+            cout << left << setw(12) << builtIn.name << right << scientific << setprecision(2)
+                 << setw(14) << accuracy.energyDrift
+                 << setw(14) << accuracy.momentumDrift
+                 << setw(14) << accuracy.closure
+                 << fixed << setprecision(1) << setw(10) << accuracy.nsPerStep << "\n";
+            if (fout.is_open())
+               fout << name << "," << dt << "," << builtIn.name << "," << numSteps << ","
+                    << accuracy.energyDrift << "," << accuracy.momentumDrift << ","
+                    << accuracy.closure << "," << accuracy.nsPerStep << "\n";
+         }
+         cout << defaultfloat << setprecision(6);
+      }
+
+   return fout.is_open() && !fout.good() ? 1 : 0;
+}
+
+/*********************************************
+ * RUN SCENARIO
+ * Make up a sky and say how long it took, how much room it takes, and
+ * how much of each kind is in it
+ *********************************************/
+int runScenario(int argc, char** argv)
+{
+   const char* name = "mix";
+   int numObjects = 1000000;
+   unsigned long long seed = 1;
+   const char* csvFileName = NULL;
+   for (int i = 2; i < argc; i++)
+      if (strcmp(argv[i], "--name") == 0 && i + 1 < argc)
+         name = argv[++i];
+      else if (strcmp(argv[i], "--objects") == 0 && i + 1 < argc)
+         numObjects = atoi(argv[++i]);
+      else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+         seed = strtoull(argv[++i], NULL, 10);
+      else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc)
+         csvFileName = argv[++i];
+
+   auto start = chrono::steady_clock::now();
+   Scenario scenario(seed);
+   if (!scenario.add(name, numObjects))
+   {
+      cerr << "No scenario called " << name << endl;
+      return 1;
+   }
+   double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+   size_t counts[3] = { 0, 0, 0 };
+   for (const Scenario::Object& object : scenario.getObjects())
+      counts[object.kind]++;
+   cout << fixed << setprecision(1) << name << ": " << scenario.size() << " objects ("
+        << counts[Scenario::WALKER] << " walker, " << counts[Scenario::MEO] << " meo, "
+        << counts[Scenario::DEBRIS] << " debris) in " << seconds * 1000.0 << " ms, "
+        << seconds * 1.0e9 / max((size_t)1, scenario.size()) << " ns and "
+        << sizeof(Scenario::Object) << " bytes each\n";
+
+   if (!csvFileName)
+      return 0;
+   ofstream fout(csvFileName);
+   fout << "kind,x,y,dx,dy\n" << setprecision(17);
+   for (const Scenario::Object& object : scenario.getObjects())
+      fout << object.kind << "," << object.state.x << "," << object.state.y << ","
+           << object.state.dx << "," << object.state.dy << "\n";
+   if (!fout.good())
+   {
+      cerr << "Unable to write " << csvFileName << endl;
+      return 1;
+   }
+   return 0;
+}
+
+/*********************************************
+ * MEASUREMENT
+ * How one phase went on so many objects and threads
+ *********************************************/
+struct Measurement
+{
+   const char* phase;
+   size_t numObjects;
+   int numThreads;
+   double items = 0.0;         // what one pass deals with
+   double seconds = 0.0;       // one pass takes
+   size_t bytes = 0;           // the objects and what the phase keeps
+   double efficiency = 1.0;    // against one thread
+
+   double getThroughput() const { return seconds > 0.0 ? items / seconds : 0.0; }
+};
+
+/*********************************************
+ * TIME PASSES
+ * Run a pass over and over until enough time has gone by to trust, and
+ * say how long one took
+ *********************************************/
+template <class Pass>
+double timePasses(Pass pass, double secondsMin)
+{
+   int numPasses = 0;
+   auto start = chrono::steady_clock::now();
+   double seconds = 0.0;
+   do
+   {
+      pass();
+      numPasses++;
+      seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+   }
+   while (seconds < secondsMin);
+   return seconds / numPasses;
+}
+
+/*********************************************
+ * SKY
+ * A made-up sky as the simulator would hold it, old enough that
+ * everything in it can break up
+ *********************************************/
+struct Sky
+{
+   list<Satellite*> satellites;
+   vector<Scenario::Object> objects;
+   size_t bytes = 0;
+
+   Sky(size_t numObjects)
+   {
+      Scenario scenario(1);
+      scenario.addMix((int)numObjects);
+      objects = scenario.getObjects();
+
+      isCounting = true;
+      size_t before = bytesCounted;
+      for (const Scenario::Object& object : objects)
+         satellites.push_back(Scenario::create(object));
+      bytes = bytesCounted - before;
+      isCounting = false;
+
+      for (int tick = 0; tick < 10; tick++)
+         for (Satellite* pSatellite : satellites)
+            pSatellite->move(1.0);
+   }
+   ~Sky()
+   {
+      for (Satellite* pSatellite : satellites)
+         delete pSatellite;
+   }
+};
+
+/*********************************************
+ * MEASURE MOVE
+ * One tick of physics for everything, as the simulator does it
+ *********************************************/
+Measurement measureMove(Sky& sky, int numThreads, double secondsMin)
+{
+   Measurement measurement = { "move", sky.satellites.size(), numThreads };
+   measurement.items = (double)sky.satellites.size();
+   Interface ui;   // never initialized: no keys down
+
+   isCounting = true;
+   size_t before = bytesCounted;
+   Phases phases(numThreads);
+   phases.move(sky.satellites, ui);
+   measurement.bytes = sky.bytes + bytesCounted - before;
+   isCounting = false;
+
+   measurement.seconds = timePasses([&]() { phases.move(sky.satellites, ui); }, secondsMin);
+   return measurement;
+}
+
+/*********************************************
+ * MEASURE BROAD PHASE
+ * Sort everything into the grid and find what touches. At the zoom the
+ * game is played at, every sprite reaches hundreds of kilometers and a
+ * crowded sky is one big pileup, so here radii are taken as meters
+ *********************************************/
+Measurement measureBroadPhase(Sky& sky, int numThreads, double secondsMin)
+{
+   Measurement measurement = { "broadphase", sky.satellites.size(), numThreads };
+   vector<BroadPhase::Circle> circles;
+   for (Satellite* pSatellite : sky.satellites)
+      if (pSatellite->getRadius() > 0.0)
+         circles.push_back({ pSatellite->getPosition().getMetersX(),
+                             pSatellite->getPosition().getMetersY(),
+                             pSatellite->getRadius() });
+   measurement.items = (double)circles.size();
+
+   isCounting = true;
+   size_t before = bytesCounted;
+   BroadPhase broadPhase(numThreads);
+   vector<BroadPhase::Pair> pairs;
+   broadPhase.build(circles);
+   broadPhase.findPairs(pairs);
+   measurement.bytes = sky.bytes + bytesCounted - before;
+   isCounting = false;
+
+   measurement.seconds = timePasses([&]()
+   {
+      broadPhase.build(circles);
+      broadPhase.findPairs(pairs);
+   }, secondsMin);
+   return measurement;
+}
+
+/*********************************************
+ * MEASURE BREAKUP
+ * One in a hundred of the satellites breaks up. Breakups draw random
+ * numbers and add to the list, so they happen on the calling thread in
+ * list order whatever numThreads says. Something that has broken up
+ * cannot again, so each pass starts with fresh satellites, made and
+ * thrown away off the clock
+ *********************************************/
+Measurement measureBreakup(Sky& sky, int numThreads, double secondsMin)
+{
+   Measurement measurement = { "breakup", sky.satellites.size(), numThreads };
+   vector<const Scenario::Object*> chosen;
+   for (size_t i = 0; i < sky.objects.size(); i += 100)
+      if (sky.objects[i].kind != Scenario::DEBRIS)
+         chosen.push_back(&sky.objects[i]);
+   measurement.items = (double)chosen.size();
+
+   list<Satellite*> parents;
+   list<Satellite*> pieces;
+   auto makeParents = [&]()
+   {
+      for (const Scenario::Object* pObject : chosen)
+      {
+         parents.push_back(Scenario::create(*pObject));
+         for (int tick = 0; tick < 10; tick++)
+            parents.back()->move(1.0);
+      }
+   };
+   auto breakUp = [&]()
+   {
+      for (Satellite* pParent : parents)
+         pParent->destroy(pieces);
+   };
+   auto throwAway = [&]()
+   {
+      for (Satellite* pSatellite : pieces)
+         delete pSatellite;
+      pieces.clear();
+      for (Satellite* pParent : parents)
+         delete pParent;
+      parents.clear();
+   };
+
+   isCounting = true;
+   size_t before = bytesCounted;
+   makeParents();
+   size_t bytesParents = bytesCounted - before;
+   breakUp();
+   measurement.bytes = sky.bytes + bytesCounted - before - bytesParents;
+   isCounting = false;
+   throwAway();
+
+   double seconds = 0.0;
+   int numPasses = 0;
+   do
+   {
+      makeParents();
+      auto start = chrono::steady_clock::now();
+      breakUp();
+      seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      numPasses++;
+      throwAway();
+   }
+   while (seconds < secondsMin && numPasses < 1000);
+   measurement.seconds = seconds / numPasses;
+   return measurement;
+}
+
+/*********************************************
+ * MEASURE RENDER PREP
+ * Everything the display needs from a tick before drawing, as the
+ * simulator does it zoomed out: cull what the camera cannot see, then
+ * count what is left into the heatmap
+ *********************************************/
+Measurement measureRenderPrep(Sky& sky, int numThreads, double secondsMin)
+{
+   Measurement measurement = { "renderprep", sky.satellites.size(), numThreads };
+   measurement.items = (double)sky.satellites.size();
+
+   Position ptUpperRight;
+   ptUpperRight.setPixelsX(1000.0);
+   ptUpperRight.setPixelsY(1000.0);
+   Camera camera(ptUpperRight);
+
+   isCounting = true;
+   size_t before = bytesCounted;
+   Phases phases(numThreads);
+   Heatmap heatmap(ptUpperRight, 8, numThreads);
+   vector<Position> points;
+   auto prepare = [&]()
+   {
+      const vector<Satellite*>& visible = phases.cull(sky.satellites, camera, 32.0, NULL);
+      points.clear();
+      for (Satellite* pSatellite : visible)
+         points.push_back(pSatellite->getPosition());
+      heatmap.accumulate(points, camera);
+   };
+   prepare();
+   measurement.bytes = sky.bytes + bytesCounted - before;
+   isCounting = false;
+
+   measurement.seconds = timePasses(prepare, secondsMin);
+   return measurement;
+}
+
+/*********************************************
+ * SUMMARIZE
+ * For each phase, how it went on the most objects, how many threads it
+ * is worth, and how many objects it takes to be worth threading at all.
+ * Threads are worth it while they are at least 70% efficient
+ *********************************************/
+bool summarize(const vector<Measurement>& measurements, double efficiencyMin)
+{
+   const double WORTH = 0.7;
+   bool isPassing = true;
+   cout << "\nSummary\n";
+   for (const char* phase : { "move", "broadphase", "breakup", "renderprep" })
+   {
+      vector<const Measurement*> rows;
+      size_t numObjectsMax = 0;
+      int numThreadsMax = 0;
+      for (const Measurement& measurement : measurements)
+         if (strcmp(measurement.phase, phase) == 0)
+         {
+            rows.push_back(&measurement);
+            numObjectsMax = max(numObjectsMax, measurement.numObjects);
+            numThreadsMax = max(numThreadsMax, measurement.numThreads);
+         }
+      if (rows.empty())
+         continue;
+
+      const Measurement* pOne = NULL;
+      const Measurement* pMost = NULL;
+      int numThreadsWorth = 1;
+      size_t numObjectsWorth = 0;
+      for (const Measurement* pRow : rows)
+      {
+         if (pRow->numObjects == numObjectsMax && pRow->numThreads == 1)
+            pOne = pRow;
+         if (pRow->numObjects == numObjectsMax && pRow->numThreads == numThreadsMax)
+            pMost = pRow;
+         if (pRow->numObjects == numObjectsMax && pRow->efficiency >= WORTH)
+            numThreadsWorth = max(numThreadsWorth, pRow->numThreads);
+         if (pRow->numThreads == numThreadsMax && pRow->efficiency >= WORTH &&
+             (numObjectsWorth == 0 || pRow->numObjects < numObjectsWorth))
+            numObjectsWorth = pRow->numObjects;
+      }
+
+      cout << fixed << setprecision(2) << left << setw(12) << phase << right
+           << pOne->getThroughput() / 1.0e6 << " M/s on 1 thread, "
+           << pMost->getThroughput() / 1.0e6 << " M/s on " << numThreadsMax
+           << " (efficiency " << pMost->efficiency << ") with " << numObjectsMax
+           << " objects, " << setprecision(0) << (double)pMost->bytes / numObjectsMax
+           << " bytes each\n" << setw(12) << "" << "worth up to " << numThreadsWorth
+           << (numThreadsWorth == 1 ? " thread" : " threads");
+      if (numThreadsMax > 1)
+      {
+         if (numObjectsWorth)
+            cout << ", and threading from " << numObjectsWorth << " objects";
+         else
+            cout << ", but never worth threading";
+      }
+      cout << "\n";
+
+      if (pMost->efficiency < efficiencyMin)
+      {
+         cout << setw(12) << "" << "FAILED: efficiency below " << setprecision(2)
+              << efficiencyMin << "\n";
+         isPassing = false;
+      }
+   }
+   return isPassing;
+}
+
+/*********************************************
+ * RUN SCALING
+ * Every phase of a tick for ten times as many objects each time, on
+ * one thread and then twice as many each time
+ *********************************************/
+int runScaling(int argc, char** argv)
+{
+   size_t numObjectsMin = 100;
+   size_t numObjectsMax = 10000000;
+   int numThreadsMax = numWorkers();
+   double secondsMin = 0.2;
+   double efficiencyMin = 0.0;
+   const char* csvFileName = NULL;
+   for (int i = 2; i < argc; i++)
+      if (strcmp(argv[i], "--min") == 0 && i + 1 < argc)
+         numObjectsMin = max(1L, atol(argv[++i]));
+      else if (strcmp(argv[i], "--max") == 0 && i + 1 < argc)
+         numObjectsMax = max(1L, atol(argv[++i]));
+      else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+         numThreadsMax = max(1, atoi(argv[++i]));
+      else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+         secondsMin = atof(argv[++i]);
+      else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc)
+         csvFileName = argv[++i];
+      else if (strcmp(argv[i], "--min-efficiency") == 0 && i + 1 < argc)
+         efficiencyMin = atof(argv[++i]);
+
+   vector<int> threadCounts;
+   for (int numThreads = 1; numThreads < numThreadsMax; numThreads *= 2)
+      threadCounts.push_back(numThreads);
+   threadCounts.push_back(numThreadsMax);
+
+   // the physics is worked out in meters, but breakups and the camera need the zoom
+   Position().setZoom(128000.0);
+
+   cout << left << setw(12) << "phase" << right << setw(10) << "objects"
+        << setw(8) << "threads" << setw(12) << "M/s" << setw(12) << "efficiency"
+        << setw(12) << "bytes each" << "\n";
+   vector<Measurement> measurements;
+   for (size_t numObjects = numObjectsMin; numObjects <= numObjectsMax; numObjects *= 10)
+   {
+      Sky sky(numObjects);
+      for (auto measure : { measureMove, measureBroadPhase, measureBreakup, measureRenderPrep })
+      {
+         double throughputOne = 0.0;
+         for (int numThreads : threadCounts)
+         {
+            // breakups stay on one thread, so more would only say so again
+            if (measure == measureBreakup && numThreads > 1)
+               break;
+            Measurement measurement = measure(sky, numThreads, secondsMin);
+            if (numThreads == 1)
+               throughputOne = measurement.getThroughput();
+            if (throughputOne > 0.0)
+               measurement.efficiency = measurement.getThroughput() / (numThreads * throughputOne);
+            measurements.push_back(measurement);
+
+            cout << left << setw(12) << measurement.phase << right << setw(10) << numObjects
+                 << setw(8) << numThreads << fixed << setprecision(3)
+                 << setw(12) << measurement.getThroughput() / 1.0e6
+                 << setprecision(2) << setw(12) << measurement.efficiency
+                 << setprecision(0) << setw(12) << (double)measurement.bytes / numObjects
+                 << "\n" << flush;
+         }
+      }
+   }
+
+   bool isPassing = summarize(measurements, efficiencyMin);
+
+   if (csvFileName)
+   {
+      ofstream fout(csvFileName);
+      fout << "phase,objects,threads,items,seconds,itemsPerSecond,efficiency,bytesPerObject\n";
+      for (const Measurement& measurement : measurements)
+         fout << measurement.phase << "," << measurement.numObjects << ","
+              << measurement.numThreads << "," << fixed << setprecision(0) << measurement.items << ","
+              << scientific << setprecision(6) << measurement.seconds << ","
+              << measurement.getThroughput() << "," << fixed << setprecision(4)
+              << measurement.efficiency << "," << setprecision(1)
+              << (double)measurement.bytes / measurement.numObjects << "\n";
+      if (!fout.good())
+      {
+         cerr << "Unable to write " << csvFileName << endl;
+         return 1;
+      }
+   }
+   return isPassing ? 0 : 1;
+}
+
+/*********************************************
+ * HASH STATES
+ * Every bit of every state in a sample, to see they come back the same
+ *********************************************/
+uint64_t hashStates(uint64_t hash, const TrajectoryCodec::Sample& sample)
+{
+   for (const vector<double>* pColumn : { &sample.x, &sample.y, &sample.dx, &sample.dy })
+      for (double value : *pColumn)
+      {
+         uint64_t bits;
+         memcpy(&bits, &value, sizeof(bits));
+         hash = (hash ^ bits) * 1099511628211ull;
+      }
+   return hash;
+}
+
+/*********************************************
+ * RUN TRAJECTORY
+ * Record a sky as the simulator would, timing the copying into the
+ * stage apart from the writer's encoding and writing, then read it all
+ * back and check that every bit survived
+ *********************************************/
+int runTrajectory(int argc, char** argv)
+{
+   int numObjects = 100000;
+   int numSamples = 100;
+   int everyTicks = 1;
+   const char* fileName = "trajectory.trj";
+   double throughputMin = 0.0;
+   for (int i = 2; i < argc; i++)
+      if (strcmp(argv[i], "--objects") == 0 && i + 1 < argc)
+         numObjects = atoi(argv[++i]);
+      else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc)
+         numSamples = atoi(argv[++i]);
+      else if (strcmp(argv[i], "--every") == 0 && i + 1 < argc)
+         everyTicks = max(1, atoi(argv[++i]));
+      else if (strcmp(argv[i], "--file") == 0 && i + 1 < argc)
+         fileName = argv[++i];
+      else if (strcmp(argv[i], "--min-throughput") == 0 && i + 1 < argc)
+         throughputMin = atof(argv[++i]);
+
+   Sky sky(numObjects);
+   TrajectoryRecorder recorder;
+   if (!recorder.open(fileName, everyTicks))
+   {
+      cerr << "Unable to write " << fileName << endl;
+      return 1;
+   }
+
+   // The physics is off the clock. Copying out and handing over is timed
+   // on its own, and so is encoding the same sample again here, since
+   // the writer's own time includes waiting for a core
+   uint64_t hashWritten = 14695981039346656037ull;
+   double secondsStaging = 0.0;
+   double secondsEncoding = 0.0;
+   TrajectoryCodec codec;
+   vector<unsigned char> bytes;
+   for (int tick = 0; tick < numSamples * everyTicks; tick++)
+   {
+      for (Satellite* pSatellite : sky.satellites)
+         pSatellite->move(1.0);
+
+      auto start = chrono::steady_clock::now();
+      TrajectoryCodec::Sample* pSample = recorder.getStageIfDue(tick * Satellite::getTimeWarp());
+      if (pSample)
+      {
+         for (const Satellite* pSatellite : sky.satellites)
+         {
+            Integrator::State state = pSatellite->getState();
+            pSample->add((uint8_t)pSatellite->getKind(), state.x, state.y, state.dx, state.dy);
+         }
+         recorder.submit();
+      }
+      auto staged = chrono::steady_clock::now();
+      secondsStaging += chrono::duration<double>(staged - start).count();
+      if (pSample)
+      {
+         bytes.clear();
+         codec.encode(*pSample, bytes);
+         secondsEncoding += chrono::duration<double>(chrono::steady_clock::now() - staged).count();
+         hashWritten = hashStates(hashWritten, *pSample);
+      }
+   }
+   if (!recorder.close())
+   {
+      cerr << "Unable to write " << fileName << endl;
+      return 1;
+   }
+
+   // and back again
+   auto start = chrono::steady_clock::now();
+   TrajectoryReader reader;
+   TrajectoryCodec::Sample sample;
+   uint64_t hashRead = 14695981039346656037ull;
+   uint64_t numRead = 0;
+   bool isOpen = reader.open(fileName);
+   while (isOpen && reader.read(sample))
+   {
+      hashRead = hashStates(hashRead, sample);
+      numRead += sample.size();
+   }
+   double secondsReading = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+   reader.close();
+   remove(fileName);
+
+   double numStates = (double)recorder.getNumStates();
+   double throughput = numStates / max(1.0e-9, secondsEncoding);
+   bool isSame = isOpen && hashRead == hashWritten && numRead == recorder.getNumStates();
+   cout << fixed << setprecision(1) << recorder.getNumStates() << " states in "
+        << recorder.getNumSamples() << " samples, " << (double)recorder.getBytes() / numStates
+        << " bytes each against " << 4 * sizeof(double) + 1 << " raw\n"
+        << setprecision(2)
+        << "staging  " << numStates / secondsStaging / 1.0e6 << " M states/s, waiting "
+        << recorder.getSecondsWaited() * 1000.0 << " ms for the writer\n"
+        << "encoding " << throughput / 1.0e6 << " M states/s, and "
+        << numStates / recorder.getSecondsWriting() / 1.0e6 << " M states/s writing on a thread\n"
+        << "reading  " << numStates / secondsReading / 1.0e6 << " M states/s, "
+        << (isSame ? "every bit the same" : "NOT THE SAME") << "\n";
+   return isSame && throughput >= throughputMin ? 0 : 1;
+}
+
+/*********************************************
+ * ADD CHECKSUM
+ * The last column of a TLE line: its digits added up, a minus counting
+ * as one, modulo ten
+ *********************************************/
+void addChecksum(char* line)
+{
+   int sum = 0;
+   for (int i = 0; i < 68; i++)
+      sum += line[i] >= '0' && line[i] <= '9' ? line[i] - '0' : (line[i] == '-' ? 1 : 0);
+   line[68] = (char)('0' + sum % 10);
+   line[69] = '\0';
+}
+
+/*********************************************
+ * MAKE CATALOG
+ * So many objects in low and medium orbits, a name line and two element
+ * lines each, the way the public catalogs come
+ *********************************************/
+bool makeCatalog(const char* fileName, int numObjects)
+{
+   ofstream fout(fileName, ios::binary);
+   mt19937_64 generator(1);
+   auto getUniform = [&](double low, double high)
+   {
+      return low + (high - low) * (double)(generator() >> 11) / 9007199254740992.0;
+   };
+   char line[128];
+   for (int i = 0; i < numObjects && fout; i++)
+   {
+      int number = i % 99999 + 1;
+      fout << (i % 4 == 3 ? "0 COSMOS 2251 DEB" : "0 STARLINK-") << number << "\n";
+      snprintf(line, sizeof(line), "1 %05dU 24001A   24%012.8f  .00000000  00000-0  00000-0 0  999",
+               number, getUniform(1.0, 366.0));
+      addChecksum(line);
+      fout << line << "\n";
+      snprintf(line, sizeof(line), "2 %05d %8.4f %8.4f %07d %8.4f %8.4f %11.8f%05d",
+               number, getUniform(0.0, 180.0), getUniform(0.0, 360.0),
+               (int)getUniform(0.0, 20000.0), getUniform(0.0, 360.0), getUniform(0.0, 360.0),
+               i % 10 == 0 ? getUniform(1.9, 2.1) : getUniform(11.0, 16.0), i % 100000);
+      addChecksum(line);
+      fout << line << "\n";
+   }
+   return (bool)fout;
+}
+
+/*********************************************
+ * RUN CATALOG
+ * Load the same file on one thread, then two, and so on up to the most,
+ * keeping the best of a few tries of each, and check that every number
+ * of threads finds the same
+ *********************************************/
+int runCatalog(int argc, char** argv)
+{
+   const char* fileName = NULL;
+   int numObjects = 30000;
+   int numThreadsMax = numWorkers(0);
+   for (int i = 2; i < argc; i++)
+      if (strcmp(argv[i], "--file") == 0 && i + 1 < argc)
+         fileName = argv[++i];
+      else if (strcmp(argv[i], "--objects") == 0 && i + 1 < argc)
+         numObjects = atoi(argv[++i]);
+      else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+         numThreadsMax = max(1, atoi(argv[++i]));
+
+   const char* madeName = "catalog.tle";
+   if (!fileName && !makeCatalog(madeName, numObjects))
+   {
+      cerr << "Unable to write " << madeName << endl;
+      return 1;
+   }
+
+   bool isSame = true;
+   size_t numFirst = 0;
+   for (int numThreads = 1; numThreads <= numThreadsMax; numThreads *= 2)
+   {
+      double seconds = 1.0e9;
+      Catalog catalog;
+      for (int attempt = 0; attempt < 5; attempt++)
+      {
+         auto start = chrono::steady_clock::now();
+         if (!catalog.load(fileName ? fileName : madeName, numThreads))
+         {
+            cerr << "Unable to read " << (fileName ? fileName : madeName) << endl;
+            return 1;
+         }
+         seconds = min(seconds, chrono::duration<double>(chrono::steady_clock::now() - start).count());
+      }
+      if (numThreads == 1)
+         numFirst = catalog.size();
+      isSame = isSame && catalog.size() == numFirst;
+      cout << setw(2) << numThreads << " threads: " << catalog.size() << " objects, "
+           << catalog.getNumRejected() << " rejected, in " << fixed << setprecision(2)
+           << seconds * 1000.0 << " ms, " << setprecision(2)
+           << (double)catalog.size() / seconds / 1.0e6 << " M objects/s\n";
+   }
+   if (!fileName)
+      remove(madeName);
+   return isSame ? 0 : 1;
+}
+
+/*********************************************
+ * RUN EPHEMERIS
+ * Fit a sky over a span, or a recording, then ask where things were at
+ * random moments. Propagated skies are checked against Kepler, and a
+ * few of the questions are also answered the old way, by stepping
+ * forward from the start, to compare
+ *********************************************/
+int runEphemeris(int argc, char** argv)
+{
+   int numObjects = 10000;
+   double hours = 6.0;
+   double secondsStep = 48.0;
+   int numQueries = 1000000;
+   const char* trajectoryFileName = NULL;
+   int numThreads = 0;
+   for (int i = 2; i < argc; i++)
+      if (strcmp(argv[i], "--objects") == 0 && i + 1 < argc)
+         numObjects = atoi(argv[++i]);
+      else if (strcmp(argv[i], "--hours") == 0 && i + 1 < argc)
+         hours = atof(argv[++i]);
+      else if (strcmp(argv[i], "--step") == 0 && i + 1 < argc)
+         secondsStep = atof(argv[++i]);
+      else if (strcmp(argv[i], "--queries") == 0 && i + 1 < argc)
+         numQueries = max(1, atoi(argv[++i]));
+      else if (strcmp(argv[i], "--trajectory") == 0 && i + 1 < argc)
+         trajectoryFileName = argv[++i];
+      else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+         numThreads = atoi(argv[++i]);
+
+   Ephemeris ephemeris(16, 10, numThreads);
+   vector<Integrator::State> states;
+   auto start = chrono::steady_clock::now();
+   if (trajectoryFileName)
+   {
+      TrajectoryReader reader;
+      if (!reader.open(trajectoryFileName))
+      {
+         cerr << "Unable to read " << trajectoryFileName << endl;
+         return 1;
+      }
+      if (!ephemeris.fit(reader))
+         cerr << "Only fit as far as the objects stayed the same\n";
+   }
+   else
+   {
+      Scenario scenario(1);
+      scenario.addMix(numObjects);
+      for (const Scenario::Object& object : scenario.getObjects())
+         states.push_back(object.state);
+      ephemeris.propagate(states, 0.0, hours * 3600.0, secondsStep);
+   }
+   double secondsFitting = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+   if (ephemeris.getNumWindows() == 0)
+   {
+      cerr << "Nothing to fit\n";
+      return 1;
+   }
+
+   // the questions, made up before the clock starts
+   mt19937_64 generator(1);
+   vector<size_t> objects(numQueries);
+   vector<double> times(numQueries);
+   double span = ephemeris.getSecondsEnd() - ephemeris.getSecondsStart();
+   for (int i = 0; i < numQueries; i++)
+   {
+      objects[i] = (size_t)(generator() % ephemeris.getNumObjects());
+      times[i] = ephemeris.getSecondsStart() + span * (double)(generator() >> 11) / 9007199254740992.0;
+   }
+
+   start = chrono::steady_clock::now();
+   double sum = 0.0;
+   Integrator::State state;
+   for (int i = 0; i < numQueries; i++)
+      if (ephemeris.getState(objects[i], times[i], state))
+         sum += state.x + state.dy;
+   double secondsQuerying = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+   cout << fixed << setprecision(1) << ephemeris.getNumObjects() << " objects over "
+        << span / 3600.0 << " hours in " << ephemeris.getNumWindows() << " windows, "
+        << (double)ephemeris.getBytes() / 1.0e6 << " MB, fit in " << secondsFitting * 1000.0
+        << " ms\n" << setprecision(2) << "querying " << numQueries / secondsQuerying / 1.0e6
+        << " M queries/s, " << secondsQuerying * 1.0e9 / numQueries << " ns each"
+        << (sum == 0.0 ? " " : "") << "\n";
+   if (states.empty())
+      return 0;
+
+   // how far off, against Kepler, and what stepping there would have cost
+   double errorPosition = 0.0;
+   double errorSpeed = 0.0;
+   double secondsStepping = 0.0;
+   int numStepped = 0;
+   for (int i = 0; i < min(numQueries, 10000); i++)
+   {
+      Kepler kepler(states[objects[i]]);
+      if (!kepler.isClosed() || !ephemeris.getState(objects[i], times[i], state))
+         continue;
+      Integrator::State exact = kepler.getState(times[i]);
+      errorPosition = max(errorPosition, hypot(state.x - exact.x, state.y - exact.y));
+      errorSpeed = max(errorSpeed, hypot(state.dx - exact.dx, state.dy - exact.dy));
+      if (numStepped < 100)
+      {
+         auto started = chrono::steady_clock::now();
+         Integrator::State stepped = states[objects[i]];
+         int numSteps = (int)ceil(times[i] / (secondsStep / 8.0));
+         for (int step = 0; step < numSteps; step++)
+            Integrator::step(Integrator::RK4, stepped, times[i] / numSteps);
+         secondsStepping += chrono::duration<double>(chrono::steady_clock::now() - started).count();
+         sum += stepped.x;
+         numStepped++;
+      }
+   }
+   cout << setprecision(3) << "worst against Kepler " << errorPosition << " m, "
+        << errorSpeed << " m/s\n" << setprecision(1) << "stepping from the start instead "
+        << secondsStepping * 1.0e6 / max(1, numStepped) << " us a query, "
+        << secondsStepping / max(1, numStepped) / (secondsQuerying / numQueries)
+        << " times as long\n";
+   return 0;
+}
+
+/*********************************************
+ * RUN CONJUNCTION
+ * Screen the mix on one thread, then two, and so on, and say what each
+ * filter let through. For scale, time stepping a few pairs through the
+ * whole span a second at a time, which is what trying every pair would
+ * take
+ *********************************************/
+int runConjunction(int argc, char** argv)
+{
+   int numObjects = 10000;
+   double hours = 24.0;
+   double distance = 10000.0;
+   int numThreadsMax = numWorkers(0);
+   for (int i = 2; i < argc; i++)
+      if (strcmp(argv[i], "--objects") == 0 && i + 1 < argc)
+         numObjects = atoi(argv[++i]);
+      else if (strcmp(argv[i], "--hours") == 0 && i + 1 < argc)
+         hours = atof(argv[++i]);
+      else if (strcmp(argv[i], "--distance") == 0 && i + 1 < argc)
+         distance = atof(argv[++i]);
+      else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+         numThreadsMax = max(1, atoi(argv[++i]));
+
+   Scenario scenario(1);
+   scenario.addMix(numObjects);
+   vector<Integrator::State> states;
+   for (const Scenario::Object& object : scenario.getObjects())
+      states.push_back(object.state);
+
+   bool isSame = true;
+   vector<ConjunctionScreen::Approach> approachesFirst;
+   ConjunctionScreen screen(distance);
+   for (int numThreads = 1; numThreads <= numThreadsMax; numThreads *= 2)
+   {
+      auto start = chrono::steady_clock::now();
+      screen.screen(states, hours * 3600.0, numThreads);
+      double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      if (numThreads == 1)
+         approachesFirst = screen.getApproaches();
+      isSame = isSame && screen.getApproaches().size() == approachesFirst.size();
+      cout << setw(2) << numThreads << " threads: " << fixed << setprecision(1)
+           << seconds * 1000.0 << " ms, " << screen.getApproaches().size()
+           << " approaches\n";
+   }
+   cout << screen.getNumPairs() << " pairs, " << screen.getNumInBand() << " in band, "
+        << screen.getNumOnPath() << " on crossing paths, " << screen.getNumAligned()
+        << " lined up, " << screen.getNumSkipped() << " open orbits skipped\n";
+   if (!approachesFirst.empty())
+   {
+      const ConjunctionScreen::Approach& closest = approachesFirst.front();
+      cout << "closest " << closest.first << " and " << closest.second << " at "
+           << closest.seconds << " s, " << closest.distance << " m apart at "
+           << closest.speed << " m/s\n";
+   }
+
+   // the brute force way, for a few pairs
+   auto start = chrono::steady_clock::now();
+   double sum = 0.0;
+   int numTried = min((int)states.size() - 1, 20);
+   for (int i = 0; i < numTried; i++)
+   {
+      Kepler one(states[i]);
+      Kepler two(states[states.size() - 1 - i]);
+      for (double t = 0.0; t <= hours * 3600.0; t += 1.0)
+         sum += one.getState(t).x - two.getState(t).x;
+   }
+   double secondsPair = chrono::duration<double>(chrono::steady_clock::now() - start).count() /
+                        max(1, numTried);
+   cout << "every pair every second would take about " << setprecision(0)
+        << secondsPair * screen.getNumPairs() << " s" << (sum == 0.0 ? " " : "") << "\n";
+   return isSame ? 0 : 1;
+}
+
+/*********************************************
+ * RUN GPS
+ * Solve every receiver a minute apart on one thread, then two, and so
+ * on. Then break the satellites up one at a time, as a collision would,
+ * and see how many receivers can still tell where they are and how well
+ *********************************************/
+int runGps(int argc, char** argv)
+{
+   int numReceivers = 10000;
+   int numSatellites = 24;
+   double noise = 5.0;
+   int numThreadsMax = numWorkers(0);
+   for (int i = 2; i < argc; i++)
+      if (strcmp(argv[i], "--receivers") == 0 && i + 1 < argc)
+         numReceivers = atoi(argv[++i]);
+      else if (strcmp(argv[i], "--satellites") == 0 && i + 1 < argc)
+         numSatellites = atoi(argv[++i]);
+      else if (strcmp(argv[i], "--noise") == 0 && i + 1 < argc)
+         noise = atof(argv[++i]);
+      else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+         numThreadsMax = max(1, atoi(argv[++i]));
+
+   Scenario scenario(1);
+   scenario.addMEO(numSatellites);
+   vector<Kepler> orbits;
+   for (const Scenario::Object& object : scenario.getObjects())
+      orbits.push_back(Kepler(object.state));
+   auto getSatellites = [&](double seconds, size_t numBroken)
+   {
+      vector<Integrator::State> satellites;
+      for (size_t i = numBroken; i < orbits.size(); i++)
+         satellites.push_back(orbits[i].getState(seconds));
+      return satellites;
+   };
+
+   const int numTicks = 20;
+   for (int numThreads = 1; numThreads <= numThreadsMax; numThreads *= 2)
+   {
+      Receivers receivers(noise, numThreads);
+      receivers.addGround(numReceivers / 2);
+      receivers.addOrbit(numReceivers - numReceivers / 2, 550000.0);
+      receivers.solve(0.0, getSatellites(0.0, 0));
+      auto start = chrono::steady_clock::now();
+      for (int tick = 1; tick <= numTicks; tick++)
+         receivers.solve(tick * 60.0, getSatellites(tick * 60.0, 0));
+      double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      cout << setw(2) << numThreads << " threads: " << fixed << setprecision(2)
+           << seconds * 1000.0 / numTicks << " ms a tick, "
+           << seconds * 1.0e9 / numTicks / max(1, numReceivers) << " ns a receiver\n";
+   }
+
+   cout << "broken  fixed   in sight  PDOP    RMS error  worst\n";
+   Receivers receivers(noise);
+   receivers.addGround(numReceivers / 2);
+   receivers.addOrbit(numReceivers - numReceivers / 2, 550000.0);
+   for (size_t numBroken = 0; numBroken < orbits.size(); numBroken++)
+   {
+      receivers.solve(0.0, getSatellites(0.0, numBroken));
+      Receivers::Summary summary = receivers.getSummary();
+      cout << setw(6) << numBroken << setw(6) << setprecision(1)
+           << 100.0 * summary.numFixed / max((size_t)1, summary.numReceivers) << "%"
+           << setw(10) << summary.meanVisible << setw(7) << summary.meanPdop
+           << setw(10) << summary.rmsError << " m" << setw(8) << summary.maxError << " m\n";
+      if (summary.numFixed == 0)
+         break;
+   }
+   return 0;
+}
+
+/*********************************************
+ * RUN LINKS
+ * Move a Walker constellation along a tick at a time and keep its links
+ * up to date, first with no routes, then with the routes patched, then
+ * with them worked out afresh every tick, and check the last two agree
+ *********************************************/
+int runLinks(int argc, char** argv)
+{
+   int numSatellites = 40000;
+   double range = 20000.0;
+   int numRoutes = 8;
+   double step = 10.0;
+   int numThreads = 0;
+   for (int i = 2; i < argc; i++)
+      if (strcmp(argv[i], "--satellites") == 0 && i + 1 < argc)
+         numSatellites = max(2, atoi(argv[++i]));
+      else if (strcmp(argv[i], "--range") == 0 && i + 1 < argc)
+         range = atof(argv[++i]);
+      else if (strcmp(argv[i], "--routes") == 0 && i + 1 < argc)
+         numRoutes = max(1, atoi(argv[++i]));
+      else if (strcmp(argv[i], "--step") == 0 && i + 1 < argc)
+         step = atof(argv[++i]);
+      else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+         numThreads = max(1, atoi(argv[++i]));
+
+   Scenario scenario(1);
+   scenario.addWalker(numSatellites, 40, 1, 550000.0, 250.0);
+   vector<Kepler> orbits;
+   for (const Scenario::Object& object : scenario.getObjects())
+      orbits.push_back(Kepler(object.state));
+   vector<Integrator::State> nodes(orbits.size());
+
+   // each from one spread round the list to whichever is furthest away
+   LinkGraph linked(range, numThreads);
+   LinkGraph patched(range, numThreads);
+   LinkGraph afresh(range, numThreads);
+   afresh.setIncremental(false);
+   for (int route = 0; route < numRoutes; route++)
+   {
+      int from = (int)((uint64_t)numSatellites * route / numRoutes);
+      int to = from;
+      double furthest = 0.0;
+      for (int i = 0; i < numSatellites; i++)
+      {
+         double dx = orbits[i].getState(0.0).x - orbits[from].getState(0.0).x;
+         double dy = orbits[i].getState(0.0).y - orbits[from].getState(0.0).y;
+         if (dx * dx + dy * dy > furthest)
+         {
+            furthest = dx * dx + dy * dy;
+            to = i;
+         }
+      }
+      patched.addRoute(from, to);
+      afresh.addRoute(from, to);
+   }
+
+   const int numTicks = 30;
+   double secondsLinked = 0.0;
+   double secondsPatched = 0.0;
+   double secondsAfresh = 0.0;
+   uint64_t numRelaxedPatched = 0;
+   uint64_t numRelaxedAfresh = 0;
+   size_t numChanged = 0;
+   bool isSame = true;
+   for (int tick = 0; tick <= numTicks; tick++)
+   {
+      parallelFor((int)orbits.size(), [&](int first, int last)
+      {
+         for (int i = first; i < last; i++)
+            nodes[i] = orbits[i].getState(tick * step);
+      }, numThreads, 1024);
+
+      auto begin = chrono::steady_clock::now();
+      linked.update(nodes);
+      auto start = chrono::steady_clock::now();
+      patched.update(nodes);
+      auto middle = chrono::steady_clock::now();
+      afresh.update(nodes);
+      auto end = chrono::steady_clock::now();
+      if (tick == 0)
+         continue;   // both start from nothing
+      secondsLinked += chrono::duration<double>(start - begin).count();
+      secondsPatched += chrono::duration<double>(middle - start).count();
+      secondsAfresh += chrono::duration<double>(end - middle).count();
+      numRelaxedPatched += patched.getNumRelaxed();
+      numRelaxedAfresh += afresh.getNumRelaxed();
+      numChanged += patched.getNumMade() + patched.getNumBroken();
+      for (int route = 0; route < numRoutes; route++)
+         isSame = isSame && fabs(patched.getLatency(route) - afresh.getLatency(route)) < 1.0e-12;
+   }
+
+   cout << numSatellites << " satellites, " << patched.getLinks().size() << " links, "
+        << fixed << setprecision(1) << (double)numChanged / numTicks
+        << " made or broken a tick\n";
+   cout << "links alone: " << setprecision(2) << secondsLinked * 1000.0 / numTicks << " ms a tick\n";
+   cout << "patched: " << setprecision(2) << secondsPatched * 1000.0 / numTicks
+        << " ms a tick, " << numRelaxedPatched / numTicks << " put on a heap\n";
+   cout << "afresh:  " << secondsAfresh * 1000.0 / numTicks << " ms a tick, "
+        << numRelaxedAfresh / numTicks << " put on a heap\n";
+   for (int route = 0; route < numRoutes; route++)
+   {
+      double latency = patched.getLatency(route);
+      cout << "route " << route << ": ";
+      if (latency < 0.0)
+         cout << "no way\n";
+      else
+         cout << setprecision(2) << latency * 1000.0 << " ms, "
+              << patched.getNumHops(route) << " hops\n";
+   }
+   if (!isSame)
+      cout << "patched and afresh disagree\n";
+   return isSame ? 0 : 1;
+}
+
+/*********************************************
+ * MAIN
+ * Run whichever benchmark was asked for
+ *********************************************/
+int main(int argc, char** argv)
+{
+   if (argc >= 2 && strcmp(argv[1], "accuracy") == 0)
+      return runAccuracy(argc, argv);
+   if (argc >= 2 && strcmp(argv[1], "scenario") == 0)
+      return runScenario(argc, argv);
+   if (argc >= 2 && strcmp(argv[1], "scaling") == 0)
+      return runScaling(argc, argv);
+   if (argc >= 2 && strcmp(argv[1], "trajectory") == 0)
+      return runTrajectory(argc, argv);
+   if (argc >= 2 && strcmp(argv[1], "catalog") == 0)
+      return runCatalog(argc, argv);
+   if (argc >= 2 && strcmp(argv[1], "ephemeris") == 0)
+      return runEphemeris(argc, argv);
+   if (argc >= 2 && strcmp(argv[1], "conjunction") == 0)
+      return runConjunction(argc, argv);
+   if (argc >= 2 && strcmp(argv[1], "gps") == 0)
+      return runGps(argc, argv);
+   if (argc >= 2 && strcmp(argv[1], "links") == 0)
+      return runLinks(argc, argv);
+
+   cerr << "Usage: " << argv[0] << " accuracy [--steps <count>] [--csv <file>]\n"
+        << "       " << argv[0] << " scenario [--name <name>] [--objects <count>] "
+        << "[--seed <number>] [--csv <file>]\n"
+        << "       " << argv[0] << " scaling [--min <objects>] [--max <objects>] "
+        << "[--threads <count>] [--seconds <s>] [--csv <file>] [--min-efficiency <e>]\n"
+        << "       " << argv[0] << " trajectory [--objects <count>] [--samples <count>] "
+        << "[--every <ticks>] [--file <file>] [--min-throughput <states/s>]\n"
+        << "       " << argv[0] << " catalog [--file <file>] [--objects <count>] "
+        << "[--threads <count>]\n"
+        << "       " << argv[0] << " ephemeris [--objects <count>] [--hours <h>] "
+        << "[--step <s>] [--queries <count>] [--trajectory <file>] [--threads <count>]\n"
+        << "       " << argv[0] << " conjunction [--objects <count>] [--hours <h>] "
+        << "[--distance <m>] [--threads <count>]\n"
+        << "       " << argv[0] << " gps [--receivers <count>] [--satellites <count>] "
+        << "[--noise <m>] [--threads <count>]\n"
+        << "       " << argv[0] << " links [--satellites <count>] [--range <m>] "
+        << "[--routes <count>] [--step <s>] [--threads <count>]\n";
+   return 1;
+}
@@ -0,0 +1,146 @@
+/***********************************************************************
+ * Source File:
+ *    BROAD PHASE
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Which things might be touching, without checking every pair
+ ************************************************************************/
+
+#include "broadPhase.h"
+#include "parallel.h"
+#include <cmath>     // for floor()
+#include <algorithm> // for sort() and max()
+
+/*********************************************
+ * BROAD PHASE : GET BUCKET
+ * Where a cell goes in the hash table. Different cells can share a
+ * bucket, which only costs a few extra distance checks
+ *********************************************/
+size_t BroadPhase::getBucket(int64_t col, int64_t row) const
+{
+   uint64_t hash = (uint64_t)col * 73856093u ^ (uint64_t)row * 19349663u;
+   return (size_t)(hash ^ (hash >> 29)) & mask;
+}
+
+/*********************************************
+ * BROAD PHASE : BUILD
+ * Find each circle's cell in parallel, then a counting sort puts them in
+ * order bucket by bucket
+ *    INPUT  circles  Where everything is. Kept, not copied, until the
+ *                    next build
+ *********************************************/
+void BroadPhase::build(const std::vector<Circle>& circles)
+{
+   pCircles = &circles;
+   int num = (int)circles.size();
+
+   double radiusMax = 0.0;
+   for (const Circle& circle : circles)
+      radiusMax = std::max(radiusMax, circle.radius);
+   cellSize = radiusMax > 0.0 ? 2.0 * radiusMax : 1.0;
+
+   size_t numBuckets = 1;
+   while (numBuckets < 2 * (size_t)num)
+      numBuckets *= 2;
+   mask = numBuckets - 1;
+
+   cols.resize(num);
+   rows.resize(num);
+   int numSlices = std::max(1, std::min(numWorkers(numThreads), num / MIN_PER_THREAD));
+   parallelFor(num, [&](int first, int last)
+   {
+      for (int i = first; i < last; i++)
+      {
+         cols[i] = (int64_t)floor(circles[i].x / cellSize);
+         rows[i] = (int64_t)floor(circles[i].y / cellSize);
+      }
+   }, numSlices, std::max(1, num / numSlices));
+
+   // counting sort, so order holds each bucket's circles together
+   starts.assign(numBuckets + 1, 0);
+   for (int i = 0; i < num; i++)
+      starts[getBucket(cols[i], rows[i]) + 1]++;
+   for (size_t bucket = 0; bucket < numBuckets; bucket++)
+      starts[bucket + 1] += starts[bucket];
+   order.resize(num);
+   std::vector<int> next(starts.begin(), starts.end() - 1);
+   for (int i = 0; i < num; i++)
+      order[next[getBucket(cols[i], rows[i])]++] = i;
+}
+
+/*********************************************
+ * BROAD PHASE : FIND PAIRS
+ * Each slice looks around its own circles and keeps what it finds to
+ * itself. A pair is only kept by the lower of the two, so it is found
+ * once. The slices are then put together in order
+ *    OUTPUT pairs  Every two circles that touch or overlap
+ *********************************************/
+void BroadPhase::findPairs(std::vector<Pair>& pairs)
+{
+   pairs.clear();
+   if (!pCircles || pCircles->empty())
+      return;
+   const std::vector<Circle>& circles = *pCircles;
+   int num = (int)order.size();
+   int numSlices = std::max(1, std::min(numWorkers(numThreads), num / MIN_PER_THREAD));
+   int grain = (num + numSlices - 1) / numSlices;
+   if ((int)partials.size() < numSlices)
+      partials.resize(numSlices);
+
+   parallelFor(num, [&](int first, int last)
+   {
+      std::vector<Pair>& found = partials[first / grain];
+      found.clear();
+      for (int i = first; i < last; i++)
+      {
+         // the nine buckets around, each only once and in order
+         size_t buckets[9];
+         int numBuckets = 0;
+         for (int cell = 0; cell < 9; cell++)
+         {
+            size_t bucket = getBucket(cols[i] + cell % 3 - 1, rows[i] + cell / 3 - 1);
+            int at = 0;
+            while (at < numBuckets && buckets[at] < bucket)
+               at++;
+            if (at < numBuckets && buckets[at] == bucket)
+               continue;
+            for (int move = numBuckets; move > at; move--)
+               buckets[move] = buckets[move - 1];
+            buckets[at] = bucket;
+            numBuckets++;
+         }
+
+         size_t start = found.size();
+         for (int b = 0; b < numBuckets; b++)
+            for (int k = starts[buckets[b]]; k < starts[buckets[b] + 1]; k++)
+            {
+               int j = order[k];
+               if (j <= i)
+                  continue;
+               double dx = circles[i].x - circles[j].x;
+               double dy = circles[i].y - circles[j].y;
+               double reach = circles[i].radius + circles[j].radius;
+               if (dx * dx + dy * dy < reach * reach)
+                  found.push_back({ i, j });
+            }
+         std::sort(found.begin() + start, found.end(),
+                   [](const Pair& lhs, const Pair& rhs) { return lhs.j < rhs.j; });
+      }
+   }, numSlices, grain);
+
+   for (int slice = 0; slice < numSlices; slice++)
+      pairs.insert(pairs.end(), partials[slice].begin(), partials[slice].end());
+}
+
+/*********************************************
+ * BROAD PHASE : GET BYTES
+ *********************************************/
+size_t BroadPhase::getBytes() const
+{
+   size_t bytes = cols.capacity() * sizeof(int64_t) + rows.capacity() * sizeof(int64_t) +
+                  starts.capacity() * sizeof(int) + order.capacity() * sizeof(int);
+   for (const std::vector<Pair>& found : partials)
+      bytes += found.capacity() * sizeof(Pair);
+   return bytes;
+}
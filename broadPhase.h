@@ -0,0 +1,73 @@
+/***********************************************************************
+ * Header File:
+ *    BROAD PHASE
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Which things might be touching, without checking every pair
+ ************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>   // for int64_t
+#include <cstddef>   // for NULL and size_t
+
+class TestBroadPhase;
+
+/*********************************************
+ * BROAD PHASE
+ * A grid of square cells twice as wide as the biggest circle, so two
+ * circles that touch are always in the same cell or in cells next to
+ * each other. The cells live in a hash table with room for every circle,
+ * so the grid costs nothing where space is empty. Circles are sorted
+ * into the table in one pass, then each thread takes a slice of them
+ * and looks through the nine cells around each
+ *********************************************/
+class BroadPhase
+{
+public:
+   friend TestBroadPhase;
+
+   struct Circle
+   {
+      double x;        // meters
+      double y;
+      double radius;
+   };
+
+   // Two circles that touch, by where they are in the list. i < j
+   struct Pair
+   {
+      int i;
+      int j;
+   };
+
+   BroadPhase(int numThreads = 0) :
+      numThreads(numThreads), cellSize(0.0), mask(0), pCircles(NULL) {}
+
+   // Sort the circles into the grid
+   void build(const std::vector<Circle>& circles);
+
+   // Every pair that touches, sorted by i and then j however many
+   // threads found them
+   void findPairs(std::vector<Pair>& pairs);
+
+   // How much room the grid takes, in bytes
+   size_t getBytes() const;
+
+private:
+   static const int MIN_PER_THREAD = 1024;   // not worth a thread for fewer
+
+   size_t getBucket(int64_t col, int64_t row) const;
+
+   int numThreads;                          // zero means one per core
+   double cellSize;                         // meters across a cell
+   size_t mask;                             // buckets - 1, a power of two
+   const std::vector<Circle>* pCircles;     // what was built
+   std::vector<int64_t> cols;               // the cell each circle is in
+   std::vector<int64_t> rows;
+   std::vector<int> starts;                 // where each bucket begins in order
+   std::vector<int> order;                  // circles, bucket by bucket
+   std::vector<std::vector<Pair>> partials; // one list for each slice
+};
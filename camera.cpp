@@ -0,0 +1,118 @@
+/***********************************************************************
+ * Source File:
+ *    CAMERA
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Where we are looking and how closely
+ ************************************************************************/
+
+#include "camera.h"
+#include "uiInteract.h"
+#include <cmath>    // for fabs() and pow()
+
+const double PAN_PIXELS = 100.0;   // how far one press of a pan key goes
+const double ZOOM_STEP = 1.5;      // how much one press of a zoom key zooms
+const double POINT_PIXELS = 8.0;   // sprites smaller than this are just points
+const size_t HEATMAP_COUNT = 2000; // more than this on screen becomes a heatmap
+
+/*********************************************
+ * CAMERA : CONSTRUCTOR
+ * Look at the center of the world at the current zoom
+ *********************************************/
+Camera::Camera(const Position& ptUpperRight) :
+   zoom(ptUpperRight.getZoom()),
+   zoomHome(ptUpperRight.getZoom()),
+   halfWidth(ptUpperRight.getPixelsX() / 2.0),
+   halfHeight(ptUpperRight.getPixelsY() / 2.0)
+{
+}
+
+/*********************************************
+ * CAMERA : IS VISIBLE
+ * Could anything drawn at this point land on the screen?
+ *    INPUT  pt            Where the object is, in meters
+ *           marginPixels  How far the drawing reaches from pt
+ *********************************************/
+bool Camera::isVisible(const Position& pt, double marginPixels) const
+{
+   double dx = fabs(pt.getMetersX() - center.getMetersX()) / zoom;
+   double dy = fabs(pt.getMetersY() - center.getMetersY()) / zoom;
+   return dx <= halfWidth + marginPixels && dy <= halfHeight + marginPixels;
+}
+
+/*********************************************
+ * CAMERA : GET DETAIL
+ * Sprites are always drawn the same number of pixels across, so zoomed
+ * out they pile on top of each other and hide how far apart things are.
+ * Once a sprite would stand for less than a few pixels of the world it
+ * started out covering, each object is drawn as a single point instead.
+ * With enough on the screen, even points are too slow and too busy to
+ * read, so a density heatmap is drawn instead
+ *    INPUT  spritePixels  How big a sprite is at the starting zoom
+ *           numVisible    How many objects survived culling
+ *********************************************/
+Camera::Detail Camera::getDetail(double spritePixels, size_t numVisible) const
+{
+   if (numVisible > HEATMAP_COUNT)
+      return HEATMAP;
+   if (spritePixels * getScale() < POINT_PIXELS)
+      return POINT;
+   return SPRITE;
+}
+
+/*********************************************
+ * CAMERA : PAN
+ * Slide the view, measured in pixels at the current zoom
+ *********************************************/
+void Camera::pan(double dxPixels, double dyPixels)
+{
+   center.addMetersX(dxPixels * zoom);
+   center.addMetersY(dyPixels * zoom);
+}
+
+/*********************************************
+ * CAMERA : ZOOM IN
+ * A factor of 2 makes everything look twice as big
+ *********************************************/
+void Camera::zoomIn(double factor)
+{
+   if (factor > 0.0)
+      zoom /= factor;
+}
+
+/*********************************************
+ * CAMERA : RESET
+ * Back to where we started
+ *********************************************/
+void Camera::reset()
+{
+   center = Position();
+   zoom = zoomHome;
+}
+
+/*********************************************
+ * CAMERA : INPUT
+ * Zoom with + and -, pan with W A S D, and C to come home
+ *********************************************/
+void Camera::input(const Interface& ui)
+{
+   if (ui.isHome())
+      reset();
+   if (ui.getZoomSteps())
+      zoomIn(pow(ZOOM_STEP, ui.getZoomSteps()));
+   if (ui.getPanX() || ui.getPanY())
+      pan(PAN_PIXELS * ui.getPanX(), PAN_PIXELS * ui.getPanY());
+}
+
+/*********************************************
+ * CAMERA : APPLY
+ * Pixels everywhere are measured at our zoom until this is undone
+ *********************************************/
+double Camera::apply() const
+{
+   Position pt;
+   double zoomOld = pt.getZoom();
+   pt.setZoom(zoom);
+   return zoomOld;
+}
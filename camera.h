@@ -0,0 +1,58 @@
+/***********************************************************************
+ * Header File:
+ *    CAMERA
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Where we are looking and how closely
+ ************************************************************************/
+
+#pragma once
+
+#include "position.h"
+#include <cstddef>   // for size_t
+
+class Interface;
+class TestCamera;
+
+/*********************************************
+ * CAMERA
+ * The part of the world that shows up on the screen. The center is
+ * in meters, the zoom is in meters per pixel
+ *********************************************/
+class Camera
+{
+public:
+   friend TestCamera;
+
+   // How much detail to draw each object with
+   enum Detail { SPRITE, POINT, HEATMAP };
+
+   // ptUpperRight is the size of the screen, just like Interface takes
+   Camera(const Position& ptUpperRight);
+
+   // getters
+   const Position& getCenter() const { return center; }
+   double getZoom()            const { return zoom;   }
+   double getScale()           const { return zoomHome / zoom; }
+   bool isVisible(const Position& pt, double marginPixels) const;
+   Detail getDetail(double spritePixels, size_t numVisible) const;
+
+   // setters
+   void setCenter(const Position& pt)  { center = pt; }
+   void setZoom(double metersPerPixel) { zoom = metersPerPixel; }
+   void pan(double dxPixels, double dyPixels);
+   void zoomIn(double factor);
+   void reset();
+   void input(const Interface& ui);
+
+   // Make Position convert to pixels at our zoom. Returns the old zoom
+   double apply() const;
+
+private:
+   Position center;        // middle of the screen, in meters
+   double zoom;            // meters per pixel
+   double zoomHome;        // the zoom we started with
+   double halfWidth;       // half the screen width, in pixels
+   double halfHeight;      // half the screen height, in pixels
+};
@@ -0,0 +1,400 @@
+/***********************************************************************
+ * Source File:
+ *    CATALOG
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Real satellites from a two-line element file, laid flat so the
+ *    simulator can fly them
+ ************************************************************************/
+
+#include "catalog.h"
+#include "parallel.h"
+#define _USE_MATH_DEFINES
+#include <cmath>     // for sqrt(), cbrt(), sin(), cos(), and M_PI
+#include <cstring>   // for memchr() and memcpy()
+#include <algorithm> // for min() and max()
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h> // for CreateFileMapping() and MapViewOfFile()
+#else
+#include <sys/mman.h>   // for mmap()
+#include <sys/stat.h>   // for fstat()
+#include <fcntl.h>      // for open()
+#include <unistd.h>     // for close()
+#endif
+
+const double SECONDS_PER_DAY = 86400.0;
+const double RADIANS_PER_DEGREE = M_PI / 180.0;
+const size_t LINE_LENGTH = 69;   // the checksum is the last
+
+/*********************************************
+ * READ NUMBER
+ * A number from a fixed-width field: spaces, a sign, digits, and maybe
+ * a point. With isFraction, the digits are all after a point the field
+ * leaves out, as the eccentricity's are. The digits are gathered as a
+ * whole number and divided once, so the result is as close as a double
+ * can be
+ *********************************************/
+static bool readNumber(const char* p, int width, double& value, bool isFraction = false)
+{
+   static const double POWERS[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+                                    1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18 };
+   const char* pEnd = p + width;
+   while (p < pEnd && *p == ' ')
+      p++;
+   bool isNegative = p < pEnd && *p == '-';
+   if (p < pEnd && (*p == '-' || *p == '+'))
+      p++;
+
+   uint64_t digits = 0;
+   int numDigits = 0;
+   int numFraction = 0;
+   bool isPoint = false;
+   for (; p < pEnd && *p != ' '; p++)
+      if (*p >= '0' && *p <= '9' && numDigits < 18)
+      {
+         digits = digits * 10 + (*p - '0');
+         numDigits++;
+         if (isPoint || isFraction)
+            numFraction++;
+      }
+      else if (*p == '.' && !isPoint && !isFraction)
+         isPoint = true;
+      else
+         return false;
+   while (p < pEnd && *p == ' ')
+      p++;
+   if (p != pEnd || numDigits == 0)
+      return false;
+
+   value = (double)digits / POWERS[numFraction];
+   if (isNegative)
+      value = -value;
+   return true;
+}
+
+/*********************************************
+ * READ CATALOG NUMBER
+ * Five characters. Past 99999 the first is a letter, leaving out I and
+ * O, so A0000 is 100000 (the "Alpha-5" numbers)
+ *********************************************/
+static bool readCatalogNumber(const char* p, uint32_t& number)
+{
+   static const char LETTERS[] = "ABCDEFGHJKLMNPQRSTUVWXYZ";
+   uint32_t first;
+   if (*p >= '0' && *p <= '9')
+      first = *p - '0';
+   else if (const char* pLetter = (const char*)memchr(LETTERS, *p, sizeof(LETTERS) - 1))
+      first = 10 + (uint32_t)(pLetter - LETTERS);
+   else if (*p == ' ')
+      first = 0;
+   else
+      return false;
+
+   double rest;
+   if (!readNumber(p + 1, 4, rest))
+      return false;
+   number = first * 10000 + (uint32_t)rest;
+   return true;
+}
+
+/*********************************************
+ * IS CHECKSUM GOOD
+ * The last character is the sum of the digits before it, counting a
+ * minus sign as one, modulo ten
+ *********************************************/
+static bool isChecksumGood(const char* line)
+{
+   int sum = 0;
+   for (size_t i = 0; i < LINE_LENGTH - 1; i++)
+      if (line[i] >= '0' && line[i] <= '9')
+         sum += line[i] - '0';
+      else if (line[i] == '-')
+         sum++;
+   return line[LINE_LENGTH - 1] == '0' + sum % 10;
+}
+
+/*********************************************
+ * CATALOG : GET DAYS TO YEAR
+ *********************************************/
+double Catalog::getDaysToYear(int year)
+{
+   auto getDays = [](long y) { return 365 * (y - 1) + (y - 1) / 4 - (y - 1) / 100 + (y - 1) / 400; };
+   return (double)(getDays(year) - getDays(2000));
+}
+
+/*********************************************
+ * CATALOG : PARSE one set
+ * Columns are counted from one in the format, and from zero here
+ *********************************************/
+bool Catalog::parse(const char* line1, const char* line2, const char* pName,
+                    size_t nameLength, Elements& elements)
+{
+   if (line1[0] != '1' || line2[0] != '2' || !isChecksumGood(line1) || !isChecksumGood(line2))
+      return false;
+
+   uint32_t number2;
+   double year;
+   double day;
+   double inclination;
+   double ascending;
+   double perigee;
+   double meanAnomaly;
+   double revolutionsPerDay;
+   if (!readCatalogNumber(line1 + 2, elements.number) ||
+       !readCatalogNumber(line2 + 2, number2) || number2 != elements.number ||
+       !readNumber(line1 + 18, 2, year) ||
+       !readNumber(line1 + 20, 12, day) ||
+       !readNumber(line2 + 8, 8, inclination) ||
+       !readNumber(line2 + 17, 8, ascending) ||
+       !readNumber(line2 + 26, 7, elements.eccentricity, true /*isFraction*/) ||
+       !readNumber(line2 + 34, 8, perigee) ||
+       !readNumber(line2 + 43, 8, meanAnomaly) ||
+       !readNumber(line2 + 52, 11, revolutionsPerDay) ||
+       revolutionsPerDay <= 0.0 || elements.eccentricity >= 1.0)
+      return false;
+
+   // two digit years: 57 and later are the 1900s, when it all started
+   elements.epoch = getDaysToYear((int)year + (year < 57.0 ? 2000 : 1900)) + day - 1.0;
+   elements.inclination = inclination * RADIANS_PER_DEGREE;
+   elements.ascending = ascending * RADIANS_PER_DEGREE;
+   elements.perigee = perigee * RADIANS_PER_DEGREE;
+   elements.meanAnomaly = meanAnomaly * RADIANS_PER_DEGREE;
+   elements.meanMotion = revolutionsPerDay * 2.0 * M_PI / SECONDS_PER_DAY;
+
+   // a three line set starts its name with a zero
+   if (pName && nameLength >= 2 && pName[0] == '0' && pName[1] == ' ')
+   {
+      pName += 2;
+      nameLength -= 2;
+   }
+   while (pName && nameLength > 0 && pName[nameLength - 1] == ' ')
+      nameLength--;
+   nameLength = pName ? std::min(nameLength, sizeof(elements.name) - 1) : 0;
+   if (nameLength)
+      memcpy(elements.name, pName, nameLength);
+   elements.name[nameLength] = '\0';
+   return true;
+}
+
+/*********************************************
+ * LINE
+ * Where a line starts and how long it is, without its line end
+ *********************************************/
+struct Line
+{
+   const char* p;
+   size_t length;
+   const char* pNext;   // where the next one starts
+};
+
+static Line getLine(const char* p, const char* pEnd)
+{
+   const char* pNewline = (const char*)memchr(p, '\n', pEnd - p);
+   const char* pLineEnd = pNewline ? pNewline : pEnd;
+   Line line = { p, (size_t)(pLineEnd - p), pNewline ? pNewline + 1 : pEnd };
+   if (line.length > 0 && p[line.length - 1] == '\r')
+      line.length--;
+   return line;
+}
+
+static bool isElementLine(const Line& line, char first)
+{
+   return line.length >= LINE_LENGTH && line.p[0] == first && line.p[1] == ' ';
+}
+
+/*********************************************
+ * CATALOG : PARSE text
+ * Cut the text into a few pieces for each thread at line ends. A piece
+ * owns every set whose first line starts in it, looking back a line for
+ * the name and ahead a line for the second line when it has to
+ *********************************************/
+void Catalog::parse(const char* text, size_t numBytes, int numThreads)
+{
+   const char* pTextEnd = text + numBytes;
+   int numPieces = (int)std::max((size_t)1,
+      std::min((size_t)numWorkers(numThreads) * 4, numBytes / 65536 + 1));
+   std::vector<const char*> starts(numPieces + 1);
+   for (int piece = 0; piece <= numPieces; piece++)
+   {
+      const char* p = text + numBytes * piece / numPieces;
+      if (p != text && p != pTextEnd && p[-1] != '\n')
+      {
+         const char* pNewline = (const char*)memchr(p, '\n', pTextEnd - p);
+         p = pNewline ? pNewline + 1 : pTextEnd;
+      }
+      starts[piece] = p;
+   }
+
+   pieces.resize(numPieces);
+   numRejectedPieces.assign(numPieces, 0);
+   parallelFor(numPieces, [&](int first, int last)
+   {
+      for (int piece = first; piece < last; piece++)
+      {
+         // every set takes at least two whole lines, so this is room enough
+         std::vector<Elements>& found = pieces[piece];
+         found.clear();
+         found.reserve((starts[piece + 1] - starts[piece]) / (2 * LINE_LENGTH) + 1);
+
+         // the line before the piece, in case it is a name
+         Line previous = { NULL, 0, starts[piece] };
+         if (starts[piece] != text)
+         {
+            const char* p = starts[piece] - 1;
+            while (p != text && p[-1] != '\n')
+               p--;
+            previous = getLine(p, pTextEnd);
+         }
+
+         const char* p = starts[piece];
+         while (p < starts[piece + 1])
+         {
+            Line line = getLine(p, pTextEnd);
+            if (isElementLine(line, '1'))
+            {
+               Line line2 = getLine(line.pNext, pTextEnd);
+               bool isName = previous.p && !isElementLine(previous, '1') &&
+                             !isElementLine(previous, '2') && previous.length > 0;
+               Elements elements;
+               if (isElementLine(line2, '2') &&
+                   parse(line.p, line2.p, isName ? previous.p : NULL, previous.length, elements))
+                  found.push_back(elements);
+               else
+                  numRejectedPieces[piece]++;
+               if (isElementLine(line2, '2'))
+                  line = line2;
+            }
+            previous = line;
+            p = line.pNext;
+         }
+      }
+   }, numThreads, 1);
+
+   size_t numFound = 0;
+   for (const std::vector<Elements>& found : pieces)
+      numFound += found.size();
+   elements.clear();
+   elements.reserve(numFound);
+   numRejected = 0;
+   for (int piece = 0; piece < numPieces; piece++)
+   {
+      elements.insert(elements.end(), pieces[piece].begin(), pieces[piece].end());
+      numRejected += numRejectedPieces[piece];
+   }
+   epochLatest = 0.0;
+   for (const Elements& each : elements)
+      epochLatest = std::max(epochLatest, each.epoch);
+}
+
+/*********************************************
+ * CATALOG : LOAD
+ * Map the file and parse it where it lies
+ *********************************************/
+bool Catalog::load(const char* fileName, int numThreads)
+{
+#ifdef _WIN32
+   HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                             FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+   if (file == INVALID_HANDLE_VALUE)
+      return false;
+   LARGE_INTEGER size;
+   if (!GetFileSizeEx(file, &size))
+   {
+      CloseHandle(file);
+      return false;
+   }
+   if (size.QuadPart == 0)
+   {
+      CloseHandle(file);
+      parse("", 0, numThreads);
+      return true;
+   }
+   HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+   const char* text = mapping ? (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+   if (text)
+   {
+      parse(text, (size_t)size.QuadPart, numThreads);
+      UnmapViewOfFile(text);
+   }
+   if (mapping)
+      CloseHandle(mapping);
+   CloseHandle(file);
+   return text != NULL;
+#else
+   int file = open(fileName, O_RDONLY);
+   if (file < 0)
+      return false;
+   struct stat status;
+   if (fstat(file, &status) != 0)
+   {
+      close(file);
+      return false;
+   }
+   size_t numBytes = (size_t)status.st_size;
+   if (numBytes == 0)
+   {
+      close(file);
+      parse("", 0, numThreads);
+      return true;
+   }
+   void* pMapped = mmap(NULL, numBytes, PROT_READ, MAP_PRIVATE, file, 0);
+   close(file);
+   if (pMapped == MAP_FAILED)
+      return false;
+   madvise(pMapped, numBytes, MADV_SEQUENTIAL);
+   parse((const char*)pMapped, numBytes, numThreads);
+   munmap(pMapped, numBytes);
+   return true;
+#endif
+}
+
+/*********************************************
+ * CATALOG : GET STATE
+ * Move the mean anomaly on to the epoch, solve Kepler's equation for
+ * the eccentric anomaly with Newton's method, and find the position and
+ * velocity in the plane of the orbit with the perigee along x. Then turn
+ * that to where the perigee points. The size of the orbit comes from the
+ * mean motion and the simulator's own gravity, so the period comes out
+ * as the file says it should
+ *********************************************/
+Integrator::State Catalog::getState(const Elements& elements, double epoch)
+{
+   double n = elements.meanMotion;
+   double e = elements.eccentricity;
+   double a = cbrt(Integrator::MU / (n * n));
+
+   double M = fmod(elements.meanAnomaly + n * (epoch - elements.epoch) * SECONDS_PER_DAY, 2.0 * M_PI);
+   double E = e < 0.8 ? M : M_PI;
+   for (int i = 0; i < 50; i++)
+   {
+      double step = (E - e * sin(E) - M) / (1.0 - e * cos(E));
+      E -= step;
+      if (fabs(step) < 1e-14)
+         break;
+   }
+
+   double c = cos(E);
+   double s = sin(E);
+   double root = sqrt(1.0 - e * e);
+   double r = a * (1.0 - e * c);
+   double speed = sqrt(Integrator::MU * a) / r;
+   double x = a * (c - e);
+   double y = a * root * s;
+   double dx = -speed * s;
+   double dy = speed * root * c;
+
+   // going the other way round: mirror it, and the perigee is measured
+   // the other way from the node
+   double turn = elements.ascending + elements.perigee;
+   if (cos(elements.inclination) < 0.0)
+   {
+      y = -y;
+      dy = -dy;
+      turn = elements.ascending - elements.perigee;
+   }
+   double ct = cos(turn);
+   double st = sin(turn);
+   return { x * ct - y * st, x * st + y * ct, dx * ct - dy * st, dx * st + dy * ct };
+}
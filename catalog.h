@@ -0,0 +1,89 @@
+/***********************************************************************
+ * Header File:
+ *    CATALOG
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Real satellites from a two-line element file, laid flat so the
+ *    simulator can fly them
+ ************************************************************************/
+
+#pragma once
+
+#include "integrator.h"
+#include <vector>
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint32_t
+
+class TestCatalog;
+
+/*********************************************
+ * CATALOG
+ * The orbits in a two-line element (TLE) file, the format the public
+ * catalogs come in. Each object is two fixed-width lines of 69
+ * characters, and often a line with its name before them.
+ * The file is mapped into memory rather than read, cut into pieces at
+ * line ends, and each piece parsed on a thread of its own straight out
+ * of the mapping. Numbers are read digit by digit from their columns,
+ * and names go in a fixed array, so nothing is allocated for a line.
+ * Sets whose checksums or catalog numbers do not agree are counted and
+ * left out
+ *********************************************/
+class Catalog
+{
+public:
+   friend TestCatalog;
+
+   // One object's orbit, as the file gives it but in radians
+   struct Elements
+   {
+      char name[25];          // up to 24 characters, empty when there was none
+      uint32_t number;        // NORAD catalog number
+      double epoch;           // days since 2000-01-01 00:00 UTC
+      double inclination;     // radians
+      double ascending;       // right ascension of the ascending node, radians
+      double eccentricity;
+      double perigee;         // argument of perigee, radians
+      double meanAnomaly;     // radians
+      double meanMotion;      // radians per second
+   };
+
+   Catalog() : numRejected(0), epochLatest(0.0) {}
+
+   // Read a TLE file, on this many threads or one per core. False when
+   // the file cannot be opened
+   bool load(const char* fileName, int numThreads = 0);
+
+   // The same for text already in memory
+   void parse(const char* text, size_t numBytes, int numThreads = 0);
+
+   // One set. The lines need not end in a zero; only their first 69
+   // characters are looked at. pName may be NULL
+   static bool parse(const char* line1, const char* line2, const char* pName,
+                     size_t nameLength, Elements& elements);
+
+   const std::vector<Elements>& getElements() const { return elements; }
+   size_t size() const { return elements.size(); }
+   size_t getNumRejected() const { return numRejected; }
+
+   // The newest epoch in the file, which is when getState() puts
+   // everything by default
+   double getEpochLatest() const { return epochLatest; }
+
+   // Where the object is at epoch, days since 2000, laid flat. Each
+   // orbit keeps its size, its shape, and where along it the object
+   // is, but is turned down onto the equator: the node and the perigee
+   // add up to where the perigee points. Orbits that go round the other
+   // way, inclined more than 90 degrees, still do
+   static Integrator::State getState(const Elements& elements, double epoch);
+
+   // Days from 2000-01-01 to the first of January of the year
+   static double getDaysToYear(int year);
+
+private:
+   std::vector<Elements> elements;
+   std::vector<std::vector<Elements>> pieces;   // one per piece of the file
+   std::vector<size_t> numRejectedPieces;
+   size_t numRejected;
+   double epochLatest;
+};
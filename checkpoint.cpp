@@ -0,0 +1,345 @@
+/***********************************************************************
+ * Source File:
+ *    CHECKPOINT
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Everything a simulation is at one moment, saved so a long run can
+ *    be picked up again exactly where it left off
+ ************************************************************************/
+
+#include "checkpoint.h"
+#include "Satellite.h"
+#include "Sputnik.h"
+#include "Hubble.h"
+#include "Starlink.h"
+#include "CrewDragon.h"
+#include "GPS.h"
+#include "Ship.h"
+#include "Debris.h"
+#include "scenario.h"
+#include <cstdio>      // for fopen(), fwrite(), and rename()
+#include <cstring>     // for memcpy() and memcmp()
+#include <filesystem>  // for file_size()
+#include <iterator>    // for next()
+#ifdef _WIN32
+#include <io.h>        // for _commit()
+#include <windows.h>   // for MoveFileEx()
+#else
+#include <unistd.h>    // for fsync()
+#endif
+
+/*********************************************
+ * HASH
+ * FNV-1a a word at a time rather than a byte at a time, which is plenty
+ * to catch a damaged file and fast enough for gigabytes. Everything
+ * hashed is a whole number of words
+ *********************************************/
+const uint64_t HASH_START = 14695981039346656037ull;
+
+static uint64_t hash(uint64_t value, const void* p, size_t bytes)
+{
+   const unsigned char* pByte = (const unsigned char*)p;
+   for (size_t i = 0; i + sizeof(uint64_t) <= bytes; i += sizeof(uint64_t))
+   {
+      uint64_t word;
+      memcpy(&word, pByte + i, sizeof(word));
+      value = (value ^ word) * 1099511628211ull;
+   }
+   return value;
+}
+
+/*********************************************
+ * CHECKPOINT : GET LAYOUT
+ *********************************************/
+Checkpoint::Header Checkpoint::getLayout(uint64_t numRecords, uint64_t numStars,
+                                         uint64_t randomBytes)
+{
+   auto align = [](uint64_t bytes) { return (bytes + ALIGN - 1) / ALIGN * ALIGN; };
+
+   Header header = {};
+   memcpy(header.magic, "ORBITCKP", sizeof(header.magic));
+   header.version = VERSION;
+   header.byteOrder = ENDIAN_MARK;
+   header.numRecords = numRecords;
+   header.recordsOffset = align(sizeof(Header));
+   header.numStars = numStars;
+   header.starsOffset = align(header.recordsOffset + numRecords * sizeof(Record));
+   header.randomBytes = randomBytes;
+   header.randomOffset = align(header.starsOffset + numStars * sizeof(Star));
+   header.fileBytes = align(header.randomOffset + randomBytes);
+   return header;
+}
+
+/*********************************************
+ * CHECKPOINT : ADD
+ *********************************************/
+void Checkpoint::add(const Satellite& satellite)
+{
+   Record record = {};
+   record.kind = satellite.getKind();
+   record.flags = satellite.dead ? DEAD : 0;
+#ifdef NDEBUG
+   if (satellite.useRandom)
+      record.flags |= USE_RANDOM;
+#endif
+   record.age = satellite.age;
+   record.x = satellite.pos.getMetersX();
+   record.y = satellite.pos.getMetersY();
+   record.dx = satellite.velocity.getDX();
+   record.dy = satellite.velocity.getDY();
+   record.radians = satellite.angle.getRadians();
+   record.angularVelocity = satellite.angularVelocity;
+   record.radius = satellite.radius;
+   if (record.kind == Satellite::SHIP)
+   {
+      const Ship& ship = (const Ship&)satellite;
+      record.extra[0] = ship.thrust.getDDX();
+      record.extra[1] = ship.thrust.getDDY();
+   }
+   records.push_back(record);
+}
+
+/*********************************************
+ * CHECKPOINT : CREATE
+ * Make one of the right kind, then put back everything about it. The
+ * pieces of a breakup start where their parent is, but where that is
+ * makes no difference when it is about to be written over
+ *********************************************/
+Satellite* Checkpoint::create(const Record& record)
+{
+   Satellite parent;
+   Satellite* pSatellite;
+   switch (record.kind)
+   {
+      case Satellite::SATELLITE:          pSatellite = new Satellite();                break;
+      case Satellite::SPUTNIK:            pSatellite = new Sputnik();                  break;
+      case Satellite::HUBBLE:             pSatellite = new Hubble();                   break;
+      case Satellite::HUBBLE_TELESCOPE:   pSatellite = new HubbleTelescope(parent);    break;
+      case Satellite::HUBBLE_COMPUTER:    pSatellite = new HubbleComputer(parent);     break;
+      case Satellite::HUBBLE_LEFT_ARRAY:  pSatellite = new HubbleLeftArray(parent);    break;
+      case Satellite::HUBBLE_RIGHT_ARRAY: pSatellite = new HubbleRightArray(parent);   break;
+      case Satellite::STARLINK:           pSatellite = new Starlink();                 break;
+      case Satellite::STARLINK_BODY:      pSatellite = new StarlinkBody(parent);       break;
+      case Satellite::STARLINK_ARRAY:     pSatellite = new StarlinkArray(parent);      break;
+      case Satellite::CREW_DRAGON:        pSatellite = new CrewDragon();               break;
+      case Satellite::CREW_DRAGON_CENTER: pSatellite = new CrewDragonCenter(parent);   break;
+      case Satellite::CREW_DRAGON_LEFT:   pSatellite = new CrewDragonLeft(parent);     break;
+      case Satellite::CREW_DRAGON_RIGHT:  pSatellite = new CrewDragonRight(parent);    break;
+      case Satellite::GPS_SATELLITE:      pSatellite = new GPS();                      break;
+      case Satellite::GPS_CENTER:         pSatellite = new GPSCenter(parent);          break;
+      case Satellite::GPS_LEFT_ARRAY:     pSatellite = new GPSLeftArray(parent);       break;
+      case Satellite::GPS_RIGHT_ARRAY:    pSatellite = new GPSRightArray(parent);      break;
+      case Satellite::SHIP:               pSatellite = new Ship();                     break;
+      case Satellite::DEBRIS:             pSatellite = new Debris(Integrator::State()); break;
+      default:
+         return NULL;
+   }
+
+   pSatellite->pos.setMetersX(record.x);
+   pSatellite->pos.setMetersY(record.y);
+   pSatellite->velocity.setDX(record.dx);
+   pSatellite->velocity.setDY(record.dy);
+   pSatellite->angle.setRadians(record.radians);
+   pSatellite->angularVelocity = record.angularVelocity;
+   pSatellite->radius = record.radius;
+   pSatellite->age = record.age;
+   pSatellite->dead = (record.flags & DEAD) != 0;
+#ifdef NDEBUG
+   pSatellite->useRandom = (record.flags & USE_RANDOM) != 0;
+#endif
+   if (record.kind == Satellite::SHIP)
+   {
+      Ship* pShip = (Ship*)pSatellite;
+      pShip->thrust.setDDX(record.extra[0]);
+      pShip->thrust.setDDY(record.extra[1]);
+   }
+   return pSatellite;
+}
+
+/*********************************************
+ * CHECKPOINT : CREATE ALL
+ * Make every satellite again, in order, and find the ship among them.
+ * A record of a kind we do not know leaves one fewer than there are
+ * records, so the ship is looked for only once they are all made
+ *    OUTPUT satellites  What was made, or nothing
+ *           pShip       The ship, or NULL when there was none
+ *           <return>    False when a record or the ship is no good
+ *********************************************/
+bool Checkpoint::createAll(std::list<Satellite*>& satellites, Satellite*& pShip) const
+{
+   satellites.clear();
+   pShip = NULL;
+   bool isGood = true;
+   for (const Record& record : records)
+   {
+      Satellite* pSatellite = create(record);
+      isGood = isGood && pSatellite;
+      if (pSatellite)
+         satellites.push_back(pSatellite);
+   }
+
+   if (isGood && shipIndex >= 0)
+   {
+      if (shipIndex < (int32_t)satellites.size())
+         pShip = *std::next(satellites.begin(), shipIndex);
+      isGood = pShip && pShip->getKind() == Satellite::SHIP;
+   }
+
+   if (!isGood)
+   {
+      for (Satellite* pSatellite : satellites)
+         delete pSatellite;
+      satellites.clear();
+      pShip = NULL;
+   }
+   return isGood;
+}
+
+/*********************************************
+ * CHECKPOINT : WRITE
+ * The header goes first with no checksum, then each section with the
+ * zeros that pad it out, and then the header again once the checksum
+ * of all that is known. Only when all of that is safely on the disk does the new
+ * file take the old one's name
+ *********************************************/
+bool Checkpoint::write(const char* fileName) const
+{
+   Header header = getLayout(records.size(), stars.size(), random.size());
+   header.secondsSimulated = secondsSimulated;
+   header.timeWarp = timeWarp;
+   header.cameraX = cameraX;
+   header.cameraY = cameraY;
+   header.cameraZoom = cameraZoom;
+   header.integrator = integrator;
+   header.shipIndex = shipIndex;
+
+   std::string temporary = std::string(fileName) + ".tmp";
+   FILE* file = fopen(temporary.c_str(), "wb");
+   if (!file)
+      return false;
+
+   static const char zeros[ALIGN] = {};
+   uint64_t checksum = hash(HASH_START, &header, sizeof(header));
+   uint64_t at = sizeof(Header);
+   bool isGood = fwrite(&header, sizeof(header), 1, file) == 1;
+   auto put = [&](const void* p, uint64_t bytes)
+   {
+      checksum = hash(checksum, p, (size_t)bytes);
+      isGood = isGood && fwrite(p, 1, (size_t)bytes, file) == bytes;
+      at += bytes;
+   };
+   auto padTo = [&](uint64_t offset) { put(zeros, offset - at); };
+
+   padTo(header.recordsOffset);
+   put(records.data(), records.size() * sizeof(Record));
+   padTo(header.starsOffset);
+   put(stars.data(), stars.size() * sizeof(Star));
+   padTo(header.randomOffset);
+
+   // the last section is text, so pad it with zeros before hashing
+   std::vector<char> tail(header.fileBytes - header.randomOffset, 0);
+   memcpy(tail.data(), random.data(), random.size());
+   put(tail.data(), tail.size());
+
+   header.checksum = checksum;
+   isGood = isGood && fseek(file, 0, SEEK_SET) == 0 &&
+            fwrite(&header, sizeof(header), 1, file) == 1;
+   isGood = fflush(file) == 0 && isGood;
+#ifdef _WIN32
+   isGood = isGood && _commit(_fileno(file)) == 0;
+#else
+   isGood = isGood && fsync(fileno(file)) == 0;
+#endif
+   isGood = fclose(file) == 0 && isGood;
+
+#ifdef _WIN32
+   isGood = isGood && MoveFileExA(temporary.c_str(), fileName,
+                                  MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+   isGood = isGood && rename(temporary.c_str(), fileName) == 0;
+#endif
+   if (!isGood)
+      remove(temporary.c_str());
+   return isGood;
+}
+
+/*********************************************
+ * CHECKPOINT : READ
+ * Check the header against the file before believing any of the counts
+ * in it, then read each section straight into place. Nothing is kept
+ * until the checksum says it all arrived as it was written
+ *********************************************/
+bool Checkpoint::read(const char* fileName)
+{
+   std::error_code error;
+   uint64_t fileBytes = std::filesystem::file_size(fileName, error);
+   if (error)
+      return false;
+
+   FILE* file = fopen(fileName, "rb");
+   if (!file)
+      return false;
+
+   Header header;
+   bool isGood = fread(&header, sizeof(header), 1, file) == 1 &&
+                 memcmp(header.magic, "ORBITCKP", sizeof(header.magic)) == 0 &&
+                 header.version == VERSION &&
+                 header.byteOrder == ENDIAN_MARK &&
+                 header.fileBytes == fileBytes &&
+                 header.numRecords <= fileBytes / sizeof(Record) &&
+                 header.numStars <= fileBytes / sizeof(Star) &&
+                 header.randomBytes <= fileBytes &&
+                 header.shipIndex >= -1 && header.shipIndex < (int64_t)header.numRecords;
+   if (isGood)
+   {
+      Header layout = getLayout(header.numRecords, header.numStars, header.randomBytes);
+      isGood = layout.recordsOffset == header.recordsOffset &&
+               layout.starsOffset == header.starsOffset &&
+               layout.randomOffset == header.randomOffset &&
+               layout.fileBytes == header.fileBytes;
+   }
+   if (!isGood)
+   {
+      fclose(file);
+      return false;
+   }
+
+   char padding[ALIGN];
+   Header unsummed = header;
+   unsummed.checksum = 0;
+   uint64_t checksum = hash(HASH_START, &unsummed, sizeof(unsummed));
+   uint64_t at = sizeof(Header);
+   auto get = [&](void* p, uint64_t bytes)
+   {
+      isGood = isGood && fread(p, 1, (size_t)bytes, file) == bytes;
+      checksum = hash(checksum, p, (size_t)bytes);
+      at += bytes;
+   };
+   auto skipTo = [&](uint64_t offset) { get(padding, offset - at); };
+
+   std::vector<Record> recordsRead(header.numRecords);
+   std::vector<Star> starsRead(header.numStars);
+   std::vector<char> tail(header.fileBytes - header.randomOffset);
+   skipTo(header.recordsOffset);
+   get(recordsRead.data(), recordsRead.size() * sizeof(Record));
+   skipTo(header.starsOffset);
+   get(starsRead.data(), starsRead.size() * sizeof(Star));
+   skipTo(header.randomOffset);
+   get(tail.data(), tail.size());
+   fclose(file);
+   if (!isGood || checksum != header.checksum)
+      return false;
+
+   secondsSimulated = header.secondsSimulated;
+   timeWarp = header.timeWarp;
+   cameraX = header.cameraX;
+   cameraY = header.cameraY;
+   cameraZoom = header.cameraZoom;
+   integrator = header.integrator;
+   shipIndex = header.shipIndex;
+   records.swap(recordsRead);
+   stars.swap(starsRead);
+   random.assign(tail.data(), (size_t)header.randomBytes);
+   return true;
+}
@@ -0,0 +1,129 @@
+/***********************************************************************
+ * Header File:
+ *    CHECKPOINT
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Everything a simulation is at one moment, saved so a long run can
+ *    be picked up again exactly where it left off
+ ************************************************************************/
+
+#pragma once
+
+#include <list>
+#include <vector>
+#include <string>
+#include <cstdint>   // for uint32_t and uint64_t
+
+class Satellite;
+class TestCheckpoint;
+
+/*********************************************
+ * CHECKPOINT
+ * The file is a header and then three sections: a record for each
+ * satellite, a record for each star, and the state of the random number
+ * generator. Every record is a fixed size with nothing to decode, and
+ * every section starts on a 64 byte boundary, so a section can be read
+ * straight into memory or mapped and used where it lies. Numbers are
+ * written the way this machine holds them; the header says which way
+ * that is, and a checkpoint from a machine that differs is refused.
+ * A checksum covers the whole file, with the checksum itself counted as
+ * zero, so a damaged time or camera is caught as well. Writing goes to a
+ * temporary file first and then renames it over the old checkpoint, so
+ * a run stopped part way through leaves the last good one alone
+ *********************************************/
+class Checkpoint
+{
+public:
+   friend TestCheckpoint;
+
+   static const uint32_t VERSION = 2;
+
+   // One satellite, exactly as it was
+   struct Record
+   {
+      uint32_t kind;            // Satellite::Kind
+      uint32_t flags;           // DEAD, USE_RANDOM
+      int32_t age;
+      uint32_t unused;
+      double x;                 // meters
+      double y;
+      double dx;                // m/s
+      double dy;
+      double radians;           // which way it points
+      double angularVelocity;
+      double radius;
+      double extra[2];          // the ship's thrust
+   };
+   enum Flags { DEAD = 1, USE_RANDOM = 2 };
+
+   // One star in the background
+   struct Star
+   {
+      double x;                 // meters
+      double y;
+      uint32_t phase;
+      uint32_t unused;
+   };
+
+   Checkpoint() : secondsSimulated(0.0), timeWarp(0.0), cameraX(0.0), cameraY(0.0),
+                  cameraZoom(0.0), integrator(0), shipIndex(-1) {}
+
+   // Record a satellite, or make one again from its record. The caller
+   // owns what is made. NULL for a record of no kind we know
+   void add(const Satellite& satellite);
+   static Satellite* create(const Record& record);
+
+   // Make every record again, in order. False, with nothing made, when a
+   // record is of no kind we know or shipIndex is not a ship
+   bool createAll(std::list<Satellite*>& satellites, Satellite*& pShip) const;
+
+   // False when the file cannot be written. The old checkpoint is left
+   // as it was
+   bool write(const char* fileName) const;
+
+   // False when the file is missing, from another version or another
+   // kind of machine, cut short, or damaged. Nothing changes then
+   bool read(const char* fileName);
+
+   // Everything else about the simulation
+   double secondsSimulated;
+   double timeWarp;
+   double cameraX;              // where the camera looks, meters
+   double cameraY;
+   double cameraZoom;           // meters per pixel
+   int32_t integrator;          // Integrator::Method
+   int32_t shipIndex;           // which record is the ship, or -1
+   std::vector<Record> records;
+   std::vector<Star> stars;
+   std::string random;          // getRandomState()
+
+private:
+   struct Header
+   {
+      char magic[8];            // "ORBITCKP"
+      uint32_t version;
+      uint32_t byteOrder;       // ENDIAN_MARK as this machine holds it
+      uint64_t fileBytes;
+      uint64_t checksum;        // of the whole file, this counted as zero
+      uint64_t numRecords;
+      uint64_t recordsOffset;   // bytes from the start of the file
+      uint64_t numStars;
+      uint64_t starsOffset;
+      uint64_t randomBytes;
+      uint64_t randomOffset;
+      double secondsSimulated;
+      double timeWarp;
+      double cameraX;
+      double cameraY;
+      double cameraZoom;
+      int32_t integrator;
+      int32_t shipIndex;
+   };
+
+   static const uint32_t ENDIAN_MARK = 0x01020304;
+   static const uint64_t ALIGN = 64;
+
+   // Where each section goes for this many records, stars, and bytes
+   static Header getLayout(uint64_t numRecords, uint64_t numStars, uint64_t randomBytes);
+};
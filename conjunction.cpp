@@ -0,0 +1,443 @@
+/***********************************************************************
+ * Source File:
+ *    CONJUNCTION
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Which pairs of things in orbit will pass close to each other in
+ *    the time ahead, without trying every pair at every moment
+ ************************************************************************/
+
+#include "conjunction.h"
+#include "parallel.h"
+#define _USE_MATH_DEFINES
+#include <cmath>     // for sqrt(), asin(), acos(), atan2(), remainder(), and M_PI
+#include <algorithm> // for sort(), reverse(), min(), and max()
+#include <mutex>
+#include <atomic>
+
+/*********************************************
+ * CONJUNCTION SCREEN : CLEAR
+ *********************************************/
+void ConjunctionScreen::clear()
+{
+   approaches.clear();
+   numPairs = 0;
+   numInBand = 0;
+   numOnPath = 0;
+   numAligned = 0;
+   numSkipped = 0;
+}
+
+/*********************************************
+ * CONJUNCTION SCREEN : GET ORBIT
+ * The true anomaly gets furthest ahead of the mean one where the two go
+ * round at the same rate, which is where r = a (1 - e^2)^(1/4)
+ *********************************************/
+ConjunctionScreen::Orbit ConjunctionScreen::getOrbit(const Integrator::State& state, uint32_t index)
+{
+   Kepler kepler(state);
+   double a = kepler.getSemiMajorAxis();
+   double e = kepler.getEccentricity();
+   double p = a * (1.0 - e * e);
+   double periapsis = kepler.getPeriapsis();
+
+   double slack = 0.0;
+   if (e > 1.0e-12)
+   {
+      double anomaly = acos(std::min(1.0, (1.0 - pow(1.0 - e * e, 0.25)) / e));
+      double trueAnomaly = 2.0 * atan2(sqrt(1.0 + e) * sin(anomaly / 2.0),
+                                       sqrt(1.0 - e) * cos(anomaly / 2.0));
+      slack = trueAnomaly - (anomaly - e * sin(anomaly)) + 1.0e-9;
+   }
+
+   // dr/dangle is r^2 e sin(true anomaly) / p
+   double apogee = a * (1.0 + e);
+   return { kepler, index, a * (1.0 - e), apogee, 1.0 / p,
+            e / p * cos(periapsis), e / p * sin(periapsis), slack, apogee * apogee * e / p,
+            kepler.getPeriod() };
+}
+
+/*********************************************
+ * CONJUNCTION SCREEN : IS ON PATH
+ * The difference in 1/r round the two paths is da + db cos + dc sin,
+ * which swings da plus or minus the length of (db, dc). When that does
+ * not reach zero the paths never cross, and one is always at least
+ * r1 r2 times the smallest difference further out than the other. How
+ * close that lets them get depends on how steeply the paths climb, no
+ * more than asin(e) from level
+ *********************************************/
+bool ConjunctionScreen::isOnPath(const Orbit& lhs, const Orbit& rhs) const
+{
+   double da = fabs(lhs.a - rhs.a);
+   double swing = hypot(lhs.b - rhs.b, lhs.c - rhs.c);
+   if (da <= swing)
+      return true;
+
+   double eMax = std::max(lhs.kepler.getEccentricity(), rhs.kepler.getEccentricity());
+   double gap = lhs.perigee * rhs.perigee * (da - swing);
+   return gap * sqrt(1.0 - eMax * eMax) <= distance;
+}
+
+/*********************************************
+ * GET MEAN ANOMALY
+ * From the true anomaly, counting whole turns, so it only ever goes up
+ * as the true one does
+ *********************************************/
+static double getMeanAnomaly(double trueAnomaly, double e)
+{
+   double turns = floor((trueAnomaly + M_PI) / (2.0 * M_PI));
+   double angle = trueAnomaly - 2.0 * M_PI * turns;
+   double anomaly = 2.0 * atan2(sqrt(1.0 - e) * sin(angle / 2.0), sqrt(1.0 + e) * cos(angle / 2.0));
+   return anomaly - e * sin(anomaly) + 2.0 * M_PI * turns;
+}
+
+/*********************************************
+ * CONJUNCTION SCREEN : GET ANGLE
+ * Two points closer than distance are less than asin(distance / r)
+ * apart in angle, r being the nearer of them
+ *********************************************/
+double ConjunctionScreen::getAngle(const Orbit& lhs, const Orbit& rhs) const
+{
+   double perigee = std::min(lhs.perigee, rhs.perigee);
+   return distance >= perigee ? M_PI : asin(distance / perigee);
+}
+
+/*********************************************
+ * CONJUNCTION SCREEN : GET WINDOWS
+ *********************************************/
+void ConjunctionScreen::getWindows(const Orbit& lhs, const Orbit& rhs, double secondsSpan,
+                                   Scratch& scratch) const
+{
+   scratch.windows.clear();
+   getAligned(lhs, rhs, secondsSpan, scratch.aligned);
+   if (scratch.aligned.empty())
+      return;
+   getArcs(lhs, rhs, scratch.arcs);
+   if (scratch.arcs.empty())
+      return;
+   getTimes(lhs, scratch.arcs, secondsSpan, scratch.times[0]);
+   getTimes(rhs, scratch.arcs, secondsSpan, scratch.times[1]);
+   intersect(scratch.times[0], scratch.times[1], scratch.both);
+   intersect(scratch.both, scratch.aligned, scratch.windows);
+}
+
+/*********************************************
+ * CONJUNCTION SCREEN : GET ALIGNED
+ * Add how far each true longitude can be from its mean one to the angle
+ * and that is how near the mean longitudes have to be, and they drift
+ * apart at a steady rate
+ *********************************************/
+void ConjunctionScreen::getAligned(const Orbit& lhs, const Orbit& rhs, double secondsSpan,
+                                   std::vector<Interval>& aligned) const
+{
+   aligned.clear();
+   double width = getAngle(lhs, rhs) + lhs.slack + rhs.slack;
+   if (width >= M_PI)
+   {
+      aligned.push_back({ 0.0, secondsSpan });
+      return;
+   }
+
+   double start = lhs.kepler.getMeanLongitude(0.0) - rhs.kepler.getMeanLongitude(0.0);
+   double rate = lhs.kepler.getMeanMotion() - rhs.kepler.getMeanMotion();
+   if (fabs(rate) * secondsSpan < 1.0e-12)
+   {
+      if (fabs(remainder(start, 2.0 * M_PI)) <= width)
+         aligned.push_back({ 0.0, secondsSpan });
+      return;
+   }
+
+   double end = start + rate * secondsSpan;
+   double low = std::min(start, end);
+   double high = std::max(start, end);
+   double kFirst = ceil((low - width) / (2.0 * M_PI));
+   double kLast = floor((high + width) / (2.0 * M_PI));
+   for (double k = kFirst; k <= kLast; k++)
+   {
+      double begin = (2.0 * M_PI * k - width - start) / rate;
+      double finish = (2.0 * M_PI * k + width - start) / rate;
+      if (rate < 0.0)
+         std::swap(begin, finish);
+      begin = std::max(0.0, begin);
+      finish = std::min(secondsSpan, finish);
+      if (begin < finish)
+         aligned.push_back({ begin, finish });
+   }
+
+   // drifting the other way, later turns come first
+   if (rate < 0.0)
+      std::reverse(aligned.begin(), aligned.end());
+}
+
+/*********************************************
+ * CONJUNCTION SCREEN : GET ARCS
+ * The difference in 1/r is da + R cos(angle - center). Where the two
+ * are within distance, one of them is at an angle where the paths are
+ * no further apart than distance plus however much the other's path
+ * climbs over the angle between them, and r1 r2 is at least the product
+ * of the perigees. That puts cos(angle - center) between two numbers:
+ * an arc either side of the center, which may run together
+ *********************************************/
+void ConjunctionScreen::getArcs(const Orbit& lhs, const Orbit& rhs, std::vector<Interval>& arcs) const
+{
+   arcs.clear();
+   double angle = getAngle(lhs, rhs);
+   double da = lhs.a - rhs.a;
+   double db = lhs.b - rhs.b;
+   double dc = lhs.c - rhs.c;
+   double swing = hypot(db, dc);
+   double most = (distance + std::max(lhs.slope, rhs.slope) * angle) / (lhs.perigee * rhs.perigee);
+   if (angle >= M_PI || swing == 0.0)
+   {
+      if (fabs(da) <= most)
+         arcs.push_back({ 0.0, 2.0 * M_PI });
+      return;
+   }
+
+   double low = (-most - da) / swing;
+   double high = (most - da) / swing;
+   if (low >= 1.0 || high <= -1.0)
+      return;
+   double inner = (high >= 1.0 ? 0.0 : acos(high)) - angle;
+   double outer = (low <= -1.0 ? M_PI : acos(low)) + angle;
+   double center = atan2(dc, db);
+   if (inner <= 0.0 && outer >= M_PI)
+      arcs.push_back({ 0.0, 2.0 * M_PI });
+   else if (inner <= 0.0)
+      arcs.push_back({ center - outer, center + outer });
+   else if (outer >= M_PI)
+      arcs.push_back({ center + inner, center + 2.0 * M_PI - inner });
+   else
+   {
+      arcs.push_back({ center - outer, center - inner });
+      arcs.push_back({ center + inner, center + outer });
+   }
+}
+
+/*********************************************
+ * CONJUNCTION SCREEN : GET TIMES
+ * Going round counterclockwise the angle is the periapsis plus the true
+ * anomaly, and clockwise it is the periapsis less it. Either way the
+ * mean anomaly at each end of an arc, less where it started, over the
+ * mean motion, is when it gets there, once a period
+ *********************************************/
+void ConjunctionScreen::getTimes(const Orbit& orbit, const std::vector<Interval>& arcs,
+                                 double secondsSpan, std::vector<Interval>& times)
+{
+   times.clear();
+   double e = orbit.kepler.getEccentricity();
+   double periapsis = orbit.kepler.getPeriapsis();
+   double motion = orbit.kepler.getMeanMotion();
+   double direction = motion < 0.0 ? -1.0 : 1.0;
+   double meanStart = direction * (orbit.kepler.getMeanLongitude(0.0) - periapsis);
+   for (const Interval& arc : arcs)
+   {
+      if (arc.second - arc.first >= 2.0 * M_PI)
+      {
+         times.assign(1, { 0.0, secondsSpan });
+         return;
+      }
+      double trueBegin = direction > 0.0 ? arc.first - periapsis : periapsis - arc.second;
+      double trueEnd = direction > 0.0 ? arc.second - periapsis : periapsis - arc.first;
+      double begin = (getMeanAnomaly(trueBegin, e) - meanStart) / fabs(motion);
+      double end = (getMeanAnomaly(trueEnd, e) - meanStart) / fabs(motion);
+      for (double shift = ceil(-end / orbit.period) * orbit.period;
+           begin + shift < secondsSpan; shift += orbit.period)
+         if (std::max(0.0, begin + shift) < std::min(secondsSpan, end + shift))
+            times.push_back({ std::max(0.0, begin + shift), std::min(secondsSpan, end + shift) });
+   }
+
+   // two arcs take turns, and may overlap at the edges
+   std::sort(times.begin(), times.end());
+   size_t numMerged = 0;
+   for (size_t i = 0; i < times.size(); i++)
+      if (numMerged > 0 && times[i].first <= times[numMerged - 1].second)
+         times[numMerged - 1].second = std::max(times[numMerged - 1].second, times[i].second);
+      else
+         times[numMerged++] = times[i];
+   times.resize(numMerged);
+}
+
+/*********************************************
+ * CONJUNCTION SCREEN : INTERSECT
+ *********************************************/
+void ConjunctionScreen::intersect(const std::vector<Interval>& lhs, const std::vector<Interval>& rhs,
+                                  std::vector<Interval>& both)
+{
+   both.clear();
+   size_t i = 0;
+   size_t j = 0;
+   while (i < lhs.size() && j < rhs.size())
+   {
+      double begin = std::max(lhs[i].first, rhs[j].first);
+      double end = std::min(lhs[i].second, rhs[j].second);
+      if (begin < end)
+         both.push_back({ begin, end });
+      if (lhs[i].second < rhs[j].second)
+         i++;
+      else
+         j++;
+   }
+}
+
+/*********************************************
+ * CONJUNCTION SCREEN : REFINE
+ * The distance is closest where the rate it changes, the relative
+ * position dotted with the relative velocity, goes from shrinking to
+ * growing. Step through the window often enough not to step over two
+ * of those, then close in on each with regula falsi, halving the stale
+ * end (the Illinois method). At the very start and end of the span the
+ * closest may be on the edge
+ *********************************************/
+void ConjunctionScreen::refine(const Orbit& lhs, const Orbit& rhs, double begin, double end,
+                               double secondsSpan, std::vector<Approach>& found) const
+{
+   auto getRelative = [&](double seconds)
+   {
+      Integrator::State one = lhs.kepler.getState(seconds);
+      Integrator::State two = rhs.kepler.getState(seconds);
+      return Integrator::State{ one.x - two.x, one.y - two.y, one.dx - two.dx, one.dy - two.dy };
+   };
+   auto getRate = [](const Integrator::State& relative)
+   {
+      return relative.x * relative.dx + relative.y * relative.dy;
+   };
+   auto keep = [&](double seconds, const Integrator::State& relative)
+   {
+      double apart = hypot(relative.x, relative.y);
+      if (apart < distance)
+         found.push_back({ std::min(lhs.index, rhs.index), std::max(lhs.index, rhs.index),
+                           seconds, apart, hypot(relative.dx, relative.dy) });
+   };
+
+   double step = std::min((end - begin) / 2.0, std::min(lhs.period, rhs.period) / 32.0);
+   int numSteps = std::max(1, (int)ceil((end - begin) / step));
+   step = (end - begin) / numSteps;
+
+   Integrator::State relative = getRelative(begin);
+   double rateBefore = getRate(relative);
+   if (begin == 0.0 && rateBefore >= 0.0)
+      keep(0.0, relative);
+   double before = begin;
+   for (int i = 1; i <= numSteps; i++)
+   {
+      double after = i == numSteps ? end : begin + i * step;
+      relative = getRelative(after);
+      double rateAfter = getRate(relative);
+      if (rateBefore < 0.0 && rateAfter >= 0.0)
+      {
+         double low = before;
+         double high = after;
+         double rateLow = rateBefore;
+         double rateHigh = rateAfter;
+         int side = 0;
+         double middle = high;
+         Integrator::State closest = relative;
+         for (int iteration = 0; iteration < 100 && high - low > 1.0e-4; iteration++)
+         {
+            middle = (low * rateHigh - high * rateLow) / (rateHigh - rateLow);
+            if (!(middle > low && middle < high))
+               middle = 0.5 * (low + high);
+            closest = getRelative(middle);
+            double rate = getRate(closest);
+            if (rate < 0.0)
+            {
+               low = middle;
+               rateLow = rate;
+               if (side == -1)
+                  rateHigh *= 0.5;
+               side = -1;
+            }
+            else
+            {
+               high = middle;
+               rateHigh = rate;
+               if (side == 1)
+                  rateLow *= 0.5;
+               side = 1;
+            }
+            if (rate == 0.0)
+               break;
+         }
+         keep(middle, closest);
+      }
+      before = after;
+      rateBefore = rateAfter;
+   }
+   if (end == secondsSpan && rateBefore < 0.0)
+      keep(end, relative);
+}
+
+/*********************************************
+ * CONJUNCTION SCREEN : SCREEN
+ * Each chunk of orbits keeps what it finds to itself and hands it over
+ * once, at the end
+ *********************************************/
+void ConjunctionScreen::screen(const std::vector<Integrator::State>& states, double secondsSpan,
+                               int numThreads)
+{
+   clear();
+   std::vector<Orbit> orbits;
+   orbits.reserve(states.size());
+   for (size_t i = 0; i < states.size(); i++)
+   {
+      Orbit orbit = getOrbit(states[i], (uint32_t)i);
+      if (orbit.kepler.isClosed())
+         orbits.push_back(orbit);
+      else
+         numSkipped++;
+   }
+   std::sort(orbits.begin(), orbits.end(),
+             [](const Orbit& lhs, const Orbit& rhs) { return lhs.perigee < rhs.perigee; });
+   numPairs = orbits.empty() ? 0 : (uint64_t)orbits.size() * (orbits.size() - 1) / 2;
+
+   std::mutex mutex;
+   std::atomic<uint64_t> inBand(0);
+   std::atomic<uint64_t> onPath(0);
+   std::atomic<uint64_t> aligned(0);
+   parallelFor((int)orbits.size(), [&](int first, int last)
+   {
+      std::vector<Approach> found;
+      Scratch scratch;
+      uint64_t numInBand = 0;
+      uint64_t numOnPath = 0;
+      uint64_t numAligned = 0;
+      for (int i = first; i < last; i++)
+         for (size_t j = i + 1; j < orbits.size() &&
+              orbits[j].perigee <= orbits[i].apogee + distance; j++)
+         {
+            numInBand++;
+            if (!isOnPath(orbits[i], orbits[j]))
+               continue;
+            numOnPath++;
+            getWindows(orbits[i], orbits[j], secondsSpan, scratch);
+            if (scratch.windows.empty())
+               continue;
+            numAligned++;
+            for (const Interval& window : scratch.windows)
+               refine(orbits[i], orbits[j], window.first, window.second, secondsSpan, found);
+         }
+
+      inBand += numInBand;
+      onPath += numOnPath;
+      aligned += numAligned;
+      std::lock_guard<std::mutex> lock(mutex);
+      approaches.insert(approaches.end(), found.begin(), found.end());
+   }, numThreads, 16);
+   numInBand = inBand;
+   numOnPath = onPath;
+   numAligned = aligned;
+
+   // closest first, and the same order however the threads went
+   std::sort(approaches.begin(), approaches.end(), [](const Approach& lhs, const Approach& rhs)
+   {
+      if (lhs.distance != rhs.distance)
+         return lhs.distance < rhs.distance;
+      if (lhs.first != rhs.first)
+         return lhs.first < rhs.first;
+      if (lhs.second != rhs.second)
+         return lhs.second < rhs.second;
+      return lhs.seconds < rhs.seconds;
+   });
+}
@@ -0,0 +1,148 @@
+/***********************************************************************
+ * Header File:
+ *    CONJUNCTION
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Which pairs of things in orbit will pass close to each other in
+ *    the time ahead, without trying every pair at every moment
+ ************************************************************************/
+
+#pragma once
+
+#include "integrator.h"
+#include <vector>
+#include <utility>   // for pair
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint32_t and uint64_t
+
+class TestConjunction;
+
+/*********************************************
+ * CONJUNCTION SCREEN
+ * Every pair of orbits goes through filters, each cheaper than the next
+ * and each only letting through pairs that might come within distance:
+ *    BAND   one's perigee to apogee has to overlap the other's. Orbits
+ *           are sorted by perigee, so each only looks at those whose
+ *           perigee is below its apogee
+ *    PATH   the two ellipses have to cross or come near. In one plane
+ *           1/r is a + b cos(angle) + c sin(angle) for any orbit, so how
+ *           near the paths come is worked out without a single point,
+ *           and so are the arcs where they are near
+ *    TIME   both have to be in those arcs at once, and at about the same
+ *           angle round the Earth. When each is in an arc comes from
+ *           Kepler's equation the easy way round, angle to time. The
+ *           mean longitudes go round evenly and the true ones are never
+ *           further from them than the equation of the center allows,
+ *           so when they can line up is solved for directly too
+ * Only inside what is left are the two moved, with Kepler, and the
+ * closest approach found where the distance stops shrinking and starts
+ * growing, by root finding on the rate it changes. The orbits are split
+ * among threads, and every approach closer than distance is kept,
+ * closest first.
+ * Nothing on an open orbit is screened
+ *********************************************/
+class ConjunctionScreen
+{
+public:
+   friend TestConjunction;
+
+   // Two objects at their closest
+   struct Approach
+   {
+      uint32_t first;     // index into the states screened, first < second
+      uint32_t second;
+      double seconds;     // after the states, the time of closest approach
+      double distance;    // meters apart then
+      double speed;       // m/s relative to each other then
+   };
+
+   ConjunctionScreen(double distance = 10000.0) : distance(distance) { clear(); }
+
+   // Look secondsSpan ahead of these states
+   void screen(const std::vector<Integrator::State>& states, double secondsSpan,
+               int numThreads = 0);
+
+   // Closest first
+   const std::vector<Approach>& getApproaches() const { return approaches; }
+
+   // How many pairs there were and how many each filter let through
+   uint64_t getNumPairs()   const { return numPairs;   }
+   uint64_t getNumInBand()  const { return numInBand;  }
+   uint64_t getNumOnPath()  const { return numOnPath;  }
+   uint64_t getNumAligned() const { return numAligned; }
+   size_t getNumSkipped()   const { return numSkipped; }   // open orbits
+
+   double getDistance() const { return distance; }
+
+private:
+   // One object's orbit and what the filters need to know about it
+   struct Orbit
+   {
+      Kepler kepler;
+      uint32_t index;     // in the states screened
+      double perigee;     // meters from the center
+      double apogee;
+      double a;           // 1/r = a + b cos(angle) + c sin(angle)
+      double b;
+      double c;
+      double slack;       // most the true longitude gets from the mean
+      double slope;       // most r changes a radian round the path
+      double period;
+   };
+
+   // From and to, in radians or seconds
+   typedef std::pair<double, double> Interval;
+
+   // Room for one thread to work in, so a pair allocates nothing
+   struct Scratch
+   {
+      std::vector<Interval> arcs;
+      std::vector<Interval> aligned;
+      std::vector<Interval> times[2];
+      std::vector<Interval> both;
+      std::vector<Interval> windows;
+   };
+
+   void clear();
+
+   static Orbit getOrbit(const Integrator::State& state, uint32_t index);
+
+   // Whether the paths come within distance
+   bool isOnPath(const Orbit& lhs, const Orbit& rhs) const;
+
+   // When the pair might be within distance, into scratch.windows
+   void getWindows(const Orbit& lhs, const Orbit& rhs, double secondsSpan,
+                   Scratch& scratch) const;
+
+   // The times the mean longitudes are close enough
+   void getAligned(const Orbit& lhs, const Orbit& rhs, double secondsSpan,
+                   std::vector<Interval>& aligned) const;
+
+   // The arcs round the Earth where the paths are close enough, widened
+   // by how far apart in angle the two can be
+   void getArcs(const Orbit& lhs, const Orbit& rhs, std::vector<Interval>& arcs) const;
+
+   // When an orbit is in any of the arcs, in order
+   static void getTimes(const Orbit& orbit, const std::vector<Interval>& arcs,
+                        double secondsSpan, std::vector<Interval>& times);
+
+   // The times in both lists
+   static void intersect(const std::vector<Interval>& lhs, const std::vector<Interval>& rhs,
+                         std::vector<Interval>& both);
+
+   // The closest approaches inside a window
+   void refine(const Orbit& lhs, const Orbit& rhs, double begin, double end,
+               double secondsSpan, std::vector<Approach>& found) const;
+
+   // How far apart in angle two things within distance can be
+   double getAngle(const Orbit& lhs, const Orbit& rhs) const;
+
+   double distance;
+   std::vector<Approach> approaches;
+   uint64_t numPairs;
+   uint64_t numInBand;
+   uint64_t numOnPath;
+   uint64_t numAligned;
+   size_t numSkipped;
+};
@@ -0,0 +1,332 @@
+/***********************************************************************
+ * Source File:
+ *    EPHEMERIS
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Where anything was at any moment of a run, without running it
+ *    again: each orbit cut into windows and a polynomial fit to each
+ ************************************************************************/
+
+#include "ephemeris.h"
+#include "trajectory.h"
+#include "parallel.h"
+#include <cmath>     // for fabs() and ceil()
+#include <algorithm> // for min(), max(), copy_backward(), and swap_ranges()
+
+/*********************************************
+ * EPHEMERIS : CONSTRUCTOR
+ *********************************************/
+Ephemeris::Ephemeris(int stepsPerWindow, int degree, int numThreads) :
+   stepsPerWindow(std::max(1, stepsPerWindow)),
+   degree(std::max(0, std::min(degree, std::max(1, stepsPerWindow)))),
+   numThreads(numThreads)
+{
+   getProjection(this->stepsPerWindow + 1, this->degree, projection);
+   start(0);
+}
+
+/*********************************************
+ * EPHEMERIS : GET PROJECTION
+ * A holds each Chebyshev polynomial at each sample, so the best fit c
+ * solves (A'A) c = A' samples. Solving that once with A' on the right
+ * leaves the matrix that does it for any samples
+ *********************************************/
+void Ephemeris::getProjection(int numSamples, int degree, std::vector<double>& projection)
+{
+   int numTerms = degree + 1;
+   std::vector<double> a(numSamples * numTerms);
+   for (int j = 0; j < numSamples; j++)
+   {
+      double tau = numSamples > 1 ? -1.0 + 2.0 * j / (numSamples - 1) : 0.0;
+      double previous = 1.0;
+      double current = tau;
+      for (int k = 0; k < numTerms; k++)
+      {
+         a[j * numTerms + k] = k == 0 ? 1.0 : current;
+         if (k > 0)
+         {
+            double next = 2.0 * tau * current - previous;
+            previous = current;
+            current = next;
+         }
+      }
+   }
+
+   // [A'A | A'], then eliminated down to [I | projection]
+   int width = numTerms + numSamples;
+   std::vector<double> m(numTerms * width, 0.0);
+   for (int row = 0; row < numTerms; row++)
+   {
+      for (int column = 0; column < numTerms; column++)
+         for (int j = 0; j < numSamples; j++)
+            m[row * width + column] += a[j * numTerms + row] * a[j * numTerms + column];
+      for (int j = 0; j < numSamples; j++)
+         m[row * width + numTerms + j] = a[j * numTerms + row];
+   }
+   for (int pivot = 0; pivot < numTerms; pivot++)
+   {
+      int best = pivot;
+      for (int row = pivot + 1; row < numTerms; row++)
+         if (fabs(m[row * width + pivot]) > fabs(m[best * width + pivot]))
+            best = row;
+      std::swap_ranges(m.begin() + pivot * width, m.begin() + (pivot + 1) * width,
+                       m.begin() + best * width);
+      double scale = 1.0 / m[pivot * width + pivot];
+      for (int column = 0; column < width; column++)
+         m[pivot * width + column] *= scale;
+      for (int row = 0; row < numTerms; row++)
+         if (row != pivot && m[row * width + pivot] != 0.0)
+         {
+            double factor = m[row * width + pivot];
+            for (int column = 0; column < width; column++)
+               m[row * width + column] -= factor * m[pivot * width + column];
+         }
+   }
+
+   projection.resize(numTerms * numSamples);
+   for (int k = 0; k < numTerms; k++)
+      for (int j = 0; j < numSamples; j++)
+         projection[k * numSamples + j] = m[k * width + numTerms + j];
+}
+
+/*********************************************
+ * EPHEMERIS : START
+ *********************************************/
+void Ephemeris::start(size_t numObjects)
+{
+   this->numObjects = numObjects;
+   numWindows = 0;
+   secondsStart = 0.0;
+   secondsStep = 0.0;
+   secondsEnd = 0.0;
+   secondsLast = 0.0;
+   secondsLastWindow = 0.0;
+   numSamples = 0;
+   isFinished = false;
+   samplesX.assign((stepsPerWindow + 1) * numObjects, 0.0);
+   samplesY.assign((stepsPerWindow + 1) * numObjects, 0.0);
+   coefficients.clear();
+}
+
+/*********************************************
+ * EPHEMERIS : ADD
+ *********************************************/
+bool Ephemeris::add(double seconds, const double* x, const double* y, size_t numObjects)
+{
+   if (numObjects != this->numObjects || isFinished)
+      return false;
+
+   // the second sample says how far apart they all are
+   size_t numTaken = numWindows * stepsPerWindow + numSamples;
+   if (numTaken == 0)
+      secondsStart = seconds;
+   else if (numTaken == 1)
+   {
+      if (!(seconds > secondsLast))
+         return false;
+      secondsStep = seconds - secondsLast;
+   }
+   else if (fabs(seconds - (secondsStart + numTaken * secondsStep)) > 0.001 * secondsStep)
+      return false;
+
+   std::copy(x, x + numObjects, samplesX.begin() + numSamples * numObjects);
+   std::copy(y, y + numObjects, samplesY.begin() + numSamples * numObjects);
+   numSamples++;
+   secondsLast = seconds;
+
+   // the end of this window is the start of the next
+   if (numSamples == stepsPerWindow + 1)
+   {
+      fitWindow(stepsPerWindow);
+      std::copy(samplesX.end() - numObjects, samplesX.end(), samplesX.begin());
+      std::copy(samplesY.end() - numObjects, samplesY.end(), samplesY.begin());
+      numSamples = 1;
+   }
+   return true;
+}
+
+/*********************************************
+ * EPHEMERIS : FINISH
+ * A few steps on their own would need a low degree that misses badly
+ * between them, so the samples move to the end of a whole window and
+ * the window before fills in the rest
+ *********************************************/
+void Ephemeris::finish()
+{
+   int numSteps = numSamples - 1;
+   if (numSteps >= 1 && numWindows > 0)
+   {
+      int numMissing = stepsPerWindow - numSteps;
+      std::copy_backward(samplesX.begin(), samplesX.begin() + numSamples * numObjects, samplesX.end());
+      std::copy_backward(samplesY.begin(), samplesY.begin() + numSamples * numObjects, samplesY.end());
+      parallelFor((int)numObjects, [&](int first, int last)
+      {
+         Integrator::State state;
+         for (int object = first; object < last; object++)
+            for (int j = 0; j < numMissing; j++)
+            {
+               getState(object, secondsLast - (stepsPerWindow - j) * secondsStep, state);
+               samplesX[j * numObjects + object] = state.x;
+               samplesY[j * numObjects + object] = state.y;
+            }
+      }, numThreads, 256);
+      fitWindow(stepsPerWindow);
+   }
+   else if (numSteps >= 1)
+      fitWindow(numSteps);
+   numSamples = 0;
+   isFinished = true;
+}
+
+/*********************************************
+ * EPHEMERIS : FIT WINDOW
+ * A run shorter than a window gets a projection of its own, and a lower
+ * degree when it has too few samples for the full one. The terms it
+ * goes without are zero
+ *********************************************/
+void Ephemeris::fitWindow(int numSteps)
+{
+   int numTerms = degree + 1;
+   int numUsed = numSteps == stepsPerWindow ? numTerms : std::min(numTerms, numSteps + 1);
+   std::vector<double> projectionShort;
+   if (numSteps != stepsPerWindow)
+      getProjection(numSteps + 1, numUsed - 1, projectionShort);
+   const std::vector<double>& p = numSteps == stepsPerWindow ? projection : projectionShort;
+   int width = numSteps + 1;
+
+   size_t first = coefficients.size();
+   coefficients.resize(first + numObjects * 2 * numTerms, 0.0);
+   parallelFor((int)numObjects, [&](int begin, int end)
+   {
+      for (int object = begin; object < end; object++)
+      {
+         double* c = &coefficients[first + object * 2 * numTerms];
+         for (int k = 0; k < numUsed; k++)
+         {
+            double sumX = 0.0;
+            double sumY = 0.0;
+            for (int j = 0; j < width; j++)
+            {
+               sumX += p[k * width + j] * samplesX[j * numObjects + object];
+               sumY += p[k * width + j] * samplesY[j * numObjects + object];
+            }
+            c[k] = sumX;
+            c[numTerms + k] = sumY;
+         }
+      }
+   }, numThreads, 1024);
+
+   numWindows++;
+   secondsEnd = secondsLast;
+   secondsLastWindow = secondsLast - numSteps * secondsStep;
+}
+
+/*********************************************
+ * EPHEMERIS : FIT
+ *********************************************/
+bool Ephemeris::fit(TrajectoryReader& reader)
+{
+   TrajectoryCodec::Sample sample;
+   if (!reader.read(sample))
+      return false;
+   start(sample.size());
+   bool isSame = add(sample.seconds, sample.x.data(), sample.y.data(), sample.size());
+   while (isSame && reader.read(sample))
+      isSame = add(sample.seconds, sample.x.data(), sample.y.data(), sample.size());
+   finish();
+   return isSame && numWindows > 0;
+}
+
+/*********************************************
+ * EPHEMERIS : PROPAGATE
+ *********************************************/
+void Ephemeris::propagate(const std::vector<Integrator::State>& states, double secondsStart,
+                          double secondsSpan, double secondsStep,
+                          Integrator::Method method, int numSubSteps)
+{
+   start(states.size());
+   int numSteps = std::max(1, (int)ceil(secondsSpan / secondsStep - 1.0e-9));
+   coefficients.reserve(((numSteps + stepsPerWindow - 1) / stepsPerWindow) *
+                        states.size() * 2 * (degree + 1));
+   numSubSteps = std::max(1, numSubSteps);
+   double dt = secondsStep / numSubSteps;
+
+   std::vector<Integrator::State> current = states;
+   std::vector<double> x(states.size());
+   std::vector<double> y(states.size());
+   for (size_t i = 0; i < states.size(); i++)
+   {
+      x[i] = states[i].x;
+      y[i] = states[i].y;
+   }
+   add(secondsStart, x.data(), y.data(), states.size());
+   for (int step = 1; step <= numSteps; step++)
+   {
+      parallelFor((int)states.size(), [&](int first, int last)
+      {
+         for (int i = first; i < last; i++)
+         {
+            for (int sub = 0; sub < numSubSteps; sub++)
+               Integrator::step(method, current[i], dt);
+            x[i] = current[i].x;
+            y[i] = current[i].y;
+         }
+      }, numThreads, 256);
+      add(secondsStart + step * secondsStep, x.data(), y.data(), states.size());
+   }
+   finish();
+}
+
+/*********************************************
+ * EPHEMERIS : GET STATE
+ * T and U are the Chebyshev polynomials of the first and second kind,
+ * and the derivative of T(k) is k U(k-1), so both come out of the same
+ * loop
+ *********************************************/
+bool Ephemeris::getState(size_t object, double seconds, Integrator::State& state) const
+{
+   if (object >= numObjects || numWindows == 0 || !(seconds >= secondsStart) || seconds > secondsEnd)
+      return false;
+
+   // the last window may overlap the one before
+   double secondsWindow = stepsPerWindow * secondsStep;
+   size_t window = numWindows - 1;
+   double begin = secondsLastWindow;
+   double length = secondsEnd - secondsLastWindow;
+   if (seconds < secondsLastWindow)
+   {
+      window = std::min(numWindows - 1, (size_t)((seconds - secondsStart) / secondsWindow));
+      begin = secondsStart + window * secondsWindow;
+      length = secondsWindow;
+   }
+   double tau = std::max(-1.0, std::min(1.0, 2.0 * (seconds - begin) / length - 1.0));
+
+   int numTerms = degree + 1;
+   const double* c = &coefficients[(window * numObjects + object) * 2 * numTerms];
+   double x = c[0];
+   double y = c[numTerms];
+   double dx = 0.0;
+   double dy = 0.0;
+   double tPrevious = 1.0;
+   double t = tau;
+   double uPrevious = 0.0;
+   double u = 1.0;
+   for (int k = 1; k < numTerms; k++)
+   {
+      x += c[k] * t;
+      y += c[numTerms + k] * t;
+      dx += c[k] * k * u;
+      dy += c[numTerms + k] * k * u;
+      double tNext = 2.0 * tau * t - tPrevious;
+      double uNext = 2.0 * tau * u - uPrevious;
+      tPrevious = t;
+      t = tNext;
+      uPrevious = u;
+      u = uNext;
+   }
+
+   double scale = 2.0 / length;
+   state = { x, y, dx * scale, dy * scale };
+   return true;
+}
@@ -0,0 +1,100 @@
+/***********************************************************************
+ * Header File:
+ *    EPHEMERIS
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Where anything was at any moment of a run, without running it
+ *    again: each orbit cut into windows and a polynomial fit to each
+ ************************************************************************/
+
+#pragma once
+
+#include "integrator.h"
+#include <vector>
+#include <cstddef>   // for size_t
+
+class TestEphemeris;
+class TrajectoryReader;
+
+/*********************************************
+ * EPHEMERIS
+ * Positions come in evenly spaced in time, the same objects in the same
+ * order each time. Every stepsPerWindow steps make a window, and x and y
+ * of each object over the window are fit with a Chebyshev series by
+ * least squares, the end of one window being the start of the next.
+ * The fit is a fixed matrix times the samples, worked out once, so
+ * fitting costs a few multiplies a sample. Asking where something is
+ * finds its window by division and adds up the series, so it takes the
+ * same time however long the run was. The velocity is the series
+ * differentiated, as the planetary ephemerides do it, rather than a
+ * second fit.
+ * When the samples run out part way through a window, the last window
+ * still spans a whole one, reaching back over the one before it, whose
+ * fit stands in for the samples that are gone. The samples of a window
+ * are only kept until it is fit
+ *********************************************/
+class Ephemeris
+{
+public:
+   friend TestEphemeris;
+
+   // Fitting and propagating use this many threads, or one per core
+   Ephemeris(int stepsPerWindow = 16, int degree = 10, int numThreads = 0);
+
+   // Forget everything and expect numObjects positions at a time
+   void start(size_t numObjects);
+
+   // Where everything was at this time. False, and nothing kept, when
+   // the count is wrong or the time is not the next step
+   bool add(double seconds, const double* x, const double* y, size_t numObjects);
+
+   // Fit what is left over into a last window. Nothing more can be
+   // added after that
+   void finish();
+
+   // Fit a recording, as far as the objects stay the same in number.
+   // False when there was nothing to fit or the count changed part way
+   bool fit(TrajectoryReader& reader);
+
+   // Move these states along and fit where they go, from secondsStart
+   // for secondsSpan, a sample every secondsStep, each step taken in
+   // numSubSteps smaller ones
+   void propagate(const std::vector<Integrator::State>& states, double secondsStart,
+                  double secondsSpan, double secondsStep,
+                  Integrator::Method method = Integrator::RK4, int numSubSteps = 8);
+
+   // Where an object was. False outside the span fit
+   bool getState(size_t object, double seconds, Integrator::State& state) const;
+
+   size_t getNumObjects() const { return numObjects; }
+   size_t getNumWindows() const { return numWindows; }
+   double getSecondsStart() const { return secondsStart; }
+   double getSecondsEnd() const { return secondsEnd; }
+   size_t getBytes() const { return coefficients.size() * sizeof(double); }
+
+private:
+   // The matrix taking numSamples evenly spaced values from -1 to 1 to
+   // the degree + 1 coefficients that fit them best
+   static void getProjection(int numSamples, int degree, std::vector<double>& projection);
+
+   // The window filled so far into coefficients
+   void fitWindow(int numSteps);
+
+   int stepsPerWindow;
+   int degree;
+   int numThreads;
+   std::vector<double> projection;   // for a whole window
+   size_t numObjects;
+   size_t numWindows;
+   double secondsStart;
+   double secondsStep;               // between samples, 0 until the second
+   double secondsEnd;                // of the last sample fit
+   double secondsLast;               // of the last sample taken
+   double secondsLastWindow;         // where the last window starts
+   int numSamples;                   // in the window being filled
+   bool isFinished;
+   std::vector<double> samplesX;     // the window being filled, sample by sample
+   std::vector<double> samplesY;
+   std::vector<double> coefficients; // window, object, x then y, degree + 1 each
+};
@@ -0,0 +1,50 @@
+/***********************************************************************
+ * Source File:
+ *    FIXED STEP
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Turn however much wall time has passed into a whole number of
+ *    fixed-size simulation ticks
+ ************************************************************************/
+
+#include "fixedStep.h"
+#include <cassert>
+
+/*********************************************
+ * FIXED STEP : CONSTRUCTOR
+ *********************************************/
+FixedStep::FixedStep(double secondsPerTick, int maxTicks) :
+   secondsPerTick(secondsPerTick),
+   maxTicks(maxTicks > 0 ? maxTicks : 1),
+   accumulated(0.0),
+   numDropped(0)
+{
+   assert(secondsPerTick > 0.0);
+}
+
+/*********************************************
+ * FIXED STEP : ADVANCE
+ * Add the elapsed time and take out as many whole ticks as fit. If we
+ * fell further behind than maxTicks, the extra time is thrown away: the
+ * simulation slows down rather than the frame rate falling off a cliff
+ *    INPUT  secondsElapsed  Wall time since the last call
+ *    OUTPUT <return>        How many ticks to run
+ *********************************************/
+int FixedStep::advance(double secondsElapsed)
+{
+   if (secondsElapsed > 0.0)
+      accumulated += secondsElapsed;
+
+   int ticks = (int)(accumulated / secondsPerTick);
+   if (ticks > maxTicks)
+   {
+      numDropped += ticks - maxTicks;
+      ticks = maxTicks;
+      accumulated = 0.0;
+   }
+   else
+      accumulated -= ticks * secondsPerTick;
+
+   return ticks;
+}
@@ -0,0 +1,48 @@
+/***********************************************************************
+ * Header File:
+ *    FIXED STEP
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Turn however much wall time has passed into a whole number of
+ *    fixed-size simulation ticks
+ ************************************************************************/
+
+#pragma once
+
+class TestFixedStep;
+
+/*********************************************
+ * FIXED STEP
+ * An accumulator: elapsed time goes in, whole ticks come out, and the
+ * part of a tick left over carries to next time. However long we were
+ * stalled, at most a handful of ticks come out at once, so a slow tick
+ * can never snowball into ever more ticks to catch up on.
+ *********************************************/
+class FixedStep
+{
+public:
+   friend TestFixedStep;
+
+   FixedStep(double secondsPerTick, int maxTicks = 5);
+
+   // How many ticks to run now that this much more time has passed
+   int advance(double secondsElapsed);
+
+   // How far we are into the next tick, 0.0 to 1.0
+   double getAlpha() const { return accumulated / secondsPerTick; }
+
+   // How long until the next tick is due
+   double getSecondsToNext() const { return secondsPerTick - accumulated; }
+
+   double getSecondsPerTick() const { return secondsPerTick; }
+   long getNumDropped() const { return numDropped; }
+
+   void reset() { accumulated = 0.0; }
+
+private:
+   double secondsPerTick;   // how much time one tick covers
+   int maxTicks;            // the most ticks advance() ever asks for
+   double accumulated;      // time not yet turned into ticks
+   long numDropped;         // ticks we gave up on catching up
+};
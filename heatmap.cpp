@@ -0,0 +1,110 @@
+/***********************************************************************
+ * Source File:
+ *    HEATMAP
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    How crowded each part of the screen is
+ ************************************************************************/
+
+#include "heatmap.h"
+#include "camera.h"
+#include "uiDraw.h"
+#include "parallel.h"
+#include <cmath>    // for floor() and log()
+
+/*********************************************
+ * HEATMAP : CONSTRUCTOR
+ * Enough cells to cover the screen
+ *********************************************/
+Heatmap::Heatmap(const Position& ptUpperRight, int cellPixels, int numThreads) :
+   cellPixels(cellPixels > 0 ? cellPixels : 1),
+   numThreads(numThreads),
+   countMax(0)
+{
+   cols = ((int)ptUpperRight.getPixelsX() + this->cellPixels - 1) / this->cellPixels;
+   rows = ((int)ptUpperRight.getPixelsY() + this->cellPixels - 1) / this->cellPixels;
+   counts.assign(cols * rows, 0);
+}
+
+/*********************************************
+ * HEATMAP : ACCUMULATE
+ * Start over and count every point. Each thread takes one contiguous
+ * slice of the points and counts into its own grid; the grids are then
+ * summed a cell at a time, again in parallel
+ *    INPUT  points  Where everything is, in meters
+ *           camera  What part of the world is on the screen
+ *********************************************/
+void Heatmap::accumulate(const std::vector<Position>& points, const Camera& camera)
+{
+   int num = (int)points.size();
+   int numCells = cols * rows;
+   int numSlices = std::max(1, std::min(numWorkers(numThreads), num / MIN_PER_THREAD));
+   int grain = (num + numSlices - 1) / numSlices;
+
+   if ((int)partials.size() < numSlices)
+      partials.resize(numSlices);
+   for (int slice = 0; slice < numSlices; slice++)
+      partials[slice].assign(numCells, 0);
+
+   double zoom = camera.getZoom();
+   double xCenter = camera.getCenter().getMetersX();
+   double yCenter = camera.getCenter().getMetersY();
+   double xOffset = cols * cellPixels / 2.0;
+   double yOffset = rows * cellPixels / 2.0;
+
+   // count each slice into its own grid
+   parallelFor(num, [&](int first, int last)
+   {
+      std::vector<int>& grid = partials[first / grain];
+      for (int i = first; i < last; i++)
+      {
+         int col = (int)floor(((points[i].getMetersX() - xCenter) / zoom + xOffset) / cellPixels);
+         int row = (int)floor(((points[i].getMetersY() - yCenter) / zoom + yOffset) / cellPixels);
+         if (col >= 0 && col < cols && row >= 0 && row < rows)
+            grid[row * cols + col]++;
+      }
+   }, numSlices, grain);
+
+   // add up the grids
+   parallelFor(numCells, [&](int first, int last)
+   {
+      for (int cell = first; cell < last; cell++)
+      {
+         int count = 0;
+         for (int slice = 0; slice < numSlices; slice++)
+            count += partials[slice][cell];
+         counts[cell] = count;
+      }
+   }, numSlices, std::max(1, numCells / numSlices));
+
+   countMax = 0;
+   for (int cell = 0; cell < numCells; cell++)
+      countMax = std::max(countMax, counts[cell]);
+}
+
+/*********************************************
+ * HEATMAP : DRAW
+ * Heat grows with the log of the count so a few very crowded cells
+ * do not wash out everything else
+ *********************************************/
+void Heatmap::draw(ogstream& gout, const Camera& camera) const
+{
+   if (countMax == 0)
+      return;
+
+   double zoom = camera.getZoom();
+   double logMax = log(1.0 + countMax);
+   for (int row = 0; row < rows; row++)
+      for (int col = 0; col < cols; col++)
+      {
+         int count = counts[row * cols + col];
+         if (count == 0)
+            continue;
+
+         Position center(camera.getCenter());
+         center.addMetersX(((col + 0.5) * cellPixels - cols * cellPixels / 2.0) * zoom);
+         center.addMetersY(((row + 0.5) * cellPixels - rows * cellPixels / 2.0) * zoom);
+         gout.drawHeat(center, cellPixels, log(1.0 + count) / logMax);
+      }
+}
@@ -0,0 +1,55 @@
+/***********************************************************************
+ * Header File:
+ *    HEATMAP
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    How crowded each part of the screen is
+ ************************************************************************/
+
+#pragma once
+
+#include "position.h"
+#include <vector>
+
+class Camera;
+class ogstream;
+class TestHeatmap;
+
+/*********************************************
+ * HEATMAP
+ * A grid laid over the screen counting the objects in each cell. The
+ * counting is split across threads, each with a grid of its own, so
+ * no two threads ever touch the same counter
+ *********************************************/
+class Heatmap
+{
+public:
+   friend TestHeatmap;
+
+   // ptUpperRight is the size of the screen, just like Interface takes
+   Heatmap(const Position& ptUpperRight, int cellPixels = 8, int numThreads = 0);
+
+   // getters
+   int getCols()  const { return cols; }
+   int getRows()  const { return rows; }
+   int getMax()   const { return countMax; }
+   int getCount(int col, int row) const { return counts[row * cols + col]; }
+
+   // Count where everything lands as seen through the camera
+   void accumulate(const std::vector<Position>& points, const Camera& camera);
+
+   // Draw every cell with something in it
+   void draw(ogstream& gout, const Camera& camera) const;
+
+private:
+   static const int MIN_PER_THREAD = 1024;   // not worth a thread for fewer
+
+   int cellPixels;                          // how wide a cell is
+   int cols;                                // cells across the screen
+   int rows;                                // cells up the screen
+   int numThreads;                          // zero means one per core
+   int countMax;                            // the most crowded cell
+   std::vector<int> counts;                 // row 0 at the bottom
+   std::vector<std::vector<int>> partials;  // one grid for each thread
+};
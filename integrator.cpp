@@ -0,0 +1,280 @@
+/***********************************************************************
+ * Source File:
+ *    INTEGRATOR
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    The ways we know to move something through Earth's gravity one
+ *    step at a time, and Kepler's exact answer to check them against
+ ************************************************************************/
+
+#include "integrator.h"
+#define _USE_MATH_DEFINES
+#include <cmath>     // for sqrt(), pow(), sin(), cos(), atan2(), and M_PI
+#include <cstring>   // for strcmp()
+#include <limits>    // for infinity()
+
+/*********************************************
+ * INTEGRATOR : GET GRAVITY
+ * Worked out exactly the way Satellite::getGravity does, so the Euler
+ * steps here come out bit for bit the same as Satellite::move always has
+ *********************************************/
+void Integrator::getGravity(double x, double y, double& ddx, double& ddy)
+{
+   double distance = sqrt(x * x + y * y);
+
+   // No gravity at center of Earth
+   if (distance == 0.0)
+   {
+      ddx = ddy = 0.0;
+      return;
+   }
+
+   double magnitude = GRAVITY * pow(EARTH_RADIUS / distance, 2.0);
+   ddx = -magnitude * x / distance;
+   ddy = -magnitude * y / distance;
+}
+
+/*********************************************
+ * INTEGRATOR : STEP
+ *    INPUT  method  How to go about it
+ *           state   Where it is now
+ *           dt      Seconds to move forward
+ *    OUTPUT state   Where it is dt seconds later
+ *********************************************/
+void Integrator::step(Method method, State& state, double dt)
+{
+   switch (method)
+   {
+      case VELOCITY_VERLET:
+         stepVerlet(state, dt);
+         break;
+      case RK4:
+         stepRK4(state, dt);
+         break;
+      default:
+         stepEuler(state, dt);
+   }
+}
+
+/*********************************************
+ * INTEGRATOR : STEP EULER
+ * Velocity first, then position with the new velocity
+ *********************************************/
+void Integrator::stepEuler(State& state, double dt)
+{
+   double ddx;
+   double ddy;
+   getGravity(state.x, state.y, ddx, ddy);
+
+   state.dx += ddx * dt;   // v = v0 + at
+   state.dy += ddy * dt;
+   state.x += state.dx * dt;   // x = x0 + vt
+   state.y += state.dy * dt;
+}
+
+/*********************************************
+ * INTEGRATOR : STEP VERLET
+ * Position with half the acceleration at the start, then velocity with
+ * the average of the acceleration at both ends
+ *********************************************/
+void Integrator::stepVerlet(State& state, double dt)
+{
+   double ddx0;
+   double ddy0;
+   getGravity(state.x, state.y, ddx0, ddy0);
+
+   state.x += (state.dx + 0.5 * ddx0 * dt) * dt;   // x = x0 + vt + 1/2 at^2
+   state.y += (state.dy + 0.5 * ddy0 * dt) * dt;
+
+   double ddx1;
+   double ddy1;
+   getGravity(state.x, state.y, ddx1, ddy1);
+   state.dx += 0.5 * (ddx0 + ddx1) * dt;
+   state.dy += 0.5 * (ddy0 + ddy1) * dt;
+}
+
+/*********************************************
+ * INTEGRATOR : STEP RK4
+ * The classic Runge-Kutta: four slopes across the step, weighted 1 2 2 1
+ *********************************************/
+void Integrator::stepRK4(State& state, double dt)
+{
+   double ax1, ay1, ax2, ay2, ax3, ay3, ax4, ay4;
+
+   getGravity(state.x, state.y, ax1, ay1);
+   double vx2 = state.dx + 0.5 * dt * ax1;
+   double vy2 = state.dy + 0.5 * dt * ay1;
+
+   getGravity(state.x + 0.5 * dt * state.dx, state.y + 0.5 * dt * state.dy, ax2, ay2);
+   double vx3 = state.dx + 0.5 * dt * ax2;
+   double vy3 = state.dy + 0.5 * dt * ay2;
+
+   getGravity(state.x + 0.5 * dt * vx2, state.y + 0.5 * dt * vy2, ax3, ay3);
+   double vx4 = state.dx + dt * ax3;
+   double vy4 = state.dy + dt * ay3;
+
+   getGravity(state.x + dt * vx3, state.y + dt * vy3, ax4, ay4);
+
+   state.x += dt / 6.0 * (state.dx + 2.0 * vx2 + 2.0 * vx3 + vx4);
+   state.y += dt / 6.0 * (state.dy + 2.0 * vy2 + 2.0 * vy3 + vy4);
+   state.dx += dt / 6.0 * (ax1 + 2.0 * ax2 + 2.0 * ax3 + ax4);
+   state.dy += dt / 6.0 * (ay1 + 2.0 * ay2 + 2.0 * ay3 + ay4);
+}
+
+/*********************************************
+ * INTEGRATOR : GET ENERGY
+ * Kinetic plus potential, per kilogram. Negative for a closed orbit
+ *********************************************/
+double Integrator::getEnergy(const State& state)
+{
+   double r = sqrt(state.x * state.x + state.y * state.y);
+   return 0.5 * (state.dx * state.dx + state.dy * state.dy) - MU / r;
+}
+
+/*********************************************
+ * INTEGRATOR : GET ANGULAR MOMENTUM
+ * Per kilogram. Positive going counterclockwise
+ *********************************************/
+double Integrator::getAngularMomentum(const State& state)
+{
+   return state.x * state.dy - state.y * state.dx;
+}
+
+/*********************************************
+ * INTEGRATOR : GET NAME
+ *********************************************/
+const char* Integrator::getName(Method method)
+{
+   switch (method)
+   {
+      case SYMPLECTIC_EULER:
+         return "euler";
+      case VELOCITY_VERLET:
+         return "verlet";
+      case RK4:
+         return "rk4";
+      default:
+         return "unknown";
+   }
+}
+
+/*********************************************
+ * INTEGRATOR : GET METHOD
+ *********************************************/
+Integrator::Method Integrator::getMethod(const char* name)
+{
+   for (int method = 0; method < NUM_METHODS; method++)
+      if (strcmp(name, getName((Method)method)) == 0)
+         return (Method)method;
+   return NUM_METHODS;
+}
+
+/*********************************************
+ * KEPLER : CONSTRUCTOR
+ * The orbital elements of a state. A circle has no periapsis, so one is
+ * put wherever the state is
+ *********************************************/
+Kepler::Kepler(const Integrator::State& state) :
+   a(0.0), e(0.0), omega(0.0), meanStart(0.0), n(0.0),
+   isClockwise(Integrator::getAngularMomentum(state) < 0.0)
+{
+   double x = state.x;
+   double y = isClockwise ? -state.y : state.y;
+   double dx = state.dx;
+   double dy = isClockwise ? -state.dy : state.dy;
+
+   double r = sqrt(x * x + y * y);
+   double energy = 0.5 * (dx * dx + dy * dy) - Integrator::MU / r;
+   if (energy >= 0.0)
+   {
+      e = 1.0;
+      return;
+   }
+   a = -Integrator::MU / (2.0 * energy);
+   n = sqrt(Integrator::MU / (a * a * a));
+
+   // e cos E and e sin E, where E is the eccentric anomaly
+   double eCos = 1.0 - r / a;
+   double eSin = (x * dx + y * dy) / sqrt(Integrator::MU * a);
+   e = sqrt(eCos * eCos + eSin * eSin);
+
+   double anomaly = 0.0;
+   if (e < 1.0e-12)
+      omega = atan2(y, x);
+   else
+   {
+      anomaly = atan2(eSin, eCos);
+
+      // the true anomaly, and so the periapsis, from the eccentric one
+      double trueAnomaly = 2.0 * atan2(sqrt(1.0 + e) * sin(anomaly / 2.0),
+                                       sqrt(1.0 - e) * cos(anomaly / 2.0));
+      omega = atan2(y, x) - trueAnomaly;
+   }
+   meanStart = anomaly - e * sin(anomaly);
+}
+
+/*********************************************
+ * KEPLER : GET PERIOD
+ *********************************************/
+double Kepler::getPeriod() const
+{
+   return isClosed() ? 2.0 * M_PI / n : std::numeric_limits<double>::infinity();
+}
+
+/*********************************************
+ * KEPLER : GET MEAN LONGITUDE
+ *********************************************/
+double Kepler::getMeanLongitude(double seconds) const
+{
+   double longitude = omega + meanStart + n * seconds;
+   return isClockwise ? -longitude : longitude;
+}
+
+/*********************************************
+ * KEPLER : GET STATE
+ * Solve Kepler's equation M = E - e sin E with Newton's method, then
+ * turn the eccentric anomaly back into a position and velocity
+ *    INPUT  seconds   Time after the state the orbit came from
+ *********************************************/
+Integrator::State Kepler::getState(double seconds) const
+{
+   Integrator::State state = { 0.0, 0.0, 0.0, 0.0 };
+   if (!isClosed())
+      return state;
+
+   double mean = fmod(meanStart + n * seconds, 2.0 * M_PI);
+   double anomaly = mean + e * sin(mean);
+   for (int i = 0; i < 20; i++)
+   {
+      double change = (anomaly - e * sin(anomaly) - mean) / (1.0 - e * cos(anomaly));
+      anomaly -= change;
+      if (fabs(change) < 1.0e-15)
+         break;
+   }
+
+   // in the plane of the orbit, periapsis along +x
+   double cosE = cos(anomaly);
+   double sinE = sin(anomaly);
+   double root = sqrt(1.0 - e * e);
+   double r = a * (1.0 - e * cosE);
+   double speed = sqrt(Integrator::MU * a) / r;
+   double px = a * (cosE - e);
+   double py = a * root * sinE;
+   double pdx = -speed * sinE;
+   double pdy = speed * root * cosE;
+
+   // turn to where the periapsis really is
+   double c = cos(omega);
+   double s = sin(omega);
+   state.x = c * px - s * py;
+   state.y = s * px + c * py;
+   state.dx = c * pdx - s * pdy;
+   state.dy = s * pdx + c * pdy;
+   if (isClockwise)
+   {
+      state.y = -state.y;
+      state.dy = -state.dy;
+   }
+   return state;
+}
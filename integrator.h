@@ -0,0 +1,107 @@
+/***********************************************************************
+ * Header File:
+ *    INTEGRATOR
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    The ways we know to move something through Earth's gravity one
+ *    step at a time, and Kepler's exact answer to check them against
+ ************************************************************************/
+
+#pragma once
+
+class TestIntegrator;
+
+/*********************************************
+ * INTEGRATOR
+ * Gravity here is g (R/r)^2, which is exactly mu/r^2 with mu = g R^2,
+ * so everything that holds for two bodies holds here. Each method
+ * trades work per step for accuracy differently:
+ *    SYMPLECTIC_EULER  one gravity per step, first order, what
+ *                      Satellite::move has always done
+ *    VELOCITY_VERLET   two gravities per step, second order
+ *    RK4               four gravities per step, fourth order, but
+ *                      energy slowly leaks away
+ *********************************************/
+class Integrator
+{
+public:
+   friend TestIntegrator;
+
+   enum Method { SYMPLECTIC_EULER, VELOCITY_VERLET, RK4, NUM_METHODS };
+
+   // Where something is and how fast it is going, in meters and m/s
+   struct State
+   {
+      double x;
+      double y;
+      double dx;
+      double dy;
+   };
+
+   // Move forward dt seconds
+   static void step(Method method, State& state, double dt);
+
+   // Gravity at a point, in m/s^2
+   static void getGravity(double x, double y, double& ddx, double& ddy);
+
+   // What should stay the same in orbit: the energy and angular momentum
+   // per kilogram
+   static double getEnergy(const State& state);
+   static double getAngularMomentum(const State& state);
+
+   // "verlet" for VELOCITY_VERLET and so on. NUM_METHODS for no such name
+   static const char* getName(Method method);
+   static Method getMethod(const char* name);
+
+   static constexpr double EARTH_RADIUS = 6378000.0;     // meters
+   static constexpr double GRAVITY = 9.80665;            // m/s^2 at the surface
+   static constexpr double MU = GRAVITY * EARTH_RADIUS * EARTH_RADIUS;   // m^3/s^2
+
+private:
+   static void stepEuler(State& state, double dt);
+   static void stepVerlet(State& state, double dt);
+   static void stepRK4(State& state, double dt);
+};
+
+/*********************************************
+ * KEPLER
+ * Where an orbit goes with no stepping at all: the elements are worked
+ * out once, and any time after that is Kepler's equation. Only closed
+ * orbits have an answer. Orbits that go clockwise are flipped over,
+ * worked out, and flipped back
+ *********************************************/
+class Kepler
+{
+public:
+   friend TestIntegrator;
+
+   Kepler(const Integrator::State& state);
+
+   // Where it will be this many seconds after the state it was given
+   Integrator::State getState(double seconds) const;
+
+   bool isClosed() const { return e < 1.0 && a > 0.0; }
+   double getPeriod() const;
+
+   // The shape of the orbit: how big, how stretched, and the angle from
+   // +x to the periapsis, counterclockwise whichever way it goes
+   double getSemiMajorAxis() const { return a; }
+   double getEccentricity() const { return e; }
+   double getPeriapsis() const { return isClockwise ? -omega : omega; }
+
+   // Radians a second round the center, less than zero going clockwise
+   double getMeanMotion() const { return isClockwise ? -n : n; }
+
+   // The periapsis angle plus the mean anomaly, where it would be if it
+   // went round evenly. This many seconds after the state it came from
+   double getMeanLongitude(double seconds) const;
+
+private:
+   double a;          // semi-major axis, meters
+   double e;          // eccentricity
+   double omega;      // where the periapsis is, radians from +x
+   double meanStart;  // mean anomaly at the start, radians
+   double n;          // mean motion, radians a second
+   bool isClockwise;  // flipped over y to make it go counterclockwise
+};
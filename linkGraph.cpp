@@ -0,0 +1,358 @@
+/***********************************************************************
+ * Source File:
+ *    LINK GRAPH
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Laser links between Starlink satellites, and the quickest way for
+ *    a message to get from one to another over them
+ ************************************************************************/
+
+#include "linkGraph.h"
+#include "parallel.h"
+#include <cmath>      // for sqrt() and HUGE_VAL
+#include <algorithm>  // for lower_bound(), push_heap(), pop_heap(), reverse(), min(), and max()
+#include <functional> // for greater
+
+/*********************************************
+ * LINK GRAPH : CONSTRUCTOR
+ *********************************************/
+LinkGraph::LinkGraph(double range, int numThreads) :
+   range(range),
+   numThreads(numThreads),
+   isIncremental(true),
+   broadPhase(numThreads),
+   numMade(0),
+   numBroken(0),
+   numRelaxed(0)
+{
+}
+
+/*********************************************
+ * LINK GRAPH : ADD ROUTE
+ *********************************************/
+int LinkGraph::addRoute(int from, int to)
+{
+   Route route;
+   route.from = from;
+   route.to = to;
+   route.isBuilt = false;
+   route.numRelaxed = 0;
+   routes.push_back(route);
+   return (int)routes.size() - 1;
+}
+
+/*********************************************
+ * LINK GRAPH : UPDATE
+ *********************************************/
+void LinkGraph::update(const std::vector<Integrator::State>& nodes)
+{
+   bool isSameSize = nodes.size() == size();
+   x.resize(nodes.size());
+   y.resize(nodes.size());
+   for (size_t i = 0; i < nodes.size(); i++)
+   {
+      x[i] = nodes[i].x;
+      y[i] = nodes[i].y;
+   }
+
+   linksLast.swap(links);
+   link();
+   buildRows();
+
+   // both lists are sorted, so walk them side by side
+   numMade = 0;
+   numBroken = 0;
+   if (isSameSize)
+   {
+      size_t k = 0;
+      for (const BroadPhase::Pair& pair : links)
+      {
+         while (k < linksLast.size() && (linksLast[k].i < pair.i ||
+                (linksLast[k].i == pair.i && linksLast[k].j < pair.j)))
+         {
+            numBroken++;
+            k++;
+         }
+         if (k < linksLast.size() && linksLast[k].i == pair.i && linksLast[k].j == pair.j)
+            k++;
+         else
+            numMade++;
+      }
+      numBroken += linksLast.size() - k;
+   }
+   else
+   {
+      numMade = links.size();
+      numBroken = linksLast.size();
+      for (Route& route : routes)
+         route.isBuilt = false;
+   }
+
+   int n = (int)size();
+   parallelFor((int)routes.size(), [&](int first, int last)
+   {
+      for (int r = first; r < last; r++)
+      {
+         Route& route = routes[r];
+         route.numRelaxed = 0;
+         if (route.from < 0 || route.from >= n || route.to < 0 || route.to >= n)
+            route.isBuilt = false;
+         else if (isIncremental && route.isBuilt)
+            repair(route);
+         else
+            solve(route);
+      }
+   }, numThreads);
+
+   numRelaxed = 0;
+   for (const Route& route : routes)
+      numRelaxed += route.numRelaxed;
+}
+
+/*********************************************
+ * LINK GRAPH : LINK
+ * The Earth is in the way when the point on the line between two
+ * satellites closest to the center is down in the air
+ *********************************************/
+void LinkGraph::link()
+{
+   circles.resize(size());
+   for (size_t i = 0; i < size(); i++)
+      circles[i] = { x[i], y[i], 0.5 * range };
+   broadPhase.build(circles);
+   broadPhase.findPairs(candidates);
+
+   double limit = (Integrator::EARTH_RADIUS + GRAZE) * (Integrator::EARTH_RADIUS + GRAZE);
+   links.clear();
+   for (const BroadPhase::Pair& pair : candidates)
+   {
+      double dx = x[pair.j] - x[pair.i];
+      double dy = y[pair.j] - y[pair.i];
+      double lengthSquared = dx * dx + dy * dy;
+      double along = lengthSquared > 0.0 ?
+         -(x[pair.i] * dx + y[pair.i] * dy) / lengthSquared : 0.0;
+      along = std::max(0.0, std::min(1.0, along));
+      double cx = x[pair.i] + along * dx;
+      double cy = y[pair.i] + along * dy;
+      if (cx * cx + cy * cy >= limit)
+         links.push_back(pair);
+   }
+}
+
+/*********************************************
+ * LINK GRAPH : BUILD ROWS
+ * Every link goes in both rows. Putting the ones to lower numbers in
+ * first, then the ones to higher, leaves each row sorted
+ *********************************************/
+void LinkGraph::buildRows()
+{
+   int n = (int)size();
+   rowStarts.assign(n + 1, 0);
+   for (const BroadPhase::Pair& pair : links)
+   {
+      rowStarts[pair.i + 1]++;
+      rowStarts[pair.j + 1]++;
+   }
+   for (int i = 0; i < n; i++)
+      rowStarts[i + 1] += rowStarts[i];
+
+   // each start moves up to the next row's as its row fills
+   neighbors.resize(2 * links.size());
+   linkLengths.resize(2 * links.size());
+   auto add = [&](int from, int to)
+   {
+      int k = rowStarts[from]++;
+      neighbors[k] = to;
+      linkLengths[k] = sqrt((x[to] - x[from]) * (x[to] - x[from]) +
+                            (y[to] - y[from]) * (y[to] - y[from]));
+   };
+   for (const BroadPhase::Pair& pair : links)
+      add(pair.j, pair.i);
+   for (const BroadPhase::Pair& pair : links)
+      add(pair.i, pair.j);
+   for (int i = n; i > 0; i--)
+      rowStarts[i] = rowStarts[i - 1];
+   rowStarts[0] = 0;
+}
+
+/*********************************************
+ * LINK GRAPH : GET LENGTH
+ *********************************************/
+double LinkGraph::getLength(int from, int to) const
+{
+   const int* pBegin = neighbors.data() + rowStarts[to];
+   const int* pEnd = neighbors.data() + rowStarts[to + 1];
+   const int* pFound = std::lower_bound(pBegin, pEnd, from);
+   return pFound != pEnd && *pFound == from ? linkLengths[pFound - neighbors.data()] : -1.0;
+}
+
+/*********************************************
+ * LINK GRAPH : SOLVE
+ *********************************************/
+void LinkGraph::solve(Route& route)
+{
+   route.distances.assign(size(), HUGE_VAL);
+   route.parents.assign(size(), -1);
+   route.heap.clear();
+   route.distances[route.from] = 0.0;
+   route.heap.push_back({ 0.0, route.from });
+   route.numRelaxed++;
+   spread(route);
+   sortTree(route);
+   route.isBuilt = true;
+}
+
+/*********************************************
+ * LINK GRAPH : REPAIR
+ *********************************************/
+void LinkGraph::repair(Route& route)
+{
+   std::vector<double>& distances = route.distances;
+   std::vector<int>& parents = route.parents;
+
+   // RECOST: a parent always comes before its children, so anything cut
+   // loose takes all below it along
+   for (int v : route.order)
+   {
+      int parent = parents[v];
+      if (parent < 0)
+         continue;
+      double length = distances[parent] == HUGE_VAL ? -1.0 : getLength(parent, v);
+      if (length < 0.0)
+      {
+         distances[v] = HUGE_VAL;
+         parents[v] = -1;
+      }
+      else
+         distances[v] = distances[parent] + length;
+   }
+
+   // RELAX: one pass over every link, and only what it helps on the heap
+   route.heap.clear();
+   int n = (int)size();
+   for (int u = 0; u < n; u++)
+   {
+      if (distances[u] == HUGE_VAL)
+         continue;
+      for (int k = rowStarts[u]; k < rowStarts[u + 1]; k++)
+      {
+         int v = neighbors[k];
+         double distance = distances[u] + linkLengths[k];
+         if (distance < distances[v])
+         {
+            distances[v] = distance;
+            parents[v] = u;
+            route.heap.push_back({ distance, v });
+            std::push_heap(route.heap.begin(), route.heap.end(), std::greater<>());
+            route.numRelaxed++;
+         }
+      }
+   }
+   spread(route);
+   sortTree(route);
+}
+
+/*********************************************
+ * LINK GRAPH : SPREAD
+ * Nearest first, skipping any on the heap that have since been bettered
+ *********************************************/
+void LinkGraph::spread(Route& route)
+{
+   std::vector<double>& distances = route.distances;
+   std::vector<std::pair<double, int>>& heap = route.heap;
+   while (!heap.empty())
+   {
+      std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+      double distanceU = heap.back().first;
+      int u = heap.back().second;
+      heap.pop_back();
+      if (distanceU > distances[u])
+         continue;
+      for (int k = rowStarts[u]; k < rowStarts[u + 1]; k++)
+      {
+         int v = neighbors[k];
+         double distance = distanceU + linkLengths[k];
+         if (distance < distances[v])
+         {
+            distances[v] = distance;
+            route.parents[v] = u;
+            heap.push_back({ distance, v });
+            std::push_heap(heap.begin(), heap.end(), std::greater<>());
+            route.numRelaxed++;
+         }
+      }
+   }
+}
+
+/*********************************************
+ * LINK GRAPH : SORT TREE
+ * Children bucketed under their parents, then read off breadth first
+ *********************************************/
+void LinkGraph::sortTree(Route& route)
+{
+   int n = (int)size();
+   std::vector<int>& starts = route.starts;
+   starts.assign(n + 1, 0);
+   for (int v = 0; v < n; v++)
+      if (route.parents[v] >= 0)
+         starts[route.parents[v] + 1]++;
+   for (int v = 0; v < n; v++)
+      starts[v + 1] += starts[v];
+   route.children.resize(starts[n]);
+   for (int v = 0; v < n; v++)
+      if (route.parents[v] >= 0)
+         route.children[starts[route.parents[v]]++] = v;
+   for (int v = n; v > 0; v--)
+      starts[v] = starts[v - 1];
+   starts[0] = 0;
+
+   route.order.clear();
+   route.order.push_back(route.from);
+   for (size_t k = 0; k < route.order.size(); k++)
+   {
+      int u = route.order[k];
+      for (int c = starts[u]; c < starts[u + 1]; c++)
+         route.order.push_back(route.children[c]);
+   }
+}
+
+/*********************************************
+ * LINK GRAPH : GET LATENCY
+ *********************************************/
+double LinkGraph::getLatency(int route) const
+{
+   const Route& found = routes[route];
+   if (!found.isBuilt || found.distances[found.to] == HUGE_VAL)
+      return -1.0;
+   return found.distances[found.to] / SPEED_OF_LIGHT;
+}
+
+/*********************************************
+ * LINK GRAPH : GET NUM HOPS
+ *********************************************/
+int LinkGraph::getNumHops(int route) const
+{
+   if (getLatency(route) < 0.0)
+      return -1;
+   const Route& found = routes[route];
+   int numHops = 0;
+   for (int v = found.to; v != found.from; v = found.parents[v])
+      numHops++;
+   return numHops;
+}
+
+/*********************************************
+ * LINK GRAPH : GET PATH
+ *********************************************/
+void LinkGraph::getPath(int route, std::vector<int>& path) const
+{
+   path.clear();
+   if (getLatency(route) < 0.0)
+      return;
+   const Route& found = routes[route];
+   for (int v = found.to; v != found.from; v = found.parents[v])
+      path.push_back(v);
+   path.push_back(found.from);
+   std::reverse(path.begin(), path.end());
+}
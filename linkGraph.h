@@ -0,0 +1,138 @@
+/***********************************************************************
+ * Header File:
+ *    LINK GRAPH
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Laser links between Starlink satellites, and the quickest way for
+ *    a message to get from one to another over them
+ ************************************************************************/
+
+#pragma once
+
+#include "integrator.h"
+#include "broadPhase.h"
+#include <vector>
+#include <utility>   // for pair
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint64_t
+
+class TestLinkGraph;
+
+/*********************************************
+ * LINK GRAPH
+ * Two satellites are linked when they are within range and the line
+ * between them clears the Earth and its air. Who might be in range
+ * comes from a BroadPhase grid of circles half the range across, so a
+ * satellite only ever looks at its neighbors. The links come out of it
+ * sorted the same way every tick, so which were made and which broken
+ * since the last is a merge of the two lists.
+ * Each route keeps a tree of the shortest paths from where it starts.
+ * Things move only a little in a tick, so rather than run Dijkstra
+ * again the tree is patched in two passes:
+ *    RECOST  walk the tree parents first with the new lengths, cutting
+ *            loose whatever lost the link to its parent
+ *    RELAX   take every link that now makes a shorter path, and spread
+ *            what that improves out from a heap
+ * The first leaves lengths of real paths, never too short, and the
+ * second leaves no link that could make one shorter, so what comes out
+ * is just what Dijkstra would have found. Only what got better goes
+ * through the heap. Routes are split among threads.
+ * Satellites are known by where they are in the list. When the list
+ * changes size, every route starts over
+ *********************************************/
+class LinkGraph
+{
+public:
+   friend TestLinkGraph;
+
+   LinkGraph(double range = 1000000.0, int numThreads = 0);
+
+   // Keep the quickest way from one satellite to another up to date.
+   // Which route it is
+   int addRoute(int from, int to);
+
+   // Where every satellite is now
+   void update(const std::vector<Integrator::State>& nodes);
+
+   // Every link, first < second, sorted by first and then second
+   const std::vector<BroadPhase::Pair>& getLinks() const { return links; }
+   size_t size() const { return x.size(); }
+
+   // Links made and broken by the last update
+   size_t getNumMade()   const { return numMade;   }
+   size_t getNumBroken() const { return numBroken; }
+
+   // Satellites put on a heap by the last update, over every route
+   uint64_t getNumRelaxed() const { return numRelaxed; }
+
+   // Seconds for light to go the route, negative when there is no way
+   double getLatency(int route) const;
+   int getNumHops(int route) const;           // -1 when there is no way
+   void getPath(int route, std::vector<int>& path) const;   // from first
+   size_t getNumRoutes() const { return routes.size(); }
+
+   // Run Dijkstra afresh every update instead, to compare
+   void setIncremental(bool isIncremental) { this->isIncremental = isIncremental; }
+
+   double getRange() const { return range; }
+
+private:
+   // The shortest paths from one satellite, and where they are wanted
+   struct Route
+   {
+      int from;
+      int to;
+      bool isBuilt;                   // false until the first update
+      std::vector<double> distances;  // meters from "from", HUGE_VAL for no way
+      std::vector<int> parents;       // the next satellite back, -1 for none
+      std::vector<int> order;         // those with a way, parents first
+      std::vector<int> starts;        // room to sort the tree in
+      std::vector<int> children;
+      std::vector<std::pair<double, int>> heap;
+      uint64_t numRelaxed;
+   };
+
+   // Which satellites are linked now, into links and the rows
+   void link();
+
+   // Who each satellite is linked to, and how far
+   void buildRows();
+
+   // Meters from one satellite to another it is linked to, negative
+   // when they are not linked
+   double getLength(int from, int to) const;
+
+   // Dijkstra, from scratch
+   void solve(Route& route);
+
+   // Patch the tree for the new lengths and links
+   void repair(Route& route);
+
+   // Whatever is on the heap, out to all it makes shorter
+   void spread(Route& route);
+
+   // The satellites with a way, parents first
+   void sortTree(Route& route);
+
+   double range;
+   int numThreads;
+   bool isIncremental;
+   BroadPhase broadPhase;
+   std::vector<BroadPhase::Circle> circles;
+   std::vector<double> x;                       // each satellite, meters
+   std::vector<double> y;
+   std::vector<BroadPhase::Pair> candidates;    // in range, maybe behind the Earth
+   std::vector<BroadPhase::Pair> links;
+   std::vector<BroadPhase::Pair> linksLast;
+   std::vector<int> rowStarts;                  // each satellite's links,
+   std::vector<int> neighbors;                  //    sorted,
+   std::vector<double> linkLengths;             //    and how long
+   std::vector<Route> routes;
+   size_t numMade;
+   size_t numBroken;
+   uint64_t numRelaxed;
+
+   static constexpr double GRAZE = 80000.0;            // meters of air a link stays above
+   static constexpr double SPEED_OF_LIGHT = 299792458.0;   // m/s
+};
@@ -0,0 +1,71 @@
+/***********************************************************************
+ * Header File:
+ *    PARALLEL
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Split a loop across a handful of worker threads
+ ************************************************************************/
+
+#pragma once
+
+#include <thread>    // for std::thread
+#include <vector>    // for std::vector
+#include <atomic>    // for std::atomic
+#include <algorithm> // for std::min
+
+/*********************************************
+ * NUM WORKERS
+ * How many threads to use. Zero means "one per core"
+ *********************************************/
+inline int numWorkers(int requested = 0)
+{
+   if (requested > 0)
+      return requested;
+   int cores = (int)std::thread::hardware_concurrency();
+   return cores > 0 ? cores : 1;
+}
+
+/*********************************************
+ * PARALLEL FOR
+ * Call fn(first, last) on chunks of [0, num) until every index has
+ * been handed out. Chunks are claimed on demand so uneven work still
+ * balances. The calling thread is one of the workers.
+ *    INPUT  num        How many items there are
+ *           fn         Called with the half-open range [first, last)
+ *           numThreads How many threads. Zero means one per core
+ *           grain      How many items to claim at a time
+ *********************************************/
+template <class Function>
+void parallelFor(int num, Function fn, int numThreads = 0, int grain = 1)
+{
+   if (num <= 0)
+      return;
+   if (grain < 1)
+      grain = 1;
+
+   int numChunks = (num + grain - 1) / grain;
+   numThreads = std::min(numWorkers(numThreads), numChunks);
+
+   // not worth a thread
+   if (numThreads <= 1)
+   {
+      fn(0, num);
+      return;
+   }
+
+   std::atomic<int> next(0);
+   auto worker = [&]()
+   {
+      for (int first = next.fetch_add(grain); first < num; first = next.fetch_add(grain))
+         fn(first, std::min(first + grain, num));
+   };
+
+   std::vector<std::thread> threads;
+   threads.reserve(numThreads - 1);
+   for (int i = 1; i < numThreads; i++)
+      threads.emplace_back(worker);
+   worker();
+   for (auto& thread : threads)
+      thread.join();
+}
@@ -0,0 +1,108 @@
+/***********************************************************************
+ * Source File:
+ *    PHASES
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    The parts of a tick that go over everything in orbit, split across
+ *    threads when there is enough in orbit to be worth it
+ ************************************************************************/
+
+#include "phases.h"
+#include "Satellite.h"
+#include "camera.h"
+#include "parallel.h"
+#include "trace.h"
+#include <algorithm> // for min() and max()
+
+/*********************************************
+ * PHASES : GATHER
+ * Copy the list into an array so it can be cut into slices
+ *    OUTPUT <return>  How many there are
+ *********************************************/
+int Phases::gather(const std::list<Satellite*>& satellites)
+{
+   all.assign(satellites.begin(), satellites.end());
+   return (int)all.size();
+}
+
+/*********************************************
+ * PHASES : GET NUM SLICES
+ * One slice for each thread, unless that leaves too few in a slice
+ *********************************************/
+int Phases::getNumSlices(int num) const
+{
+   return std::max(1, std::min(numWorkers(numThreads), num / MIN_PER_THREAD));
+}
+
+/*********************************************
+ * PHASES : MOVE
+ * Nothing one satellite does in a tick touches another, so each thread
+ * takes whatever is next. Only the ship pays any attention to the keys
+ *    INPUT  satellites  Everything in orbit
+ *           ui          The keys down this tick
+ *********************************************/
+void Phases::move(const std::list<Satellite*>& satellites, const Interface& ui)
+{
+   TRACE_SCOPE("Phases::move");
+   int num = gather(satellites);
+   parallelFor(num, [&](int first, int last)
+   {
+      for (int i = first; i < last; i++)
+         if (!all[i]->isDead())
+         {
+            all[i]->input(ui);
+            all[i]->move(1.0);
+         }
+   }, numThreads, MIN_PER_THREAD);
+}
+
+/*********************************************
+ * PHASES : CULL
+ * Each thread keeps what it can see from its own slice, and the slices
+ * are joined in order
+ *    INPUT  satellites    Everything in orbit
+ *           camera        What part of the world is on the screen
+ *           marginPixels  How far a sprite reaches from its center
+ *           pSkip         Left out, whether it can be seen or not
+ *    OUTPUT <return>      What can be seen
+ *********************************************/
+const std::vector<Satellite*>& Phases::cull(const std::list<Satellite*>& satellites,
+                                            const Camera& camera, double marginPixels,
+                                            const Satellite* pSkip)
+{
+   TRACE_SCOPE("Phases::cull");
+   int num = gather(satellites);
+   int numSlices = getNumSlices(num);
+   int grain = (num + numSlices - 1) / numSlices;
+   if ((int)partials.size() < numSlices)
+      partials.resize(numSlices);
+   for (int slice = 0; slice < numSlices; slice++)
+      partials[slice].clear();
+
+   parallelFor(num, [&](int first, int last)
+   {
+      std::vector<Satellite*>& seen = partials[first / grain];
+      for (int i = first; i < last; i++)
+         if (all[i] != pSkip && !all[i]->isDead() &&
+             camera.isVisible(all[i]->getPosition(), marginPixels))
+            seen.push_back(all[i]);
+   }, numSlices, grain);
+
+   visible.clear();
+   for (int slice = 0; slice < numSlices; slice++)
+      visible.insert(visible.end(), partials[slice].begin(), partials[slice].end());
+   return visible;
+}
+
+/*********************************************
+ * PHASES : GET BYTES
+ *********************************************/
+size_t Phases::getBytes() const
+{
+   size_t bytes = (all.capacity() + visible.capacity()) * sizeof(Satellite*) +
+                  partials.capacity() * sizeof(std::vector<Satellite*>);
+   for (const std::vector<Satellite*>& seen : partials)
+      bytes += seen.capacity() * sizeof(Satellite*);
+   return bytes;
+}
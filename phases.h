@@ -0,0 +1,60 @@
+/***********************************************************************
+ * Header File:
+ *    PHASES
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    The parts of a tick that go over everything in orbit, split across
+ *    threads when there is enough in orbit to be worth it
+ ************************************************************************/
+
+#pragma once
+
+#include <list>
+#include <vector>
+#include <cstddef>   // for size_t
+
+class Satellite;
+class Interface;
+class Camera;
+class TestPhases;
+
+/*********************************************
+ * PHASES
+ * Moving everything, and culling it for the display. The list is
+ * copied into an array so each thread can take a slice of it. Nothing here draws a
+ * random number or changes the list, so a run comes out the same on any
+ * number of threads. The simulator runs every tick through here and so
+ * does the scaling benchmark
+ *********************************************/
+class Phases
+{
+public:
+   friend TestPhases;
+
+   Phases(int numThreads = 0) : numThreads(numThreads) {}
+
+   // Everything still whole takes the keys and moves one tick
+   void move(const std::list<Satellite*>& satellites, const Interface& ui);
+
+   // Everything still whole that can reach the screen, in list order,
+   // leaving out pSkip. Good until the next call
+   const std::vector<Satellite*>& cull(const std::list<Satellite*>& satellites,
+                                       const Camera& camera, double marginPixels,
+                                       const Satellite* pSkip);
+
+   // How much room the scratch space takes, in bytes
+   size_t getBytes() const;
+
+private:
+   static const int MIN_PER_THREAD = 1024;   // not worth a thread for fewer
+
+   // The list as an array, and how many slices to cut it into
+   int gather(const std::list<Satellite*>& satellites);
+   int getNumSlices(int num) const;
+
+   int numThreads;                               // zero means one per core
+   std::vector<Satellite*> all;                  // the list, in order
+   std::vector<std::vector<Satellite*>> partials;   // what each slice can see
+   std::vector<Satellite*> visible;              // what they all can
+};
@@ -12,7 +12,7 @@
 #include "acceleration.h"
 #include <cassert>
 
-double Position::metersFromPixels = 0.0;
+thread_local double Position::metersFromPixels = 0.0;
 
 Position::Position(double x, double y) : x(x), y(y)
 {
@@ -73,7 +73,7 @@ public:
 private:
    double x;                 // horizontal position
    double y;                 // vertical position
-   static double metersFromPixels;
+   static thread_local double metersFromPixels;  // each thread zooms on its own
 };
 
 
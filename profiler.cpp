@@ -0,0 +1,214 @@
+/***********************************************************************
+ * Source File:
+ *    PROFILER
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Where the time in a frame goes, phase by phase
+ ************************************************************************/
+
+#include "profiler.h"
+#include "uiDraw.h"
+#include <cmath>     // for log2() and pow()
+#include <cstdio>    // for fopen() and snprintf()
+
+/*********************************************
+ * PROFILER : CONSTRUCTOR
+ * Empty histograms, each remembering numSamples frames
+ *********************************************/
+Profiler::Profiler(int numSamples) :
+   numSamples(numSamples > 0 ? numSamples : 1)
+{
+   for (Histogram& histogram : histograms)
+   {
+      histogram.counts.assign(NUM_BUCKETS, 0);
+      histogram.window.assign(this->numSamples, 0.0);
+      histogram.next = 0;
+      histogram.size = 0;
+      histogram.numTotal = 0;
+      histogram.secondsTotal = 0.0;
+      histogram.secondsWorst = 0.0;
+   }
+}
+
+/*********************************************
+ * PROFILER : GET NAME
+ *********************************************/
+const char* Profiler::getName(Phase phase)
+{
+   switch (phase)
+   {
+      case UPDATE:  return "update";
+      case COLLIDE: return "collide";
+      case DRAW:    return "draw";
+      case SWAP:    return "swap";
+      case SLEEP:   return "sleep";
+      default:      return "?";
+   }
+}
+
+/*********************************************
+ * PROFILER : BUCKET FOR
+ * Bucket 0 is anything under a microsecond. After that, every bucket is
+ * an eighth of an octave wider than the one before
+ *********************************************/
+int Profiler::bucketFor(double seconds)
+{
+   if (!(seconds >= SECONDS_MIN))
+      return 0;
+   int bucket = 1 + (int)(log2(seconds / SECONDS_MIN) * BUCKETS_PER_OCTAVE);
+   return bucket < NUM_BUCKETS ? bucket : NUM_BUCKETS - 1;
+}
+
+/*********************************************
+ * PROFILER : SECONDS FOR
+ * The middle of a bucket, in the sense that it is the same ratio from
+ * either edge
+ *********************************************/
+double Profiler::secondsFor(int bucket)
+{
+   if (bucket <= 0)
+      return 0.0;
+   return SECONDS_MIN * pow(2.0, (bucket - 0.5) / BUCKETS_PER_OCTAVE);
+}
+
+/*********************************************
+ * PROFILER : ADD
+ * The new sample goes into the window and its bucket. When the window
+ * is full, the oldest sample comes out of its bucket to make room
+ *    INPUT  phase    Which part of the frame
+ *           seconds  How long it took
+ *********************************************/
+void Profiler::add(Phase phase, double seconds)
+{
+   if (phase < 0 || phase >= NUM_PHASES)
+      return;
+
+   std::lock_guard<std::mutex> lock(mutex);
+   Histogram& histogram = histograms[phase];
+
+   if (histogram.size == numSamples)
+      histogram.counts[bucketFor(histogram.window[histogram.next])]--;
+   else
+      histogram.size++;
+
+   histogram.window[histogram.next] = seconds;
+   histogram.counts[bucketFor(seconds)]++;
+   histogram.next = (histogram.next + 1) % numSamples;
+
+   histogram.numTotal++;
+   histogram.secondsTotal += seconds;
+   if (seconds > histogram.secondsWorst)
+      histogram.secondsWorst = seconds;
+}
+
+/*********************************************
+ * PROFILER : GET PERCENTILE
+ * Walk up the buckets until we have passed the given fraction of the
+ * recent samples
+ *    INPUT  fraction  0.5 for the median, 0.99 for p99
+ *    OUTPUT <return>  seconds, or zero if nothing has been added
+ *********************************************/
+double Profiler::getPercentile(Phase phase, double fraction) const
+{
+   std::lock_guard<std::mutex> lock(mutex);
+   return getPercentile(histograms[phase], fraction);
+}
+
+double Profiler::getPercentile(const Histogram& histogram, double fraction) const
+{
+   if (histogram.size == 0)
+      return 0.0;
+
+   int target = (int)ceil(fraction * histogram.size);
+   if (target < 1)
+      target = 1;
+
+   int count = 0;
+   for (int bucket = 0; bucket < NUM_BUCKETS; bucket++)
+   {
+      count += histogram.counts[bucket];
+      if (count >= target)
+         return secondsFor(bucket);
+   }
+   return secondsFor(NUM_BUCKETS - 1);
+}
+
+/*********************************************
+ * PROFILER : GETTERS
+ * These cover every frame, not just the recent ones
+ *********************************************/
+long Profiler::getCount(Phase phase) const
+{
+   std::lock_guard<std::mutex> lock(mutex);
+   return histograms[phase].numTotal;
+}
+
+double Profiler::getMean(Phase phase) const
+{
+   std::lock_guard<std::mutex> lock(mutex);
+   const Histogram& histogram = histograms[phase];
+   return histogram.numTotal ? histogram.secondsTotal / histogram.numTotal : 0.0;
+}
+
+double Profiler::getWorst(Phase phase) const
+{
+   std::lock_guard<std::mutex> lock(mutex);
+   return histograms[phase].secondsWorst;
+}
+
+/*********************************************
+ * PROFILER : DRAW
+ * Put p50, p95, and p99 of each phase on the screen as text
+ *    INPUT  gout     Where to draw
+ *           topLeft  Where the first line goes, in screen pixels
+ *********************************************/
+void Profiler::draw(ogstream& gout, const Position& topLeft) const
+{
+   std::lock_guard<std::mutex> lock(mutex);
+
+   gout.setPosition(topLeft);
+   gout << "ms        p50     p95     p99\n";
+   for (int phase = 0; phase < NUM_PHASES; phase++)
+   {
+      char line[64];
+      snprintf(line, sizeof(line), "%-8s %6.2f  %6.2f  %6.2f\n",
+               getName((Phase)phase),
+               1000.0 * getPercentile(histograms[phase], 0.50),
+               1000.0 * getPercentile(histograms[phase], 0.95),
+               1000.0 * getPercentile(histograms[phase], 0.99));
+      gout << line;
+   }
+   gout.flush();
+}
+
+/*********************************************
+ * PROFILER : WRITE CSV
+ * One header line, then one line per phase
+ *    INPUT  fileName  Where to write
+ *    OUTPUT <return>  Whether it worked
+ *********************************************/
+bool Profiler::writeCSV(const char* fileName) const
+{
+   FILE* file = fopen(fileName, "w");
+   if (!file)
+      return false;
+
+   std::lock_guard<std::mutex> lock(mutex);
+   fprintf(file, "phase,frames,mean_ms,p50_ms,p95_ms,p99_ms,worst_ms\n");
+   for (int phase = 0; phase < NUM_PHASES; phase++)
+   {
+      const Histogram& histogram = histograms[phase];
+      fprintf(file, "%s,%ld,%.4f,%.4f,%.4f,%.4f,%.4f\n",
+              getName((Phase)phase),
+              histogram.numTotal,
+              histogram.numTotal ? 1000.0 * histogram.secondsTotal / histogram.numTotal : 0.0,
+              1000.0 * getPercentile(histogram, 0.50),
+              1000.0 * getPercentile(histogram, 0.95),
+              1000.0 * getPercentile(histogram, 0.99),
+              1000.0 * histogram.secondsWorst);
+   }
+
+   bool ok = !ferror(file);
+   return fclose(file) == 0 && ok;
+}
@@ -0,0 +1,104 @@
+/***********************************************************************
+ * Header File:
+ *    PROFILER
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Where the time in a frame goes, phase by phase
+ ************************************************************************/
+
+#pragma once
+
+#include "position.h"
+#include <vector>
+#include <mutex>     // phases are timed on more than one thread
+#include <chrono>    // for steady_clock
+
+class ogstream;
+class TestProfiler;
+
+/*********************************************
+ * PROFILER
+ * A rolling histogram of the most recent frames for each phase of a
+ * frame. Buckets are an eighth of an octave wide, so adding a sample and
+ * dropping the oldest are both a single counter, and any percentile is
+ * one walk across the buckets, good to within 5%
+ *********************************************/
+class Profiler
+{
+public:
+   friend TestProfiler;
+
+   // The parts of a frame, in the order they happen. Nothing collides
+   // yet, so COLLIDE stays empty until something does
+   enum Phase { UPDATE, COLLIDE, DRAW, SWAP, SLEEP, NUM_PHASES };
+
+   Profiler(int numSamples = 300);
+
+   // Record how long one phase of one frame took
+   void add(Phase phase, double seconds);
+
+   // How long the given fraction of recent frames fit in (0.5 is p50)
+   double getPercentile(Phase phase, double fraction) const;
+
+   // Over every frame since we started
+   long   getCount(Phase phase) const;
+   double getMean(Phase phase)  const;
+   double getWorst(Phase phase) const;
+
+   static const char* getName(Phase phase);
+
+   // Show the percentiles on the screen, one line per phase
+   void draw(ogstream& gout, const Position& topLeft) const;
+
+   // Write one line per phase, in milliseconds
+   bool writeCSV(const char* fileName) const;
+
+   /*********************************************
+    * PROFILER :: TIMER
+    * Time a phase from construction to destruction. A NULL profiler
+    * times nothing
+    *********************************************/
+   class Timer
+   {
+   public:
+      Timer(Profiler* pProfiler, Phase phase) :
+         pProfiler(pProfiler), phase(phase), start(std::chrono::steady_clock::now()) {}
+      ~Timer()
+      {
+         if (pProfiler)
+            pProfiler->add(phase, std::chrono::duration<double>(
+               std::chrono::steady_clock::now() - start).count());
+      }
+   private:
+      Profiler* pProfiler;
+      Phase phase;
+      std::chrono::steady_clock::time_point start;
+   };
+
+private:
+   static const int BUCKETS_PER_OCTAVE = 8;
+   static const int NUM_BUCKETS = BUCKETS_PER_OCTAVE * 24;   // 1us to 16s
+   static constexpr double SECONDS_MIN = 0.000001;           // bucket 0 is less
+
+   static int bucketFor(double seconds);
+   static double secondsFor(int bucket);
+
+   // The recent samples of one phase and how they fall in the buckets
+   struct Histogram
+   {
+      std::vector<int> counts;      // samples in each bucket
+      std::vector<double> window;   // the samples, oldest overwritten first
+      int next;                     // where the next sample goes
+      int size;                     // how much of the window is filled
+      long numTotal;                // every sample ever
+      double secondsTotal;          //    "   , added up
+      double secondsWorst;          // the longest ever
+   };
+
+   double getPercentile(const Histogram& histogram, double fraction) const;
+
+   int numSamples;                    // how many frames the window holds
+   Histogram histograms[NUM_PHASES];
+   mutable std::mutex mutex;          // the display reads what the simulation writes
+};
@@ -0,0 +1,393 @@
+/***********************************************************************
+ * Source File:
+ *    RECEIVERS
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Thousands of GPS receivers on the ground and in orbit, each working
+ *    out where it is from the GPS satellites it can see
+ ************************************************************************/
+
+#include "receivers.h"
+#include "parallel.h"
+#define _USE_MATH_DEFINES
+#include <cmath>     // for sqrt(), log(), sin(), cos(), and M_PI
+#include <algorithm> // for min() and max()
+
+/*********************************************
+ * RECEIVERS : CONSTRUCTOR
+ *********************************************/
+Receivers::Receivers(double sigmaRange, int numThreads, uint64_t seed) :
+   sigmaRange(sigmaRange),
+   numThreads(numThreads),
+   seed(seed),
+   numSolves(0)
+{
+}
+
+/*********************************************
+ * RECEIVERS : ADD GROUND
+ *********************************************/
+void Receivers::addGround(int count)
+{
+   for (int k = 0; k < count; k++)
+   {
+      double radians = 2.0 * M_PI * k / count;
+      add({ Integrator::EARTH_RADIUS * cos(radians), Integrator::EARTH_RADIUS * sin(radians), 0.0, 0.0 },
+          true /*isGround*/, SIGMA_CLOCK * getNormal(2 * size()));
+   }
+}
+
+/*********************************************
+ * RECEIVERS : ADD ORBIT
+ *********************************************/
+void Receivers::addOrbit(int count, double altitude)
+{
+   double radius = Integrator::EARTH_RADIUS + altitude;
+   double speed = sqrt(Integrator::MU / radius);
+   for (int k = 0; k < count; k++)
+   {
+      double radians = 2.0 * M_PI * k / count;
+      double c = cos(radians);
+      double s = sin(radians);
+      add({ radius * c, radius * s, -speed * s, speed * c },
+          false /*isGround*/, SIGMA_CLOCK * getNormal(2 * size()));
+   }
+}
+
+/*********************************************
+ * RECEIVERS : ADD
+ *********************************************/
+void Receivers::add(const Integrator::State& state, bool isGround, double bias)
+{
+   orbits.push_back(Kepler(state));
+   startX.push_back(state.x);
+   startY.push_back(state.y);
+   this->isGround.push_back(isGround);
+   trueBias.push_back(bias);
+   trueX.push_back(state.x);
+   trueY.push_back(state.y);
+   estimateX.push_back(0.0);
+   estimateY.push_back(0.0);
+   estimateBias.push_back(0.0);
+   fixes.push_back({ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, false });
+}
+
+/*********************************************
+ * RECEIVERS : GET NORMAL
+ * Two uniform numbers from splitmix64 of the counter, made a bell curve
+ * by Box-Muller
+ *********************************************/
+double Receivers::getNormal(uint64_t counter) const
+{
+   auto mix = [](uint64_t z)
+   {
+      z += 0x9e3779b97f4a7c15ULL;
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      return z ^ (z >> 31);
+   };
+   uint64_t first = mix(seed ^ mix(counter));
+   uint64_t second = mix(first);
+   double u1 = ((first >> 11) + 1.0) * (1.0 / 9007199254740993.0);   // (0, 1]
+   double u2 = (second >> 11) * (1.0 / 9007199254740992.0);          // [0, 1)
+   return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+/*********************************************
+ * RECEIVERS : SOLVE
+ *********************************************/
+void Receivers::solve(double seconds, const std::vector<Integrator::State>& satellites)
+{
+   size_t n = size();
+   size_t numSatellites = satellites.size();
+   satelliteX.resize(numSatellites);
+   satelliteY.resize(numSatellites);
+   for (size_t s = 0; s < numSatellites; s++)
+   {
+      satelliteX[s] = satellites[s].x;
+      satelliteY[s] = satellites[s].y;
+   }
+   stride = (n + LANES - 1) / LANES * LANES;
+   weights.resize(numSatellites * stride);
+   pseudoranges.resize(numSatellites * stride);
+   for (std::vector<double>* pColumn : { &hxx, &hxy, &hxb, &hyy, &hyb, &hbb, &steps })
+      pColumn->resize(n);
+
+   // batches start on a whole block, so only the last has lanes to spare,
+   // and are the same however the threads split them up
+   parallelFor((int)n, [&](int first, int last)
+   {
+      for (size_t batch = first; batch < (size_t)last; batch += BATCH)
+         solveBatch(batch, std::min(batch + BATCH, (size_t)last), seconds, numSatellites);
+   }, numThreads, (int)BATCH);
+   numSolves++;
+}
+
+/*********************************************
+ * RECEIVERS : SOLVE BATCH
+ * Keep stepping until the whole batch has settled. One that cannot
+ * settle, with too few satellites or too poor a spread, gets no fix
+ *********************************************/
+void Receivers::solveBatch(size_t first, size_t last, double seconds, size_t numSatellites)
+{
+   move(first, last, seconds);
+   measure(first, last, numSatellites);
+   guess(first, last, numSatellites);
+   for (int iteration = 0; iteration < NUM_ITERATIONS; iteration++)
+      if (iterate(first, last, numSatellites) < TOLERANCE)
+         break;
+
+   // the DOP is the inverse of H'H, whose cofactors the last step left
+   for (size_t i = first; i < last; i++)
+   {
+      double c00 = hyy[i] * hbb[i] - hyb[i] * hyb[i];
+      double c01 = hxb[i] * hyb[i] - hxy[i] * hbb[i];
+      double c02 = hxy[i] * hyb[i] - hyy[i] * hxb[i];
+      double c11 = hxx[i] * hbb[i] - hxb[i] * hxb[i];
+      double c22 = hxx[i] * hyy[i] - hxy[i] * hxy[i];
+      double determinant = hxx[i] * c00 + hxy[i] * c01 + hxb[i] * c02;
+      Fix& fix = fixes[i];
+      fix.numVisible = (int)hbb[i];
+      fix.isFixed = fix.numVisible >= 3 && determinant > 0.0 && steps[i] < TOLERANCE_FIX;
+      fix.x = estimateX[i];
+      fix.y = estimateY[i];
+      fix.bias = estimateBias[i];
+      fix.error = sqrt((estimateX[i] - trueX[i]) * (estimateX[i] - trueX[i]) +
+                       (estimateY[i] - trueY[i]) * (estimateY[i] - trueY[i]));
+      fix.gdop = fix.isFixed ? sqrt((c00 + c11 + c22) / determinant) : 0.0;
+      fix.pdop = fix.isFixed ? sqrt((c00 + c11) / determinant) : 0.0;
+      fix.tdop = fix.isFixed ? sqrt(c22 / determinant) : 0.0;
+   }
+}
+
+/*********************************************
+ * RECEIVERS : MOVE
+ * The Earth does not turn, so the ground stays put
+ *********************************************/
+void Receivers::move(size_t first, size_t last, double seconds)
+{
+   for (size_t i = first; i < last; i++)
+      if (isGround[i])
+      {
+         trueX[i] = startX[i];
+         trueY[i] = startY[i];
+      }
+      else
+      {
+         Integrator::State state = orbits[i].getState(seconds);
+         trueX[i] = state.x;
+         trueY[i] = state.y;
+      }
+}
+
+/*********************************************
+ * RECEIVERS : MEASURE
+ * The Earth hides a satellite when the point on the line to it closest
+ * to the center is inside the Earth. The lanes past the last receiver
+ * are at the center, so they see nothing
+ *********************************************/
+void Receivers::measure(size_t first, size_t last, size_t numSatellites)
+{
+   double limit = (Integrator::EARTH_RADIUS - GRACE) * (Integrator::EARTH_RADIUS - GRACE);
+   for (size_t block = first; block < last; block += LANES)
+   {
+      size_t count = std::min(LANES, last - block);
+      double x[LANES] = {};
+      double y[LANES] = {};
+      double bias[LANES] = {};
+      for (size_t lane = 0; lane < count; lane++)
+      {
+         x[lane] = trueX[block + lane];
+         y[lane] = trueY[block + lane];
+         bias[lane] = trueBias[block + lane];
+      }
+
+      for (size_t s = 0; s < numSatellites; s++)
+      {
+         double sx = satelliteX[s];
+         double sy = satelliteY[s];
+         double* w = &weights[s * stride + block];
+         double* rho = &pseudoranges[s * stride + block];
+         for (size_t lane = 0; lane < LANES; lane++)
+         {
+            double dx = sx - x[lane];
+            double dy = sy - y[lane];
+            double lengthSquared = dx * dx + dy * dy;
+            double along = -(x[lane] * dx + y[lane] * dy) / lengthSquared;
+            along = std::max(0.0, std::min(1.0, along));
+            double cx = x[lane] + along * dx;
+            double cy = y[lane] + along * dy;
+            w[lane] = cx * cx + cy * cy >= limit ? 1.0 : 0.0;
+            rho[lane] = sqrt(lengthSquared) + bias[lane];
+         }
+         // noise is slow to make, and only matters for what is in sight
+         if (sigmaRange > 0.0)
+            for (size_t lane = 0; lane < count; lane++)
+               if (w[lane] != 0.0)
+                  rho[lane] += sigmaRange *
+                     getNormal(2 * ((numSolves * numSatellites + s) * stride + block + lane) + 1);
+      }
+   }
+}
+
+/*********************************************
+ * RECEIVERS : GUESS
+ *********************************************/
+void Receivers::guess(size_t first, size_t last, size_t numSatellites)
+{
+   for (size_t block = first; block < last; block += LANES)
+   {
+      size_t count = std::min(LANES, last - block);
+      double sumX[LANES] = {};
+      double sumY[LANES] = {};
+      for (size_t s = 0; s < numSatellites; s++)
+      {
+         const double* w = &weights[s * stride + block];
+         for (size_t lane = 0; lane < LANES; lane++)
+         {
+            sumX[lane] += w[lane] * satelliteX[s];
+            sumY[lane] += w[lane] * satelliteY[s];
+         }
+      }
+      for (size_t lane = 0; lane < count; lane++)
+      {
+         size_t i = block + lane;
+         if (fixes[i].isFixed)
+            continue;
+         double length = sqrt(sumX[lane] * sumX[lane] + sumY[lane] * sumY[lane]);
+         double scale = length > 0.0 ? Integrator::EARTH_RADIUS / length : 0.0;
+         estimateX[i] = sumX[lane] * scale;
+         estimateY[i] = sumY[lane] * scale;
+         estimateBias[i] = 0.0;
+      }
+   }
+}
+
+/*********************************************
+ * RECEIVERS : ITERATE
+ * Each row of H is the unit vector from the satellite to where the
+ * receiver is thought to be, and a 1 for the clock. The residual is the
+ * pseudorange less what it would be from there. H'H and H'r are added
+ * up a satellite at a time, LANES receivers side by side in arrays of
+ * their own so the compiler knows nothing else touches them, and then
+ * solved by cofactors, all without a branch. Any without three
+ * satellites in sight stay where they are
+ *********************************************/
+double Receivers::iterate(size_t first, size_t last, size_t numSatellites)
+{
+   double largest = 0.0;
+   for (size_t block = first; block < last; block += LANES)
+   {
+      size_t count = std::min(LANES, last - block);
+      double x[LANES] = {};
+      double y[LANES] = {};
+      double bias[LANES] = {};
+      for (size_t lane = 0; lane < count; lane++)
+      {
+         x[lane] = estimateX[block + lane];
+         y[lane] = estimateY[block + lane];
+         bias[lane] = estimateBias[block + lane];
+      }
+
+      double xx[LANES] = {};
+      double xy[LANES] = {};
+      double xb[LANES] = {};
+      double yy[LANES] = {};
+      double yb[LANES] = {};
+      double bb[LANES] = {};
+      double rx[LANES] = {};
+      double ry[LANES] = {};
+      double rb[LANES] = {};
+      for (size_t s = 0; s < numSatellites; s++)
+      {
+         double sx = satelliteX[s];
+         double sy = satelliteY[s];
+         const double* w = &weights[s * stride + block];
+         const double* rho = &pseudoranges[s * stride + block];
+         for (size_t lane = 0; lane < LANES; lane++)
+         {
+            double weight = w[lane];
+            double dx = x[lane] - sx;
+            double dy = y[lane] - sy;
+            double range = sqrt(dx * dx + dy * dy);
+            double ux = dx / range;
+            double uy = dy / range;
+            double residual = rho[lane] - range - bias[lane];
+            xx[lane] += weight * ux * ux;
+            xy[lane] += weight * ux * uy;
+            xb[lane] += weight * ux;
+            yy[lane] += weight * uy * uy;
+            yb[lane] += weight * uy;
+            bb[lane] += weight;
+            rx[lane] += weight * ux * residual;
+            ry[lane] += weight * uy * residual;
+            rb[lane] += weight * residual;
+         }
+      }
+
+      double step[LANES];
+      for (size_t lane = 0; lane < LANES; lane++)
+      {
+         double c00 = yy[lane] * bb[lane] - yb[lane] * yb[lane];
+         double c01 = xb[lane] * yb[lane] - xy[lane] * bb[lane];
+         double c02 = xy[lane] * yb[lane] - yy[lane] * xb[lane];
+         double c11 = xx[lane] * bb[lane] - xb[lane] * xb[lane];
+         double c12 = xy[lane] * xb[lane] - xx[lane] * yb[lane];
+         double c22 = xx[lane] * yy[lane] - xy[lane] * xy[lane];
+         double determinant = xx[lane] * c00 + xy[lane] * c01 + xb[lane] * c02;
+         double inverse = bb[lane] >= 3.0 && determinant > 0.0 ? 1.0 / determinant : 0.0;
+         double stepX = inverse * (c00 * rx[lane] + c01 * ry[lane] + c02 * rb[lane]);
+         double stepY = inverse * (c01 * rx[lane] + c11 * ry[lane] + c12 * rb[lane]);
+         double stepBias = inverse * (c02 * rx[lane] + c12 * ry[lane] + c22 * rb[lane]);
+         x[lane] += stepX;
+         y[lane] += stepY;
+         bias[lane] += stepBias;
+         step[lane] = fabs(stepX) + fabs(stepY) + fabs(stepBias);
+      }
+
+      for (size_t lane = 0; lane < count; lane++)
+      {
+         size_t i = block + lane;
+         estimateX[i] = x[lane];
+         estimateY[i] = y[lane];
+         estimateBias[i] = bias[lane];
+         hxx[i] = xx[lane];
+         hxy[i] = xy[lane];
+         hxb[i] = xb[lane];
+         hyy[i] = yy[lane];
+         hyb[i] = yb[lane];
+         hbb[i] = bb[lane];
+         steps[i] = step[lane];
+         largest = std::max(largest, step[lane]);
+      }
+   }
+   return largest;
+}
+
+/*********************************************
+ * RECEIVERS : GET SUMMARY
+ *********************************************/
+Receivers::Summary Receivers::getSummary() const
+{
+   Summary summary = { size(), 0, 0.0, 0.0, 0.0, 0.0 };
+   double sumSquared = 0.0;
+   for (const Fix& fix : fixes)
+   {
+      summary.meanVisible += fix.numVisible;
+      if (!fix.isFixed)
+         continue;
+      summary.numFixed++;
+      summary.meanPdop += fix.pdop;
+      sumSquared += fix.error * fix.error;
+      summary.maxError = std::max(summary.maxError, fix.error);
+   }
+   if (summary.numReceivers > 0)
+      summary.meanVisible /= summary.numReceivers;
+   if (summary.numFixed > 0)
+   {
+      summary.meanPdop /= summary.numFixed;
+      summary.rmsError = sqrt(sumSquared / summary.numFixed);
+   }
+   return summary;
+}
@@ -0,0 +1,163 @@
+/***********************************************************************
+ * Header File:
+ *    RECEIVERS
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Thousands of GPS receivers on the ground and in orbit, each working
+ *    out where it is from the GPS satellites it can see
+ ************************************************************************/
+
+#pragma once
+
+#include "integrator.h"
+#include <vector>
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint64_t
+
+class TestReceivers;
+
+/*********************************************
+ * RECEIVERS
+ * Each solve, every receiver measures a pseudorange to each GPS
+ * satellite it can see: the true distance plus its own clock error,
+ * in meters, plus noise. A satellite is out of sight when the line to
+ * it passes through the Earth. The world is flat, so each receiver has
+ * three unknowns, x, y, and its clock, and needs three satellites.
+ * They are solved by Gauss-Newton least squares, all receivers in a
+ * batch going through each step together. Receivers are kept as arrays
+ * of numbers rather than objects, and the loops go along the receivers
+ * with no branches, so the compiler can do several at once (GCC only
+ * when told -fno-math-errno, or sqrt() is a branch). Batches are
+ * split among threads. Each starts from where it was last time when it
+ * had a fix, and otherwise from the ground under the satellites it sees.
+ * DOP, the dilution of precision, is how much the geometry of the
+ * satellites in view magnifies range error into position error
+ *********************************************/
+class Receivers
+{
+public:
+   friend TestReceivers;
+
+   // What one receiver made of the satellites it could see
+   struct Fix
+   {
+      double x;            // where it thinks it is, meters
+      double y;
+      double bias;         // its clock error, in meters
+      double error;        // meters from where it really is
+      double gdop;         // in all,
+      double pdop;         // in position,
+      double tdop;         // and in the clock
+      int numVisible;      // GPS satellites it could see
+      bool isFixed;        // enough of them, and the solution settled
+   };
+
+   // How the receivers did as a whole. The means and errors are only
+   // over the ones with a fix
+   struct Summary
+   {
+      size_t numReceivers;
+      size_t numFixed;
+      double meanVisible;
+      double meanPdop;
+      double rmsError;
+      double maxError;
+   };
+
+   // Ranges are off by a bell curve with sigmaRange meters standard
+   // deviation, the same for the same seed
+   Receivers(double sigmaRange = 0.0, int numThreads = 0, uint64_t seed = 1);
+
+   // Evenly round the surface of the Earth, where they stay
+   void addGround(int count);
+
+   // Evenly round a circular orbit this high
+   void addOrbit(int count, double altitude);
+
+   // One more, going round from this state or sitting still there, with
+   // a clock this many meters off
+   void add(const Integrator::State& state, bool isGround, double bias);
+
+   // Where each receiver thinks it is this long after they were added,
+   // from the GPS satellites where they are now
+   void solve(double seconds, const std::vector<Integrator::State>& satellites);
+
+   size_t size() const { return fixes.size(); }
+   const Fix& getFix(size_t i) const { return fixes[i]; }
+   Summary getSummary() const;
+
+   // Where a receiver really is, as of the last solve
+   double getX(size_t i) const { return trueX[i]; }
+   double getY(size_t i) const { return trueY[i]; }
+
+private:
+   // One batch, [first, last), through every step
+   void solveBatch(size_t first, size_t last, double seconds, size_t numSatellites);
+
+   // Where the receivers in a batch really are at this time
+   void move(size_t first, size_t last, double seconds);
+
+   // Which satellites each sees, and the pseudoranges to them
+   void measure(size_t first, size_t last, size_t numSatellites);
+
+   // Where to start from: last time's answer, or failing that the
+   // ground under the satellites in sight
+   void guess(size_t first, size_t last, size_t numSatellites);
+
+   // One Gauss-Newton step. The largest change it made
+   double iterate(size_t first, size_t last, size_t numSatellites);
+
+   // A bell curve number from a counter and the seed, so it comes out
+   // the same whichever thread asks
+   double getNormal(uint64_t counter) const;
+
+   double sigmaRange;
+   int numThreads;
+   uint64_t seed;
+   uint64_t numSolves;
+
+   // each receiver: where it started, how it moves, and its clock
+   std::vector<Kepler> orbits;
+   std::vector<double> startX;
+   std::vector<double> startY;
+   std::vector<char> isGround;
+   std::vector<double> trueBias;
+
+   // each receiver: where it is and where it thinks it is
+   std::vector<double> trueX;
+   std::vector<double> trueY;
+   std::vector<double> estimateX;
+   std::vector<double> estimateY;
+   std::vector<double> estimateBias;
+
+   // each GPS satellite, where it is now
+   std::vector<double> satelliteX;
+   std::vector<double> satelliteY;
+
+   // each satellite then each receiver, a row stride long, which is
+   // enough for every block to be whole
+   size_t stride;
+   std::vector<double> weights;        // 1 in sight, 0 not
+   std::vector<double> pseudoranges;
+
+   // each receiver: H'H as of the last step, symmetric, so six of its
+   // nine, and how far that step went
+   std::vector<double> hxx;
+   std::vector<double> hxy;
+   std::vector<double> hxb;
+   std::vector<double> hyy;
+   std::vector<double> hyb;
+   std::vector<double> hbb;
+   std::vector<double> steps;
+
+   std::vector<Fix> fixes;
+
+   static constexpr size_t LANES = 8;      // receivers side by side in a step
+   static constexpr size_t BATCH = 128 * LANES; // receivers that settle together
+   static const int NUM_ITERATIONS = 10;
+   static constexpr double TOLERANCE = 1.0e-4;        // meters, a step small enough to stop
+   static constexpr double TOLERANCE_FIX = 1.0;       // meters, a last step small enough to trust
+   static constexpr double SIGMA_CLOCK = 100000.0;    // meters, about a third of a millisecond
+   static constexpr double GRACE = 1.0;               // meters, so the ground sees its horizon
+};
@@ -0,0 +1,186 @@
+/***********************************************************************
+ * Source File:
+ *    SCENARIO
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Made-up skies of any size, from ten objects to ten million, that
+ *    come out the same every time for the same seed
+ ************************************************************************/
+
+#include "scenario.h"
+#include "Starlink.h"
+#include "GPS.h"
+#define _USE_MATH_DEFINES
+#include <cmath>     // for sqrt(), sin(), cos(), log(), and M_PI
+#include <cstring>   // for strcmp() and strstr()
+#include <algorithm> // for max()
+
+/*********************************************
+ * SCENARIO : GET CIRCLE
+ *********************************************/
+Integrator::State Scenario::getCircle(double radius, double radians)
+{
+   double speed = sqrt(Integrator::MU / radius);
+   double c = cos(radians);
+   double s = sin(radians);
+   return { radius * c, radius * s, -speed * s, speed * c };
+}
+
+/*********************************************
+ * SCENARIO : ADD WALKER
+ * Satellite k of plane p sits at 360 (k / perPlane + phasing p / total)
+ * degrees. Planes that do not divide evenly get one extra each, first
+ * planes first
+ *********************************************/
+void Scenario::addWalker(int total, int numPlanes, int phasing, double altitude,
+                         double spacing)
+{
+   if (total <= 0)
+      return;
+   numPlanes = std::max(1, std::min(numPlanes, total));
+   double start = 2.0 * M_PI * getUniform();
+
+   reserve(size() + total);
+   for (int plane = 0; plane < numPlanes; plane++)
+   {
+      int perPlane = total / numPlanes + (plane < total % numPlanes ? 1 : 0);
+      double radius = Integrator::EARTH_RADIUS + altitude + spacing * plane;
+      double offset = 2.0 * M_PI * phasing * plane / total;
+      for (int k = 0; k < perPlane; k++)
+         objects.push_back({ getCircle(radius, start + offset + 2.0 * M_PI * k / perPlane),
+                             WALKER });
+   }
+}
+
+/*********************************************
+ * SCENARIO : ADD MEO
+ * The planes share one orbit and are spaced evenly around it, the way
+ * the six GPS satellites the simulator starts with are
+ *********************************************/
+void Scenario::addMEO(int total, int numPlanes, double altitude)
+{
+   size_t first = size();
+   addWalker(total, numPlanes, 1, altitude, 0.0);
+   for (size_t i = first; i < size(); i++)
+      objects[i].kind = MEO;
+}
+
+/*********************************************
+ * SCENARIO : ADD DEBRIS
+ *********************************************/
+void Scenario::addDebris(int total, const Integrator::State& center,
+                         double sigmaPosition, double sigmaSpeed)
+{
+   reserve(size() + std::max(0, total));
+   for (int i = 0; i < total; i++)
+   {
+      Integrator::State state = center;
+      state.x += sigmaPosition * getNormal();
+      state.y += sigmaPosition * getNormal();
+      state.dx += sigmaSpeed * getNormal();
+      state.dy += sigmaSpeed * getNormal();
+      objects.push_back({ state, DEBRIS });
+   }
+}
+
+/*********************************************
+ * SCENARIO : ADD MIX
+ * Six tenths Starlink split between a 550 km and a 1150 km shell, a
+ * tenth in the GPS planes, and the rest debris from a breakup at 800 km.
+ * Each shell has about as many planes as satellites in a plane
+ *********************************************/
+void Scenario::addMix(int total)
+{
+   int numStarlink = total * 6 / 10;
+   int numLow = numStarlink / 2;
+   int numHigh = numStarlink - numLow;
+   int numMEO = total / 10;
+
+   reserve(size() + std::max(0, total));
+   addWalker(numLow, std::max(1, (int)sqrt((double)numLow)), 1, 550000.0);
+   addWalker(numHigh, std::max(1, (int)sqrt((double)numHigh)), 1, 1150000.0);
+   addMEO(numMEO);
+   addDebris(total - numStarlink - numMEO,
+             getCircle(Integrator::EARTH_RADIUS + 800000.0, 2.0 * M_PI * getUniform()));
+}
+
+/*********************************************
+ * SCENARIO : ADD
+ * The kinds of sky by name, for the command line. A lone constellation
+ * gets the same planes as a shell of the mix, and lone debris breaks up
+ * at 800 km
+ *********************************************/
+bool Scenario::add(const char* name, int total)
+{
+   if (strcmp(name, "walker") == 0)
+      addWalker(total, std::max(1, (int)sqrt((double)total)), 1, 550000.0);
+   else if (strcmp(name, "meo") == 0)
+      addMEO(total);
+   else if (strcmp(name, "debris") == 0)
+      addDebris(total, getCircle(Integrator::EARTH_RADIUS + 800000.0, 2.0 * M_PI * getUniform()));
+   else if (strcmp(name, "mix") == 0)
+      addMix(total);
+   else
+      return false;
+   return true;
+}
+
+/*********************************************
+ * SCENARIO : ADD CATALOG
+ *********************************************/
+void Scenario::addCatalog(const Catalog& catalog, double epoch)
+{
+   const double MEO_MOTION = 2.5 * 2.0 * M_PI / 86400.0;   // radians per second
+   reserve(size() + catalog.size());
+   for (const Catalog::Elements& elements : catalog.getElements())
+   {
+      Kind kind = WALKER;
+      if (strstr(elements.name, "DEB") || strstr(elements.name, "R/B"))
+         kind = DEBRIS;
+      else if (elements.meanMotion < MEO_MOTION)
+         kind = MEO;
+      objects.push_back({ Catalog::getState(elements, epoch), kind });
+   }
+}
+
+/*********************************************
+ * SCENARIO : CREATE
+ *********************************************/
+Satellite* Scenario::create(const Object& object)
+{
+   Satellite* pSatellite;
+   switch (object.kind)
+   {
+      case WALKER:
+         pSatellite = new Starlink();
+         break;
+      case MEO:
+         pSatellite = new GPS();
+         break;
+      default:
+         return new Debris(object.state);
+   }
+   pSatellite->setState(object.state);
+   return pSatellite;
+}
+
+/*********************************************
+ * SCENARIO : GET UNIFORM
+ * The top 53 bits, which is all a double can hold
+ *********************************************/
+double Scenario::getUniform()
+{
+   return (double)(generator() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/*********************************************
+ * SCENARIO : GET NORMAL
+ * Box-Muller. One minus the uniform is never zero, so the log is safe
+ *********************************************/
+double Scenario::getNormal()
+{
+   double u = 1.0 - getUniform();
+   double v = getUniform();
+   return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
@@ -0,0 +1,92 @@
+/***********************************************************************
+ * Header File:
+ *    SCENARIO
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Made-up skies of any size, from ten objects to ten million, that
+ *    come out the same every time for the same seed
+ ************************************************************************/
+
+#pragma once
+
+#include "integrator.h"
+#include "Satellite.h"
+#include "Debris.h"
+#include "catalog.h"
+#include <vector>
+#include <cstdint>   // for uint64_t
+#include <random>    // for mt19937_64
+
+class TestScenario;
+
+/*********************************************
+ * SCENARIO
+ * A list of where things start, built up a piece at a time. The world is
+ * flat, so the planes of a constellation cannot lean over the way they
+ * do in orbit. Here each plane is a ring of its own a little higher than
+ * the one before, and the Walker phasing still staggers them, so the
+ * planes drift past each other the way crossing planes would.
+ * The generator is a mt19937_64 drawn on directly rather than through
+ * the standard distributions, which differ from library to library, so
+ * a seed makes the same sky on any compiler
+ *********************************************/
+class Scenario
+{
+public:
+   friend TestScenario;
+
+   enum Kind { WALKER, MEO, DEBRIS };
+
+   struct Object
+   {
+      Integrator::State state;
+      Kind kind;
+   };
+
+   Scenario(uint64_t seed = 1) : generator(seed) {}
+
+   // A Walker delta constellation of total satellites in numPlanes rings
+   // starting at altitude, each plane's ring spacing meters above the last.
+   // Plane p is turned 360 * phasing * p / total degrees ahead
+   void addWalker(int total, int numPlanes, int phasing, double altitude,
+                  double spacing = 2000.0);
+
+   // Navigation satellites in medium Earth orbit, like GPS
+   void addMEO(int total, int numPlanes = 6, double altitude = 20180000.0);
+
+   // A cloud of debris around where something broke up: position and
+   // velocity are each spread out in a bell curve around the center's
+   void addDebris(int total, const Integrator::State& center,
+                  double sigmaPosition = 10000.0, double sigmaSpeed = 50.0);
+
+   // Some of everything, total objects in all: two Starlink shells, the
+   // GPS planes, and a breakup in low orbit
+   void addMix(int total);
+
+   // By name: "walker", "meo", "debris" or "mix". False for anything else
+   bool add(const char* name, int total);
+
+   // Everything in a catalog where it is at epoch, days since 2000. Names
+   // with DEB or R/B in them are debris, anything that goes round fewer
+   // than two and a half times a day is MEO, and the rest are Starlink
+   void addCatalog(const Catalog& catalog, double epoch);
+
+   const std::vector<Object>& getObjects() const { return objects; }
+   size_t size() const { return objects.size(); }
+   void reserve(size_t count) { objects.reserve(count); }
+
+   // A satellite for each object, the kind the object says. The caller
+   // owns them
+   static Satellite* create(const Object& object);
+
+   // Going round counterclockwise at this distance from the center
+   static Integrator::State getCircle(double radius, double radians);
+
+private:
+   double getUniform();   // [0, 1)
+   double getNormal();    // mean 0, standard deviation 1
+
+   std::vector<Object> objects;
+   std::mt19937_64 generator;
+};
@@ -0,0 +1,69 @@
+/***********************************************************************
+ * Header File:
+ *    SPSC QUEUE
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Pass a stream of items from one thread to another, in order,
+ *    without either one ever waiting on the other
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>    // for std::atomic
+#include <cstddef>   // for size_t
+
+class TestSpscQueue;
+
+/*********************************************
+ * SPSC QUEUE
+ * A ring of CAPACITY slots between a single producer and a single
+ * consumer. The producer only moves the tail and the consumer only moves
+ * the head, so each index has exactly one writer and there are no locks.
+ * When the ring is full, push() fails rather than overwriting something
+ * the consumer has not seen.
+ *********************************************/
+template <class T, size_t CAPACITY>
+class SpscQueue
+{
+   static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+
+public:
+   friend TestSpscQueue;
+
+   SpscQueue() : head(0), tail(0) {}
+
+   // Producer: add to the back. False when the consumer is too far behind,
+   // or when it would leave fewer than keepFree slots for other items
+   bool push(const T& item, size_t keepFree = 0)
+   {
+      size_t t = tail.load(std::memory_order_relaxed);
+      if (t - head.load(std::memory_order_acquire) >= CAPACITY - keepFree)
+         return false;
+      slots[t & (CAPACITY - 1)] = item;
+      tail.store(t + 1, std::memory_order_release);
+      return true;
+   }
+
+   // Consumer: look at the front without taking it. NULL when empty
+   const T* peek() const
+   {
+      size_t h = head.load(std::memory_order_relaxed);
+      if (h == tail.load(std::memory_order_acquire))
+         return NULL;
+      return &slots[h & (CAPACITY - 1)];
+   }
+
+   // Consumer: done with the front. Only call after peek() found one
+   void pop()
+   {
+      head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+   }
+
+   bool isEmpty() const { return peek() == NULL; }
+
+private:
+   T slots[CAPACITY];
+   alignas(64) std::atomic<size_t> head;   // next to read, only the consumer moves it
+   alignas(64) std::atomic<size_t> tail;   // next to write, only the producer moves it
+};
@@ -20,25 +20,99 @@
 #include "TestCrewDragon.h"
 #include "TestGPS.h"
 #include "TestShip.h"
+#include "TestRaster.h"
+#include "TestCamera.h"
+#include "TestHeatmap.h"
+#include "TestRecord.h"
+#include "TestTripleBuffer.h"
+#include "TestSpscQueue.h"
+#include "TestFixedStep.h"
+#include "TestProfiler.h"
+#include "TestTrace.h"
+#include "TestIntegrator.h"
+#include "TestScenario.h"
+#include "TestBroadPhase.h"
+#include "TestPhases.h"
+#include "TestCheckpoint.h"
+#include "TestTrajectory.h"
+#include "TestCatalog.h"
+#include "TestEphemeris.h"
+#include "TestConjunction.h"
+#include "TestReceivers.h"
+#include "TestLinkGraph.h"
 
 /*****************************************************************
- * TEST RUNNER
- * Runs all the unit tests
+ * RUN SUITE
+ * One test class from start to finish
  ****************************************************************/
-void testRunner()
+template <class T>
+void runSuite()
 {
-	TestPosition().run();
-	TestVelocity().run();
-	TestAcceleration().run();
-	TestAngle().run();
-	TestSatellite().run();
-	TestSputnik().run();
-	TestHubble().run();
-	TestStarlink().run();
-	TestCrewDragon().run();
-	TestGPS().run();
-	TestSputnik().run();
-   TestShip().run();
+   T().run();
+}
 
+/*****************************************************************
+ * GET TEST STAGES
+ * Every suite, arranged so the ones that share anything never run at
+ * the same time. The physics suites leave the zoom and the time warp
+ * for each other, so they stay in one lane in their old order. The
+ * trace suite empties every thread's trace, so it waits until the end,
+ * and the checkpoint suite puts the random numbers back where they
+ * were, so nothing else may draw any while it runs
+ ****************************************************************/
+const std::vector<TestStage>& getTestStages()
+{
+   static const std::vector<TestStage> stages =
+   {
+      {
+         {
+            runSuite<TestPosition>,
+            runSuite<TestVelocity>,
+            runSuite<TestAcceleration>,
+            runSuite<TestAngle>,
+            runSuite<TestSatellite>,
+            runSuite<TestSputnik>,
+            runSuite<TestHubble>,
+            runSuite<TestStarlink>,
+            runSuite<TestCrewDragon>,
+            runSuite<TestGPS>,
+            runSuite<TestShip>
+         },
+         { runSuite<TestRaster> },
+         { runSuite<TestCamera> },
+         { runSuite<TestHeatmap> },
+         { runSuite<TestRecord> },
+         { runSuite<TestTripleBuffer> },
+         { runSuite<TestSpscQueue> },
+         { runSuite<TestFixedStep> },
+         { runSuite<TestProfiler> },
+         { runSuite<TestIntegrator> },
+         { runSuite<TestScenario> },
+         { runSuite<TestBroadPhase> },
+         { runSuite<TestPhases> },
+         { runSuite<TestTrajectory> },
+         { runSuite<TestCatalog> },
+         { runSuite<TestEphemeris> },
+         { runSuite<TestConjunction> },
+         { runSuite<TestReceivers> },
+         { runSuite<TestLinkGraph> }
+      },
+      {
+         { runSuite<TestTrace> },
+         { runSuite<TestCheckpoint> }
+      }
+   };
+   return stages;
+}
 
+/*****************************************************************
+ * TEST RUNNER
+ * Runs all the unit tests, one after another
+ ****************************************************************/
+void testRunner()
+{
+   for (const TestStage& stage : getTestStages())
+      for (const TestLane& lane : stage)
+         for (TestSuite suite : lane)
+            suite();
 }
@@ -10,5 +10,18 @@
 
 #pragma once
 
-void testRunner();
+#include <vector>
+
+// One test class: run() it and report()
+typedef void (*TestSuite)();
+
+// Suites that lean on what the one before left behind, such as the
+// zoom or the time warp, so they run in order on one thread
+typedef std::vector<TestSuite> TestLane;
 
+// Lanes that can run side by side. A stage finishes before the next starts
+typedef std::vector<TestLane> TestStage;
+
+const std::vector<TestStage>& getTestStages();
+
+void testRunner();
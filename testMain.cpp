@@ -0,0 +1,236 @@
+/***********************************************************************
+ * Source File:
+ *    TEST MAIN
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    The unit tests as a program of their own. The lanes of each stage
+ *    run on as many threads as there are, every test case is timed, and
+ *    the results can be saved for a build server. Build it from every
+ *    source file but Simulator.cpp and benchmark.cpp, which have their
+ *    own main():
+ *       g++ -std=gnu++20 -O2 $(ls *.cpp | grep -v Simulator.cpp | grep -v benchmark.cpp) \
+ *           -o orbitTests -lglut -lGLU -lGL -lpthread
+ *    Options:
+ *       --threads <count>   how many lanes at once, all the cores by default
+ *       --junit <file>      save JUnit XML
+ *       --json <file>       save JSON
+ ************************************************************************/
+
+#include "test.h"
+#include "unitTest.h"
+#include <iostream>  // for COUT
+#include <fstream>   // for OFSTREAM
+#include <string>
+#include <vector>
+#include <thread>    // for the lanes
+#include <atomic>
+#include <chrono>    // for steady_clock
+#include <cstring>   // for strcmp()
+#include <cstdlib>   // for atoi()
+using namespace std;
+
+/*********************************************
+ * ESCAPE
+ * Text made safe to put in quotes, in XML or in JSON
+ *********************************************/
+string escapeXML(const char* text)
+{
+   string escaped;
+   for (const char* p = text; *p; p++)
+      switch (*p)
+      {
+         case '&':  escaped += "&amp;";  break;
+         case '<':  escaped += "&lt;";   break;
+         case '>':  escaped += "&gt;";   break;
+         case '"':  escaped += "&quot;"; break;
+         default:   escaped += *p;
+      }
+   return escaped;
+}
+
+string escapeJSON(const char* text)
+{
+   string escaped;
+   for (const char* p = text; *p; p++)
+      if (*p == '"' || *p == '\\')
+         (escaped += '\\') += *p;
+      else if ((unsigned char)*p < ' ')
+         escaped += ' ';
+      else
+         escaped += *p;
+   return escaped;
+}
+
+/*********************************************
+ * COUNT
+ * Test cases and failed test cases in a suite, and how long it took
+ *********************************************/
+struct Count
+{
+   int cases = 0;
+   int failures = 0;
+   double seconds = 0.0;
+
+   Count(const UnitTest::Suite& suite)
+   {
+      for (const UnitTest::Case& test : suite.cases)
+      {
+         cases++;
+         failures += test.failures.empty() ? 0 : 1;
+         seconds += test.seconds;
+      }
+   }
+   Count(const vector<UnitTest::Suite>& suites)
+   {
+      for (const UnitTest::Suite& suite : suites)
+      {
+         Count count(suite);
+         cases += count.cases;
+         failures += count.failures;
+         seconds += count.seconds;
+      }
+   }
+};
+
+/*********************************************
+ * WRITE JUNIT
+ * The results the way most build servers read them
+ *********************************************/
+bool writeJUnit(const char* fileName, const vector<UnitTest::Suite>& suites)
+{
+   ofstream fout(fileName);
+   if (!fout)
+      return false;
+
+   Count total(suites);
+   fout << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<testsuites tests=\"" << total.cases << "\" failures=\"" << total.failures
+        << "\" time=\"" << total.seconds << "\">\n";
+   for (const UnitTest::Suite& suite : suites)
+   {
+      Count count(suite);
+      fout << "  <testsuite name=\"" << escapeXML(suite.name) << "\" tests=\"" << count.cases
+           << "\" failures=\"" << count.failures << "\" time=\"" << count.seconds << "\">\n";
+      for (const UnitTest::Case& test : suite.cases)
+      {
+         fout << "    <testcase classname=\"" << escapeXML(suite.name) << "\" name=\""
+              << escapeXML(test.name) << "\" time=\"" << test.seconds << "\"";
+         if (test.failures.empty())
+         {
+            fout << "/>\n";
+            continue;
+         }
+         fout << ">\n";
+         for (const UnitTest::Failure& failure : test.failures)
+            fout << "      <failure message=\"" << escapeXML(failure.failure)
+                 << "\" type=\"assert\">line " << failure.lineNumber << "</failure>\n";
+         fout << "    </testcase>\n";
+      }
+      fout << "  </testsuite>\n";
+   }
+   fout << "</testsuites>\n";
+   return fout.good();
+}
+
+/*********************************************
+ * WRITE JSON
+ * The results for scripts
+ *********************************************/
+bool writeJSON(const char* fileName, const vector<UnitTest::Suite>& suites)
+{
+   ofstream fout(fileName);
+   if (!fout)
+      return false;
+
+   fout << "{\"suites\":[";
+   for (size_t i = 0; i < suites.size(); i++)
+   {
+      fout << (i ? ",\n" : "\n") << "{\"name\":\"" << escapeJSON(suites[i].name)
+           << "\",\"cases\":[";
+      for (size_t j = 0; j < suites[i].cases.size(); j++)
+      {
+         const UnitTest::Case& test = suites[i].cases[j];
+         fout << (j ? "," : "") << "\n {\"name\":\"" << escapeJSON(test.name)
+              << "\",\"seconds\":" << test.seconds << ",\"failures\":[";
+         for (size_t k = 0; k < test.failures.size(); k++)
+            fout << (k ? "," : "") << "{\"line\":" << test.failures[k].lineNumber
+                 << ",\"condition\":\"" << escapeJSON(test.failures[k].failure) << "\"}";
+         fout << "]}";
+      }
+      fout << "]}";
+   }
+   fout << "\n]}\n";
+   return fout.good();
+}
+
+/*********************************************
+ * RUN STAGE
+ * Hand the lanes out to the threads as they come free. Each lane's
+ * results go in its own slot, so they come out in the same order
+ * however the threads got to them
+ *********************************************/
+void runStage(const TestStage& stage, int numThreads, vector<UnitTest::Suite>& suites)
+{
+   vector<vector<UnitTest::Suite>> results(stage.size());
+   atomic<size_t> next(0);
+   auto worker = [&]()
+   {
+      for (size_t lane = next++; lane < stage.size(); lane = next++)
+      {
+         UnitTest::pResults = &results[lane];
+         for (TestSuite suite : stage[lane])
+            suite();
+         UnitTest::pResults = nullptr;
+      }
+   };
+
+   vector<thread> threads;
+   for (int i = 1; i < numThreads && i < (int)stage.size(); i++)
+      threads.push_back(thread(worker));
+   worker();
+   for (thread& t : threads)
+      t.join();
+
+   for (vector<UnitTest::Suite>& lane : results)
+      for (UnitTest::Suite& suite : lane)
+         suites.push_back(move(suite));
+}
+
+/*********************************************
+ * MAIN
+ * Run everything and say how it went. Fails when any test does
+ *********************************************/
+int main(int argc, char** argv)
+{
+   int numThreads = max(1, (int)thread::hardware_concurrency());
+   const char* junitFileName = NULL;
+   const char* jsonFileName = NULL;
+   for (int i = 1; i < argc; i++)
+      if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+         numThreads = max(1, atoi(argv[++i]));
+      else if (strcmp(argv[i], "--junit") == 0 && i + 1 < argc)
+         junitFileName = argv[++i];
+      else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+         jsonFileName = argv[++i];
+
+   auto start = chrono::steady_clock::now();
+   vector<UnitTest::Suite> suites;
+   for (const TestStage& stage : getTestStages())
+      runStage(stage, numThreads, suites);
+   double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+   for (const UnitTest::Suite& suite : suites)
+      UnitTest::print(suite, cout);
+   Count total(suites);
+   cout << total.cases << " tests in " << suites.size() << " suites, "
+        << total.failures << " failed, in " << seconds * 1000.0 << " ms on "
+        << numThreads << " threads\n";
+
+   if (junitFileName && !writeJUnit(junitFileName, suites))
+      cerr << "Unable to write " << junitFileName << endl;
+   if (jsonFileName && !writeJSON(jsonFileName, suites))
+      cerr << "Unable to write " << jsonFileName << endl;
+
+   return total.failures ? 1 : 0;
+}
@@ -0,0 +1,217 @@
+/***********************************************************************
+ * Source File:
+ *    TRACE
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Record when each interesting scope starts and stops, thread by
+ *    thread, and write it out for chrome://tracing or Perfetto
+ ************************************************************************/
+
+#include "trace.h"
+#include <mutex>     // for adding a thread and writing
+#include <fstream>
+#include <cstdio>    // for snprintf()
+
+thread_local Trace::Buffer* Trace::pLocal = nullptr;
+thread_local Trace::Owner Trace::owner;
+
+/*********************************************
+ * MUTEX
+ * Held while a thread adds its buffer and while the trace is written
+ *********************************************/
+static std::mutex& getMutex()
+{
+   static std::mutex mutex;
+   return mutex;
+}
+
+/*********************************************
+ * TRACE : GET BUFFERS
+ * Every ring buffer there is. They are never freed, so a thread that has
+ * finished still shows up in the trace until its ring is taken again
+ *********************************************/
+std::vector<std::unique_ptr<Trace::Buffer>>& Trace::getBuffers()
+{
+   static std::vector<std::unique_ptr<Buffer>> buffers;
+   return buffers;
+}
+
+/*********************************************
+ * TRACE : GET SPARES
+ * The rings of threads that have finished, waiting for the next thread
+ * to start recording. Guarded by the mutex
+ *********************************************/
+std::vector<Trace::Buffer*>& Trace::getSpares()
+{
+   static std::vector<Buffer*> spares;
+   return spares;
+}
+
+/*********************************************
+ * EPOCH
+ * Timestamps in the trace count from when the program started
+ *********************************************/
+static const uint64_t epoch = Trace::now();
+
+/*********************************************
+ * TRACE : CREATE
+ * Give this thread a ring buffer of its own, one a finished thread left
+ * behind if there is one. It carries on from where that thread stopped
+ *********************************************/
+Trace::Buffer* Trace::create()
+{
+   std::lock_guard<std::mutex> lock(getMutex());
+   Buffer* pBuffer;
+   if (!getSpares().empty())
+   {
+      pBuffer = getSpares().back();
+      getSpares().pop_back();
+   }
+   else
+   {
+      pBuffer = new Buffer();
+      pBuffer->head = 0;
+      getBuffers().emplace_back(pBuffer);
+      pBuffer->id = (int)getBuffers().size();
+   }
+   pBuffer->threadName = nullptr;
+
+   (void)&owner;   // made now, so it is there to hand the ring back
+   pLocal = pBuffer;
+   return pBuffer;
+}
+
+/*********************************************
+ * TRACE : OWNER : DESTRUCTOR
+ * This thread is done, so the next one can have its ring
+ *********************************************/
+Trace::Owner::~Owner()
+{
+   if (!pLocal)
+      return;
+   std::lock_guard<std::mutex> lock(getMutex());
+   getSpares().push_back(pLocal);
+   pLocal = nullptr;
+}
+
+/*********************************************
+ * TRACE : CLEAR
+ * Forget everything. Only safe while no thread is recording
+ *********************************************/
+void Trace::clear()
+{
+   std::lock_guard<std::mutex> lock(getMutex());
+   for (const std::unique_ptr<Buffer>& pBuffer : getBuffers())
+   {
+      pBuffer->head = 0;
+      pBuffer->threadName = nullptr;
+      for (Event& event : pBuffer->events)
+         event.sequence = 0;
+   }
+}
+
+/*********************************************
+ * TRACE : SET THREAD NAME
+ *********************************************/
+void Trace::setThreadName(const char* name)
+{
+   Buffer* pBuffer = pLocal ? pLocal : create();
+   pBuffer->threadName.store(name, std::memory_order_release);
+}
+
+/*********************************************
+ * WRITE NAME
+ * A name as a JSON string
+ *********************************************/
+static void writeName(std::ostream& out, const char* name)
+{
+   out << '"';
+   for (const char* p = name ? name : "?"; *p; p++)
+      if (*p == '"' || *p == '\\')
+         out << '\\' << *p;
+      else if ((unsigned char)*p < ' ')
+         out << ' ';
+      else
+         out << *p;
+   out << '"';
+}
+
+/*********************************************
+ * TRACE : WRITE JSON
+ * Copy each ring out, one event at a time. An event is only kept if its
+ * slot held that same event both before and after the copy
+ *    INPUT  out  Where the JSON goes
+ *********************************************/
+void Trace::writeJSON(std::ostream& out)
+{
+   struct Copy
+   {
+      const char* name;
+      uint64_t start;
+      uint64_t duration;
+   };
+   std::vector<Copy> copies;
+
+   out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+   const char* separator = "\n";
+
+   std::lock_guard<std::mutex> lock(getMutex());
+   for (const std::unique_ptr<Buffer>& pBuffer : getBuffers())
+   {
+      const char* threadName = pBuffer->threadName.load(std::memory_order_acquire);
+      if (threadName)
+      {
+         out << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+             << pBuffer->id << ",\"args\":{\"name\":";
+         writeName(out, threadName);
+         out << "}}";
+         separator = ",\n";
+      }
+
+      // copy what is there now, skipping whatever is being overwritten
+      uint64_t head = pBuffer->head.load(std::memory_order_acquire);
+      uint64_t begin = head > (uint64_t)CAPACITY ? head - CAPACITY : 0;
+      copies.clear();
+      for (uint64_t i = begin; i < head; i++)
+      {
+         const Event& event = pBuffer->events[i & (CAPACITY - 1)];
+         if (event.sequence.load(std::memory_order_acquire) != i + 1)
+            continue;
+         Copy copy = { event.name.load(std::memory_order_relaxed),
+                       event.start.load(std::memory_order_relaxed),
+                       event.duration.load(std::memory_order_relaxed) };
+         std::atomic_thread_fence(std::memory_order_acquire);
+         if (event.sequence.load(std::memory_order_relaxed) == i + 1)
+            copies.push_back(copy);
+      }
+
+      for (const Copy& copy : copies)
+      {
+         char times[64];
+         snprintf(times, sizeof(times), ",\"ts\":%.3f,\"dur\":%.3f}",
+                  (double)(int64_t)(copy.start - epoch) / 1000.0,
+                  (double)copy.duration / 1000.0);
+         out << separator << "{\"name\":";
+         writeName(out, copy.name);
+         out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << pBuffer->id << times;
+         separator = ",\n";
+      }
+   }
+
+   out << "\n]}\n";
+}
+
+/*********************************************
+ * TRACE : WRITE
+ *    INPUT  fileName  Where to write the JSON
+ *    OUTPUT <return>  Whether it worked
+ *********************************************/
+bool Trace::write(const char* fileName)
+{
+   std::ofstream fout(fileName);
+   if (!fout)
+      return false;
+   writeJSON(fout);
+   return (bool)fout;
+}
@@ -0,0 +1,134 @@
+/***********************************************************************
+ * Header File:
+ *    TRACE
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Record when each interesting scope starts and stops, thread by
+ *    thread, and write it out for chrome://tracing or Perfetto. Build
+ *    with ORBIT_TRACE defined to turn it on; otherwise TRACE_SCOPE and
+ *    TRACE_THREAD compile to nothing
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>    // the buffers are read while they are written
+#include <cstdint>   // for uint64_t
+#include <chrono>    // for steady_clock
+#include <vector>
+#include <memory>    // for unique_ptr
+#include <ostream>
+
+class TestTrace;
+
+/*********************************************
+ * TRACE
+ * Every thread gets a ring buffer of its own the first time it records,
+ * so recording is never more than a few stores and never waits. When a
+ * ring fills, the oldest events are overwritten. A thread that finishes
+ * hands its ring on to the next thread to start recording, so threads
+ * that come and go, such as parallelFor's workers, take turns with a
+ * few rings rather than each leaving one behind. Each slot carries the
+ * number of the event in it, cleared while the event is being written,
+ * so writing the trace can read every ring without stopping anybody and
+ * leave out events that changed under it rather than write them torn
+ *********************************************/
+class Trace
+{
+public:
+   friend TestTrace;
+
+   static const int CAPACITY = 1 << 14;   // events each thread remembers
+
+#ifdef ORBIT_TRACE
+   static constexpr bool isEnabled() { return true; }
+#else
+   static constexpr bool isEnabled() { return false; }
+#endif
+
+   // Nanoseconds on the steady clock
+   static uint64_t now()
+   {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+         std::chrono::steady_clock::now().time_since_epoch()).count();
+   }
+
+   // Remember one scope that just ended on this thread. The name has to
+   // last as long as the program does; a string literal is best
+   static void record(const char* name, uint64_t start, uint64_t end)
+   {
+      Buffer* pBuffer = pLocal ? pLocal : create();
+      uint64_t head = pBuffer->head.load(std::memory_order_relaxed);
+      Event& event = pBuffer->events[head & (CAPACITY - 1)];
+      event.sequence.store(0, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      event.name.store(name, std::memory_order_relaxed);
+      event.start.store(start, std::memory_order_relaxed);
+      event.duration.store(end - start, std::memory_order_relaxed);
+      event.sequence.store(head + 1, std::memory_order_release);
+      pBuffer->head.store(head + 1, std::memory_order_release);
+   }
+
+   // What to call this thread in the trace
+   static void setThreadName(const char* name);
+
+   // Everything every thread remembers, as Chrome trace JSON
+   static void writeJSON(std::ostream& out);
+   static bool write(const char* fileName);
+
+private:
+   struct Event
+   {
+      std::atomic<uint64_t> sequence;   // head after this event, 0 while writing
+      std::atomic<const char*> name;
+      std::atomic<uint64_t> start;      // nanoseconds on the steady clock
+      std::atomic<uint64_t> duration;   // nanoseconds
+   };
+
+   struct Buffer
+   {
+      Event events[CAPACITY];
+      std::atomic<uint64_t> head;       // how many events ever, not wrapped
+      std::atomic<const char*> threadName;
+      int id;                           // 1 for the first ring made
+   };
+
+   // Hands this thread's ring back when the thread ends
+   struct Owner
+   {
+      ~Owner();
+   };
+
+   static Buffer* create();
+   static void clear();
+   static std::vector<std::unique_ptr<Buffer>>& getBuffers();
+   static std::vector<Buffer*>& getSpares();
+
+   static thread_local Buffer* pLocal;  // this thread's, once it has one
+   static thread_local Owner owner;
+};
+
+/*********************************************
+ * TRACE SCOPE
+ * Record from construction to destruction. Use TRACE_SCOPE rather than
+ * this directly so it goes away when tracing is off
+ *********************************************/
+class TraceScope
+{
+public:
+   TraceScope(const char* name) : name(name), start(Trace::now()) {}
+   ~TraceScope() { Trace::record(name, start, Trace::now()); }
+private:
+   const char* name;
+   uint64_t start;
+};
+
+#ifdef ORBIT_TRACE
+#define TRACE_JOIN2(a, b) a##b
+#define TRACE_JOIN(a, b) TRACE_JOIN2(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_JOIN(traceScope, __LINE__)(name)
+#define TRACE_THREAD(name) Trace::setThreadName(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_THREAD(name) ((void)0)
+#endif
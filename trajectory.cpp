@@ -0,0 +1,576 @@
+/***********************************************************************
+ * Source File:
+ *    TRAJECTORY
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Where everything was and how fast it was going, every so many
+ *    ticks, saved on a thread of its own for looking at afterwards
+ ************************************************************************/
+
+#include "trajectory.h"
+#include <algorithm> // for upper_bound() and min()
+#include <chrono>    // for steady_clock
+#include <cstring>   // for memcpy(), memcmp(), and memset()
+#ifndef _WIN32
+#include <sys/types.h>   // for off_t
+#endif
+
+/*********************************************
+ * THE FILE
+ * A header, a block for each sample, the index, and a footer saying
+ * where the index is. Numbers in the headers are written the way this
+ * machine holds them, which the header says; inside a block every byte
+ * is spelled out, so blocks read the same anywhere
+ *********************************************/
+const uint32_t VERSION = 1;
+const uint32_t ENDIAN_MARK = 0x01020304;
+
+struct FileHeader
+{
+   char magic[8];          // "ORBITTRJ"
+   uint32_t version;
+   uint32_t byteOrder;     // ENDIAN_MARK as this machine holds it
+   uint32_t everyTicks;
+   uint32_t unused;
+};
+
+struct BlockHeader
+{
+   uint64_t tick;
+   double seconds;
+   uint32_t count;         // how many rows
+   uint32_t bytes;         // after this header
+};
+
+struct Footer
+{
+   uint64_t numSamples;
+   uint64_t numIndex;      // fresh starts in the index
+   uint64_t indexOffset;   // all the ticks, then all the offsets
+   char magic[8];          // "ORBITIDX"
+};
+
+/*********************************************
+ * SEEK TO
+ * Anywhere in the file, past 2GB too
+ *********************************************/
+static bool seekTo(FILE* file, uint64_t offset)
+{
+#ifdef _WIN32
+   return _fseeki64(file, (long long)offset, SEEK_SET) == 0;
+#else
+   return fseeko(file, (off_t)offset, SEEK_SET) == 0;
+#endif
+}
+
+/*********************************************
+ * SAMPLE : CLEAR
+ * Empty, keeping the room for the next one
+ *********************************************/
+void TrajectoryCodec::Sample::clear(uint64_t tick, double seconds)
+{
+   this->tick = tick;
+   this->seconds = seconds;
+   kinds.clear();
+   x.clear();
+   y.clear();
+   dx.clear();
+   dy.clear();
+}
+
+/*********************************************
+ * TRAJECTORY CODEC : GET COLUMN
+ *********************************************/
+const std::vector<double>& TrajectoryCodec::getColumn(const Sample& sample, int column)
+{
+   switch (column)
+   {
+      case 0:  return sample.x;
+      case 1:  return sample.y;
+      case 2:  return sample.dx;
+      default: return sample.dy;
+   }
+}
+
+std::vector<double>& TrajectoryCodec::getColumn(Sample& sample, int column)
+{
+   return const_cast<std::vector<double>&>(getColumn((const Sample&)sample, column));
+}
+
+/*********************************************
+ * TRAJECTORY CODEC : PREDICT
+ * Carry on along a parabola through the three samples before, which
+ * takes out the pull of gravity as well as the speed. Rows they did not
+ * all have are guessed from what there is, or zero
+ *********************************************/
+void TrajectoryCodec::predict(int column, size_t numRows)
+{
+   const std::vector<double>& p = previous[column];
+   const std::vector<double>& pp = beforePrevious[column];
+   const std::vector<double>& ppp = older[column];
+   size_t num1 = std::min(numRows, p.size());
+   size_t num2 = std::min(num1, pp.size());
+   size_t num3 = std::min(num2, ppp.size());
+   guesses.resize(numRows);
+   double* pGuess = guesses.data();
+   size_t row = 0;
+   for (; row < num3; row++)
+      pGuess[row] = 3.0 * (p[row] - pp[row]) + ppp[row];
+   for (; row < num2; row++)
+      pGuess[row] = p[row] + (p[row] - pp[row]);
+   for (; row < num1; row++)
+      pGuess[row] = p[row];
+   for (; row < numRows; row++)
+      pGuess[row] = 0.0;
+}
+
+/*********************************************
+ * TRAJECTORY CODEC : REMEMBER
+ *********************************************/
+void TrajectoryCodec::remember(const Sample& sample)
+{
+   for (int column = 0; column < NUM_COLUMNS; column++)
+   {
+      older[column].swap(beforePrevious[column]);
+      beforePrevious[column].swap(previous[column]);
+      previous[column].assign(getColumn(sample, column).begin(), getColumn(sample, column).end());
+   }
+   numSince++;
+}
+
+/*********************************************
+ * TRAJECTORY CODEC : START
+ * Forget everything at a fresh start
+ *********************************************/
+void TrajectoryCodec::start()
+{
+   if (!isKey())
+      return;
+   for (int column = 0; column < NUM_COLUMNS; column++)
+   {
+      previous[column].clear();
+      beforePrevious[column].clear();
+      older[column].clear();
+   }
+   numSince = 0;
+}
+
+/*********************************************
+ * IS LITTLE ENDIAN
+ * Whether the bottom byte of a number comes first in memory, so the
+ * bytes kept can be copied eight at a time rather than one
+ *********************************************/
+static bool isLittleEndian()
+{
+   uint16_t one = 1;
+   unsigned char first;
+   memcpy(&first, &one, 1);
+   return first == 1;
+}
+static const bool IS_LITTLE_ENDIAN = isLittleEndian();
+
+/*********************************************
+ * COUNT ZERO BYTES
+ * How many of the top bytes are zero, 8 for zero itself
+ *********************************************/
+static int countZeroBytes(uint64_t value)
+{
+   if (value == 0)
+      return 8;
+#if defined(__GNUC__) || defined(__clang__)
+   return __builtin_clzll(value) / 8;
+#else
+   int numZero = 0;
+   while ((value >> (56 - 8 * numZero)) == 0)
+      numZero++;
+   return numZero;
+#endif
+}
+
+/*********************************************
+ * TRAJECTORY CODEC : ENCODE
+ * The size of each column, the kinds a byte each, then the columns.
+ * A column is a nibble for each row saying how many of the top bytes of
+ * its difference from the guess are zero, then the rest of those bytes
+ * from the bottom up
+ *********************************************/
+void TrajectoryCodec::encode(const Sample& sample, std::vector<unsigned char>& bytes)
+{
+   start();
+
+   size_t numRows = sample.size();
+   size_t sizes = bytes.size();
+   bytes.resize(sizes + NUM_COLUMNS * sizeof(uint32_t));
+   bytes.insert(bytes.end(), sample.kinds.begin(), sample.kinds.end());
+
+   for (int column = 0; column < NUM_COLUMNS; column++)
+   {
+      predict(column, numRows);
+      const double* pValue = getColumn(sample, column).data();
+      const double* pGuess = guesses.data();
+
+      // room for every byte of every number, and eight more to spare
+      size_t start = bytes.size();
+      size_t numControl = (numRows + 1) / 2;
+      bytes.resize(start + numControl + 8 * numRows + 8);
+      unsigned char* pControl = bytes.data() + start;
+      unsigned char* p = pControl + numControl;
+      memset(pControl, 0, numControl);
+
+      for (size_t row = 0; row < numRows; row++)
+      {
+         uint64_t bits;
+         uint64_t bitsGuess;
+         memcpy(&bits, pValue + row, sizeof(bits));
+         memcpy(&bitsGuess, pGuess + row, sizeof(bitsGuess));
+         uint64_t difference = bits ^ bitsGuess;
+
+         int numZero = countZeroBytes(difference);
+         pControl[row / 2] |= (unsigned char)(numZero << (4 * (row & 1)));
+         if (IS_LITTLE_ENDIAN)
+            memcpy(p, &difference, sizeof(difference));
+         else
+            for (int b = 0; b < 8 - numZero; b++)
+               p[b] = (unsigned char)(difference >> (8 * b));
+         p += 8 - numZero;
+      }
+
+      bytes.resize(p - bytes.data());
+      uint32_t size = (uint32_t)(bytes.size() - start);
+      for (int b = 0; b < 4; b++)
+         bytes[sizes + column * 4 + b] = (unsigned char)(size >> (8 * b));
+   }
+
+   remember(sample);
+}
+
+/*********************************************
+ * TRAJECTORY CODEC : DECODE
+ * Undo encode(), checking every size against what is there. The tick,
+ * the time, and how many rows come from the block's header
+ *    INPUT  p         The bytes encode() added
+ *           numBytes  How many
+ *    OUTPUT sample    Its columns filled in
+ *********************************************/
+bool TrajectoryCodec::decode(const unsigned char* p, size_t numBytes, Sample& sample)
+{
+   start();
+
+   size_t numRows = sample.kinds.size();
+   const unsigned char* pEnd = p + numBytes;
+   if (numBytes < NUM_COLUMNS * sizeof(uint32_t) + numRows)
+      return false;
+   uint32_t sizes[NUM_COLUMNS];
+   for (int column = 0; column < NUM_COLUMNS; column++)
+   {
+      sizes[column] = 0;
+      for (int b = 0; b < 4; b++)
+         sizes[column] |= (uint32_t)p[column * 4 + b] << (8 * b);
+   }
+   p += NUM_COLUMNS * sizeof(uint32_t);
+   memcpy(sample.kinds.data(), p, numRows);
+   p += numRows;
+
+   for (int column = 0; column < NUM_COLUMNS; column++)
+   {
+      size_t numControl = (numRows + 1) / 2;
+      if (sizes[column] < numControl || sizes[column] > (size_t)(pEnd - p))
+         return false;
+      const unsigned char* pControl = p;
+      const unsigned char* pColumnEnd = p + sizes[column];
+      p += numControl;
+
+      predict(column, numRows);
+      const double* pGuess = guesses.data();
+      std::vector<double>& values = getColumn(sample, column);
+      values.resize(numRows);
+      double* pValue = values.data();
+      for (size_t row = 0; row < numRows; row++)
+      {
+         int numZero = (pControl[row / 2] >> (4 * (row & 1))) & 0x0F;
+         if (numZero > 8 || 8 - numZero > pColumnEnd - p)
+            return false;
+
+         // eight at a time when that stays inside the column
+         uint64_t difference = 0;
+         if (IS_LITTLE_ENDIAN && pColumnEnd - p >= 8)
+         {
+            memcpy(&difference, p, sizeof(difference));
+            difference = numZero == 8 ? 0 : difference & (~(uint64_t)0 >> (8 * numZero));
+         }
+         else
+            for (int b = 0; b < 8 - numZero; b++)
+               difference |= (uint64_t)p[b] << (8 * b);
+         p += 8 - numZero;
+
+         uint64_t bits;
+         memcpy(&bits, pGuess + row, sizeof(bits));
+         bits ^= difference;
+         memcpy(pValue + row, &bits, sizeof(bits));
+      }
+      if (p != pColumnEnd)
+         return false;
+   }
+
+   remember(sample);
+   return p == pEnd;
+}
+
+/*********************************************
+ * TRAJECTORY RECORDER : CONSTRUCTOR
+ *********************************************/
+TrajectoryRecorder::TrajectoryRecorder() :
+   filling(0),
+   tick(0),
+   everyTicks(1),
+   numSamples(0),
+   numStates(0),
+   secondsWaited(0.0),
+   pending(-1),
+   isStopping(false),
+   file(NULL),
+   isGood(false),
+   offset(0),
+   secondsWriting(0.0)
+{
+}
+
+/*********************************************
+ * TRAJECTORY RECORDER : OPEN
+ *********************************************/
+bool TrajectoryRecorder::open(const char* fileName, int everyTicks)
+{
+   close();
+   file = fopen(fileName, "wb");
+   if (!file)
+      return false;
+
+   FileHeader header = {};
+   memcpy(header.magic, "ORBITTRJ", sizeof(header.magic));
+   header.version = VERSION;
+   header.byteOrder = ENDIAN_MARK;
+   header.everyTicks = (uint32_t)std::max(1, everyTicks);
+   isGood = fwrite(&header, sizeof(header), 1, file) == 1;
+
+   this->everyTicks = (int)header.everyTicks;
+   tick = 0;
+   numSamples = 0;
+   numStates = 0;
+   secondsWaited = 0.0;
+   secondsWriting = 0.0;
+   offset = sizeof(header);
+   codec.reset();
+   indexTicks.clear();
+   indexOffsets.clear();
+   pending = -1;
+   isStopping = false;
+   thread = std::thread(&TrajectoryRecorder::loop, this);
+   return true;
+}
+
+/*********************************************
+ * TRAJECTORY RECORDER : CLOSE
+ * Let the writer finish what it was given, then put the index and the
+ * footer on the end
+ *********************************************/
+bool TrajectoryRecorder::close()
+{
+   if (!file)
+      return true;
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      isStopping = true;
+   }
+   handedOver.notify_one();
+   thread.join();
+
+   Footer footer = {};
+   footer.numSamples = numSamples;
+   footer.numIndex = indexTicks.size();
+   footer.indexOffset = offset;
+   memcpy(footer.magic, "ORBITIDX", sizeof(footer.magic));
+   isGood = isGood &&
+            fwrite(indexTicks.data(), sizeof(uint64_t), indexTicks.size(), file) == indexTicks.size() &&
+            fwrite(indexOffsets.data(), sizeof(uint64_t), indexOffsets.size(), file) == indexOffsets.size() &&
+            fwrite(&footer, sizeof(footer), 1, file) == 1;
+   isGood = fclose(file) == 0 && isGood;
+   file = NULL;
+   return isGood;
+}
+
+/*********************************************
+ * TRAJECTORY RECORDER : GET STAGE IF DUE
+ *********************************************/
+TrajectoryCodec::Sample* TrajectoryRecorder::getStageIfDue(double seconds)
+{
+   bool isDue = file && tick % everyTicks == 0;
+   tick++;
+   if (!isDue)
+      return NULL;
+   stages[filling].clear(tick - 1, seconds);
+   return &stages[filling];
+}
+
+/*********************************************
+ * TRAJECTORY RECORDER : SUBMIT
+ * Hand the stage over and start filling the other one, once the writer
+ * is done with it
+ *********************************************/
+void TrajectoryRecorder::submit()
+{
+   std::unique_lock<std::mutex> lock(mutex);
+   if (pending >= 0)
+   {
+      auto start = std::chrono::steady_clock::now();
+      written.wait(lock, [this] { return pending < 0; });
+      secondsWaited += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   }
+   numSamples++;
+   numStates += stages[filling].size();
+   pending = filling;
+   filling ^= 1;
+   lock.unlock();
+   handedOver.notify_one();
+}
+
+/*********************************************
+ * TRAJECTORY RECORDER : LOOP
+ * Encode and write whatever is handed over until told to stop
+ *********************************************/
+void TrajectoryRecorder::loop()
+{
+   std::unique_lock<std::mutex> lock(mutex);
+   while (true)
+   {
+      handedOver.wait(lock, [this] { return pending >= 0 || isStopping; });
+      if (pending < 0)
+         break;
+      const TrajectoryCodec::Sample& sample = stages[pending];
+      lock.unlock();
+      auto start = std::chrono::steady_clock::now();
+
+      if (codec.isKey())
+      {
+         indexTicks.push_back(sample.tick);
+         indexOffsets.push_back(offset);
+      }
+      block.resize(sizeof(BlockHeader));
+      codec.encode(sample, block);
+      BlockHeader header = { sample.tick, sample.seconds, (uint32_t)sample.size(),
+                             (uint32_t)(block.size() - sizeof(BlockHeader)) };
+      memcpy(block.data(), &header, sizeof(header));
+      isGood = isGood && fwrite(block.data(), 1, block.size(), file) == block.size();
+      offset += block.size();
+      secondsWriting += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      lock.lock();
+      pending = -1;
+      written.notify_one();
+   }
+}
+
+/*********************************************
+ * TRAJECTORY READER : OPEN
+ * The header says what the file is and the footer says where the
+ * index is. Start at the beginning
+ *********************************************/
+bool TrajectoryReader::open(const char* fileName)
+{
+   close();
+   file = fopen(fileName, "rb");
+   if (!file)
+      return false;
+
+   FileHeader header;
+   Footer footer;
+   bool isGood = fread(&header, sizeof(header), 1, file) == 1 &&
+                 memcmp(header.magic, "ORBITTRJ", sizeof(header.magic)) == 0 &&
+                 header.version == VERSION &&
+                 header.byteOrder == ENDIAN_MARK &&
+                 fseek(file, -(long)sizeof(footer), SEEK_END) == 0 &&
+                 fread(&footer, sizeof(footer), 1, file) == 1 &&
+                 memcmp(footer.magic, "ORBITIDX", sizeof(footer.magic)) == 0 &&
+                 footer.indexOffset >= sizeof(header) &&
+                 footer.numIndex <= footer.numSamples;
+   if (isGood)
+   {
+      indexTicks.resize(footer.numIndex);
+      indexOffsets.resize(footer.numIndex);
+      isGood = seekTo(file, footer.indexOffset) &&
+               fread(indexTicks.data(), sizeof(uint64_t), indexTicks.size(), file) == indexTicks.size() &&
+               fread(indexOffsets.data(), sizeof(uint64_t), indexOffsets.size(), file) == indexOffsets.size();
+   }
+   if (!isGood)
+   {
+      close();
+      return false;
+   }
+
+   numSamples = footer.numSamples;
+   everyTicks = (int)header.everyTicks;
+   offsetEnd = footer.indexOffset;
+   return seek(0);
+}
+
+/*********************************************
+ * TRAJECTORY READER : CLOSE
+ *********************************************/
+void TrajectoryReader::close()
+{
+   if (file)
+      fclose(file);
+   file = NULL;
+   numSamples = 0;
+   indexTicks.clear();
+   indexOffsets.clear();
+}
+
+/*********************************************
+ * TRAJECTORY READER : SEEK
+ * Go back to the last fresh start at or before the tick. read() decodes
+ * forward from there, keeping only what is late enough
+ *********************************************/
+bool TrajectoryReader::seek(uint64_t tick)
+{
+   if (!file)
+      return false;
+   size_t i = std::upper_bound(indexTicks.begin(), indexTicks.end(), tick) - indexTicks.begin();
+   uint64_t offsetStart = i == 0 ? sizeof(FileHeader) : indexOffsets[i - 1];
+   tickWanted = tick;
+   codec.reset();
+   return seekTo(file, offsetStart);
+}
+
+/*********************************************
+ * TRAJECTORY READER : READ
+ *********************************************/
+bool TrajectoryReader::read(TrajectoryCodec::Sample& sample)
+{
+   if (!file)
+      return false;
+   while (true)
+   {
+#ifdef _WIN32
+      uint64_t offsetNow = (uint64_t)_ftelli64(file);
+#else
+      uint64_t offsetNow = (uint64_t)ftello(file);
+#endif
+      BlockHeader header;
+      if (offsetNow + sizeof(header) > offsetEnd ||
+          fread(&header, sizeof(header), 1, file) != 1 ||
+          header.bytes > offsetEnd - offsetNow - sizeof(header) ||
+          header.count > header.bytes)
+         return false;
+
+      block.resize(header.bytes);
+      if (fread(block.data(), 1, block.size(), file) != block.size())
+         return false;
+      sample.clear(header.tick, header.seconds);
+      sample.kinds.resize(header.count);
+      if (!codec.decode(block.data(), block.size(), sample))
+         return false;
+      if (sample.tick >= tickWanted)
+         return true;
+   }
+}
@@ -0,0 +1,205 @@
+/***********************************************************************
+ * Header File:
+ *    TRAJECTORY
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Where everything was and how fast it was going, every so many
+ *    ticks, saved on a thread of its own for looking at afterwards
+ ************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>    // for FILE
+#include <cstdint>   // for uint8_t, uint32_t, and uint64_t
+
+class TestTrajectory;
+
+/*********************************************
+ * TRAJECTORY CODEC
+ * Turns one sample after another into bytes and back. Everything is kept
+ * in columns, one for each of x, y, dx, and dy, so alike numbers sit
+ * together. Each number is guessed from the same row of the three
+ * samples before, and only what differs from the guess is kept: the two
+ * are XORed, and the bytes that come out zero at the top are dropped. A
+ * nibble for each number says how many bytes were dropped. How many are
+ * kept depends on how far things go between samples; the closer the
+ * samples, the better the guess.
+ * Rows are the order of the list, so a breakup shifts the rows behind it
+ * and those guess badly for three samples. Nothing is lost, it only takes
+ * more room. Every KEY_INTERVAL samples the codec forgets what came
+ * before so a reader can start there
+ *********************************************/
+class TrajectoryCodec
+{
+public:
+   friend TestTrajectory;
+
+   // One moment, in columns
+   struct Sample
+   {
+      uint64_t tick = 0;        // since the recording started
+      double seconds = 0.0;     // simulated
+      std::vector<uint8_t> kinds;   // Satellite::Kind
+      std::vector<double> x;    // meters
+      std::vector<double> y;
+      std::vector<double> dx;   // m/s
+      std::vector<double> dy;
+
+      size_t size() const { return kinds.size(); }
+      void clear(uint64_t tick, double seconds);
+      void add(uint8_t kind, double x, double y, double dx, double dy)
+      {
+         kinds.push_back(kind);
+         this->x.push_back(x);
+         this->y.push_back(y);
+         this->dx.push_back(dx);
+         this->dy.push_back(dy);
+      }
+   };
+
+   static const int NUM_COLUMNS = 4;
+   static const int KEY_INTERVAL = 64;   // samples between fresh starts
+
+   TrajectoryCodec() : numSince(KEY_INTERVAL) {}
+
+   // Whether the next sample starts afresh
+   bool isKey() const { return numSince >= KEY_INTERVAL; }
+
+   // Add a sample to the end of bytes, or take one back out of them.
+   // Decoding is false when the bytes do not hold what they should
+   void encode(const Sample& sample, std::vector<unsigned char>& bytes);
+   bool decode(const unsigned char* p, size_t numBytes, Sample& sample);
+
+   // Forget what came before, as at a fresh start
+   void reset() { numSince = KEY_INTERVAL; }
+
+private:
+   // What each row of a column is guessed to be, into guesses
+   void predict(int column, size_t numRows);
+
+   // Forget what came before, if this sample is a fresh start
+   void start();
+
+   // Remember this sample for guessing the next
+   void remember(const Sample& sample);
+
+   static const std::vector<double>& getColumn(const Sample& sample, int column);
+   static std::vector<double>& getColumn(Sample& sample, int column);
+
+   std::vector<double> previous[NUM_COLUMNS];        // the sample before
+   std::vector<double> beforePrevious[NUM_COLUMNS];  // and the one before that
+   std::vector<double> older[NUM_COLUMNS];           // and the one before that
+   std::vector<double> guesses;                      // for the column at hand
+   int numSince;                                     // samples since a fresh start
+};
+
+/*********************************************
+ * TRAJECTORY RECORDER
+ * The simulation copies where everything is into one of two staging
+ * samples and hands it over; a thread of its own encodes and writes it
+ * while the next one fills. Handing over only waits when the writer has
+ * fallen a whole sample behind. The file is a header, then a block for
+ * each sample, then an index of where each fresh start is by tick, so
+ * a reader can go straight to any tick
+ *********************************************/
+class TrajectoryRecorder
+{
+public:
+   friend TestTrajectory;
+
+   TrajectoryRecorder();
+   ~TrajectoryRecorder() { close(); }
+
+   // Start writing to a new file, a sample every so many ticks. False
+   // when the file cannot be made
+   bool open(const char* fileName, int everyTicks = 1);
+
+   // Write what is left and the index. True when everything got there
+   bool close();
+
+   bool isOpen() const { return file != NULL; }
+
+   // Called once a tick. When this tick is to be sampled, an empty stage
+   // to fill in and then submit(), otherwise NULL
+   TrajectoryCodec::Sample* getStageIfDue(double seconds);
+   void submit();
+
+   // How it has gone. The writer's time and bytes are only right once
+   // it is closed
+   uint64_t getNumSamples() const { return numSamples; }
+   uint64_t getNumStates()  const { return numStates;  }
+   double getSecondsWaited() const { return secondsWaited; }
+   double getSecondsWriting() const { return secondsWriting; }
+   uint64_t getBytes() const { return offset; }
+
+private:
+   void loop();   // the writer thread
+
+   TrajectoryCodec::Sample stages[2];   // one filling, one being written
+   int filling;                         // which one the simulation fills
+   uint64_t tick;                       // ticks since open()
+   int everyTicks;
+   uint64_t numSamples;
+   uint64_t numStates;
+   double secondsWaited;                // handing over, in all
+
+   std::mutex mutex;
+   std::condition_variable handedOver;  // the writer has something to do
+   std::condition_variable written;     // the writer is done with it
+   int pending;                         // the stage to write, or -1
+   bool isStopping;
+   std::thread thread;
+
+   // only the writer thread touches these until it is joined
+   FILE* file;
+   bool isGood;
+   uint64_t offset;                     // where the next block goes
+   double secondsWriting;               // encoding and writing, in all
+   TrajectoryCodec codec;
+   std::vector<unsigned char> block;
+   std::vector<uint64_t> indexTicks;    // each fresh start
+   std::vector<uint64_t> indexOffsets;
+};
+
+/*********************************************
+ * TRAJECTORY READER
+ * Reads back what a recorder wrote, from the start or from any tick
+ *********************************************/
+class TrajectoryReader
+{
+public:
+   friend TestTrajectory;
+
+   TrajectoryReader() : file(NULL), numSamples(0), everyTicks(0), tickWanted(0), offsetEnd(0) {}
+   ~TrajectoryReader() { close(); }
+
+   // False when the file is missing, from another version, or was not
+   // closed properly and has no index
+   bool open(const char* fileName);
+   void close();
+
+   uint64_t getNumSamples() const { return numSamples; }
+   int getEveryTicks() const { return everyTicks; }
+
+   // The next read() gives the first sample at or after this tick
+   bool seek(uint64_t tick);
+
+   // The next sample. False at the end or when the file is damaged
+   bool read(TrajectoryCodec::Sample& sample);
+
+private:
+   FILE* file;
+   uint64_t numSamples;
+   int everyTicks;
+   uint64_t tickWanted;                 // skip samples before this
+   uint64_t offsetEnd;                  // where the blocks stop
+   TrajectoryCodec codec;
+   std::vector<unsigned char> block;
+   std::vector<uint64_t> indexTicks;
+   std::vector<uint64_t> indexOffsets;
+};
@@ -0,0 +1,66 @@
+/***********************************************************************
+ * Header File:
+ *    TRIPLE BUFFER
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    Hand the latest of something from one thread to another without
+ *    either one ever waiting on the other
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>    // for std::atomic
+
+class TestTripleBuffer;
+
+/*********************************************
+ * TRIPLE BUFFER
+ * Three slots: the writer owns one, the reader owns one, and the third
+ * sits in the middle holding the newest finished item. Publishing swaps
+ * the writer's slot with the middle one, and picking up swaps the
+ * reader's slot with the middle one. Both swaps are a single atomic
+ * exchange, so there are no locks. Only one thread may write and only
+ * one may read.
+ *********************************************/
+template <class T>
+class TripleBuffer
+{
+public:
+   friend TestTripleBuffer;
+
+   TripleBuffer() : middle(1), back(0), front(2) {}
+
+   // Writer: fill in getBack(), then publish() it
+   T& getBack() { return slots[back]; }
+   void publish()
+   {
+      back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX;
+   }
+
+   // Reader: has something been published since we last picked up?
+   bool isFresh() const
+   {
+      return (middle.load(std::memory_order_acquire) & FRESH) != 0;
+   }
+
+   // Reader: take the newest published item. Returns false, leaving
+   // getFront() as it was, when nothing new has been published
+   bool pickUp()
+   {
+      if (!isFresh())
+         return false;
+      front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+      return true;
+   }
+   T& getFront() { return slots[front]; }
+
+private:
+   static const int INDEX = 0x3;   // which slot is in the middle
+   static const int FRESH = 0x4;   // the middle has not been picked up
+
+   T slots[3];
+   std::atomic<int> middle;   // shared: slot index plus the FRESH flag
+   int back;                  // only the writer touches this
+   int front;                 // only the reader touches this
+};
@@ -37,7 +37,10 @@
 
 #include "position.h"
 #include "uiDraw.h"
+#include "trace.h"
 #include <iostream>
+#include <random>     // for mt19937
+#include <mutex>      // breakups on any thread share the one generator
 
 
 
@@ -52,6 +55,8 @@ const int RGB_DEEP_BLUE[] = { 64,   64, 156 };
 const int RGB_BLUE[] = { 0,     0, 256 };
 const int RGB_RED[] = { 255,   0,   0 };
 const int RGB_GOLD[] = { 255, 255,   0 };
+const int RGB_DULL_GOLD[] = { 179, 179,   0 };
+const int RGB_PALE_GOLD[] = { 128, 128,   0 };
 const int RGB_TAN[] = { 180, 150, 110 };
 const int RGB_GREEN[] = { 0, 150,   0 };
 
@@ -129,31 +134,70 @@ inline void glVertexPoint(const Position& point)
 }
 
 /*************************************************************************
- * GL DRAW RECT
+ * DRAW TRIANGLE FAN
+ * Draw a filled fan of triangles around the first point. Quads and
+ * single triangles are just short fans.
+ *   INPUT  points    The vertices, the first being the hub of the fan
+ *          num       How many vertices there are
+ *          rgb       The color to fill with
+ *************************************************************************/
+void ogstream::drawTriangleFan(const Position* points, int num, const int* rgb)
+{
+    glBegin(GL_TRIANGLE_FAN);
+    glColor(rgb);
+    for (int i = 0; i < num; i++)
+        glVertexPoint(toView(points[i]));
+    glResetColor();
+    glEnd();
+}
+
+/*************************************************************************
+ * DRAW LINE
+ * Draw a single line segment
+ *   INPUT  begin     One end of the line
+ *          end       The other end of the line
+ *          rgb       The color of the line
+ *************************************************************************/
+void ogstream::drawLine(const Position& begin, const Position& end, const int* rgb)
+{
+    glBegin(GL_LINES);
+    glColor(rgb);
+    glVertexPoint(toView(begin));
+    glVertexPoint(toView(end));
+    glResetColor();
+    glEnd();
+}
+
+/*************************************************************************
+ * DRAW DOT
+ * Draw a single pixel
+ *   INPUT  point     Where the pixel goes
+ *          rgb       The color of the pixel
+ *************************************************************************/
+void ogstream::drawDot(const Position& point, const int* rgb)
+{
+    glBegin(GL_POINTS);
+    glColor(rgb);
+    glVertexPoint(toView(point));
+    glResetColor();
+    glEnd();
+}
+
+/*************************************************************************
+ * DRAW RECT
  * Draw a colored rectangle
  *************************************************************************/
-void glDrawRect(const Position& center, const Position& offset,
+void ogstream::drawRect(const Position& center, const Position& offset,
     const ColorRect& rect, double rotation)
 {
-    glBegin(GL_QUADS);
-    glColor(rect.rgb);
-    glVertexPoint(rotate(center,
-        rect.x0 + offset.getPixelsX(),
-        rect.y0 + offset.getPixelsY(),
-        rotation));
-    glVertexPoint(rotate(center,
-        rect.x1 + offset.getPixelsX(),
-        rect.y1 + offset.getPixelsY(),
-        rotation));
-    glVertexPoint(rotate(center,
-        rect.x2 + offset.getPixelsX(),
-        rect.y2 + offset.getPixelsY(),
-        rotation));
-    glVertexPoint(rotate(center,
-        rect.x3 + offset.getPixelsX(),
-        rect.y3 + offset.getPixelsY(),
-        rotation));
-    glEnd();
+    Position points[4] =
+    {
+       rotate(center, rect.x0 + offset.getPixelsX(), rect.y0 + offset.getPixelsY(), rotation),
+       rotate(center, rect.x1 + offset.getPixelsX(), rect.y1 + offset.getPixelsY(), rotation),
+       rotate(center, rect.x2 + offset.getPixelsX(), rect.y2 + offset.getPixelsY(), rotation),
+       rotate(center, rect.x3 + offset.getPixelsX(), rect.y3 + offset.getPixelsY(), rotation)
+    };
+    drawTriangleFan(points, 4, rect.rgb);
 }
 
 /*************************************************************************
@@ -162,7 +206,7 @@ void glDrawRect(const Position& center, const Position& offset,
  *   INPUT  topLeft   The top left corner of the text
  *          text      The text to be displayed
  ************************************************************************/
-void drawText(const Position& topLeft, const char* text)
+void ogstream::drawText(const Position& topLeft, const char* text)
 {
     void* pFont = GLUT_BITMAP_HELVETICA_12;  // also try _18
 
@@ -180,6 +224,7 @@ void drawText(const Position& topLeft, const char* text)
  *************************************************************************/
 void ogstream::flush()
 {
+    TRACE_SCOPE("ogstream::flush");
     string sOut;
     string sIn = str();
 
@@ -220,7 +265,7 @@ void ogstream::drawProjectile(const Position& pt)
     };
 
     for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-        glDrawRect(pt, Position(), rects[i], 0.0);
+        drawRect(pt, Position(), rects[i], 0.0);
 }
 
 /************************************************************************
@@ -237,7 +282,7 @@ void ogstream::drawFragment(const Position& center, double rotation)
     };
 
     for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-        glDrawRect(center, Position(), rects[i], rotation);
+        drawRect(center, Position(), rects[i], rotation);
 }
 
 /************************************************************************
@@ -257,7 +302,7 @@ void ogstream::drawCrewDragonCenter(const Position& center, double rotation)
     };
 
     for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-        glDrawRect(center, Position(), rects[i], rotation);
+        drawRect(center, Position(), rects[i], rotation);
 }
 
 /************************************************************************
@@ -278,7 +323,7 @@ void ogstream::drawCrewDragonRight(const Position& center, double rotation, cons
     };
 
     for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-        glDrawRect(center, offset, rects[i], rotation);
+        drawRect(center, offset, rects[i], rotation);
 }
 
 /************************************************************************
@@ -299,7 +344,7 @@ void ogstream::drawCrewDragonLeft(const Position& center, double rotation, const
     };
 
     for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-        glDrawRect(center, offset, rects[i], rotation);
+        drawRect(center, offset, rects[i], rotation);
 }
 
 
@@ -338,27 +383,21 @@ void ogstream::drawSputnik(const Position& center, double rotation)
        {0,0},
        {2,6}, {6,2}, {6,-2}, {2,-6}, {-2,-6}, {-2,-6}, {-6,-2}, {-6,2}, {-2,6}, {2,6}
     };
-    glBegin(GL_TRIANGLE_FAN);
-    glColor(RGB_GREY);
-    for (int i = 0; i < sizeof(pointsSphere) / sizeof(PT); i++)
-        glVertexPoint(rotate(center, pointsSphere[i].x, pointsSphere[i].y, rotation));
-    glEnd();
+    const int numSphere = sizeof(pointsSphere) / sizeof(PT);
+    Position points[numSphere];
+    for (int i = 0; i < numSphere; i++)
+        points[i] = rotate(center, pointsSphere[i].x, pointsSphere[i].y, rotation);
+    drawTriangleFan(points, numSphere, RGB_GREY);
 
     // draw the antenna
-    glBegin(GL_LINES);
-    glColor(RGB_WHITE);
-    glVertexPoint(rotate(center, -6.0, 2.0, rotation));
-    glVertexPoint(rotate(center, -10.0, -15.0, rotation));
-
-    glVertexPoint(rotate(center, 0.0, 1.0, rotation));
-    glVertexPoint(rotate(center, -2.5, -15.0, rotation));
-
-    glVertexPoint(rotate(center, 2.0, -6.0, rotation));
-    glVertexPoint(rotate(center, 2.5, -15.0, rotation));
-
-    glVertexPoint(rotate(center, 6.0, 2.0, rotation));
-    glVertexPoint(rotate(center, 10.0, -15.0, rotation));
-    glEnd();
+    drawLine(rotate(center, -6.0, 2.0, rotation),
+             rotate(center, -10.0, -15.0, rotation), RGB_WHITE);
+    drawLine(rotate(center, 0.0, 1.0, rotation),
+             rotate(center, -2.5, -15.0, rotation), RGB_WHITE);
+    drawLine(rotate(center, 2.0, -6.0, rotation),
+             rotate(center, 2.5, -15.0, rotation), RGB_WHITE);
+    drawLine(rotate(center, 6.0, 2.0, rotation),
+             rotate(center, 10.0, -15.0, rotation), RGB_WHITE);
 }
 
 /************************************************************************
@@ -380,24 +419,23 @@ void ogstream::drawGPSLeft(const Position& center, double rotation, const Positi
     };
 
     for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-        glDrawRect(center, offset, rects[i], rotation);
+        drawRect(center, offset, rects[i], rotation);
 
     // draw the line connecting the solar array to the rest of the ship
-    glBegin(GL_LINE_STRIP);
-    glColor(RGB_WHITE);
-    glVertexPoint(rotate(center,
+    Position ptRight = rotate(center,
         3.0 + offset.getPixelsX(),
         4.0 + offset.getPixelsY(),
-        rotation));
-    glVertexPoint(rotate(center,
+        rotation);
+    Position ptTop = rotate(center,
         0.0 + offset.getPixelsX(),
         8.0 + offset.getPixelsY(),
-        rotation));
-    glVertexPoint(rotate(center,
+        rotation);
+    Position ptLeft = rotate(center,
         -3.0 + offset.getPixelsX(),
         4.0 + offset.getPixelsY(),
-        rotation));
-    glEnd();
+        rotation);
+    drawLine(ptRight, ptTop, RGB_WHITE);
+    drawLine(ptTop, ptLeft, RGB_WHITE);
 }
 
 /************************************************************************
@@ -419,24 +457,23 @@ void ogstream::drawGPSRight(const Position& center, double rotation, const Posit
     };
 
     for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-        glDrawRect(center, offset, rects[i], rotation);
+        drawRect(center, offset, rects[i], rotation);
 
     // draw the line connecting the solar array to the rest of the ship
-    glBegin(GL_LINE_STRIP);
-    glColor(RGB_WHITE);
-    glVertexPoint(rotate(center,
+    Position ptRight = rotate(center,
         3.0 + offset.getPixelsX(),
         -4.0 + offset.getPixelsY(),
-        rotation));
-    glVertexPoint(rotate(center,
+        rotation);
+    Position ptTop = rotate(center,
         0.0 + offset.getPixelsX(),
         -8.0 + offset.getPixelsY(),
-        rotation));
-    glVertexPoint(rotate(center,
+        rotation);
+    Position ptLeft = rotate(center,
         -3.0 + offset.getPixelsX(),
         -4.0 + offset.getPixelsY(),
-        rotation));
-    glEnd();
+        rotation);
+    drawLine(ptRight, ptTop, RGB_WHITE);
+    drawLine(ptTop, ptLeft, RGB_WHITE);
 
 }
 
@@ -457,7 +494,7 @@ void ogstream::drawGPSCenter(const Position& center, double rotation)
     };
 
     for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-        glDrawRect(center, Position(), rects[i], rotation);
+        drawRect(center, Position(), rects[i], rotation);
 }
 
 /************************************************************************
@@ -499,7 +536,7 @@ void ogstream::drawHubbleTelescope(const Position& center, double rotation, cons
     };
 
     for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-        glDrawRect(center, offset, rects[i], rotation);
+        drawRect(center, offset, rects[i], rotation);
 }
 
 /************************************************************************
@@ -521,7 +558,7 @@ void ogstream::drawHubbleComputer(const Position& center, double rotation, const
     };
 
     for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-        glDrawRect(center, offset, rects[i], rotation);
+        drawRect(center, offset, rects[i], rotation);
 }
 
 /************************************************************************
@@ -543,19 +580,16 @@ void ogstream::drawHubbleLeft(const Position& center, double rotation, const Pos
     };
 
     for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-        glDrawRect(center, offset, rects[i], rotation);
+        drawRect(center, offset, rects[i], rotation);
 
-    glBegin(GL_LINE_STRIP);
-    glColor(RGB_WHITE);
-    glVertexPoint(rotate(center,
+    drawLine(rotate(center,
         0.0 + offset.getPixelsX(),
         3.0 + offset.getPixelsY(),
-        rotation));
-    glVertexPoint(rotate(center,
+        rotation),
+        rotate(center,
         0.0 + offset.getPixelsX(),
         -5.0 + offset.getPixelsY(),
-        rotation));
-    glEnd();
+        rotation), RGB_WHITE);
 }
 
 
@@ -578,19 +612,16 @@ void ogstream::drawHubbleRight(const Position& center, double rotation, const Po
     };
 
     for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-        glDrawRect(center, offset, rects[i], rotation);
+        drawRect(center, offset, rects[i], rotation);
 
-    glBegin(GL_LINE_STRIP);
-    glColor(RGB_WHITE);
-    glVertexPoint(rotate(center,
+    drawLine(rotate(center,
         0.0 + offset.getPixelsX(),
         -3.0 + offset.getPixelsY(),
-        rotation));
-    glVertexPoint(rotate(center,
+        rotation),
+        rotate(center,
         0.0 + offset.getPixelsX(),
         5.0 + offset.getPixelsY(),
-        rotation));
-    glEnd();
+        rotation), RGB_WHITE);
 }
 
 /************************************************************************
@@ -640,7 +671,7 @@ void ogstream::drawStarlinkBody(const Position& center, double rotation, const P
     };
 
     for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-        glDrawRect(center, offset, rects[i], rotation);
+        drawRect(center, offset, rects[i], rotation);
 }
 
 /************************************************************************
@@ -660,7 +691,7 @@ void ogstream::drawStarlinkArray(const Position& center, double rotation, const
     };
 
     for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-        glDrawRect(center, offset, rects[i], rotation);
+        drawRect(center, offset, rects[i], rotation);
 }
 
 /************************************************************************
@@ -701,25 +732,25 @@ void ogstream::drawShip(const Position& center, double rotation, bool thrust)
        {1,18}, {3,16}, {4,14}, {4,11}, {6,3}, {8,-2}, {13,-7}, {14,-12}, {12,-12}, {3,-9}, {-3,-9}
     };
 
-    glBegin(GL_TRIANGLE_FAN);
-    glColor(RGB_LIGHT_GREY);
-    for (int i = 0; i < sizeof(pointsShipWhite) / sizeof(PT); i++)
-        glVertexPoint(rotate(center, pointsShipWhite[i].x, pointsShipWhite[i].y, rotation));
-    glEnd();
+    const int numShipWhite = sizeof(pointsShipWhite) / sizeof(PT);
+    Position points[numShipWhite];
+    for (int i = 0; i < numShipWhite; i++)
+        points[i] = rotate(center, pointsShipWhite[i].x, pointsShipWhite[i].y, rotation);
+    drawTriangleFan(points, numShipWhite, RGB_LIGHT_GREY);
 
     // draw the flame if necessary
     if (thrust)
     {
-        glBegin(GL_TRIANGLES);
-        glColor(RGB_RED);
-        glVertexPoint(rotate(center, -3.0, -9.0, rotation));
-        glVertexPoint(rotate(center, random(-5.0, 5.0), random(-25.0, -13.0), rotation));
-        glVertexPoint(rotate(center, 3.0, -9.0, rotation));
-        glVertexPoint(rotate(center, -3.0, -9.0, rotation));
-        glVertexPoint(rotate(center, random(-5.0, 5.0), random(-25.0, -13.0), rotation));
-        glVertexPoint(rotate(center, 3.0, -9.0, rotation));
-        glResetColor();
-        glEnd();
+        for (int iFlame = 0; iFlame < 2; iFlame++)
+        {
+            Position pointsFlame[3] =
+            {
+               rotate(center, -3.0, -9.0, rotation),
+               rotate(center, random(-5.0, 5.0), random(-25.0, -13.0), rotation),
+               rotate(center, 3.0, -9.0, rotation)
+            };
+            drawTriangleFan(pointsFlame, 3, RGB_RED);
+        }
     }
 
     // draw the dark part of the ship                                               
@@ -730,14 +761,14 @@ void ogstream::drawShip(const Position& center, double rotation, bool thrust)
        {{ 0,-13}, {-3,11},  {-1,15}, {1,15}},  // left canopy
        {{ 0,-13}, { 3,11},  { 1,15}, {-1,15}}  // right canopy
     };
-    glBegin(GL_QUADS);
-    glColor(RGB_DEEP_BLUE);
     for (int iRectangle = 0; iRectangle < 4; iRectangle++)
+    {
+        Position pointsQuad[4];
         for (int iVertex = 0; iVertex < 4; iVertex++)
-            glVertexPoint(rotate(center, pointsShipBlack[iRectangle][iVertex].x,
-                pointsShipBlack[iRectangle][iVertex].y, rotation));
-    glResetColor();
-    glEnd();
+            pointsQuad[iVertex] = rotate(center, pointsShipBlack[iRectangle][iVertex].x,
+                pointsShipBlack[iRectangle][iVertex].y, rotation);
+        drawTriangleFan(pointsQuad, 4, RGB_DEEP_BLUE);
+    }
 }
 
 /************************************************************************
@@ -843,7 +874,7 @@ void ogstream::drawEarth(const Position& center, double rotation)
                 Position pos;
                 pos.setPixelsX(-25.0 * SCALE);
                 pos.setPixelsY(-25.0 * SCALE);
-                glDrawRect(center, pos, rect, rotation);
+                drawRect(center, pos, rect, rotation);
             }
 
     return;
@@ -857,52 +888,90 @@ void ogstream::drawEarth(const Position& center, double rotation)
  *************************************************************************/
 void ogstream::drawStar(const Position& point, unsigned char phase)
 {
-    // Get ready...
-    glBegin(GL_POINTS);
+    // the twinkle is a center dot with a ring of fainter dots around it
+    Position ptRing[4] = { point, point, point, point };
+    ptRing[0].addPixelsX( 1.0);
+    ptRing[1].addPixelsX(-1.0);
+    ptRing[2].addPixelsY( 1.0);
+    ptRing[3].addPixelsY(-1.0);
 
     // most of the time, it is just a pale yellow dot
     if (phase < 128)
-    {
-        glColor3f((GLfloat)0.5 /* red % */, (GLfloat)0.5 /* green % */, (GLfloat)0.0 /* blue % */);
-        glVertex2f((GLfloat)(point.getPixelsX() + 0.0), (GLfloat)(point.getPixelsY() + 0.0));
-    }
+        drawDot(point, RGB_PALE_GOLD);
     // transitions to a bright yellow dot
     else if (phase < 160 || phase > 224)
-    {
-        glColor3f((GLfloat)1.0 /* red % */, (GLfloat)1.0 /* green % */, (GLfloat)0.0 /* blue % */);
-        glVertex2f((GLfloat)(point.getPixelsX() + 0.0), (GLfloat)(point.getPixelsY() + 0.0));
-    }
+        drawDot(point, RGB_GOLD);
     // transitions to a bright yellow dot with pale yellow corners
     else if (phase < 176 || phase > 208)
     {
-        glColor3f((GLfloat)1.0 /* red % */, (GLfloat)1.0 /* green % */, (GLfloat)0.0 /* blue % */);
-        glVertex2f((GLfloat)(point.getPixelsX() + 0.0), (GLfloat)(point.getPixelsY() + 0.0));
-        glColor3f((GLfloat)0.5 /* red % */, (GLfloat)0.5 /* green % */, (GLfloat)0.0 /* blue % */);
-        glVertex2f((GLfloat)(point.getPixelsX() + 1.0), (GLfloat)(point.getPixelsY() + 0.0));
-        glVertex2f((GLfloat)(point.getPixelsX() - 1.0), (GLfloat)(point.getPixelsY() + 0.0));
-        glVertex2f((GLfloat)(point.getPixelsX() + 0.0), (GLfloat)(point.getPixelsY() + 1.0));
-        glVertex2f((GLfloat)(point.getPixelsX() + 0.0), (GLfloat)(point.getPixelsY() - 1.0));
+        drawDot(point, RGB_GOLD);
+        for (int i = 0; i < 4; i++)
+            drawDot(ptRing[i], RGB_PALE_GOLD);
     }
     // the biggest yet
     else
     {
-        glColor3f((GLfloat)1.0 /* red % */, (GLfloat)1.0 /* green % */, (GLfloat)0.0 /* blue % */);
-        glVertex2f((GLfloat)(point.getPixelsX() + 0.0), (GLfloat)(point.getPixelsY() + 0.0));
-        glColor3f((GLfloat)0.7 /* red % */, (GLfloat)0.7 /* green % */, (GLfloat)0.0 /* blue % */);
-        glVertex2f((GLfloat)(point.getPixelsX() + 1.0), (GLfloat)(point.getPixelsY() + 0.0));
-        glVertex2f((GLfloat)(point.getPixelsX() - 1.0), (GLfloat)(point.getPixelsY() + 0.0));
-        glVertex2f((GLfloat)(point.getPixelsX() + 0.0), (GLfloat)(point.getPixelsY() + 1.0));
-        glVertex2f((GLfloat)(point.getPixelsX() + 0.0), (GLfloat)(point.getPixelsY() - 1.0));
-        glColor3f((GLfloat)0.5 /* red % */, (GLfloat)0.5 /* green % */, (GLfloat)0.0 /* blue % */);
-        glVertex2f((GLfloat)(point.getPixelsX() + 2.0), (GLfloat)(point.getPixelsY() + 0.0));
-        glVertex2f((GLfloat)(point.getPixelsX() - 2.0), (GLfloat)(point.getPixelsY() + 0.0));
-        glVertex2f((GLfloat)(point.getPixelsX() + 0.0), (GLfloat)(point.getPixelsY() + 2.0));
-        glVertex2f((GLfloat)(point.getPixelsX() + 0.0), (GLfloat)(point.getPixelsY() - 2.0));
+        drawDot(point, RGB_GOLD);
+        for (int i = 0; i < 4; i++)
+            drawDot(ptRing[i], RGB_DULL_GOLD);
+
+        Position ptOuter[4] = { point, point, point, point };
+        ptOuter[0].addPixelsX( 2.0);
+        ptOuter[1].addPixelsX(-2.0);
+        ptOuter[2].addPixelsY( 2.0);
+        ptOuter[3].addPixelsY(-2.0);
+        for (int i = 0; i < 4; i++)
+            drawDot(ptOuter[i], RGB_PALE_GOLD);
     }
+}
 
-    // Complete drawing
-    glColor3f((GLfloat)1.0 /* red % */, (GLfloat)1.0 /* green % */, (GLfloat)1.0 /* blue % */);
-    glEnd();
+/************************************************************************
+ * DRAW POINT
+ * Draw anything in orbit as a single dot. This is what we draw when
+ * zoomed so far out that a sprite would just be a smudge
+ *   INPUT  center    The location of the object
+ *************************************************************************/
+void ogstream::drawPoint(const Position& center)
+{
+    drawDot(center, RGB_WHITE);
+}
+
+/************************************************************************
+ * DRAW HEAT
+ * Draw one cell of a density heatmap. Cold cells are deep blue, warmer
+ * ones go through red to a hot yellow
+ *   INPUT  center     The middle of the cell
+ *          sizePixels How wide the cell is
+ *          heat       How crowded the cell is, 0.0 to 1.0
+ *************************************************************************/
+void ogstream::drawHeat(const Position& center, double sizePixels, double heat)
+{
+    heat = max(0.0, min(1.0, heat));
+    int rgb[3];
+    if (heat < 0.5)
+    {
+        // deep blue to red
+        rgb[0] = (int)(64.0 + 382.0 * heat);
+        rgb[1] = 0;
+        rgb[2] = (int)(156.0 - 312.0 * heat);
+    }
+    else
+    {
+        // red to yellow
+        rgb[0] = 255;
+        rgb[1] = (int)(510.0 * (heat - 0.5));
+        rgb[2] = 0;
+    }
+
+    double half = sizePixels / 2.0;
+    Position points[4] =
+    {
+       rotate(center, -half, -half, 0.0),
+       rotate(center,  half, -half, 0.0),
+       rotate(center,  half,  half, 0.0),
+       rotate(center, -half,  half, 0.0)
+    };
+    drawTriangleFan(points, 4, rgb);
 }
 
 /******************************************************************
@@ -933,6 +1002,8 @@ void ogstreamDummy::drawStarlinkArray(const Position& center, double rotation, c
 void ogstreamDummy::drawShip(const Position& center, double rotation, bool thrust) { assert(false); }
 void ogstreamDummy::drawEarth(const Position& center, double rotation) { assert(false); }
 void ogstreamDummy::drawStar(const Position& point, unsigned char phase) { assert(false); }
+void ogstreamDummy::drawPoint(const Position& center) { assert(false); }
+void ogstreamDummy::drawHeat(const Position& center, double sizePixels, double heat) { assert(false); }
 
 
 /******************************************************************
@@ -963,6 +1034,48 @@ void ogstreamDummy::drawStar(const Position& point, unsigned char phase) { asser
  // void ogstreamFake::drawShip(const Position& center, double rotation, bool thrust) { *this << "Ship" << center << rotation << "\n"; }
  // void ogstreamFake::drawEarth(const Position& center, double rotation) { *this << "Earth" << center << rotation << "\n"; }
  // void ogstreamFake::drawStar(const Position& center, unsigned char phase) { *this << "Star" << center << phase << "\n"; }
+ // void ogstreamFake::drawPoint(const Position& center) { *this << "Point" << center << "\n"; }
+ // void ogstreamFake::drawHeat(const Position& center, double sizePixels, double heat) { *this << "Heat" << center << heat << "\n"; }
+
+ /******************************************************************
+  * GENERATOR
+  * Everything random comes from here. Unlike rand(), the standard says
+  * exactly what mt19937 produces and lets us save where it is
+  ****************************************************************/
+static std::mt19937 generator;
+static std::mutex generatorLock;
+
+static unsigned int getRandom()
+{
+    std::lock_guard<std::mutex> lock(generatorLock);
+    return (unsigned int)generator();
+}
+
+void seedRandom(unsigned int seed)
+{
+    std::lock_guard<std::mutex> lock(generatorLock);
+    generator.seed(seed);
+}
+
+string getRandomState()
+{
+    std::lock_guard<std::mutex> lock(generatorLock);
+    std::ostringstream sout;
+    sout << generator;
+    return sout.str();
+}
+
+bool setRandomState(const string& state)
+{
+    std::mt19937 restored;
+    std::istringstream sin(state);
+    sin >> restored;
+    if (sin.fail())
+        return false;
+    std::lock_guard<std::mutex> lock(generatorLock);
+    generator = restored;
+    return true;
+}
 
  /******************************************************************
   * RANDOM
@@ -974,7 +1087,7 @@ void ogstreamDummy::drawStar(const Position& point, unsigned char phase) { asser
 int random(int min, int max)
 {
     assert(min < max);
-    int num = (rand() % (max - min)) + min;
+    int num = (int)(getRandom() % (unsigned int)(max - min)) + min;
     assert(min <= num && num <= max);
 
     return num;
@@ -990,7 +1103,7 @@ int random(int min, int max)
 double random(double min, double max)
 {
     assert(min <= max);
-    double num = min + ((double)rand() / (double)RAND_MAX * (max - min));
+    double num = min + ((double)getRandom() / (double)std::mt19937::max() * (max - min));
 
     assert(min <= num && num <= max);
 
@@ -25,6 +25,8 @@ using std::max;
 
 #define GL_SILENCE_DEPRECATION
 
+struct ColorRect;
+
 /*************************************************************************
  * GRAPHICS STREAM
  * A graphics stream that behaves much like COUT except on a drawn screen
@@ -45,6 +47,10 @@ public:
         return *this;
     }
 
+    // The point in the world that lands in the middle of the screen.
+    // Shapes are drawn relative to it; text is not
+    virtual void setView(const Position& ptCenter) { ptView = ptCenter; }
+
     // This is specific to the orbit simulator
     virtual void drawFragment(const Position& center, double rotation);
     virtual void drawProjectile(const Position& pt);
@@ -77,8 +83,31 @@ public:
 
     virtual void drawStar(const Position& point, unsigned char phase);
 
+    // Level of detail: a lone dot for when sprites are too small to read,
+    // and a square heatmap cell where heat runs from 0.0 (cold) to 1.0
+    virtual void drawPoint(const Position& center);
+    virtual void drawHeat(const Position& center, double sizePixels, double heat);
+
 protected:
+    // Every shape above is built out of these few primitives. The default
+    // versions talk to OpenGL; another backend only needs to replace these.
+    virtual void drawTriangleFan(const Position* points, int num, const int* rgb);
+    virtual void drawLine(const Position& begin, const Position& end, const int* rgb);
+    virtual void drawDot(const Position& point, const int* rgb);
+    virtual void drawText(const Position& topLeft, const char* text);
+
+    void drawRect(const Position& center, const Position& offset,
+                  const ColorRect& rect, double rotation);
+
+    // Move a point in the world to where it goes on the screen
+    Position toView(const Position& point) const
+    {
+        return Position(point.getMetersX() - ptView.getMetersX(),
+                        point.getMetersY() - ptView.getMetersY());
+    }
+
     Position pt;
+    Position ptView;
 };
 
 /*************************************************************************
@@ -127,6 +156,9 @@ public:
     void drawEarth(const Position& center, double rotation);
 
     void drawStar(const Position& point, unsigned char phase);
+
+    void drawPoint(const Position& center);
+    void drawHeat(const Position& center, double sizePixels, double heat);
 };
 
 /*************************************************************************
@@ -175,6 +207,9 @@ public:
     void drawEarth(const Position& center, double rotation);
 
     void drawStar(const Position& point, unsigned char phase);
+
+    void drawPoint(const Position& center);
+    void drawHeat(const Position& center, double sizePixels, double heat);
 };
 
 /******************************************************************
@@ -187,3 +222,12 @@ public:
 int    random(int    min, int    max);
 double random(double min, double max);
 
+/******************************************************************
+ * RANDOM STATE
+ * Where the generator behind random() is in its sequence, as text, so
+ * a run can be saved and picked up exactly where it left off
+ ****************************************************************/
+void   seedRandom(unsigned int seed);
+string getRandomState();
+bool   setRandomState(const string& state);
+
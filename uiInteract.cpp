@@ -13,8 +13,9 @@
 #include <string>     // need you ask?
 #include <sstream>    // convert an integer into text
 #include <cassert>    // I feel the need... the need for asserts
-#include <time.h>     // for clock
-#include <cstdlib>    // for rand()
+#include <time.h>     // for time() to seed random()
+#include <cstdlib>    // for exit()
+#include <thread>     // for sleep_until()
 
 
 #ifdef __APPLE__
@@ -39,40 +40,19 @@
 #include <math.h>
 #endif // _WIN32
 
+#ifdef ORBIT_GLFW
+#include <GLFW/glfw3.h>     // window, keys, and vsync
+#include <iostream>         // for CERR
+#endif // ORBIT_GLFW
+
 #include "uiInteract.h"
+#include "uiDraw.h"     // for seedRandom()
 #include "position.h"
+#include "profiler.h"
 
 using namespace std;
 
 
-/*********************************************************************
- * SLEEP
- * Pause for a while.  We want to put the program to sleep until it
- * is time to draw again.  Note that this requires us to tell the OS
- * that we are idle.  the nanosleep function performs this task for us
- *   INPUT: msSleep: sleep time in milliseconds
- *********************************************************************/
-void sleep(unsigned long msSleep)
-{
-    // Windows handles sleep one way
-#ifdef _WIN32
-    ::Sleep(msSleep + 35);
-
-    // Unix-based operating systems (OS-X, Linux) do it another
-#else // LINUX, XCODE
-    timespec req = {};
-    time_t sec = (int)(msSleep / 1000);
-    msSleep -= (sec * 1000);
-
-    req.tv_sec = sec;
-    req.tv_nsec = msSleep * 1000000L;
-
-    while (nanosleep(&req, &req) == -1)
-        ;
-#endif // LINUX, XCODE
-    return;
-}
-
 /************************************************************************
  * DRAW CALLBACK
  * This is the main callback from OpenGL. It gets called constantly by
@@ -93,20 +73,29 @@ void drawCallback()
 
     //calls the client's display function
     assert(ui.callBack != NULL);
+    auto start = std::chrono::steady_clock::now();
     ui.callBack(&ui, ui.p);
+    auto drawn = std::chrono::steady_clock::now();
 
-    //loop until the timer runs out
+    //wait until the timer runs out
     if (!ui.isTimeToDraw())
-        sleep((unsigned long)((ui.getNextTick() - clock()) / 1000));
+        std::this_thread::sleep_until(ui.getNextTick());
+    auto woken = std::chrono::steady_clock::now();
 
     // from this point, set the next draw time
     ui.setNextDrawTime();
 
     // bring forth the background buffer
     glutSwapBuffers();
+    auto swapped = std::chrono::steady_clock::now();
 
-    // clear the space at the end
-    ui.keyEvent();
+    // how long each part took
+    if (ui.getProfiler())
+    {
+        ui.getProfiler()->add(Profiler::DRAW,  std::chrono::duration<double>(drawn - start).count());
+        ui.getProfiler()->add(Profiler::SLEEP, std::chrono::duration<double>(woken - drawn).count());
+        ui.getProfiler()->add(Profiler::SWAP,  std::chrono::duration<double>(swapped - woken).count());
+    }
 }
 
 /************************************************************************
@@ -121,7 +110,7 @@ void keyDownCallback(int key, int x, int y)
     // Even though this is a local variable, all the members are static
     // so we are actually getting the same version as in the constructor.
     Interface ui;
-    ui.keyEvent(key, true /*fDown*/);
+    ui.post(InputEvent::KEY_DOWN, key);
 }
 
 /************************************************************************
@@ -135,7 +124,7 @@ void keyUpCallback(int key, int x, int y)
     // Even though this is a local variable, all the members are static
     // so we are actually getting the same version as in the constructor.
     Interface ui;
-    ui.keyEvent(key, false /*fDown*/);
+    ui.post(InputEvent::KEY_UP, key);
 }
 
 /***************************************************************
@@ -148,7 +137,7 @@ void keyboardCallback(unsigned char key, int x, int y)
     // Even though this is a local variable, all the members are static
     // so we are actually getting the same version as in the constructor.
     Interface ui;
-    ui.keyEvent(key, true /*fDown*/);
+    ui.post(InputEvent::KEYBOARD, key);
 }
 
 /************************************************************************
@@ -160,52 +149,267 @@ void closeCallback()
     exit(0);
 }
 
+/***************************************************************
+ * ARROWS
+ * The keys that stay down between frames, in the order of their bits
+ * in releases and arrowsHeld
+ ****************************************************************/
+static const int ARROWS[] = { GLUT_KEY_DOWN, GLUT_KEY_UP, GLUT_KEY_RIGHT, GLUT_KEY_LEFT };
+
+static int getArrowBit(int key)
+{
+    for (int i = 0; i < 4; i++)
+        if (key == ARROWS[i])
+            return 1 << i;
+    return 0;
+}
+
+/***************************************************************
+ * INTERFACE : POST
+ * Queue a key for whoever polls them. A second press of an arrow that
+ * is already down is left out. Arrow releases may use the slots kept
+ * back from everything else. If the consumer has fallen so far behind
+ * that even those are full, the key is dropped and counted so the
+ * arrows can be caught up later
+ *   INPUT   type    down, up, or an ASCII key
+ *           key     which key
+ ****************************************************************/
+void Interface::post(InputEvent::Type type, int key)
+{
+    int bit = type == InputEvent::KEYBOARD ? 0 : getArrowBit(key);
+    int held = arrowsHeld.load(std::memory_order_relaxed);
+    if (type == InputEvent::KEY_DOWN && (held & bit))
+        return;
+    if (bit)
+        arrowsHeld.store(type == InputEvent::KEY_DOWN ? held | bit : held & ~bit,
+                         std::memory_order_relaxed);
+
+    InputEvent event;
+    event.time = std::chrono::steady_clock::now();
+    event.type = type;
+    event.key = key;
+    bool isRelease = type == InputEvent::KEY_UP && bit;
+    if (!events.push(event, isRelease ? 0 : RESERVED_FOR_RELEASES))
+        numDropped.fetch_add(1, std::memory_order_release);
+}
+
+/***************************************************************
+ * INTERFACE : POLL EVENT
+ * Take the next queued key if it happened by the given time
+ *   INPUT   until   the end of the frame about to run
+ *   OUTPUT  event   the key, when there is one
+ ****************************************************************/
+bool Interface::pollEvent(std::chrono::steady_clock::time_point until, InputEvent& event)
+{
+    const InputEvent* pEvent = events.peek();
+    if (!pEvent || pEvent->time > until)
+        return false;
+    event = *pEvent;
+    events.pop();
+    return true;
+}
+
+/***************************************************************
+ * INTERFACE : POLL EVENTS
+ * Apply every queued key that happened by the given time. Later keys
+ * wait in the queue for the frame they belong to. If any key was
+ * dropped since last time, the arrows are caught up afterward
+ *   INPUT   until   the end of the frame about to run
+ ****************************************************************/
+int Interface::pollEvents(std::chrono::steady_clock::time_point until)
+{
+    int count = 0;
+    InputEvent event;
+    while (pollEvent(until, event))
+    {
+        apply(event);
+        count++;
+    }
+
+    int dropped = numDropped.load(std::memory_order_acquire);
+    if (dropped != numDroppedSeen)
+    {
+        numDroppedSeen = dropped;
+        resync();
+    }
+    return count;
+}
+
+/***************************************************************
+ * INTERFACE : RESYNC
+ * Press or let go of each arrow the queue has it wrong about, going by
+ * what the callbacks last saw. Only needed when keys were dropped
+ ****************************************************************/
+void Interface::resync()
+{
+    int held = arrowsHeld.load(std::memory_order_relaxed);
+    int* presses[] = { &isDownPress, &isUpPress, &isRightPress, &isLeftPress };
+    for (int i = 0; i < 4; i++)
+    {
+        bool isHeld = (held & (1 << i)) != 0;
+        bool isPressed = *presses[i] != 0 && !(releases & (1 << i));
+        if (isHeld != isPressed)
+            keyEvent(ARROWS[i], isHeld);
+    }
+}
+
+/***************************************************************
+ * INTERFACE : APPLY
+ * Send one key where it goes
+ *   INPUT   event   the key
+ ****************************************************************/
+void Interface::apply(const InputEvent& event)
+{
+    switch (event.type)
+    {
+    case InputEvent::KEY_DOWN:
+        keyEvent(event.key, true /*fDown*/);
+        break;
+    case InputEvent::KEY_UP:
+        keyEvent(event.key, false /*fDown*/);
+        break;
+    case InputEvent::KEYBOARD:
+        keyboardEvent((unsigned char)event.key);
+        break;
+    }
+}
+
 /***************************************************************
  * INTERFACE : KEY EVENT
- * Either set the up or down event for a given key
+ * Either set the up or down event for a given key. An arrow let go
+ * before any frame saw it pressed stays down for one frame, so a quick
+ * tap still counts
  *   INPUT   key     which key is pressed
  *           fDown   down or brown
  ****************************************************************/
 void Interface::keyEvent(int key, bool fDown)
 {
+    int* pPress = NULL;
+    int bit = 0;
     switch (key)
     {
     case GLUT_KEY_DOWN:
-        isDownPress = fDown;
+        pPress = &isDownPress;
+        bit = 0x1;
         break;
     case GLUT_KEY_UP:
-        isUpPress = fDown;
+        pPress = &isUpPress;
+        bit = 0x2;
         break;
     case GLUT_KEY_RIGHT:
-        isRightPress = fDown;
+        pPress = &isRightPress;
+        bit = 0x4;
         break;
     case GLUT_KEY_LEFT:
-        isLeftPress = fDown;
+        pPress = &isLeftPress;
+        bit = 0x8;
         break;
     case GLUT_KEY_HOME:
     case ' ':
         isSpacePress = fDown;
-        break;
+        return;
+    default:
+        return;
+    }
+
+    if (fDown)
+    {
+        *pPress = 1;
+        releases &= ~bit;
     }
+    else if (*pPress == 1)
+        releases |= bit;
+    else
+        *pPress = 0;
 }
 
 /***************************************************************
  * INTERFACE : KEY EVENT
- * Either set the up or down event for a given key
- *   INPUT   key     which key is pressed
- *           fDown   down or brown
+ * The frame of input has been used up. Held keys have now been held
+ * one frame longer and one-time presses are forgotten
  ****************************************************************/
 void Interface::keyEvent()
 {
-    if (isDownPress)
-        isDownPress++;
-    if (isUpPress)
-        isUpPress++;
-    if (isLeftPress)
-        isLeftPress++;
-    if (isRightPress)
-        isRightPress++;
+    // count how long each key has been held, and let go of the ones
+    // released since the frame saw them
+    int* presses[] = { &isDownPress, &isUpPress, &isRightPress, &isLeftPress };
+    for (int i = 0; i < 4; i++)
+        if (releases & (1 << i))
+            *presses[i] = 0;
+        else if (*presses[i])
+            (*presses[i])++;
+    releases = 0;
     isSpacePress = false;
+    zoomSteps = 0;
+    panX = 0;
+    panY = 0;
+    isHomePress = false;
+    warpSteps = 0;
+}
+
+/***************************************************************
+ * INTERFACE : KEYBOARD EVENT
+ * A regular ASCII key was pressed. These come without a matching
+ * release, so they count as one press each. We cannot send them through
+ * keyEvent() because GLUT_KEY_LEFT and friends collide with letters
+ *   INPUT   key     which key is pressed
+ ****************************************************************/
+void Interface::keyboardEvent(unsigned char key)
+{
+    switch (key)
+    {
+    case ' ':
+        isSpacePress = true;
+        break;
+    case '+':
+    case '=':
+        zoomSteps++;
+        break;
+    case '-':
+    case '_':
+        zoomSteps--;
+        break;
+    case 'w':
+    case 'W':
+        panY++;
+        break;
+    case 's':
+    case 'S':
+        panY--;
+        break;
+    case 'a':
+    case 'A':
+        panX--;
+        break;
+    case 'd':
+    case 'D':
+        panX++;
+        break;
+    case 'c':
+    case 'C':
+        isHomePress = true;
+        break;
+    case '.':
+    case '>':
+        warpSteps++;
+        break;
+    case ',':
+    case '<':
+        warpSteps--;
+        break;
+    case 'p':
+    case 'P':
+        showProfile = !showProfile;
+        break;
+    case 't':
+    case 'T':
+        isTracePress = true;
+        break;
+    case 'f':
+    case 'F':
+        isFastPress = true;
+        break;
+    }
 }
 
 /************************************************************************
@@ -215,17 +419,24 @@ void Interface::keyEvent()
  *************************************************************************/
 bool Interface::isTimeToDraw()
 {
-    return ((unsigned int)clock() >= nextTick);
+    return std::chrono::steady_clock::now() >= nextTick;
 }
 
 /************************************************************************
  * INTERFACE : SET NEXT DRAW TIME
- * What time should we draw the buffer again?  This is a function of
- * the current time and the frames per second.
+ * What time should we draw the buffer again?  Draws are spaced one
+ * period apart on the wall clock so the frame rate does not drift. If
+ * we have fallen more than a frame behind, start over from now rather
+ * than racing to catch up.
  *************************************************************************/
 void Interface::setNextDrawTime()
 {
-    nextTick = (long)clock() + static_cast<long> (timePeriod * CLOCKS_PER_SEC);
+    auto now = std::chrono::steady_clock::now();
+    auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(timePeriod));
+    nextTick += period;
+    if (nextTick + period < now)
+        nextTick = now + period;
 }
 
 /************************************************************************
@@ -245,18 +456,114 @@ void Interface::setFramesPerSecond(double value)
  * All the static member variables need to be initialized
  * Somewhere globally.  This is a good spot
  **************************************************/
-int          Interface::isDownPress = 0;
-int          Interface::isUpPress = 0;
-int          Interface::isLeftPress = 0;
-int          Interface::isRightPress = 0;
-bool         Interface::isSpacePress = false;
+SpscQueue<InputEvent, 256> Interface::events;
+int               Interface::isDownPress = 0;
+int               Interface::isUpPress = 0;
+int               Interface::isLeftPress = 0;
+int               Interface::isRightPress = 0;
+int               Interface::releases = 0;
+bool              Interface::isSpacePress = false;
+int               Interface::zoomSteps = 0;
+int               Interface::panX = 0;
+int               Interface::panY = 0;
+bool              Interface::isHomePress = false;
+int               Interface::warpSteps = 0;
+std::atomic<int>  Interface::arrowsHeld(0);
+std::atomic<int>  Interface::numDropped(0);
+int               Interface::numDroppedSeen = 0;
+std::atomic<bool> Interface::showProfile(false);
+std::atomic<bool> Interface::isTracePress(false);
+std::atomic<bool> Interface::isFastPress(false);
+Profiler*    Interface::pProfiler = NULL;
 bool         Interface::initialized = false;
 double       Interface::timePeriod = 1.0 / 30; // default to 30 frames/second
-unsigned long Interface::nextTick = 0;        // redraw now please
+std::chrono::steady_clock::time_point Interface::nextTick;  // redraw now please
 void* Interface::p = NULL;
 void (*Interface::callBack)(const Interface*, void*) = NULL;
 
 
+#ifdef ORBIT_GLFW
+/************************************************************************
+ * GLFW
+ * Define ORBIT_GLFW (and GLFW_DLL on Windows) to have GLFW run the window
+ * instead of GLUT. GLUT spins on its idle callback between frames; GLFW
+ * sleeps in an event wait until the frame is due and then blocks in the
+ * swap until the display refreshes, so an idle simulator costs next to
+ * nothing. GLUT is still initialized because it draws the text
+ ************************************************************************/
+static GLFWwindow* pWindow = NULL;
+
+/************************************************************************
+ * GLFW KEY CALLBACK
+ * The arrows and home go down and up, just as GLUT's special keys do
+ *   INPUT   key:     the key according to the GLFW_KEY_ prefix
+ *           action:  pressed, released, or repeated
+ *************************************************************************/
+void glfwKeyCallback(GLFWwindow* pWindow, int key, int scancode, int action, int mods)
+{
+    // just like glutIgnoreKeyRepeat()
+    if (action == GLFW_REPEAT)
+        return;
+
+    int glutKey;
+    switch (key)
+    {
+    case GLFW_KEY_DOWN:
+        glutKey = GLUT_KEY_DOWN;
+        break;
+    case GLFW_KEY_UP:
+        glutKey = GLUT_KEY_UP;
+        break;
+    case GLFW_KEY_RIGHT:
+        glutKey = GLUT_KEY_RIGHT;
+        break;
+    case GLFW_KEY_LEFT:
+        glutKey = GLUT_KEY_LEFT;
+        break;
+    case GLFW_KEY_HOME:
+        glutKey = GLUT_KEY_HOME;
+        break;
+    default:
+        return;
+    }
+
+    Interface ui;
+    ui.post(action == GLFW_PRESS ? InputEvent::KEY_DOWN : InputEvent::KEY_UP, glutKey);
+}
+
+/************************************************************************
+ * GLFW CHAR CALLBACK
+ * Typed characters, as GLUT's keyboard callback gets them
+ *   INPUT   codepoint:  the character, of which we only know ASCII
+ *************************************************************************/
+void glfwCharCallback(GLFWwindow* pWindow, unsigned int codepoint)
+{
+    if (codepoint >= 128)
+        return;
+    Interface ui;
+    ui.post(InputEvent::KEYBOARD, (int)codepoint);
+}
+
+/************************************************************************
+ * GLFW WAIT UNTIL
+ * Sleep until the given time, waking up to queue any keys on the way.
+ * GLFW before 3.2 cannot wait with a timeout, so it sleeps and then
+ * picks up the keys all at once
+ *   INPUT   until:   when to wake up
+ *************************************************************************/
+static void glfwWaitUntil(std::chrono::steady_clock::time_point until)
+{
+#if GLFW_VERSION_MAJOR > 3 || GLFW_VERSION_MINOR >= 2
+    for (auto now = std::chrono::steady_clock::now(); now < until;
+         now = std::chrono::steady_clock::now())
+        glfwWaitEventsTimeout(std::chrono::duration<double>(until - now).count());
+#else
+    std::this_thread::sleep_until(until);
+#endif
+    glfwPollEvents();
+}
+#endif // ORBIT_GLFW
+
 /************************************************************************
  * INTERFACE : DESTRUCTOR
  * Nothing here!
@@ -281,8 +588,31 @@ void Interface::initialize(int argc, char** argv, const char* title,
         return;
 
     // set up the random number generator
-    srand((unsigned int)time(NULL));
+    seedRandom((unsigned int)time(NULL));
+
+#ifdef ORBIT_GLFW
+    // GLUT only draws the text
+    glutInit(&argc, argv);
 
+    // create the window
+    if (!glfwInit())
+    {
+        std::cerr << "Unable to start GLFW" << std::endl;
+        exit(1);
+    }
+    pWindow = glfwCreateWindow((int)ptUpperRight.getPixelsX(),
+        (int)ptUpperRight.getPixelsY(), title, NULL, NULL);
+    if (!pWindow)
+    {
+        std::cerr << "Unable to open a window" << std::endl;
+        glfwTerminate();
+        exit(1);
+    }
+    glfwMakeContextCurrent(pWindow);
+    glfwSwapInterval(1);                            // swap on the display's refresh
+    glfwSetKeyCallback(pWindow, glfwKeyCallback);
+    glfwSetCharCallback(pWindow, glfwCharCallback);
+#else // !ORBIT_GLFW
     // create the window
     glutInit(&argc, argv);
     glutInitWindowSize((int)ptUpperRight.getPixelsX(),
@@ -292,12 +622,14 @@ void Interface::initialize(int argc, char** argv, const char* title,
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB);    // double buffering
     glutCreateWindow(title);                        // text on titlebar
     glutIgnoreKeyRepeat(true);
+#endif // !ORBIT_GLFW
 
     // set up the drawing style: B/W and 2D
     glClearColor(0.0, 0.0, 0.0, 0);            // White is the background color
     gluOrtho2D(-(int)ptUpperRight.getPixelsX() / 2, (int)ptUpperRight.getPixelsX() / 2,    // range of x values: (0, width)
         -(int)ptUpperRight.getPixelsY() / 2, (int)ptUpperRight.getPixelsY() / 2);   // range of y values: (0, height)
 
+#ifndef ORBIT_GLFW
     // register the callbacks so OpenGL knows how to call us
     glutDisplayFunc(drawCallback);
     glutIdleFunc(drawCallback);
@@ -307,6 +639,7 @@ void Interface::initialize(int argc, char** argv, const char* title,
 #ifdef __APPLE__
     glutWMCloseFunc(closeCallback);
 #endif
+#endif // !ORBIT_GLFW
     initialized = true;
 
     // done
@@ -330,7 +663,43 @@ void Interface::run(void (*callBack)(const Interface*, void*), void* p)
     this->p = p;
     this->callBack = callBack;
 
+#ifdef ORBIT_GLFW
+    // Returns when the window is closed rather than exiting like GLUT
+    while (!glfwWindowShouldClose(pWindow))
+    {
+        // wait for the frame to come due. The swap does the waiting when
+        // we draw as often as the display refreshes or more
+        auto start = std::chrono::steady_clock::now();
+        if (!isTimeToDraw())
+            glfwWaitUntil(getNextTick());
+        setNextDrawTime();
+        auto woken = std::chrono::steady_clock::now();
+
+        // calls the client's display function
+        glClear(GL_COLOR_BUFFER_BIT);
+        glColor3f((GLfloat)1.0 /* red % */, (GLfloat)1.0 /* green % */, (GLfloat)1.0 /* blue % */);
+        callBack(this, p);
+        auto drawn = std::chrono::steady_clock::now();
+
+        // blocks until the display refreshes
+        glfwSwapBuffers(pWindow);
+        glfwPollEvents();
+        auto swapped = std::chrono::steady_clock::now();
+
+        // how long each part took
+        if (getProfiler())
+        {
+            getProfiler()->add(Profiler::SLEEP, std::chrono::duration<double>(woken - start).count());
+            getProfiler()->add(Profiler::DRAW,  std::chrono::duration<double>(drawn - woken).count());
+            getProfiler()->add(Profiler::SWAP,  std::chrono::duration<double>(swapped - drawn).count());
+        }
+    }
+
+    glfwDestroyWindow(pWindow);
+    glfwTerminate();
+#else // !ORBIT_GLFW
     glutMainLoop();
+#endif // !ORBIT_GLFW
 
     return;
 }
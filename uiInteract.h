@@ -12,17 +12,36 @@
  *    3. callback     - Specified in Run, this user-provided
  *                      function will get called with every frame
  *    4. isDown()     - Is a given key pressed on this loop?
+ *    5. pollEvents() - Catch the keys up to a given time
  **********************************************/
 
 #pragma once
 
 #include "position.h"
+#include "spscQueue.h"
 #include <algorithm> // used for min() and max() (specifically required by Visual Studio)
+#include <atomic>    // keys are shared between threads
+#include <chrono>    // for steady_clock
 using std::min;
 using std::max;
 
 #define GL_SILENCE_DEPRECATION
 
+class Profiler;
+
+/********************************************
+ * INPUT EVENT
+ * One key going down or up, and when it happened
+ ********************************************/
+struct InputEvent
+{
+    enum Type { KEY_DOWN, KEY_UP, KEYBOARD };
+
+    std::chrono::steady_clock::time_point time;
+    Type type;   // KEY_DOWN and KEY_UP are GLUT_KEY_ codes, KEYBOARD is ASCII
+    int  key;
+};
+
 /********************************************
  * INTERFACE
  * All the data necessary to keep our graphics
@@ -53,15 +72,29 @@ public:
     void setNextDrawTime();
 
     // Retrieve the next tick time... the time of the next draw.
-    unsigned long getNextTick() { return nextTick; }
+    std::chrono::steady_clock::time_point getNextTick() { return nextTick; }
 
     // How many frames per second are we configured for?
     void setFramesPerSecond(double value);
 
-    // Key event indicating a key has been pressed or not.  The callbacks
-    // should be the only onces to call this
+    // The callbacks stamp each key with the time and queue it. Only
+    // the callbacks should call this
+    void post(InputEvent::Type type, int key);
+
+    // Apply every queued key that happened by this time, returning how
+    // many. Whoever consumes the input calls this before each frame, so a
+    // key lands in the frame it belongs to however late the frame runs
+    int  pollEvents(std::chrono::steady_clock::time_point until);
+    bool pollEvent(std::chrono::steady_clock::time_point until, InputEvent& event);
+
+    // Apply one key. A replay feeds recorded keys through here
+    void apply(const InputEvent& event);
+
+    // Key event indicating a key has been pressed or not. The no-argument
+    // version ends a frame of input; whoever consumes the input calls it
     void keyEvent(int key, bool fDown);
     void keyEvent();
+    void keyboardEvent(unsigned char key);
 
     // Current frame rate
     double frameRate() const { return timePeriod; }
@@ -73,21 +106,72 @@ public:
     int  isRight()     const { return isRightPress; }
     bool isSpace()     const { return isSpacePress; }
 
+    // Camera keys: each press counts once. Zoom is + for in, pan is in
+    // screen directions (+X is right, +Y is up)
+    int  getZoomSteps() const { return zoomSteps; }
+    int  getPanX()      const { return panX; }
+    int  getPanY()      const { return panY; }
+    bool isHome()       const { return isHomePress; }
+
+    // Time warp presses this frame, + is faster
+    int  getWarpSteps() const { return warpSteps; }
+
+    // Frame timing. The draw callback times its own phases when there is
+    // a profiler to put them in. 'P' toggles whether to show it
+    void setProfiler(Profiler* pProfiler) { this->pProfiler = pProfiler; }
+    Profiler* getProfiler() const { return pProfiler; }
+    bool isProfileShown()   const { return showProfile; }
+
+    // 'T' asks for a trace to be saved. This answers yes only once
+    bool isTraceRequested() const { return isTracePress.exchange(false); }
+
+    // 'F' starts or stops simulating as fast as we can. Also only once
+    bool isFastForwardRequested() const { return isFastPress.exchange(false); }
+
     static void* p;                   // for client
     static void (*callBack)(const Interface*, void*);
 
 private:
     void initialize(int argc, char** argv, const char* title, const Position& ptUpperRight);
 
+    // Catch the arrows up with the callbacks after keys were dropped
+    void resync();
+
     static bool         initialized;  // only run the constructor once!
     static double       timePeriod;   // interval between frame draws
-    static unsigned long nextTick;     // time (from clock()) of our next draw
-
-    static int  isDownPress;          // is the down arrow currently pressed?
-    static int  isUpPress;            //    "   up         "
-    static int  isLeftPress;          //    "   left       "
-    static int  isRightPress;         //    "   right      "
-    static bool isSpacePress;         //    "   space      "
+    static std::chrono::steady_clock::time_point nextTick;  // wall time of our next draw
+
+    // Keys go from the GLUT thread to whoever polls them through here.
+    // Only arrow releases may use the last few slots, so a full queue
+    // never leaves an arrow stuck down
+    static const size_t RESERVED_FOR_RELEASES = 16;
+    static SpscQueue<InputEvent, 256> events;
+
+    // Only the callbacks write these
+    static std::atomic<int> arrowsHeld;   // arrows down as the callbacks saw them, one bit each
+    static std::atomic<int> numDropped;   // keys that did not fit in the queue
+
+    // Only the thread polling events touches this
+    static int numDroppedSeen;            // drops already made up for
+
+    // Only the thread polling events touches these
+    static int  isDownPress;   // frames the down arrow has been pressed
+    static int  isUpPress;     //    "       up         "
+    static int  isLeftPress;   //    "       left       "
+    static int  isRightPress;  //    "       right      "
+    static int  releases;      // arrows let go before a frame saw them, one bit each
+    static bool isSpacePress;  // is space pressed this frame?
+    static int  zoomSteps;     // zoom presses this frame, + is in
+    static int  panX;          // pan presses this frame, + is right
+    static int  panY;          //    "                    , + is up
+    static bool isHomePress;   // recenter the camera
+    static int  warpSteps;     // time warp presses this frame, + is faster
+
+    // These are read by the display thread as well
+    static std::atomic<bool> showProfile;   // draw the frame timing overlay
+    static std::atomic<bool> isTracePress;  // save a trace
+    static std::atomic<bool> isFastPress;   // start or stop fast forward
+    static Profiler*    pProfiler;    // where frame timing goes, if anywhere
 };
 
 
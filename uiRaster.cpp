@@ -0,0 +1,568 @@
+/***********************************************************************
+ * Source File:
+ *    User Interface Raster : put pixels in memory
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    A CPU rasterizer behind the ogstream interface so we can draw
+ *    without a window, a GPU, or even a display
+ ************************************************************************/
+
+#include "uiRaster.h"
+#include "parallel.h"
+#include "trace.h"
+#include <cassert>   // for assert()
+#include <cmath>     // for floor()
+#include <cstdio>    // for FILE
+#include <cstdint>   // for uint32_t
+#include <algorithm> // for min() and max()
+using namespace std;
+
+/*************************************************************************
+ * FONT
+ * A hand-drawn bitmap font, sized and spaced to stand in for the
+ * Helvetica 12 that GLUT uses on the screen. Each glyph is an advance
+ * width and sixteen rows from the bottom up, with the leftmost pixel in
+ * the high bit. Glyphs sit four pixels below the baseline
+ *************************************************************************/
+struct Glyph
+{
+   int width;
+   unsigned short rows[16];
+};
+
+const int FONT_FIRST = 32;
+const int FONT_LAST = 126;
+const int FONT_DESCENT = 4;
+const Glyph FONT[FONT_LAST - FONT_FIRST + 1] =
+{
+   {  4, { 0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // space
+   {  3, { 0x0000,0x0000,0x0000,0x0000,0x4000,0x0000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x0000,0x0000,0x0000 } }, // !
+   {  5, { 0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x5000,0x5000,0x5000,0x0000,0x0000,0x0000 } }, // "
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x5000,0x5000,0x5000,0xfc00,0x2800,0xfc00,0x2800,0x2800,0x0000,0x0000,0x0000,0x0000 } }, // #
+   {  7, { 0x0000,0x0000,0x0000,0x1000,0x3800,0x5400,0x5400,0x1400,0x3800,0x5000,0x5400,0x3800,0x1000,0x0000,0x0000,0x0000 } }, // $
+   { 11, { 0x0000,0x0000,0x0000,0x0000,0x1180,0x0a40,0x0a40,0x0980,0x0400,0x3400,0x4a00,0x4a00,0x3100,0x0000,0x0000,0x0000 } }, // %
+   {  9, { 0x0000,0x0000,0x0000,0x0000,0x3900,0x4600,0x4200,0x4500,0x2800,0x1800,0x2400,0x2400,0x1800,0x0000,0x0000,0x0000 } }, // &
+   {  3, { 0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x4000,0x2000,0x6000,0x0000,0x0000,0x0000 } }, // '
+   {  4, { 0x0000,0x1000,0x2000,0x2000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x2000,0x2000,0x1000,0x0000,0x0000,0x0000 } }, // (
+   {  4, { 0x0000,0x8000,0x4000,0x4000,0x2000,0x2000,0x2000,0x2000,0x2000,0x2000,0x4000,0x4000,0x8000,0x0000,0x0000,0x0000 } }, // )
+   {  5, { 0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x5000,0x2000,0x5000,0x0000,0x0000,0x0000 } }, // *
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x0000,0x1000,0x1000,0x7c00,0x1000,0x1000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // +
+   {  4, { 0x0000,0x0000,0x4000,0x2000,0x2000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // ,
+   {  8, { 0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x7c00,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // -
+   {  3, { 0x0000,0x0000,0x0000,0x0000,0x4000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // .
+   {  4, { 0x0000,0x0000,0x0000,0x0000,0x8000,0x8000,0x4000,0x4000,0x4000,0x2000,0x2000,0x1000,0x1000,0x0000,0x0000,0x0000 } }, // /
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x3800,0x4400,0x4400,0x4400,0x4400,0x4400,0x4400,0x4400,0x3800,0x0000,0x0000,0x0000 } }, // 0
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x1000,0x1000,0x1000,0x1000,0x1000,0x1000,0x1000,0x7000,0x1000,0x0000,0x0000,0x0000 } }, // 1
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x7c00,0x4000,0x4000,0x2000,0x1000,0x0800,0x0400,0x4400,0x3800,0x0000,0x0000,0x0000 } }, // 2
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x3800,0x4400,0x4400,0x0400,0x0400,0x1800,0x0400,0x4400,0x3800,0x0000,0x0000,0x0000 } }, // 3
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x0800,0x0800,0xfc00,0x8800,0x4800,0x2800,0x2800,0x1800,0x0800,0x0000,0x0000,0x0000 } }, // 4
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x3800,0x4400,0x4400,0x0400,0x0400,0x7800,0x4000,0x4000,0x7c00,0x0000,0x0000,0x0000 } }, // 5
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x3800,0x4400,0x4400,0x4400,0x6400,0x5800,0x4000,0x4400,0x3800,0x0000,0x0000,0x0000 } }, // 6
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x2000,0x2000,0x1000,0x1000,0x1000,0x0800,0x0800,0x0400,0x7c00,0x0000,0x0000,0x0000 } }, // 7
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x3800,0x4400,0x4400,0x4400,0x4400,0x3800,0x4400,0x4400,0x3800,0x0000,0x0000,0x0000 } }, // 8
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x3800,0x4400,0x0400,0x0400,0x3c00,0x4400,0x4400,0x4400,0x3800,0x0000,0x0000,0x0000 } }, // 9
+   {  3, { 0x0000,0x0000,0x0000,0x0000,0x4000,0x0000,0x0000,0x0000,0x0000,0x4000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // :
+   {  3, { 0x0000,0x0000,0x8000,0x4000,0x4000,0x0000,0x0000,0x0000,0x0000,0x4000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // ;
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x0000,0x0c00,0x3000,0xc000,0x3000,0x0c00,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // <
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x7c00,0x0000,0x7c00,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // =
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x0000,0x6000,0x1800,0x0600,0x1800,0x6000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // >
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x1000,0x0000,0x1000,0x1000,0x0800,0x0800,0x4400,0x4400,0x3800,0x0000,0x0000,0x0000 } }, // ?
+   { 12, { 0x0000,0x0000,0x0000,0x1f00,0x2000,0x4d80,0x5340,0x5120,0x5120,0x4920,0x26a0,0x3040,0x0f80,0x0000,0x0000,0x0000 } }, // @
+   {  9, { 0x0000,0x0000,0x0000,0x0000,0x4100,0x4100,0x4100,0x3e00,0x2200,0x2200,0x1400,0x1400,0x0800,0x0000,0x0000,0x0000 } }, // A
+   {  8, { 0x0000,0x0000,0x0000,0x0000,0x7c00,0x4200,0x4200,0x4200,0x7c00,0x4200,0x4200,0x4200,0x7c00,0x0000,0x0000,0x0000 } }, // B
+   {  9, { 0x0000,0x0000,0x0000,0x0000,0x1e00,0x2100,0x4000,0x4000,0x4000,0x4000,0x4000,0x2100,0x1e00,0x0000,0x0000,0x0000 } }, // C
+   {  9, { 0x0000,0x0000,0x0000,0x0000,0x7c00,0x4200,0x4100,0x4100,0x4100,0x4100,0x4100,0x4200,0x7c00,0x0000,0x0000,0x0000 } }, // D
+   {  8, { 0x0000,0x0000,0x0000,0x0000,0x7e00,0x4000,0x4000,0x4000,0x7e00,0x4000,0x4000,0x4000,0x7e00,0x0000,0x0000,0x0000 } }, // E
+   {  8, { 0x0000,0x0000,0x0000,0x0000,0x4000,0x4000,0x4000,0x4000,0x7c00,0x4000,0x4000,0x4000,0x7e00,0x0000,0x0000,0x0000 } }, // F
+   {  9, { 0x0000,0x0000,0x0000,0x0000,0x1d00,0x2300,0x4100,0x4100,0x4700,0x4000,0x4000,0x2100,0x1e00,0x0000,0x0000,0x0000 } }, // G
+   {  9, { 0x0000,0x0000,0x0000,0x0000,0x4100,0x4100,0x4100,0x4100,0x7f00,0x4100,0x4100,0x4100,0x4100,0x0000,0x0000,0x0000 } }, // H
+   {  3, { 0x0000,0x0000,0x0000,0x0000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x0000,0x0000,0x0000 } }, // I
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x3800,0x4400,0x4400,0x0400,0x0400,0x0400,0x0400,0x0400,0x0400,0x0000,0x0000,0x0000 } }, // J
+   {  8, { 0x0000,0x0000,0x0000,0x0000,0x4100,0x4200,0x4400,0x4800,0x7000,0x5000,0x4800,0x4400,0x4200,0x0000,0x0000,0x0000 } }, // K
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x7c00,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x0000,0x0000,0x0000 } }, // L
+   { 11, { 0x0000,0x0000,0x0000,0x0000,0x4440,0x4440,0x4a40,0x4a40,0x5140,0x5140,0x60c0,0x60c0,0x4040,0x0000,0x0000,0x0000 } }, // M
+   {  9, { 0x0000,0x0000,0x0000,0x0000,0x4100,0x4300,0x4500,0x4500,0x4900,0x5100,0x5100,0x6100,0x4100,0x0000,0x0000,0x0000 } }, // N
+   { 10, { 0x0000,0x0000,0x0000,0x0000,0x1e00,0x2100,0x4080,0x4080,0x4080,0x4080,0x4080,0x2100,0x1e00,0x0000,0x0000,0x0000 } }, // O
+   {  8, { 0x0000,0x0000,0x0000,0x0000,0x4000,0x4000,0x4000,0x4000,0x7c00,0x4200,0x4200,0x4200,0x7c00,0x0000,0x0000,0x0000 } }, // P
+   { 10, { 0x0000,0x0000,0x0000,0x0000,0x1e80,0x2100,0x4280,0x4480,0x4080,0x4080,0x4080,0x2100,0x1e00,0x0000,0x0000,0x0000 } }, // Q
+   {  8, { 0x0000,0x0000,0x0000,0x0000,0x4200,0x4200,0x4200,0x4400,0x7c00,0x4200,0x4200,0x4200,0x7c00,0x0000,0x0000,0x0000 } }, // R
+   {  8, { 0x0000,0x0000,0x0000,0x0000,0x3c00,0x4200,0x4200,0x0200,0x0c00,0x3000,0x4000,0x4200,0x3c00,0x0000,0x0000,0x0000 } }, // S
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x1000,0x1000,0x1000,0x1000,0x1000,0x1000,0x1000,0x1000,0xfe00,0x0000,0x0000,0x0000 } }, // T
+   {  8, { 0x0000,0x0000,0x0000,0x0000,0x3c00,0x4200,0x4200,0x4200,0x4200,0x4200,0x4200,0x4200,0x4200,0x0000,0x0000,0x0000 } }, // U
+   {  9, { 0x0000,0x0000,0x0000,0x0000,0x0800,0x0800,0x1400,0x1400,0x2200,0x2200,0x2200,0x4100,0x4100,0x0000,0x0000,0x0000 } }, // V
+   { 11, { 0x0000,0x0000,0x0000,0x0000,0x1100,0x1100,0x1100,0x2a80,0x2a80,0x2480,0x4440,0x4440,0x4440,0x0000,0x0000,0x0000 } }, // W
+   {  9, { 0x0000,0x0000,0x0000,0x0000,0x4100,0x2200,0x2200,0x1400,0x0800,0x1400,0x2200,0x2200,0x4100,0x0000,0x0000,0x0000 } }, // X
+   {  9, { 0x0000,0x0000,0x0000,0x0000,0x0800,0x0800,0x0800,0x0800,0x1400,0x2200,0x2200,0x4100,0x4100,0x0000,0x0000,0x0000 } }, // Y
+   {  9, { 0x0000,0x0000,0x0000,0x0000,0x7f00,0x4000,0x2000,0x1000,0x0800,0x0400,0x0200,0x0100,0x7f00,0x0000,0x0000,0x0000 } }, // Z
+   {  3, { 0x0000,0x6000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x6000,0x0000,0x0000,0x0000 } }, // [
+   {  4, { 0x0000,0x0000,0x0000,0x0000,0x1000,0x1000,0x2000,0x2000,0x2000,0x4000,0x4000,0x8000,0x8000,0x0000,0x0000,0x0000 } }, // backslash
+   {  3, { 0x0000,0xc000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0xc000,0x0000,0x0000,0x0000 } }, // ]
+   {  6, { 0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x8800,0x5000,0x2000,0x0000,0x0000,0x0000,0x0000 } }, // ^
+   {  7, { 0x0000,0x0000,0xfe00,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // _
+   {  3, { 0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0xc000,0x8000,0x4000,0x0000,0x0000,0x0000 } }, // `
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x3a00,0x4400,0x4400,0x3c00,0x0400,0x4400,0x3800,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // a
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x5800,0x6400,0x4400,0x4400,0x4400,0x6400,0x5800,0x4000,0x4000,0x0000,0x0000,0x0000 } }, // b
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x3800,0x4400,0x4000,0x4000,0x4000,0x4400,0x3800,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // c
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x3400,0x4c00,0x4400,0x4400,0x4400,0x4c00,0x3400,0x0400,0x0400,0x0000,0x0000,0x0000 } }, // d
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x3800,0x4400,0x4000,0x7c00,0x4400,0x4400,0x3800,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // e
+   {  3, { 0x0000,0x0000,0x0000,0x0000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0xe000,0x4000,0x3000,0x0000,0x0000,0x0000 } }, // f
+   {  7, { 0x0000,0x3800,0x4400,0x0400,0x3400,0x4c00,0x4400,0x4400,0x4400,0x4c00,0x3400,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // g
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x4400,0x4400,0x4400,0x4400,0x4400,0x6400,0x5800,0x4000,0x4000,0x0000,0x0000,0x0000 } }, // h
+   {  3, { 0x0000,0x0000,0x0000,0x0000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x0000,0x4000,0x0000,0x0000,0x0000 } }, // i
+   {  3, { 0x0000,0x8000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x0000,0x4000,0x0000,0x0000,0x0000 } }, // j
+   {  6, { 0x0000,0x0000,0x0000,0x0000,0x4400,0x4800,0x5000,0x6000,0x6000,0x5000,0x4800,0x4000,0x4000,0x0000,0x0000,0x0000 } }, // k
+   {  3, { 0x0000,0x0000,0x0000,0x0000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x0000,0x0000,0x0000 } }, // l
+   {  9, { 0x0000,0x0000,0x0000,0x0000,0x4900,0x4900,0x4900,0x4900,0x4900,0x6d00,0x5200,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // m
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x4400,0x4400,0x4400,0x4400,0x4400,0x6400,0x5800,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // n
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x3800,0x4400,0x4400,0x4400,0x4400,0x4400,0x3800,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // o
+   {  7, { 0x0000,0x4000,0x4000,0x4000,0x5800,0x6400,0x4400,0x4400,0x4400,0x6400,0x5800,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // p
+   {  7, { 0x0000,0x0400,0x0400,0x0400,0x3400,0x4c00,0x4400,0x4400,0x4400,0x4c00,0x3400,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // q
+   {  4, { 0x0000,0x0000,0x0000,0x0000,0x4000,0x4000,0x4000,0x4000,0x4000,0x6000,0x5000,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // r
+   {  6, { 0x0000,0x0000,0x0000,0x0000,0x3000,0x4800,0x0800,0x3000,0x4000,0x4800,0x3000,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // s
+   {  3, { 0x0000,0x0000,0x0000,0x0000,0x6000,0x4000,0x4000,0x4000,0x4000,0x4000,0xe000,0x4000,0x4000,0x0000,0x0000,0x0000 } }, // t
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x3400,0x4c00,0x4400,0x4400,0x4400,0x4400,0x4400,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // u
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x1000,0x1000,0x2800,0x2800,0x4400,0x4400,0x4400,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // v
+   {  9, { 0x0000,0x0000,0x0000,0x0000,0x2200,0x2200,0x5500,0x4900,0x4900,0x8880,0x8880,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // w
+   {  6, { 0x0000,0x0000,0x0000,0x0000,0x8400,0x8400,0x4800,0x3000,0x3000,0x4800,0x8400,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // x
+   {  7, { 0x0000,0x4000,0x2000,0x1000,0x1000,0x2800,0x2800,0x4800,0x4400,0x4400,0x4400,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // y
+   {  6, { 0x0000,0x0000,0x0000,0x0000,0x7800,0x4000,0x2000,0x2000,0x1000,0x0800,0x7800,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // z
+   {  4, { 0x0000,0x3000,0x4000,0x4000,0x4000,0x4000,0x4000,0x8000,0x4000,0x4000,0x4000,0x4000,0x3000,0x0000,0x0000,0x0000 } }, // {
+   {  3, { 0x0000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x4000,0x0000,0x0000,0x0000 } }, // |
+   {  4, { 0x0000,0xc000,0x2000,0x2000,0x2000,0x2000,0x2000,0x1000,0x2000,0x2000,0x2000,0x2000,0xc000,0x0000,0x0000,0x0000 } }, // }
+   {  7, { 0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x9800,0x6400,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000 } }, // ~
+};
+
+/*************************************************************************
+ * RASTER : CONSTRUCTOR
+ * Set up an all black frame buffer
+ *   INPUT  width      How wide the image is in pixels
+ *          height     How tall the image is in pixels
+ *          numThreads How many threads to rasterize with. Zero is one per core
+ *************************************************************************/
+ogstreamRaster::ogstreamRaster(int width, int height, int numThreads) :
+   width(width), height(height), numThreads(numThreads),
+   tilesX((width + TILE_SIZE - 1) / TILE_SIZE),
+   tilesY((height + TILE_SIZE - 1) / TILE_SIZE)
+{
+   assert(width > 0 && height > 0);
+   bins.resize(tilesX * tilesY);
+   clear();
+}
+
+/*************************************************************************
+ * RASTER : CLEAR
+ * Back to a black frame with nothing queued
+ *************************************************************************/
+void ogstreamRaster::clear()
+{
+   pixels.assign(4 * width * height, 0);
+   for (int i = 3; i < (int)pixels.size(); i += 4)
+      pixels[i] = 255;
+   primitives.clear();
+}
+
+/*************************************************************************
+ * RASTER : TO PIXELS
+ * Screen coordinates have the origin in the center with Y going up, just
+ * like gluOrtho2D() sets up. The frame buffer has row 0 at the top.
+ *************************************************************************/
+void ogstreamRaster::toPixels(const Position& pt, float& x, float& y) const
+{
+   x = (float)(pt.getPixelsX() + width / 2);
+   y = (float)(height / 2 - pt.getPixelsY());
+}
+
+/*************************************************************************
+ * RASTER : VIEW TO PIXELS
+ * Same as toPixels() but for shapes, which move with the view
+ *************************************************************************/
+void ogstreamRaster::viewToPixels(const Position& pt, float& x, float& y) const
+{
+   toPixels(toView(pt), x, y);
+}
+
+/*************************************************************************
+ * RASTER : QUEUE
+ * Finish filling out a primitive (color and bounding box) and queue it.
+ * Anything that is entirely off the frame is dropped here.
+ *************************************************************************/
+void ogstreamRaster::queue(Primitive& prim, int numPoints, const int* rgb)
+{
+   float xMin = prim.x[0], xMax = prim.x[0];
+   float yMin = prim.y[0], yMax = prim.y[0];
+   for (int i = 1; i < numPoints; i++)
+   {
+      xMin = min(xMin, prim.x[i]);
+      xMax = max(xMax, prim.x[i]);
+      yMin = min(yMin, prim.y[i]);
+      yMax = max(yMax, prim.y[i]);
+   }
+
+   // reject what we cannot see, and clamp the rest to the frame
+   if (xMax < 0.0f || yMax < 0.0f || xMin >= (float)width || yMin >= (float)height)
+      return;
+   prim.xMin = max(0, (int)floor(xMin));
+   prim.yMin = max(0, (int)floor(yMin));
+   prim.xMax = min(width - 1, (int)floor(xMax));
+   prim.yMax = min(height - 1, (int)floor(yMax));
+
+   // colors go to 256 in a few places. We only have a byte
+   for (int i = 0; i < 3; i++)
+      prim.rgb[i] = (unsigned char)max(0, min(255, rgb[i]));
+
+   primitives.push_back(prim);
+}
+
+/*************************************************************************
+ * RASTER : DRAW TRIANGLE FAN
+ * Break the fan into triangles around the first point
+ *************************************************************************/
+void ogstreamRaster::drawTriangleFan(const Position* points, int num, const int* rgb)
+{
+   for (int i = 1; i + 1 < num; i++)
+   {
+      Primitive prim;
+      prim.type = TRIANGLE;
+      viewToPixels(points[0],     prim.x[0], prim.y[0]);
+      viewToPixels(points[i],     prim.x[1], prim.y[1]);
+      viewToPixels(points[i + 1], prim.x[2], prim.y[2]);
+      queue(prim, 3, rgb);
+   }
+}
+
+/*************************************************************************
+ * RASTER : DRAW LINE
+ *************************************************************************/
+void ogstreamRaster::drawLine(const Position& begin, const Position& end, const int* rgb)
+{
+   Primitive prim;
+   prim.type = LINE;
+   viewToPixels(begin, prim.x[0], prim.y[0]);
+   viewToPixels(end,   prim.x[1], prim.y[1]);
+   queue(prim, 2, rgb);
+}
+
+/*************************************************************************
+ * RASTER : DRAW DOT
+ *************************************************************************/
+void ogstreamRaster::drawDot(const Position& point, const int* rgb)
+{
+   Primitive prim;
+   prim.type = DOT;
+   viewToPixels(point, prim.x[0], prim.y[0]);
+   queue(prim, 1, rgb);
+}
+
+/*************************************************************************
+ * RASTER : DRAW TEXT
+ * Turn each lit pixel of each glyph into a dot. Text is white, just as
+ * it is on the screen.
+ *************************************************************************/
+void ogstreamRaster::drawText(const Position& topLeft, const char* text)
+{
+   const int rgbText[] = { 255, 255, 255 };
+   float xOrigin;
+   float yBaseline;
+   toPixels(topLeft, xOrigin, yBaseline);
+   xOrigin = floor(xOrigin);
+   yBaseline = floor(yBaseline);
+
+   for (const char* p = text; *p; p++)
+   {
+      if (*p < FONT_FIRST || *p > FONT_LAST)
+         continue;
+      const Glyph& glyph = FONT[*p - FONT_FIRST];
+      for (int row = 0; row < 16; row++)
+         for (int col = 0; col < glyph.width; col++)
+            if (glyph.rows[row] & (0x8000 >> col))
+            {
+               Primitive prim;
+               prim.type = DOT;
+               prim.x[0] = xOrigin + (float)col + 0.5f;
+               prim.y[0] = yBaseline + (float)(FONT_DESCENT - row) - 0.5f;
+               queue(prim, 1, rgbText);
+            }
+      xOrigin += (float)glyph.width;
+   }
+}
+
+/*************************************************************************
+ * RASTER : RENDER
+ * Bin every queued primitive into the tiles it touches, then rasterize the
+ * tiles in parallel. Tiles never share a pixel so there is no locking.
+ *************************************************************************/
+void ogstreamRaster::render()
+{
+   TRACE_SCOPE("ogstreamRaster::render");
+   flush();
+
+   for (auto& bin : bins)
+      bin.clear();
+   for (int i = 0; i < (int)primitives.size(); i++)
+   {
+      const Primitive& prim = primitives[i];
+      for (int ty = prim.yMin / TILE_SIZE; ty <= prim.yMax / TILE_SIZE; ty++)
+         for (int tx = prim.xMin / TILE_SIZE; tx <= prim.xMax / TILE_SIZE; tx++)
+            bins[ty * tilesX + tx].push_back(i);
+   }
+
+   parallelFor((int)bins.size(), [this](int first, int last)
+   {
+      for (int tile = first; tile < last; tile++)
+         rasterizeTile(tile);
+   }, numThreads);
+
+   primitives.clear();
+}
+
+/*************************************************************************
+ * RASTER : RASTERIZE TILE
+ * Draw everything binned into one tile, in the order it was drawn
+ *************************************************************************/
+void ogstreamRaster::rasterizeTile(int tile)
+{
+   int x0 = (tile % tilesX) * TILE_SIZE;
+   int y0 = (tile / tilesX) * TILE_SIZE;
+   int x1 = min(x0 + TILE_SIZE, width) - 1;
+   int y1 = min(y0 + TILE_SIZE, height) - 1;
+
+   for (int i : bins[tile])
+   {
+      const Primitive& prim = primitives[i];
+      switch (prim.type)
+      {
+      case TRIANGLE:
+         fillTriangle(prim, max(x0, prim.xMin), max(y0, prim.yMin),
+                            min(x1, prim.xMax), min(y1, prim.yMax));
+         break;
+      case LINE:
+         fillLine(prim, x0, y0, x1, y1);
+         break;
+      case DOT:
+         setPixel(prim.xMin, prim.yMin, prim.rgb);
+         break;
+      }
+   }
+}
+
+/*************************************************************************
+ * RASTER : FILL TRIANGLE
+ * Edge functions evaluated at pixel centers. Shared edges follow the
+ * top-left rule so adjacent triangles neither overlap nor leave cracks.
+ *   INPUT  prim       The triangle
+ *          x0 .. y1   The part of the frame we may touch, inclusive
+ *************************************************************************/
+void ogstreamRaster::fillTriangle(const Primitive& prim, int x0, int y0, int x1, int y1)
+{
+   float ax = prim.x[0], ay = prim.y[0];
+   float bx = prim.x[1], by = prim.y[1];
+   float cx = prim.x[2], cy = prim.y[2];
+
+   // put the vertices in a consistent winding. Degenerate triangles draw nothing
+   float area = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+   if (area == 0.0f)
+      return;
+   if (area < 0.0f)
+   {
+      std::swap(bx, cx);
+      std::swap(by, cy);
+   }
+
+   // with Y down and this winding, an edge is "top" if it is flat and
+   // heads right, and "left" if it heads up the frame
+   auto isTopLeft = [](float dx, float dy) { return (dy == 0.0f && dx > 0.0f) || dy < 0.0f; };
+   bool topLeftAB = isTopLeft(bx - ax, by - ay);
+   bool topLeftBC = isTopLeft(cx - bx, cy - by);
+   bool topLeftCA = isTopLeft(ax - cx, ay - cy);
+
+   for (int y = y0; y <= y1; y++)
+   {
+      float py = (float)y + 0.5f;
+      for (int x = x0; x <= x1; x++)
+      {
+         float px = (float)x + 0.5f;
+         float wAB = (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+         float wBC = (cx - bx) * (py - by) - (cy - by) * (px - bx);
+         float wCA = (ax - cx) * (py - cy) - (ay - cy) * (px - cx);
+         if ((wAB > 0.0f || (wAB == 0.0f && topLeftAB)) &&
+             (wBC > 0.0f || (wBC == 0.0f && topLeftBC)) &&
+             (wCA > 0.0f || (wCA == 0.0f && topLeftCA)))
+            setPixel(x, y, prim.rgb);
+      }
+   }
+}
+
+/*************************************************************************
+ * RASTER : FILL LINE
+ * Walk the line one pixel at a time, only touching pixels in the tile
+ *************************************************************************/
+void ogstreamRaster::fillLine(const Primitive& prim, int x0, int y0, int x1, int y1)
+{
+   float dx = prim.x[1] - prim.x[0];
+   float dy = prim.y[1] - prim.y[0];
+   int steps = (int)max(fabs(dx), fabs(dy));
+   if (steps == 0)
+      steps = 1;
+
+   for (int i = 0; i <= steps; i++)
+   {
+      int x = (int)floor(prim.x[0] + dx * (float)i / (float)steps);
+      int y = (int)floor(prim.y[0] + dy * (float)i / (float)steps);
+      if (x >= x0 && x <= x1 && y >= y0 && y <= y1)
+         setPixel(x, y, prim.rgb);
+   }
+}
+
+/*************************************************************************
+ * RASTER : SET PIXEL
+ *************************************************************************/
+inline void ogstreamRaster::setPixel(int x, int y, const unsigned char* rgb)
+{
+   unsigned char* pixel = &pixels[4 * (y * width + x)];
+   pixel[0] = rgb[0];
+   pixel[1] = rgb[1];
+   pixel[2] = rgb[2];
+}
+
+/*************************************************************************
+ * RASTER : WRITE PPM
+ * The simplest image format there is: a short header and raw RGB
+ *************************************************************************/
+bool ogstreamRaster::writePPM(const char* fileName) const
+{
+   FILE* file = fopen(fileName, "wb");
+   if (!file)
+      return false;
+
+   fprintf(file, "P6\n%d %d\n255\n", width, height);
+   vector<unsigned char> row(3 * width);
+   for (int y = 0; y < height; y++)
+   {
+      for (int x = 0; x < width; x++)
+         for (int c = 0; c < 3; c++)
+            row[3 * x + c] = pixels[4 * (y * width + x) + c];
+      fwrite(row.data(), 1, row.size(), file);
+   }
+
+   return fclose(file) == 0;
+}
+
+/*************************************************************************
+ * CRC TABLE
+ * One entry per byte value, worked out by the compiler
+ *************************************************************************/
+struct CrcTable
+{
+   uint32_t entries[256];
+
+   constexpr CrcTable() : entries()
+   {
+      for (uint32_t n = 0; n < 256; n++)
+      {
+         uint32_t c = n;
+         for (int k = 0; k < 8; k++)
+            c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+         entries[n] = c;
+      }
+   }
+};
+static constexpr CrcTable CRC_TABLE;
+
+/*************************************************************************
+ * RASTER CRC
+ * The CRC-32 PNG puts at the end of every chunk
+ *************************************************************************/
+static uint32_t rasterCrc(const unsigned char* data, size_t size, uint32_t crc = 0)
+{
+   crc = ~crc;
+   for (size_t i = 0; i < size; i++)
+      crc = CRC_TABLE.entries[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+   return ~crc;
+}
+
+/*************************************************************************
+ * PUT BIG ENDIAN
+ *************************************************************************/
+static void putBigEndian(vector<unsigned char>& buffer, uint32_t value)
+{
+   buffer.push_back((unsigned char)(value >> 24));
+   buffer.push_back((unsigned char)(value >> 16));
+   buffer.push_back((unsigned char)(value >> 8));
+   buffer.push_back((unsigned char)(value));
+}
+
+/*************************************************************************
+ * WRITE CHUNK
+ * Length, type, data, then a CRC over the type and data
+ *************************************************************************/
+static void writeChunk(FILE* file, const char* type, const vector<unsigned char>& data)
+{
+   vector<unsigned char> chunk;
+   putBigEndian(chunk, (uint32_t)data.size());
+   chunk.insert(chunk.end(), type, type + 4);
+   chunk.insert(chunk.end(), data.begin(), data.end());
+   putBigEndian(chunk, rasterCrc(&chunk[4], chunk.size() - 4));
+   fwrite(chunk.data(), 1, chunk.size(), file);
+}
+
+/*************************************************************************
+ * RASTER : WRITE PNG
+ * An RGB PNG. We have no zlib, so the image data goes into uncompressed
+ * ("stored") deflate blocks. The files are big but any viewer reads them.
+ *************************************************************************/
+bool ogstreamRaster::writePNG(const char* fileName) const
+{
+   FILE* file = fopen(fileName, "wb");
+   if (!file)
+      return false;
+
+   const unsigned char signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+   fwrite(signature, 1, sizeof(signature), file);
+
+   // header: size, 8 bits per channel, RGB, no interlacing
+   vector<unsigned char> header;
+   putBigEndian(header, (uint32_t)width);
+   putBigEndian(header, (uint32_t)height);
+   header.insert(header.end(), { 8, 2, 0, 0, 0 });
+   writeChunk(file, "IHDR", header);
+
+   // every scanline starts with a zero "no filter" byte
+   vector<unsigned char> raw;
+   raw.reserve((3 * width + 1) * height);
+   for (int y = 0; y < height; y++)
+   {
+      raw.push_back(0);
+      for (int x = 0; x < width; x++)
+         for (int c = 0; c < 3; c++)
+            raw.push_back(pixels[4 * (y * width + x) + c]);
+   }
+
+   // zlib header, stored blocks of at most 65535 bytes, then Adler-32
+   vector<unsigned char> data = { 0x78, 0x01 };
+   uint32_t a = 1;
+   uint32_t b = 0;
+   for (size_t i = 0; i < raw.size(); i++)
+   {
+      a = (a + raw[i]) % 65521;
+      b = (b + a) % 65521;
+   }
+   for (size_t offset = 0; offset < raw.size() || offset == 0; offset += 65535)
+   {
+      size_t size = min((size_t)65535, raw.size() - offset);
+      bool isLast = offset + size >= raw.size();
+      data.push_back(isLast ? 1 : 0);
+      data.push_back((unsigned char)(size & 0xff));
+      data.push_back((unsigned char)(size >> 8));
+      data.push_back((unsigned char)(~size & 0xff));
+      data.push_back((unsigned char)((~size >> 8) & 0xff));
+      data.insert(data.end(), raw.begin() + offset, raw.begin() + offset + size);
+      if (isLast)
+         break;
+   }
+   putBigEndian(data, (b << 16) | a);
+   writeChunk(file, "IDAT", data);
+   writeChunk(file, "IEND", vector<unsigned char>());
+
+   return fclose(file) == 0;
+}
@@ -0,0 +1,83 @@
+/***********************************************************************
+ * Header File:
+ *    User Interface Raster : put pixels in memory
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    A graphics stream that needs no window. Every shape is broken down
+ *    into the same triangles, lines, dots, and text that OpenGL would get,
+ *    and those are rasterized by the CPU into an RGBA frame buffer which
+ *    can then be written out as a PPM or PNG image.
+ ************************************************************************/
+
+#pragma once
+
+#include "uiDraw.h"
+#include <vector>
+
+class TestRaster;
+
+/*************************************************************************
+ * GRAPHICS STREAM RASTER
+ * Draw into memory rather than onto the screen. Primitives are queued as
+ * they are drawn and binned into tiles by render(), and the tiles are then
+ * rasterized in parallel. Each tile draws its primitives in submission
+ * order, so the result is the same no matter how many threads there are.
+ *************************************************************************/
+class ogstreamRaster : public ogstream
+{
+public:
+   friend TestRaster;
+
+   ogstreamRaster(int width, int height, int numThreads = 0);
+   ~ogstreamRaster() { flush(); }
+
+   // Frame buffer management
+   void clear();
+   void render();
+   int  getWidth()  const { return width;  }
+   int  getHeight() const { return height; }
+   const unsigned char* getPixel(int x, int y) const { return &pixels[4 * (y * width + x)]; }
+
+   // Save the frame buffer. Returns false if the file could not be written
+   bool writePPM(const char* fileName) const;
+   bool writePNG(const char* fileName) const;
+
+protected:
+   void drawTriangleFan(const Position* points, int num, const int* rgb) override;
+   void drawLine(const Position& begin, const Position& end, const int* rgb) override;
+   void drawDot(const Position& point, const int* rgb) override;
+   void drawText(const Position& topLeft, const char* text) override;
+
+private:
+   enum PrimitiveType { TRIANGLE, LINE, DOT };
+
+   // A queued primitive in frame buffer coordinates (row 0 is the top)
+   struct Primitive
+   {
+      PrimitiveType type;
+      float x[3];
+      float y[3];
+      unsigned char rgb[3];
+      int xMin, yMin, xMax, yMax;    // pixel bounding box, inclusive
+   };
+
+   void queue(Primitive& prim, int numPoints, const int* rgb);
+   void toPixels(const Position& pt, float& x, float& y) const;
+   void viewToPixels(const Position& pt, float& x, float& y) const;
+   void rasterizeTile(int tile);
+   void fillTriangle(const Primitive& prim, int x0, int y0, int x1, int y1);
+   void fillLine(const Primitive& prim, int x0, int y0, int x1, int y1);
+   void setPixel(int x, int y, const unsigned char* rgb);
+
+   static const int TILE_SIZE = 32;
+
+   int width;
+   int height;
+   int numThreads;
+   int tilesX;
+   int tilesY;
+   std::vector<Primitive> primitives;     // queued since the last render()
+   std::vector<std::vector<int>> bins;    // primitive indices for each tile
+   std::vector<unsigned char> pixels;     // RGBA, row 0 at the top
+};
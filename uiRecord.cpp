@@ -0,0 +1,600 @@
+/***********************************************************************
+ * Source File:
+ *    User Interface Record : remember what was drawn
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    A graphics stream that draws nothing. Every call is written to a
+ *    compact binary command buffer instead, which can later be replayed
+ *    into any other graphics stream, saved to a file, or compared.
+ ************************************************************************/
+
+#include "uiRecord.h"
+#include "trace.h"
+#include <cstring>   // for memcpy() and memcmp()
+#include <cstdio>    // for fopen() and friends
+#include <utility>   // for std::swap
+#include <cmath>     // for floor()
+#include <filesystem>  // for file_size()
+
+// Saved files start with this, followed by the buffer size
+const char RECORD_MAGIC[4] = { 'O', 'G', 'S', 'R' };
+
+/*************************************************************************
+ * RECORD READER
+ * Walk through a command buffer pulling out one value at a time. Given
+ * an earlier buffer of the same shape, every number is blended between
+ * the two: a weight of 0.0 is all the earlier one, 1.0 is all this one
+ *************************************************************************/
+class RecordReader
+{
+public:
+   RecordReader(const std::vector<unsigned char>& buffer,
+                const std::vector<unsigned char>* pPrevious = NULL,
+                double weight = 1.0) :
+      buffer(buffer), pPrevious(pPrevious), weight(weight), cursor(0) {}
+
+   bool isDone() const { return cursor >= buffer.size(); }
+
+   unsigned char getByte() { return buffer[cursor++]; }
+
+   double getDouble()
+   {
+      double value = read(buffer);
+      if (pPrevious)
+         value = read(*pPrevious) + weight * (value - read(*pPrevious));
+      cursor += sizeof(value);
+      return value;
+   }
+
+   // the short way around, so 350 degrees to 10 degrees does not spin
+   double getRotation()
+   {
+      double value = read(buffer);
+      if (pPrevious)
+      {
+         double difference = value - read(*pPrevious);
+         difference -= TWO_PI * floor(difference / TWO_PI + 0.5);
+         value = read(*pPrevious) + weight * difference;
+      }
+      cursor += sizeof(value);
+      return value;
+   }
+
+   Position getPosition()
+   {
+      double x = getDouble();
+      double y = getDouble();
+      return Position(x, y);
+   }
+
+   Position getOffset()
+   {
+      Position offset;
+      offset.setPixelsX(getDouble());
+      offset.setPixelsY(getDouble());
+      return offset;
+   }
+
+   const char* getText(size_t& length)
+   {
+      length = getByte();
+      length |= (size_t)getByte() << 8;
+      const char* text = (const char*)&buffer[cursor];
+      cursor += length;
+      return text;
+   }
+
+private:
+   double read(const std::vector<unsigned char>& source) const
+   {
+      double value;
+      memcpy(&value, &source[cursor], sizeof(value));
+      return value;
+   }
+
+   static constexpr double TWO_PI = 6.28318530717958647692;
+
+   const std::vector<unsigned char>& buffer;
+   const std::vector<unsigned char>* pPrevious;
+   double weight;
+   size_t cursor;
+};
+
+/*************************************************************************
+ * COMMAND SIZE
+ * How many bytes follow a command's type byte, or 0 if the type is not
+ * one we know or the command runs off the end of the buffer
+ *    INPUT  buffer  The commands
+ *           cursor  Where the command's type byte is
+ *************************************************************************/
+size_t ogstreamRecord::commandSize(const std::vector<unsigned char>& buffer, size_t cursor)
+{
+   const size_t SIZE_POSITION = 2 * sizeof(double);
+   const size_t SIZE_PART = SIZE_POSITION + sizeof(double);
+
+   size_t size;
+   switch (buffer[cursor])
+   {
+      case ZOOM:       size = sizeof(double);                        break;
+      case VIEW:
+      case PROJECTILE:
+      case POINT:      size = SIZE_POSITION;                         break;
+      case STAR:       size = SIZE_POSITION + 1;                     break;
+      case HEAT:       size = SIZE_POSITION + 2 * sizeof(double);    break;
+      case SHIP:       size = SIZE_PART + 1;                         break;
+      case TEXT:
+         size = SIZE_POSITION + 2;
+         if (cursor + size < buffer.size())
+            size += buffer[cursor + SIZE_POSITION + 1] |
+                    (buffer[cursor + SIZE_POSITION + 2] << 8);
+         break;
+      case CREW_DRAGON_RIGHT: case CREW_DRAGON_LEFT:
+      case GPS_RIGHT: case GPS_LEFT:
+      case HUBBLE_COMPUTER: case HUBBLE_TELESCOPE: case HUBBLE_LEFT: case HUBBLE_RIGHT:
+      case STARLINK_BODY: case STARLINK_ARRAY:
+                       size = SIZE_PART + SIZE_POSITION;             break;
+      default:
+         if (buffer[cursor] >= NUM_COMMANDS)
+            return 0;
+         size = SIZE_PART;
+         break;
+   }
+   return cursor + size < buffer.size() ? size : 0;
+}
+
+/*************************************************************************
+ * RECORD : IS SAME SHAPE
+ * Could we blend between these two recordings? They need the same
+ * commands in the same order, and any text must be the same length
+ *************************************************************************/
+bool ogstreamRecord::isSameShape(const ogstreamRecord& rhs) const
+{
+   if (buffer.size() != rhs.buffer.size() || numCommands != rhs.numCommands)
+      return false;
+
+   for (size_t cursor = 0; cursor < buffer.size(); )
+   {
+      if (buffer[cursor] != rhs.buffer[cursor])
+         return false;
+      size_t size = commandSize(buffer, cursor);
+      if (size == 0 || size != commandSize(rhs.buffer, cursor))
+         return false;
+      cursor += 1 + size;
+   }
+   return true;
+}
+
+/*************************************************************************
+ * RECORD : CLEAR
+ * Forget everything, keeping the memory for the next frame
+ *************************************************************************/
+void ogstreamRecord::clear()
+{
+   str("");
+   buffer.clear();
+   zoom = 0.0;
+   numCommands = 0;
+}
+
+/*************************************************************************
+ * RECORD : SWAP
+ * Trade command buffers with another recording. This never copies
+ *************************************************************************/
+void ogstreamRecord::swap(ogstreamRecord& rhs)
+{
+   buffer.swap(rhs.buffer);
+   std::swap(zoom, rhs.zoom);
+   std::swap(numCommands, rhs.numCommands);
+}
+
+/*************************************************************************
+ * RECORD : PUT DOUBLE
+ * Doubles are stored as their raw bytes, so files are only portable
+ * between machines of the same byte order
+ *************************************************************************/
+void ogstreamRecord::putDouble(double value)
+{
+   unsigned char bytes[sizeof(value)];
+   memcpy(bytes, &value, sizeof(value));
+   buffer.insert(buffer.end(), bytes, bytes + sizeof(value));
+}
+
+/*************************************************************************
+ * RECORD : PUT POSITION
+ * Where something is in the world, in meters
+ *************************************************************************/
+void ogstreamRecord::putPosition(const Position& pt)
+{
+   putDouble(pt.getMetersX());
+   putDouble(pt.getMetersY());
+}
+
+/*************************************************************************
+ * RECORD : PUT OFFSET
+ * How far a part is from the middle of its satellite, in pixels
+ *************************************************************************/
+void ogstreamRecord::putOffset(const Position& offset)
+{
+   putDouble(offset.getPixelsX());
+   putDouble(offset.getPixelsY());
+}
+
+/*************************************************************************
+ * RECORD : BEGIN
+ * Start a new command, noting the zoom first if it has changed
+ *************************************************************************/
+void ogstreamRecord::begin(Command command)
+{
+   double zoomNow = Position().getZoom();
+   if (zoomNow != zoom)
+   {
+      putByte(ZOOM);
+      putDouble(zoomNow);
+      zoom = zoomNow;
+   }
+   putByte(command);
+   numCommands++;
+}
+
+/*************************************************************************
+ * RECORD : RECORD
+ * Most of the satellite parts take a center and a rotation, and some
+ * also take an offset
+ *************************************************************************/
+void ogstreamRecord::record(Command command, const Position& center, double rotation)
+{
+   begin(command);
+   putPosition(center);
+   putDouble(rotation);
+}
+
+void ogstreamRecord::record(Command command, const Position& center, double rotation,
+                            const Position& offset)
+{
+   record(command, center, rotation);
+   putOffset(offset);
+}
+
+/*************************************************************************
+ * RECORD : everything an ogstream can draw
+ *************************************************************************/
+void ogstreamRecord::setView(const Position& ptCenter)
+{
+   ogstream::setView(ptCenter);
+   begin(VIEW);
+   putPosition(ptCenter);
+}
+
+void ogstreamRecord::drawText(const Position& topLeft, const char* text)
+{
+   size_t length = strlen(text);
+   if (length > 0xFFFF)
+      length = 0xFFFF;
+   begin(TEXT);
+   putPosition(topLeft);
+   putByte((unsigned char)(length & 0xFF));
+   putByte((unsigned char)(length >> 8));
+   buffer.insert(buffer.end(), text, text + length);
+}
+
+void ogstreamRecord::drawFragment(const Position& center, double rotation)
+{
+   record(FRAGMENT, center, rotation);
+}
+
+void ogstreamRecord::drawProjectile(const Position& pt)
+{
+   begin(PROJECTILE);
+   putPosition(pt);
+}
+
+void ogstreamRecord::drawCrewDragon(const Position& center, double rotation)
+{
+   record(CREW_DRAGON, center, rotation);
+}
+
+void ogstreamRecord::drawCrewDragonRight(const Position& center, double rotation, const Position& offset)
+{
+   record(CREW_DRAGON_RIGHT, center, rotation, offset);
+}
+
+void ogstreamRecord::drawCrewDragonLeft(const Position& center, double rotation, const Position& offset)
+{
+   record(CREW_DRAGON_LEFT, center, rotation, offset);
+}
+
+void ogstreamRecord::drawCrewDragonCenter(const Position& center, double rotation)
+{
+   record(CREW_DRAGON_CENTER, center, rotation);
+}
+
+void ogstreamRecord::drawSputnik(const Position& center, double rotation)
+{
+   record(SPUTNIK, center, rotation);
+}
+
+void ogstreamRecord::drawGPS(const Position& center, double rotation)
+{
+   record(GPS, center, rotation);
+}
+
+void ogstreamRecord::drawGPSCenter(const Position& center, double rotation)
+{
+   record(GPS_CENTER, center, rotation);
+}
+
+void ogstreamRecord::drawGPSRight(const Position& center, double rotation, const Position& offset)
+{
+   record(GPS_RIGHT, center, rotation, offset);
+}
+
+void ogstreamRecord::drawGPSLeft(const Position& center, double rotation, const Position& offset)
+{
+   record(GPS_LEFT, center, rotation, offset);
+}
+
+void ogstreamRecord::drawHubble(const Position& center, double rotation)
+{
+   record(HUBBLE, center, rotation);
+}
+
+void ogstreamRecord::drawHubbleComputer(const Position& center, double rotation, const Position& offset)
+{
+   record(HUBBLE_COMPUTER, center, rotation, offset);
+}
+
+void ogstreamRecord::drawHubbleTelescope(const Position& center, double rotation, const Position& offset)
+{
+   record(HUBBLE_TELESCOPE, center, rotation, offset);
+}
+
+void ogstreamRecord::drawHubbleLeft(const Position& center, double rotation, const Position& offset)
+{
+   record(HUBBLE_LEFT, center, rotation, offset);
+}
+
+void ogstreamRecord::drawHubbleRight(const Position& center, double rotation, const Position& offset)
+{
+   record(HUBBLE_RIGHT, center, rotation, offset);
+}
+
+void ogstreamRecord::drawStarlink(const Position& center, double rotation)
+{
+   record(STARLINK, center, rotation);
+}
+
+void ogstreamRecord::drawStarlinkBody(const Position& center, double rotation, const Position& offset)
+{
+   record(STARLINK_BODY, center, rotation, offset);
+}
+
+void ogstreamRecord::drawStarlinkArray(const Position& center, double rotation, const Position& offset)
+{
+   record(STARLINK_ARRAY, center, rotation, offset);
+}
+
+void ogstreamRecord::drawShip(const Position& center, double rotation, bool thrust)
+{
+   record(SHIP, center, rotation);
+   putByte(thrust ? 1 : 0);
+}
+
+void ogstreamRecord::drawEarth(const Position& center, double rotation)
+{
+   record(EARTH, center, rotation);
+}
+
+void ogstreamRecord::drawStar(const Position& point, unsigned char phase)
+{
+   begin(STAR);
+   putPosition(point);
+   putByte(phase);
+}
+
+void ogstreamRecord::drawPoint(const Position& center)
+{
+   begin(POINT);
+   putPosition(center);
+}
+
+void ogstreamRecord::drawHeat(const Position& center, double sizePixels, double heat)
+{
+   begin(HEAT);
+   putPosition(center);
+   putDouble(sizePixels);
+   putDouble(heat);
+}
+
+/*************************************************************************
+ * RECORD : REPLAY
+ * Make every recorded call again, this time on another stream. The zoom
+ * is put back the way it was when we are done.
+ *************************************************************************/
+void ogstreamRecord::replay(ogstream& gout) const
+{
+   RecordReader reader(buffer);
+   replay(gout, reader);
+}
+
+/*************************************************************************
+ * RECORD : REPLAY blended with an earlier recording
+ * Draw somewhere between an earlier frame and this one, so motion looks
+ * smooth even when we draw more often than the simulation moves. Every
+ * center, rotation, and the view slide along; anything that came or went
+ * between the frames means we cannot line them up, so this one is drawn
+ *    INPUT  gout       Where to draw
+ *           previous   The frame before this one
+ *           weight     0.0 draws previous, 1.0 draws this one
+ *************************************************************************/
+void ogstreamRecord::replay(ogstream& gout, const ogstreamRecord& previous, double weight) const
+{
+   if (!isSameShape(previous))
+   {
+      replay(gout);
+      return;
+   }
+
+   RecordReader reader(buffer, &previous.buffer, weight);
+   replay(gout, reader);
+}
+
+/*************************************************************************
+ * RECORD : REPLAY with a reader
+ * Do the work for both kinds of replay
+ *************************************************************************/
+void ogstreamRecord::replay(ogstream& gout, RecordReader& reader) const
+{
+   TRACE_SCOPE("ogstreamRecord::replay");
+   Position ptZoom;
+   double zoomOld = ptZoom.getZoom();
+
+   while (!reader.isDone())
+   {
+      Command command = (Command)reader.getByte();
+      switch (command)
+      {
+         case ZOOM:
+            ptZoom.setZoom(reader.getDouble());
+            break;
+         case VIEW:
+            gout.setView(reader.getPosition());
+            break;
+         case TEXT:
+         {
+            Position topLeft = reader.getPosition();
+            size_t length;
+            const char* text = reader.getText(length);
+            gout.setPosition(topLeft);
+            gout.write(text, length);
+            gout.flush();
+            break;
+         }
+         case PROJECTILE:
+            gout.drawProjectile(reader.getPosition());
+            break;
+         case STAR:
+         {
+            Position point = reader.getPosition();
+            gout.drawStar(point, reader.getByte());
+            break;
+         }
+         case POINT:
+            gout.drawPoint(reader.getPosition());
+            break;
+         case HEAT:
+         {
+            Position center = reader.getPosition();
+            double sizePixels = reader.getDouble();
+            gout.drawHeat(center, sizePixels, reader.getDouble());
+            break;
+         }
+         default:
+         {
+            // everything else starts with a center and a rotation
+            Position center = reader.getPosition();
+            double rotation = reader.getRotation();
+            switch (command)
+            {
+               case FRAGMENT:           gout.drawFragment(center, rotation);                         break;
+               case CREW_DRAGON:        gout.drawCrewDragon(center, rotation);                       break;
+               case CREW_DRAGON_RIGHT:  gout.drawCrewDragonRight(center, rotation, reader.getOffset());  break;
+               case CREW_DRAGON_LEFT:   gout.drawCrewDragonLeft(center, rotation, reader.getOffset());   break;
+               case CREW_DRAGON_CENTER: gout.drawCrewDragonCenter(center, rotation);                 break;
+               case SPUTNIK:            gout.drawSputnik(center, rotation);                          break;
+               case GPS:                gout.drawGPS(center, rotation);                              break;
+               case GPS_CENTER:         gout.drawGPSCenter(center, rotation);                        break;
+               case GPS_RIGHT:          gout.drawGPSRight(center, rotation, reader.getOffset());     break;
+               case GPS_LEFT:           gout.drawGPSLeft(center, rotation, reader.getOffset());      break;
+               case HUBBLE:             gout.drawHubble(center, rotation);                           break;
+               case HUBBLE_COMPUTER:    gout.drawHubbleComputer(center, rotation, reader.getOffset());   break;
+               case HUBBLE_TELESCOPE:   gout.drawHubbleTelescope(center, rotation, reader.getOffset());  break;
+               case HUBBLE_LEFT:        gout.drawHubbleLeft(center, rotation, reader.getOffset());   break;
+               case HUBBLE_RIGHT:       gout.drawHubbleRight(center, rotation, reader.getOffset());  break;
+               case STARLINK:           gout.drawStarlink(center, rotation);                         break;
+               case STARLINK_BODY:      gout.drawStarlinkBody(center, rotation, reader.getOffset()); break;
+               case STARLINK_ARRAY:     gout.drawStarlinkArray(center, rotation, reader.getOffset());    break;
+               case SHIP:               gout.drawShip(center, rotation, reader.getByte() != 0);      break;
+               case EARTH:              gout.drawEarth(center, rotation);                            break;
+               default:
+                  // a corrupt buffer: nothing after this can be trusted
+                  ptZoom.setZoom(zoomOld);
+                  return;
+            }
+         }
+      }
+   }
+
+   ptZoom.setZoom(zoomOld);
+}
+
+/*************************************************************************
+ * RECORD : SAVE
+ * The file is the magic number, the buffer size, then the buffer
+ *************************************************************************/
+bool ogstreamRecord::save(const char* fileName) const
+{
+   FILE* file = fopen(fileName, "wb");
+   if (!file)
+      return false;
+
+   unsigned long long size = buffer.size();
+   bool success =
+      fwrite(RECORD_MAGIC, sizeof(RECORD_MAGIC), 1, file) == 1 &&
+      fwrite(&size, sizeof(size), 1, file) == 1 &&
+      (size == 0 || fwrite(buffer.data(), (size_t)size, 1, file) == 1);
+   return fclose(file) == 0 && success;
+}
+
+/*************************************************************************
+ * RECORD : LOAD
+ * Replace whatever we have with what was saved. The size in the file is
+ * checked against what is really there before any room is made for it.
+ * The command count is worked out again by walking the buffer
+ *************************************************************************/
+bool ogstreamRecord::load(const char* fileName)
+{
+   std::error_code error;
+   unsigned long long fileBytes = std::filesystem::file_size(fileName, error);
+   if (error)
+      return false;
+
+   FILE* file = fopen(fileName, "rb");
+   if (!file)
+      return false;
+
+   char magic[sizeof(RECORD_MAGIC)];
+   unsigned long long size = 0;
+   bool success =
+      fread(magic, sizeof(magic), 1, file) == 1 &&
+      memcmp(magic, RECORD_MAGIC, sizeof(magic)) == 0 &&
+      fread(&size, sizeof(size), 1, file) == 1 &&
+      size == fileBytes - sizeof(magic) - sizeof(size);
+   if (success)
+   {
+      clear();
+      buffer.resize((size_t)size);
+      success = size == 0 || fread(buffer.data(), (size_t)size, 1, file) == 1;
+   }
+   fclose(file);
+   if (!success)
+   {
+      clear();
+      return false;
+   }
+
+   // count the commands so getNumCommands() agrees with the recording
+   for (size_t cursor = 0; cursor < buffer.size(); )
+   {
+      size_t size = commandSize(buffer, cursor);
+      if (size == 0)
+      {
+         clear();
+         return false;
+      }
+      if (buffer[cursor] != ZOOM)
+         numCommands++;
+      cursor += 1 + size;
+   }
+   return true;
+}
@@ -0,0 +1,122 @@
+/***********************************************************************
+ * Header File:
+ *    User Interface Record : remember what was drawn
+ * Author:
+ *    Chris Mijango and Seth Chen
+ * Summary:
+ *    A graphics stream that draws nothing. Every call is written to a
+ *    compact binary command buffer instead, which can later be replayed
+ *    into any other graphics stream, saved to a file, or compared.
+ ************************************************************************/
+
+#pragma once
+
+#include "uiDraw.h"
+#include <vector>
+#include <cstddef>   // for size_t
+
+class TestRecord;
+class RecordReader;
+
+/*************************************************************************
+ * GRAPHICS STREAM RECORD
+ * Each draw call becomes one command: a single type byte followed by
+ * just the arguments that call needs. Centers are kept in meters while
+ * offsets are kept in pixels, and the zoom is recorded whenever it
+ * changes, so a replay looks the same no matter what the zoom is then.
+ *************************************************************************/
+class ogstreamRecord : public ogstream
+{
+public:
+   friend TestRecord;
+
+   ogstreamRecord() : zoom(0.0), numCommands(0) {}
+   ~ogstreamRecord() { flush(); }
+
+   // Command buffer management
+   void clear();
+   size_t getNumCommands() const { return numCommands; }
+   const std::vector<unsigned char>& getBuffer() const { return buffer; }
+   void swap(ogstreamRecord& rhs);
+
+   // Draw every recorded command into another stream, optionally blending
+   // from an earlier recording with a weight of 0.0 (previous) to 1.0 (this)
+   void replay(ogstream& gout) const;
+   void replay(ogstream& gout, const ogstreamRecord& previous, double weight) const;
+   bool isSameShape(const ogstreamRecord& rhs) const;
+
+   // Save and load the command buffer. Returns false on failure
+   bool save(const char* fileName) const;
+   bool load(const char* fileName);
+
+   // Everything an ogstream can draw
+   void setView(const Position& ptCenter) override;
+
+   void drawFragment(const Position& center, double rotation) override;
+   void drawProjectile(const Position& pt) override;
+
+   void drawCrewDragon(const Position& center, double rotation) override;
+   void drawCrewDragonRight(const Position& center, double rotation, const Position& offset = Position()) override;
+   void drawCrewDragonLeft(const Position& center, double rotation, const Position& offset = Position()) override;
+   void drawCrewDragonCenter(const Position& center, double rotation) override;
+
+   void drawSputnik(const Position& center, double rotation) override;
+
+   void drawGPS(const Position& center, double rotation) override;
+   void drawGPSCenter(const Position& center, double rotation) override;
+   void drawGPSRight(const Position& center, double rotation, const Position& offset = Position()) override;
+   void drawGPSLeft(const Position& center, double rotation, const Position& offset = Position()) override;
+
+   void drawHubble(const Position& center, double rotation) override;
+   void drawHubbleComputer(const Position& center, double rotation, const Position& offset = Position()) override;
+   void drawHubbleTelescope(const Position& center, double rotation, const Position& offset = Position()) override;
+   void drawHubbleLeft(const Position& center, double rotation, const Position& offset = Position()) override;
+   void drawHubbleRight(const Position& center, double rotation, const Position& offset = Position()) override;
+
+   void drawStarlink(const Position& center, double rotation) override;
+   void drawStarlinkBody(const Position& center, double rotation, const Position& offset = Position()) override;
+   void drawStarlinkArray(const Position& center, double rotation, const Position& offset = Position()) override;
+
+   void drawShip(const Position& center, double rotation, bool thrust) override;
+
+   void drawEarth(const Position& center, double rotation) override;
+
+   void drawStar(const Position& point, unsigned char phase) override;
+
+   void drawPoint(const Position& center) override;
+   void drawHeat(const Position& center, double sizePixels, double heat) override;
+
+protected:
+   void drawText(const Position& topLeft, const char* text) override;
+
+private:
+   enum Command : unsigned char
+   {
+      ZOOM, VIEW, TEXT,
+      FRAGMENT, PROJECTILE,
+      CREW_DRAGON, CREW_DRAGON_RIGHT, CREW_DRAGON_LEFT, CREW_DRAGON_CENTER,
+      SPUTNIK,
+      GPS, GPS_CENTER, GPS_RIGHT, GPS_LEFT,
+      HUBBLE, HUBBLE_COMPUTER, HUBBLE_TELESCOPE, HUBBLE_LEFT, HUBBLE_RIGHT,
+      STARLINK, STARLINK_BODY, STARLINK_ARRAY,
+      SHIP, EARTH, STAR, POINT, HEAT,
+      NUM_COMMANDS
+   };
+
+   // reading
+   void replay(ogstream& gout, RecordReader& reader) const;
+   static size_t commandSize(const std::vector<unsigned char>& buffer, size_t cursor);
+
+   // writing
+   void begin(Command command);
+   void record(Command command, const Position& center, double rotation);
+   void record(Command command, const Position& center, double rotation, const Position& offset);
+   void putByte(unsigned char value) { buffer.push_back(value); }
+   void putDouble(double value);
+   void putPosition(const Position& pt);
+   void putOffset(const Position& offset);
+
+   std::vector<unsigned char> buffer;   // the commands, back to back
+   double zoom;                         // the zoom last recorded
+   size_t numCommands;                  // not counting zoom changes
+};
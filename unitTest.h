@@ -21,25 +21,127 @@
 
 #include <iostream>  // for std::cerr
 #include <iomanip>   // for std::setw
-#include <string>    // for std::string
 #include <vector>    // for std::vector
-#include <map>       // for std::map
+#include <chrono>    // for steady_clock
+#include <cstring>   // for strcmp()
 
 class UnitTest
 {
 public:
     UnitTest() { reset(); }
 
-private:
-    // a test failure is a failure string and a line number
+    // a test failure is the condition that failed and its line number
     struct Failure
     {
-        std::string failure;
+        const char* failure;
         int         lineNumber;
     };
 
-    // each test has a name (the key) and the list of failures(value).
-    std::map<std::string, std::vector<Failure>> tests;
+    // each test case is named after its function. A case usually sets up
+    // and exercises before it first asserts anything, so it is timed from
+    // the first assertion of the case before it (or the start of the
+    // suite) to its own first assertion
+    struct Case
+    {
+        const char*          name;
+        double               seconds;
+        std::vector<Failure> failures;
+    };
+
+    // everything one run() found
+    struct Suite
+    {
+        const char*       name;
+        std::vector<Case> cases;
+    };
+
+    // When set, report() puts the suite here rather than on the screen.
+    // Each thread has its own, so suites can run side by side
+    static inline thread_local std::vector<Suite>* pResults = nullptr;
+
+    /*************************************************************
+     * PRINT
+     * Show the failures and the success rate of a suite
+     *************************************************************/
+    static void print(const Suite& suite, std::ostream& out)
+    {
+        // enumerate the failures, if there are any
+        for (const Case& test : suite.cases)
+            if (!test.failures.empty())
+            {
+                out << "\t" << test.name << "()\n";
+                for (const Failure& failure : test.failures)
+                    out << "\t\tline:" << failure.lineNumber
+                    << " condition:" << failure.failure << "\n";
+            }
+
+        // name the test case
+        out << std::left << std::setw(15) << suite.name << ":\t";
+
+        // handle the no test case
+        if (suite.cases.empty())
+        {
+            out << "There were no tests]\n";
+            return;
+        }
+
+        // determine the success rate
+        int numSuccess = 0;
+        for (const Case& test : suite.cases)
+            numSuccess += (test.failures.empty() ? 1 : 0);
+        double successRate = (double)numSuccess / (double)suite.cases.size();
+
+        // display the summary
+        out.setf(std::ios::fixed | std::ios::showpoint);
+        out.precision(1);
+        out << "There were "
+            << suite.cases.size()
+            << " tests run for a success rate of: "
+            << (successRate * 100.0) << "%\n";
+    }
+
+private:
+    // the test cases in the order they first asserted something
+    std::vector<Case> tests;
+
+    // the case asserting now, and when it started to
+    const char* current = nullptr;
+    size_t      iCurrent = 0;
+    std::chrono::steady_clock::time_point timeLast;
+
+    /*************************************************************
+     * FIND
+     * The test case for a function, starting one if it is new
+     *************************************************************/
+    size_t find(const char* func)
+    {
+        for (size_t i = 0; i < tests.size(); i++)
+            if (strcmp(tests[i].name, func) == 0)
+                return i;
+        tests.push_back(Case{ func, 0.0, {} });
+        return tests.size() - 1;
+    }
+
+    /*************************************************************
+     * RECORD
+     * Everything but a pass in the case already asserting: start
+     * timing a new case, note a failure, or both
+     *************************************************************/
+    void record(bool condition, const char* conditionString, int line, const char* func)
+    {
+        if (func != current)
+        {
+            auto now = std::chrono::steady_clock::now();
+            iCurrent = find(func);
+            current = func;
+            tests[iCurrent].seconds += std::chrono::duration<double>(now - timeLast).count();
+            timeLast = now;
+        }
+
+        // add a failure to the list of failures
+        if (!condition)
+            tests[iCurrent].failures.push_back(Failure{ conditionString, line });
+    }
 
 protected:
 
@@ -62,6 +164,8 @@ protected:
     void reset()
     {
         tests.clear();
+        current = nullptr;
+        timeLast = std::chrono::steady_clock::now();
     }
 
     /*************************************************************
@@ -70,39 +174,11 @@ protected:
      *************************************************************/
     void report(const char* name)
     {
-        // enumerate the failures, if there are any
-        for (auto& test : tests)
-            if (!test.second.empty())
-            {
-                std::cout << "\t" << test.first << "()\n";
-                for (auto& failure : test.second)
-                    std::cout << "\t\tline:" << failure.lineNumber
-                    << " condition:" << failure.failure << "\n";
-            }
-
-        // name the test case
-        std::cout << std::left << std::setw(15) << name << ":\t";
-
-        // handle the no test case
-        if (tests.empty())
-        {
-            std::cout << "There were no tests]\n";
-            return;
-        }
-
-        // determine the success rate
-        int numSuccess = 0;
-        for (auto& test : tests)
-            numSuccess += (test.second.empty() ? 1 : 0);
-        double successRate = (double)numSuccess / (double)tests.size();
-
-        // display the summary
-        std::cout.setf(std::ios::fixed | std::ios::showpoint);
-        std::cout.precision(1);
-        std::cout << "There were "
-            << tests.size()
-            << " tests run for a success rate of: "
-            << (successRate * 100.0) << "%\n";
+        Suite suite{ name, std::move(tests) };
+        if (pResults)
+            pResults->push_back(std::move(suite));
+        else
+            print(suite, std::cout);
 
         // after we have reported, the reset for the next report
         reset();
@@ -110,24 +186,18 @@ protected:
 
     /*************************************************************
      * ASSERT UNIT PARAMETERS
-     * Custom assert code so we can see all the errors at once
+     * Custom assert code so we can see all the errors at once. The
+     * clock is only read where one case ends and the next begins, so
+     * passing in the same case as last time is a single branch: the
+     * two tests are or-ed without short circuiting. __FUNCTION__ is the
+     * same pointer every time it is used in a function, so comparing
+     * pointers is enough to tell
      *************************************************************/
     void assertUnitParameters(bool condition, const char* conditionString,
         int line, const char* func)
     {
-        std::string sFunc(func);
-
-        if (!condition)
-        {
-            // add a failure to the list of failures
-            Failure failure{ std::string(conditionString), line };
-            tests[sFunc].push_back(failure);
-        }
-        else
-        {
-            // this ensures there is a placeholder for the successful test
-            tests[sFunc];
-        }
+        if ((func != current) | !condition)
+            record(condition, conditionString, line, func);
     }
 
 
@@ -137,16 +207,7 @@ protected:
      *************************************************************/
     void verify(bool condition, const char* function)
     {
-        std::string sFunc(function);
-        if (!condition)
-        {
-            Failure failure{ "Failed", __LINE__ };
-            tests[sFunc].push_back(failure);
-        }
-        else
-        {
-            tests[sFunc]; // Register successful test
-        }
+        assertUnitParameters(condition, "Failed", __LINE__, function);
     }
 
 };